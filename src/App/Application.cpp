@@ -27,6 +27,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <iostream>
 # include <sstream>
 # include <exception>
@@ -70,6 +71,8 @@
 #include <Base/PlacementPy.h>
 #include <Base/RotationPy.h>
 #include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 #include <Base/UnitsApi.h>
 #include <Base/QuantityPy.h>
@@ -148,6 +151,7 @@ Base::ConsoleObserverStd  *Application::_pConsoleObserverStd =0;
 Base::ConsoleObserverFile *Application::_pConsoleObserverFile =0;
 
 AppExport std::map<std::string,std::string> Application::mConfig;
+std::vector<Application::StartupPhase> Application::_startupPhases;
 BaseExport extern PyObject* Base::BaseExceptionFreeCADError;
 
 
@@ -903,6 +907,7 @@ void Application::destruct(void)
 
     Base::Interpreter().finalize();
 
+    Base::TaskScheduler::Destruct();
     ScriptFactorySingleton::Destruct();
     InterpreterSingleton::Destruct();
     Base::Type::destruct();
@@ -1014,14 +1019,24 @@ void Application::init(int argc, char ** argv)
 //        _set_se_translator(my_trans_func);
 #endif
 
+        Base::TimeInfo timer;
         initTypes();
+        addStartupPhase("Register types", Base::TimeInfo::diffTimeF(timer));
 
 #if (BOOST_VERSION < 104600) || (BOOST_FILESYSTEM_VERSION == 2)
         boost::filesystem::path::default_name_check(boost::filesystem::no_check);
 #endif
 
+        timer.setCurrent();
         initConfig(argc,argv);
+        addStartupPhase("Configuration", Base::TimeInfo::diffTimeF(timer));
+
+        // the Init.py of each module adds its own phase while the init script
+        // runs, so the script's phase is added first and finished afterwards
+        timer.setCurrent();
+        std::size_t phase = addStartupPhase("App init script", 0.0);
         initApplication();
+        setStartupPhaseDuration(phase, Base::TimeInfo::diffTimeF(timer));
     }
     catch (...) {
         // force to flush the log
@@ -1096,6 +1111,8 @@ void Application::initTypes(void)
     App ::GeoFeatureGroupPython     ::init();
     App ::FeatureTest               ::init();
     App ::FeatureTestException      ::init();
+    App ::FeatureTestParallel       ::init();
+    App ::FeatureTestConsole        ::init();
     App ::FeaturePython             ::init();
     App ::GeometryPython            ::init();
     App ::Document                  ::init();
@@ -1201,6 +1218,13 @@ void Application::initConfig(int argc, char ** argv)
 
     LoadParameters();
 
+    // the observers of the GUI are set up later and switch the console mode
+    // themselves once the splash screen is gone
+    if (_pcUserParamMngr->GetGroup("BaseApp/Preferences/General")->GetBool("AsyncConsole", false))
+        mConfig["AsyncConsole"] = "1";
+    if (mConfig["AsyncConsole"] == "1" && mConfig["RunMode"] != "Gui")
+        Console().SetMode(ConsoleSingleton::Asynchronous);
+
     // capture python variables
     SaveEnv("PYTHONPATH");
     SaveEnv("PYTHONHOME");
@@ -1249,6 +1273,11 @@ void Application::initApplication(void)
        ("User parameter:BaseApp/Preferences/Units");
     UnitsApi::setSchema((UnitSystem)hGrp->GetInt("UserSchema",0));
 
+    // set up the number of threads parallel algorithms may use (0 = all cores)
+    hGrp = App::GetApplication().GetParameterGroupByPath
+       ("User parameter:BaseApp/Preferences/General");
+    Base::TaskScheduler::Instance().setThreadBudget(hGrp->GetInt("ThreadBudget",0));
+
 #if defined (_DEBUG)
     Console().Log("Application is built with debug information\n");
 #endif
@@ -1353,7 +1382,10 @@ void Application::processCmdLineFiles(void)
 void Application::runApplication()
 {
     // process all files given through command line interface
+    Base::TimeInfo timer;
     processCmdLineFiles();
+    addStartupPhase("Command line files", Base::TimeInfo::diffTimeF(timer));
+    dumpStartupTimeline();
 
     if (mConfig["RunMode"] == "Cmd") {
         // Run the comandline interface
@@ -1368,11 +1400,48 @@ void Application::runApplication()
         // geting out
         Console().Log("Exiting on purpose\n");
     }
+    else if (mConfig["RunMode"] == "Worker") {
+        // the worker is run by the main function of the command line version
+        Console().Error("The worker mode is only supported by the command line version\n");
+    }
     else {
         Console().Log("Unknown Run mode (%d) in main()?!?\n\n",mConfig["RunMode"].c_str());
     }
 }
 
+std::size_t Application::addStartupPhase(const char* name, double seconds, int level)
+{
+    StartupPhase phase;
+    phase.name = name;
+    phase.seconds = seconds;
+    phase.level = level;
+    _startupPhases.push_back(phase);
+    return _startupPhases.size() - 1;
+}
+
+void Application::setStartupPhaseDuration(std::size_t index, double seconds)
+{
+    if (index < _startupPhases.size())
+        _startupPhases[index].seconds = seconds;
+}
+
+void Application::dumpStartupTimeline(void)
+{
+    if (mConfig["StartupTimeline"] != "1")
+        return;
+
+    // nested phases are already contained in the time of their parent phase
+    double total = 0.0;
+    Console().Message("Startup timeline:\n");
+    for (std::vector<StartupPhase>::const_iterator it = _startupPhases.begin(); it != _startupPhases.end(); ++it) {
+        if (it->level == 0)
+            total += it->seconds;
+        std::string indent(2 * std::max<int>(it->level, 0), ' ');
+        Console().Message("  %8.3f s  %s%s\n", it->seconds, indent.c_str(), it->name.c_str());
+    }
+    Console().Message("  %8.3f s  Total\n", total);
+}
+
 void Application::logStatus()
 {
     time_t now;
@@ -1540,6 +1609,9 @@ void Application::ParseOptions(int ac, char ** av)
     ("response-file", value<string>(),"Can be specified with '@name', too")
     ("dump-config", "Dumps configuration")
     ("get-config", value<string>(), "Prints the value of the requested configuration key")
+    ("worker", "Stays alive and processes the jobs read from stdin (command line version only)")
+    ("worker-socket", value<string>(), "Stays alive and processes the jobs sent to this local socket (command line version only)")
+    ("worker-slots", value<int>(), "Number of processes that serve the worker socket")
     ;
 
     // Declare a group of options that will be
@@ -1557,6 +1629,8 @@ void Application::ParseOptions(int ac, char ** av)
     ("user-cfg,u", value<string>(),"User config file to load/save user settings")
     ("system-cfg,s", value<string>(),"Systen config file to load/save system settings")
     ("run-test,t",   value<int>()   ,"Test level")
+    ("startup-timeline", "Print the time spent in each startup phase and module")
+    ("async-log", "Pass the console messages to the output and log file from a separate thread")
     ("module-path,M", value< vector<string> >()->composing(),"Additional module paths")
     ("python-path,P", value< vector<string> >()->composing(),"Additional python paths")
     ;
@@ -1700,6 +1774,21 @@ void Application::ParseOptions(int ac, char ** av)
         mConfig["RunMode"] = "Cmd";
     }
 
+    if (vm.count("worker")) {
+        mConfig["RunMode"] = "Worker";
+    }
+
+    if (vm.count("worker-socket")) {
+        mConfig["RunMode"] = "Worker";
+        mConfig["WorkerSocket"] = vm["worker-socket"].as<string>();
+    }
+
+    if (vm.count("worker-slots")) {
+        std::stringstream str;
+        str << vm["worker-slots"].as<int>();
+        mConfig["WorkerSlots"] = str.str();
+    }
+
     if (vm.count("module-path")) {
         vector<string> Mods = vm["module-path"].as< vector<string> >();
         string temp;
@@ -1742,6 +1831,14 @@ void Application::ParseOptions(int ac, char ** av)
         mConfig["StartHidden"] = "1";
     }
 
+    if (vm.count("startup-timeline")) {
+        mConfig["StartupTimeline"] = "1";
+    }
+
+    if (vm.count("async-log")) {
+        mConfig["AsyncConsole"] = "1";
+    }
+
     if (vm.count("write-log")) {
         mConfig["LoggingFile"] = "1";
         //mConfig["LoggingFileName"] = vm["write-log"].as<string>();
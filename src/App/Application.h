@@ -223,6 +223,25 @@ public:
     static char** GetARGV(void){return _argv;}
     //@}
 
+    /** @name Startup timeline
+     * The durations of the startup phases, i.e. the type registration, the
+     * configuration, the init scripts and the Init.py of each module, are
+     * collected here and printed with the --startup-timeline switch.
+     */
+    //@{
+    /** Record the duration of a startup phase in seconds. Phases with a level
+     * greater than zero are part of the preceding phase of a lower level.
+     * Returns the position of the phase for setStartupPhaseDuration().
+     */
+    static std::size_t addStartupPhase(const char* name, double seconds, int level=0);
+    /** Set the duration of a phase that has been added before its nested
+     * phases, i.e. before it was finished.
+     */
+    static void setStartupPhaseDuration(std::size_t index, double seconds);
+    /// Print the recorded startup phases if requested on the command line
+    static void dumpStartupTimeline(void);
+    //@}
+
     const char* getHomePath(void) const;
     const char* getExecutableName(void) const;
     static std::string getUserAppDataDir();
@@ -295,6 +314,7 @@ private:
     static PyObject* sAddDocObserver    (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject* sRemoveDocObserver (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject* sTranslateUnit     (PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject* sAddStartupPhase   (PyObject *self,PyObject *args,PyObject *kwd);
 
     static PyMethodDef    Methods[]; 
 
@@ -325,6 +345,13 @@ private:
     static std::map<std::string,std::string> mConfig;
     static int _argc;
     static char ** _argv;
+    struct StartupPhase {
+        std::string name;
+        double seconds;
+        int level;
+    };
+    /// startup phases with their durations
+    static std::vector<StartupPhase> _startupPhases;
     //@}
 
     struct FileTypeItem {
@@ -129,6 +129,10 @@ PyMethodDef Application::Methods[] = {
     {"removeDocumentObserver",  (PyCFunction) Application::sRemoveDocObserver  ,1,
      "removeDocumentObserver() -> None\n\n"
      "Remove an added document observer."},
+    {"addStartupPhase",  (PyCFunction) Application::sAddStartupPhase  ,1,
+     "addStartupPhase(string, float, [int]) -> None\n\n"
+     "Record the duration in seconds of a startup phase for the timeline\n"
+     "printed with --startup-timeline. The optional level nests the phase."},
 
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
@@ -589,3 +593,15 @@ PyObject* Application::sRemoveDocObserver(PyObject * /*self*/, PyObject *args,Py
         Py_Return;
     } PY_CATCH;
 }
+
+PyObject* Application::sAddStartupPhase(PyObject * /*self*/, PyObject *args,PyObject * /*kwd*/)
+{
+    char* name;
+    double seconds;
+    int level=0;
+    if (!PyArg_ParseTuple(args, "sd|i", &name, &seconds, &level))
+        return NULL;
+
+    addStartupPhase(name, seconds, level);
+    Py_Return;
+}
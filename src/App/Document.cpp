@@ -142,6 +142,9 @@ struct DocumentP
     // Array to preserve the creation order of created objects
     std::vector<DocumentObject*> objectArray;
     std::map<std::string,DocumentObject*> objectMap;
+    // numeric suffixes of the object names and labels
+    Base::UniqueNameManager objectNames;
+    Base::UniqueNameManager objectLabels;
     DocumentObject* activeObject;
     Transaction *activeUndoTransaction;
     Transaction *activeTransaction;
@@ -152,7 +155,7 @@ struct DocumentP
     bool closable;
     bool keepTrailingDigits;
     int iUndoMode;
-    unsigned int UndoMemSize;
+    unsigned int UndoMemLimit;
     unsigned int UndoMaxStackSize;
 #if USE_OLD_DAG
     DependencyList DepList;
@@ -171,9 +174,19 @@ struct DocumentP
         closable = true;
         keepTrailingDigits = true;
         iUndoMode = 0;
-        UndoMemSize = 0;
+        UndoMemLimit = 0;
         UndoMaxStackSize = 20;
     }
+
+    // Only objects that are part of the document take part in the label index
+    bool hasObject(const DocumentObject* obj) const
+    {
+        const char* name = obj->getNameInDocument();
+        if (!name)
+            return false;
+        std::map<std::string,DocumentObject*>::const_iterator pos = objectMap.find(name);
+        return pos != objectMap.end() && pos->second == obj;
+    }
 };
 
 } // namespace App
@@ -375,6 +388,21 @@ void Document::commitTransaction()
             delete mUndoTransactions.front();
             mUndoTransactions.pop_front();
         }
+        // the latest transaction is always kept
+        if (d->UndoMemLimit > 0) {
+            unsigned int size = getUndoMemSize();
+            while (mUndoTransactions.size() > 1 && size > d->UndoMemLimit) {
+                Transaction* front = mUndoTransactions.front();
+                size -= std::min<unsigned int>(size, front->getMemSize());
+                delete front;
+                mUndoTransactions.pop_front();
+                // the chunks the removed transaction shared with the next one
+                // are then fully accounted to the next one, so count again
+                // when the estimate falls below the limit
+                if (size <= d->UndoMemLimit)
+                    size = getUndoMemSize();
+            }
+        }
     }
 }
 
@@ -451,12 +479,22 @@ int Document::getUndoMode(void) const
 
 unsigned int Document::getUndoMemSize (void) const
 {
-    return d->UndoMemSize;
+    // snapshots of big list properties share the unchanged chunks and
+    // only account for their share of them
+    unsigned int size = 0;
+    std::list<Transaction*>::const_iterator it;
+    for (it = mUndoTransactions.begin(); it != mUndoTransactions.end(); ++it)
+        size += (*it)->getMemSize();
+    for (it = mRedoTransactions.begin(); it != mRedoTransactions.end(); ++it)
+        size += (*it)->getMemSize();
+    if (d->activeUndoTransaction)
+        size += d->activeUndoTransaction->getMemSize();
+    return size;
 }
 
 void Document::setUndoLimit(unsigned int UndoMemSize)
 {
-    d->UndoMemSize = UndoMemSize;
+    d->UndoMemLimit = UndoMemSize;
 }
 
 void Document::setMaxUndoStackSize(unsigned int UndoMaxStackSize)
@@ -513,12 +551,16 @@ void Document::onBeforeChangeProperty(const DocumentObject *Who, const Property
 {
     if (d->activeUndoTransaction && !d->rollback)
         d->activeUndoTransaction->addObjectChange(Who,What);
+    if (What == &Who->Label && d->hasObject(Who))
+        d->objectLabels.removeName(Who->Label.getValue());
 }
 
 void Document::onChangedProperty(const DocumentObject *Who, const Property *What)
 {
     if (d->activeTransaction && !d->rollback)
         d->activeTransaction->addObjectChange(Who,What);
+    if (What == &Who->Label && d->hasObject(Who))
+        d->objectLabels.addName(Who->Label.getValue());
     signalChangedObject(*Who, *What);
 }
 
@@ -1128,6 +1170,8 @@ void Document::restore (void)
     }
     d->objectArray.clear();
     d->objectMap.clear();
+    d->objectNames.clear();
+    d->objectLabels.clear();
     d->activeObject = 0;
 
     Base::FileInfo fi(FileName.getValue());
@@ -1499,7 +1543,9 @@ int Document::recompute()
             std::clog << "Recompute" << std::endl;
 #endif
 			objectCount++;
-            if (_recomputeFeature(Cur)) {
+            bool abort = _recomputeFeature(Cur);
+            signalRecomputedObject(*Cur);
+            if (abort) {
                 // if something happen break execution of recompute
                 d->vertexMap.clear();
                 return -1;
@@ -1541,6 +1587,7 @@ int Document::recompute()
         if ((*objIt)->mustExecute() == 1){
             objectCount++;
             if (_recomputeFeature(*objIt)) {
+                signalRecomputedObject(**objIt);
                 // if something happen break execution of recompute
                 return -1;
             }
@@ -1640,6 +1687,7 @@ void Document::recomputeFeature(DocumentObject* Feat)
     _RecomputeLog.clear();
 
     _recomputeFeature(Feat);
+    signalRecomputedObject(*Feat);
 }
 
 DocumentObject * Document::addObject(const char* sType, const char* pObjectName)
@@ -1680,8 +1728,10 @@ DocumentObject * Document::addObject(const char* sType, const char* pObjectName)
 
     // insert in the name map
     d->objectMap[ObjectName] = pcObject;
+    d->objectNames.addName(ObjectName);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    d->objectLabels.addName(pcObject->Label.getValue());
     // insert in the vector
     d->objectArray.push_back(pcObject);
     // insert in the adjacence list and referenc through the ConectionMap
@@ -1702,9 +1752,11 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
 {
     std::string ObjectName = getUniqueObjectName(pObjectName);
     d->objectMap[ObjectName] = pcObject;
+    d->objectNames.addName(ObjectName);
     d->objectArray.push_back(pcObject);
     // cache the pointer to the name string in the Object (for performance of DocumentObject::getNameInDocument())
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
+    d->objectLabels.addName(pcObject->Label.getValue());
 
     // do no transactions if we do a rollback!
     if(!d->rollback){
@@ -1766,6 +1818,9 @@ void Document::remObject(const char* sName, bool forceIfUndeletable)
         TipName.setValue("");
     }
 
+    d->objectNames.removeName(pos->first);
+    d->objectLabels.removeName(pos->second->Label.getValue());
+
     // do no transactions if we do a rollback!
     if(!d->rollback){
 
@@ -1826,6 +1881,8 @@ void Document::_remObject(DocumentObject* pcObject)
             d->activeUndoTransaction->addObjectNew(pcObject);
     }
     // remove from map
+    d->objectNames.removeName(pos->first);
+    d->objectLabels.removeName(pcObject->Label.getValue());
     d->objectMap.erase(pos);
     //// set name cache false
     //pcObject->pcNameInDocument = 0;
@@ -2046,26 +2103,13 @@ std::string Document::getUniqueObjectName(const char *Name) const
             }
         }
 
-        std::vector<std::string> names;
-        names.reserve(d->objectMap.size());
-        for (pos = d->objectMap.begin();pos != d->objectMap.end();++pos) {
-            names.push_back(pos->first);
-        }
-        return Base::Tools::getUniqueName(CleanName, names, 3);
+        return d->objectNames.makeUniqueName(CleanName, 3);
     }
 }
 
-std::string Document::getStandardObjectName(const char *Name, int d) const
+std::string Document::getStandardObjectName(const char *Name, int digits) const
 {
-    std::vector<App::DocumentObject*> mm = getObjects();
-    std::vector<std::string> labels;
-    labels.reserve(mm.size());
-
-    for (std::vector<App::DocumentObject*>::const_iterator it = mm.begin(); it != mm.end(); ++it) {
-        std::string label = (*it)->Label.getValue();
-        labels.push_back(label);
-    }
-    return Base::Tools::getUniqueName(Name, labels, d);
+    return d->objectLabels.makeUniqueName(Name, digits);
 }
 
 std::vector<DocumentObject*> Document::getObjects() const
@@ -119,6 +119,10 @@ public:
     boost::signal<void (const App::DocumentObject&)> signalRenamedObject;
     /// signal on activated Object
     boost::signal<void (const App::DocumentObject&)> signalActivatedObject;
+    /// signal on touched or purged Object, its status has changed without a property change
+    boost::signal<void (const App::DocumentObject&)> signalTouchedObject;
+    /// signal on recomputed Object, its touched and error status may have changed
+    boost::signal<void (const App::DocumentObject&)> signalRecomputedObject;
     /// signal on undo
     boost::signal<void (const App::Document&)> signalUndo;
     /// signal on redo
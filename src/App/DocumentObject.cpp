@@ -429,6 +429,18 @@ vector<PyObject *> DocumentObject::getPySubObjects(const vector<string>&) const
 void DocumentObject::touch(void)
 {
     StatusBits.set(0);
+    if (_pDoc)
+        _pDoc->signalTouchedObject(*this);
+}
+
+void DocumentObject::purgeTouched(void)
+{
+    // the shown status only changes if the object had to be recomputed
+    bool touched = (mustExecute() == 1);
+    StatusBits.reset(0);
+    setPropertyStatus(0,false);
+    if (touched && _pDoc)
+        _pDoc->signalTouchedObject(*this);
 }
 
 void DocumentObject::Save (Base::Writer &writer) const
@@ -103,7 +103,7 @@ public:
     /// test if this feature is touched
     bool isTouched(void) const {return StatusBits.test(0);}
     /// reset this feature touched
-    void purgeTouched(void){StatusBits.reset(0);setPropertyStatus(0,false);}
+    void purgeTouched(void);
     /// set this feature to error
     bool isError(void) const {return  StatusBits.test(1);}
     bool isValid(void) const {return !StatusBits.test(1);}
@@ -106,12 +106,19 @@ void DynamicProperty::addDynamicProperties(const PropertyContainer* cont)
     }
 }
 
+const DynamicProperty::PropData* DynamicProperty::findProperty(const Property* prop) const
+{
+    PropPointerMap::const_iterator it = propsByPointer.find(prop);
+    if (it != propsByPointer.end())
+        return &it->second->second;
+    return 0;
+}
+
 const char* DynamicProperty::getPropertyName(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->first.c_str();
-    }
+    PropPointerMap::const_iterator it = propsByPointer.find(prop);
+    if (it != propsByPointer.end())
+        return it->second->first.c_str();
     return this->pc->PropertyContainer::getPropertyName(prop);
 }
 
@@ -128,10 +135,9 @@ unsigned int DynamicProperty::getMemSize (void) const
 
 short DynamicProperty::getPropertyType(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.attr;
-    }
+    const PropData* data = findProperty(prop);
+    if (data)
+        return data->attr;
     return this->pc->PropertyContainer::getPropertyType(prop);
 }
 
@@ -145,10 +151,9 @@ short DynamicProperty::getPropertyType(const char *name) const
 
 const char* DynamicProperty::getPropertyGroup(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.group.c_str();
-    }
+    const PropData* data = findProperty(prop);
+    if (data)
+        return data->group.c_str();
     return this->pc->PropertyContainer::getPropertyGroup(prop);
 }
 
@@ -162,10 +167,9 @@ const char* DynamicProperty::getPropertyGroup(const char *name) const
 
 const char* DynamicProperty::getPropertyDocumentation(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.doc.c_str();
-    }
+    const PropData* data = findProperty(prop);
+    if (data)
+        return data->doc.c_str();
     return this->pc->PropertyContainer::getPropertyDocumentation(prop);
 }
 
@@ -179,10 +183,9 @@ const char* DynamicProperty::getPropertyDocumentation(const char *name) const
 
 bool DynamicProperty::isReadOnly(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.readonly;
-    }
+    const PropData* data = findProperty(prop);
+    if (data)
+        return data->readonly;
     return this->pc->PropertyContainer::isReadOnly(prop);
 }
 
@@ -196,10 +199,9 @@ bool DynamicProperty::isReadOnly(const char *name) const
 
 bool DynamicProperty::isHidden(const Property* prop) const
 {
-    for (std::map<std::string,PropData>::const_iterator it = props.begin(); it != props.end(); ++it) {
-        if (it->second.property == prop)
-            return it->second.hidden;
-    }
+    const PropData* data = findProperty(prop);
+    if (data)
+        return data->hidden;
     return this->pc->PropertyContainer::isHidden(prop);
 }
 
@@ -240,7 +242,8 @@ Property* DynamicProperty::addDynamicProperty(const char* type, const char* name
     data.attr = attr;
     data.readonly = ro;
     data.hidden = hidden;
-    props[ObjectName] = data;
+    PropMap::iterator it = props.insert(std::make_pair(ObjectName, data)).first;
+    propsByPointer[pcProperty] = it;
 
     return pcProperty;
 }
@@ -249,6 +252,7 @@ bool DynamicProperty::removeDynamicProperty(const char* name)
 {
     std::map<std::string,PropData>::iterator it = props.find(name);
     if (it != props.end()) {
+        propsByPointer.erase(it->second.property);
         delete it->second.property;
         props.erase(it);
         return true;
@@ -28,6 +28,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <boost/unordered_map.hpp>
 
 namespace Base {
 class Writer;
@@ -112,10 +113,16 @@ private:
     /// Encodes an attribute upon saving.
     std::string encodeAttribute(const std::string&) const;
     std::string getUniquePropertyName(const char *Name) const;
+    /// Returns the data of a dynamic property or 0 if \a prop is not a dynamic property.
+    const PropData* findProperty(const Property* prop) const;
 
 private:
+    typedef std::map<std::string,PropData> PropMap;
+    typedef boost::unordered_map<const Property*, PropMap::const_iterator> PropPointerMap;
     PropertyContainer* pc;
-    std::map<std::string,PropData> props;
+    PropMap props;
+    /// maps each dynamic property to its entry in props
+    PropPointerMap propsByPointer;
 };
 
 } // namespace App
@@ -23,11 +23,17 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <cstring>
+# include <sstream>
+# include <QThread>
 #endif
 
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/TaskScheduler.h>
+#include <Base/TimeInfo.h>
 #include <Base/Unit.h>
 #include "FeatureTest.h"
 #include "Material.h"
@@ -159,3 +165,218 @@ DocumentObjectExecReturn *FeatureTestException::execute(void)
 
   return 0;
 }
+
+
+PROPERTY_SOURCE(App::FeatureTestParallel, App::FeatureTest)
+
+
+FeatureTestParallel::FeatureTestParallel()
+{
+  static const char* group = "Parallel Test";
+  ADD_PROPERTY_TYPE(Count       ,(1000),group,Prop_None,"Number of items to process");
+  ADD_PROPERTY_TYPE(GrainSize   ,(1)  ,group,Prop_None,"Minimum number of items per task");
+  ADD_PROPERTY_TYPE(ExceptionAt ,(-1) ,group,Prop_None,"The item that throws an exception");
+  ADD_PROPERTY_TYPE(CancelAt    ,(-1) ,group,Prop_None,"The item that cancels the operation");
+  ADD_PROPERTY_TYPE(Visits      ,(0)  ,group,Prop_Output,"Number of visits of each item");
+  ADD_PROPERTY_TYPE(Ranges      ,(0)  ,group,Prop_Output,"Joined ranges of parallel_reduce");
+  ADD_PROPERTY_TYPE(Sum         ,(0.0),group,Prop_Output,"Sum of all items");
+}
+
+namespace {
+
+struct TestVisitor
+{
+  TestVisitor(std::vector<long>& v, long e, long c, Base::CancellationToken* t)
+    : visits(v), exceptionAt(e), cancelAt(c), token(t)
+  {
+  }
+  void operator()(std::size_t first, std::size_t last) const
+  {
+    for (std::size_t i = first; i < last; i++) {
+      if (token && token->isCanceled())
+        return;
+      // each item belongs to exactly one task
+      visits[i]++;
+      if ((long)i == exceptionAt) {
+        std::stringstream str;
+        str << "Exception at item " << i;
+        throw Base::ValueError(str.str());
+      }
+      if ((long)i == cancelAt)
+        token->cancel();
+    }
+  }
+
+  std::vector<long>& visits;
+  long exceptionAt, cancelAt;
+  Base::CancellationToken* token;
+};
+
+struct TestRange
+{
+  std::vector<long> operator()(std::size_t first, std::size_t last) const
+  {
+    std::vector<long> range;
+    range.push_back((long)first);
+    range.push_back((long)last);
+    return range;
+  }
+};
+
+struct TestJoinRanges
+{
+  std::vector<long> operator()(const std::vector<long>& a, const std::vector<long>& b) const
+  {
+    std::vector<long> ranges(a);
+    ranges.insert(ranges.end(), b.begin(), b.end());
+    return ranges;
+  }
+};
+
+struct TestSum
+{
+  double operator()(std::size_t first, std::size_t last) const
+  {
+    double sum = 0.0;
+    for (std::size_t i = first; i < last; i++)
+      sum += (double)i;
+    return sum;
+  }
+};
+
+struct TestJoinSum
+{
+  double operator()(double a, double b) const
+  {
+    return a + b;
+  }
+};
+
+}
+
+DocumentObjectExecReturn *FeatureTestParallel::execute(void)
+{
+  std::size_t count = (std::size_t)std::max<long>(0, Count.getValue());
+  std::size_t grain = (std::size_t)std::max<long>(1, GrainSize.getValue());
+  std::vector<long> visits(count, 0);
+  Base::CancellationToken token;
+  Base::CancellationToken* cancel = CancelAt.getValue() >= 0 ? &token : 0;
+
+  try {
+    Base::parallel_for(0, count, TestVisitor(visits, ExceptionAt.getValue(), CancelAt.getValue(), cancel),
+                       grain, cancel);
+  }
+  catch (const Base::Exception& e) {
+    ExecResult.setValue(e.what());
+    return new DocumentObjectExecReturn(e.what());
+  }
+  Visits.setValues(visits);
+
+  Ranges.setValues(Base::parallel_reduce(0, count, std::vector<long>(), TestRange(), TestJoinRanges(), grain));
+  Sum.setValue(Base::parallel_reduce(0, count, 0.0, TestSum(), TestJoinSum(), grain));
+
+  ExecCount.setValue(ExecCount.getValue() + 1);
+  ExecResult.setValue("Exec");
+
+  return DocumentObject::StdReturn;
+}
+
+
+PROPERTY_SOURCE(App::FeatureTestConsole, App::FeatureTest)
+
+
+FeatureTestConsole::FeatureTestConsole()
+{
+  static const char* group = "Console Test";
+  ADD_PROPERTY_TYPE(Threads     ,(8)    ,group,Prop_None,"Number of producing threads");
+  ADD_PROPERTY_TYPE(Messages    ,(1000) ,group,Prop_None,"Number of log messages per thread");
+  ADD_PROPERTY_TYPE(Asynchronous,(false),group,Prop_None,"Notify the observers from a separate thread");
+  ADD_PROPERTY_TYPE(Delivered   ,(0)    ,group,Prop_Output,"Number of messages the observer has received");
+  ADD_PROPERTY_TYPE(Seconds     ,(0.0f) ,group,Prop_Output,"Time until all messages were delivered");
+}
+
+namespace {
+
+const char* consoleTestPrefix = "Console test: ";
+
+class ConsoleProducer : public QThread
+{
+public:
+  ConsoleProducer(long n) : messages(n)
+  {
+  }
+
+protected:
+  void run()
+  {
+    for (long i = 0; i < messages; i++)
+      Base::Console().Log("%s%ld\n", consoleTestPrefix, i);
+  }
+
+private:
+  long messages;
+};
+
+class ConsoleCounter : public Base::ConsoleObserver
+{
+public:
+  ConsoleCounter() : count(0)
+  {
+    bErr = bMsg = bWrn = false;
+  }
+  // the console passes the messages to one observer at a time
+  void Log(const char* sLog)
+  {
+    if (strncmp(sLog, consoleTestPrefix, strlen(consoleTestPrefix)) == 0)
+      count++;
+  }
+  void Error(const char*)
+  {
+  }
+  const char* Name(void)
+  {
+    return "ConsoleTest";
+  }
+
+  long count;
+};
+
+}
+
+DocumentObjectExecReturn *FeatureTestConsole::execute(void)
+{
+  Base::ConsoleSingleton& console = Base::Console();
+  bool async = console.IsAsynchronous();
+  if (Asynchronous.getValue())
+    console.SetMode(Base::ConsoleSingleton::Asynchronous);
+  else
+    console.UnsetMode(Base::ConsoleSingleton::Asynchronous);
+
+  ConsoleCounter counter;
+  console.AttachObserver(&counter);
+
+  Base::TimeInfo start;
+  std::vector<ConsoleProducer*> producers;
+  for (long i = 0; i < Threads.getValue(); i++) {
+    producers.push_back(new ConsoleProducer(Messages.getValue()));
+    producers.back()->start();
+  }
+  for (std::vector<ConsoleProducer*>::iterator it = producers.begin(); it != producers.end(); ++it) {
+    (*it)->wait();
+    delete *it;
+  }
+  console.Flush();
+  Seconds.setValue(Base::TimeInfo::diffTimeF(start));
+
+  console.DetachObserver(&counter);
+  if (async)
+    console.SetMode(Base::ConsoleSingleton::Asynchronous);
+  else
+    console.UnsetMode(Base::ConsoleSingleton::Asynchronous);
+
+  Delivered.setValue(counter.count);
+  ExecCount.setValue(ExecCount.getValue() + 1);
+  ExecResult.setValue("Exec");
+
+  return DocumentObject::StdReturn;
+}
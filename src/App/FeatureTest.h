@@ -129,6 +129,63 @@ public:
   }
 };
 
+/// The feature to test the parallel algorithms of the Base::TaskScheduler
+class FeatureTestParallel :public FeatureTest
+{
+  PROPERTY_HEADER(App::FeatureTestParallel);
+
+public:
+  FeatureTestParallel();
+
+  App::PropertyInteger     Count;
+  App::PropertyInteger     GrainSize;
+  /// the item that throws an exception, -1 for none
+  App::PropertyInteger     ExceptionAt;
+  /// the item that cancels the operation, -1 for none
+  App::PropertyInteger     CancelAt;
+
+  /// how often parallel_for visited each item
+  App::PropertyIntegerList Visits;
+  /// the ranges in the order parallel_reduce joined them
+  App::PropertyIntegerList Ranges;
+  /// the sum of all items computed by parallel_reduce
+  App::PropertyFloat       Sum;
+
+  /// run the parallel algorithms over Count items
+  virtual DocumentObjectExecReturn *execute(void);
+  /// returns the type name of the ViewProvider
+  virtual const char* getViewProviderName(void) const {
+    return "Gui::ViewProviderFeature";
+  }
+};
+
+/// The feature to test Base::Console with several producing threads
+class FeatureTestConsole :public FeatureTest
+{
+  PROPERTY_HEADER(App::FeatureTestConsole);
+
+public:
+  FeatureTestConsole();
+
+  App::PropertyInteger     Threads;
+  /// the number of log messages each thread prints
+  App::PropertyInteger     Messages;
+  /// run the test with the asynchronous console
+  App::PropertyBool        Asynchronous;
+
+  /// the number of test messages an observer has received
+  App::PropertyInteger     Delivered;
+  /// the time from starting the threads until all messages were delivered
+  App::PropertyFloat       Seconds;
+
+  /// print the messages from Threads threads
+  virtual DocumentObjectExecReturn *execute(void);
+  /// returns the type name of the ViewProvider
+  virtual const char* getViewProviderName(void) const {
+    return "Gui::ViewProviderFeature";
+  }
+};
+
 
 
 } //namespace App
@@ -34,9 +34,22 @@
 import FreeCAD
 
 
+def InitManifest(ManifestFile):
+	"""Registers the file types declared in the Manifest.cfg of a module.
+	A module with a manifest is not initialized by its Init.py, so neither its
+	libraries nor its Python code get loaded before they are actually used."""
+	import ConfigParser
+	Manifest = ConfigParser.RawConfigParser()
+	Manifest.optionxform = str # keep the case of the filters
+	Manifest.read(ManifestFile)
+	for Section,AddType in (("Import",FreeCAD.addImportType),("Export",FreeCAD.addExportType)):
+		if Manifest.has_section(Section):
+			for Filter,Module in Manifest.items(Section):
+				AddType(Filter,Module)
+
 def InitApplications():
 	try:
-		import sys,os
+		import sys,os,time
 	except ImportError:
 		FreeCAD.PrintError("\n\nSeems the python standard libs are not installed, bailing out!\n\n")
 		raise
@@ -89,8 +102,19 @@ def InitApplications():
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
 			sys.path.insert(0,Dir)
 			PathExtension += Dir + os.pathsep
+			ManifestFile = os.path.join(Dir,"Manifest.cfg")
 			InstallFile = os.path.join(Dir,"Init.py")
-			if (os.path.exists(InstallFile)):
+			StartTime = time.time()
+			if (os.path.exists(ManifestFile)):
+				InstallFile = ManifestFile
+				try:
+					InitManifest(ManifestFile)
+				except Exception, inst:
+					Log('Init:      Initializing ' + Dir + '... failed\n')
+					Err('During initialization the error ' + str(inst) + ' occurred in ' + ManifestFile + '\n')
+				else:
+					Log('Init:      Initializing ' + Dir + ' from manifest... done\n')
+			elif (os.path.exists(InstallFile)):
 				try:
 					#execfile(InstallFile)
 					exec open(InstallFile).read()
@@ -101,6 +125,8 @@ def InitApplications():
 					Log('Init:      Initializing ' + Dir + '... done\n')
 			else:
 				Log('Init:      Initializing ' + Dir + '(Init.py not found)... ignore\n')
+				continue
+			FreeCAD.addStartupPhase(os.path.join(os.path.basename(Dir),os.path.basename(InstallFile)),time.time()-StartTime,1)
 	sys.path.insert(0,LibDir)
 	sys.path.insert(0,ModDir)
 	Log("Using "+ModDir+" as module path!\n")
@@ -236,6 +262,7 @@ App.Units.Power         = App.Units.Unit(2,1,-3)
 
 # clean up namespace
 del(InitApplications)
+del(InitManifest)
 
 Log ('Init: App::FreeCADInit.py done\n')
 
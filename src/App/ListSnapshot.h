@@ -0,0 +1,134 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef APP_LISTSNAPSHOT_H
+#define APP_LISTSNAPSHOT_H
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+namespace App
+{
+
+/// Compares two values byte-wise, for value types without padding
+template <class T>
+struct BitwiseEqual
+{
+    bool operator()(const T& a, const T& b) const
+    {
+        return std::memcmp(&a, &b, sizeof(T)) == 0;
+    }
+};
+
+/**
+ * The ListSnapshot class keeps the values of a big list for undo and redo.
+ * The values are split into chunks of fixed size, and a chunk that is equal to
+ * the chunk at the same position of the previous snapshot is shared with it
+ * instead of being copied. Thus, a transaction that changes a few values of a
+ * list only costs the memory of the modified chunks.
+ * The Equal functor must compare exactly, with a tolerance changes get lost.
+ */
+template <class T, class Equal = BitwiseEqual<T> >
+class ListSnapshot
+{
+public:
+    typedef boost::shared_ptr<const ListSnapshot> Pointer;
+    typedef boost::weak_ptr<const ListSnapshot> WeakPointer;
+
+    /// Returns true if a list of this size is worth to be split into chunks
+    static bool isBig(std::size_t count)
+    {
+        return count * sizeof(T) >= ChunkBytes;
+    }
+
+    /** Creates a snapshot of \a values that shares the unchanged chunks with
+     * \a last and makes it the new \a last snapshot. The property only keeps
+     * a weak pointer so that the chunks get freed with the transactions.
+     */
+    static Pointer create(const std::vector<T>& values, WeakPointer& last)
+    {
+        Pointer prev = last.lock();
+        Pointer snapshot(new ListSnapshot(values, prev.get()));
+        last = snapshot;
+        return snapshot;
+    }
+
+    /// Restores the values of the snapshot
+    template <class Container>
+    void restore(Container& values) const
+    {
+        values.clear();
+        values.reserve(count);
+        for (typename std::vector<ChunkPointer>::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+            values.insert(values.end(), (*it)->begin(), (*it)->end());
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    /// The memory of a shared chunk is split among the snapshots sharing it
+    unsigned int getMemSize() const
+    {
+        std::size_t size = 0;
+        for (typename std::vector<ChunkPointer>::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+            size += (*it)->size() * sizeof(T) / it->use_count();
+        return static_cast<unsigned int>(size + chunks.size() * sizeof(ChunkPointer));
+    }
+
+private:
+    typedef std::vector<T> Chunk;
+    typedef boost::shared_ptr<const Chunk> ChunkPointer;
+    enum { ChunkBytes = 0x10000 };
+
+    ListSnapshot(const std::vector<T>& values, const ListSnapshot* prev)
+      : count(values.size())
+    {
+        std::size_t size = std::max<std::size_t>(1, ChunkBytes / sizeof(T));
+        chunks.reserve((count + size - 1) / size);
+        for (std::size_t first = 0; first < count; first += size) {
+            std::size_t index = chunks.size();
+            std::size_t num = std::min<std::size_t>(size, count - first);
+            typename std::vector<T>::const_iterator begin = values.begin() + first;
+            if (prev && index < prev->chunks.size()) {
+                const Chunk& chunk = *prev->chunks[index];
+                if (chunk.size() == num && std::equal(chunk.begin(), chunk.end(), begin, Equal())) {
+                    chunks.push_back(prev->chunks[index]);
+                    continue;
+                }
+            }
+            chunks.push_back(ChunkPointer(new Chunk(begin, begin + num)));
+        }
+    }
+
+    std::vector<ChunkPointer> chunks;
+    std::size_t count;
+};
+
+} // namespace App
+
+#endif // APP_LISTSNAPSHOT_H
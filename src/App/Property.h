@@ -93,6 +93,13 @@ public:
 
     /// Returns a new copy of the property (mainly for Undo/Redo and transactions)
     virtual Property *Copy(void) const = 0;
+    /** Returns a copy of the property that is only used to restore the value
+     * with Paste(), i.e. by transactions. By default this is Copy(). Properties
+     * with big lists share the unchanged parts with their previous snapshot.
+     */
+    virtual Property *Snapshot(void) const {
+        return Copy();
+    }
     /// Paste the value from the property (mainly for Undo/Redo and transactions)
     virtual void Paste(const Property &from) = 0;
     /// Encodes an attribute upon saving.
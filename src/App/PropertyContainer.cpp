@@ -26,8 +26,15 @@
 #ifndef _PreComp_
 # include <cassert>
 # include <algorithm>
+# include <cstring>
 #endif
 
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+#include <QAtomicPointer>
+#include <QMutex>
+#include <QMutexLocker>
+
 /// Here the FreeCAD includes sorted by Base,App,Gui......
 #include <Base/Reader.h>
 #include <Base/Writer.h>
@@ -260,12 +267,148 @@ void PropertyContainer::Restore(Base::XMLReader &reader)
     reader.readEndElement("Properties");
 }
 
+namespace {
+
+struct CStringHash
+{
+  std::size_t operator()(const char* s) const
+  {
+    return boost::hash_range(s, s + std::strlen(s));
+  }
+};
+
+struct CStringEqual
+{
+  bool operator()(const char* a, const char* b) const
+  {
+    return std::strcmp(a, b) == 0;
+  }
+};
+
+// serializes the rebuild of the property indexes
+QMutex propertyIndexMutex;
+
+}
+
+/**
+ * Flattened view of a PropertyData and all its parents. The specs are in the
+ * same order as the old recursive lookup visited them, i.e. the own properties
+ * first, then those of the parent class and so on. The hash tables map to the
+ * first spec with a given name or offset so that a derived class shadows its
+ * parents like before.
+ */
+struct PropertyData::PropertyIndex
+{
+  typedef boost::unordered_map<const char*, std::size_t, CStringHash, CStringEqual> NameMap;
+  typedef boost::unordered_map<short, std::size_t> OffsetMap;
+  typedef std::vector<std::pair<const PropertyData*, std::size_t> > Chain;
+
+  PropertyIndex() : previous(0) {}
+  ~PropertyIndex() { delete previous; }
+
+  /// The index is valid as long as no class of the chain got a new property
+  bool isValid(const PropertyData* data) const
+  {
+    Chain::const_iterator it = chain.begin();
+    for (; data; data = data->parentPropertyData, ++it) {
+      if (it == chain.end() || it->first != data || it->second != data->propertyData.size())
+        return false;
+    }
+    return it == chain.end();
+  }
+
+  // the classes and their number of specs when the index was built
+  Chain chain;
+  std::vector<const PropertySpec*> specs;
+  NameMap byName;
+  OffsetMap byOffset;
+  // a replaced index is kept because other threads may still read it
+  PropertyIndex* previous;
+};
+
+PropertyData::PropertyData()
+  : parentPropertyData(0), index(new QAtomicPointer<PropertyIndex>(0))
+{
+}
+
+PropertyData::PropertyData(const PropertyData& that)
+  : propertyData(that.propertyData), parentPropertyData(that.parentPropertyData)
+  , index(new QAtomicPointer<PropertyIndex>(0))
+{
+}
+
+PropertyData::~PropertyData()
+{
+  delete static_cast<PropertyIndex*>(*index);
+  delete index;
+}
+
+PropertyData& PropertyData::operator=(const PropertyData& that)
+{
+  if (this != &that) {
+    propertyData = that.propertyData;
+    parentPropertyData = that.parentPropertyData;
+    // the index is checked against the spec lists, so it can stay
+  }
+  return *this;
+}
+
+const PropertyData::PropertyIndex* PropertyData::getValidIndex() const
+{
+  // the index is only published after it has been completely built
+  PropertyIndex* idx = *index;
+  if (idx && idx->isValid(this))
+    return idx;
+  return 0;
+}
+
+const PropertyData::PropertyIndex& PropertyData::getIndex() const
+{
+  const PropertyIndex* valid = getValidIndex();
+  if (valid)
+    return *valid;
+
+  QMutexLocker locker(&propertyIndexMutex);
+  valid = getValidIndex();
+  if (valid)
+    return *valid;
+
+  PropertyIndex* idx = new PropertyIndex();
+  for (const PropertyData* data = this; data; data = data->parentPropertyData) {
+    idx->chain.push_back(std::make_pair(data, data->propertyData.size()));
+    for (vector<PropertySpec>::const_iterator It = data->propertyData.begin(); It != data->propertyData.end(); ++It) {
+      std::size_t pos = idx->specs.size();
+      idx->specs.push_back(&(*It));
+      // insert() keeps an existing entry, so the most derived class wins
+      idx->byName.insert(std::make_pair(It->Name, pos));
+      idx->byOffset.insert(std::make_pair(It->Offset, pos));
+    }
+  }
+
+  idx->previous = index->fetchAndStoreOrdered(idx);
+  return *idx;
+}
+
 void PropertyData::addProperty(const PropertyContainer *container,const char* PropName, Property *Prop, const char* PropertyGroup , PropertyType Type, const char* PropertyDocu)
 {
+  // This is called for every property of every new instance. Only the own
+  // properties matter, and these are the first entries of the index. While
+  // the first instance is constructed the index is outdated, and building it
+  // for every new spec would be a waste.
   bool IsIn = false;
-  for (vector<PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(strcmp(It->Name,PropName)==0)
-      IsIn = true;
+  const PropertyIndex* idx = getValidIndex();
+  if (idx) {
+    PropertyIndex::NameMap::const_iterator pos = idx->byName.find(PropName);
+    IsIn = (pos != idx->byName.end() && pos->second < propertyData.size());
+  }
+  else {
+    for (vector<PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It) {
+      if (strcmp(It->Name, PropName) == 0) {
+        IsIn = true;
+        break;
+      }
+    }
+  }
 
   if( !IsIn )
   {
@@ -281,26 +424,28 @@ void PropertyData::addProperty(const PropertyContainer *container,const char* Pr
 
 const PropertyData::PropertySpec *PropertyData::findProperty(const PropertyContainer *container,const char* PropName) const
 {
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(strcmp(It->Name,PropName)==0)
-      return &(*It);
+  if (!PropName)
+    return 0;
+
+  const PropertyIndex& idx = getIndex();
+  PropertyIndex::NameMap::const_iterator pos = idx.byName.find(PropName);
+  if (pos != idx.byName.end())
+    return idx.specs[pos->second];
 
-  if(parentPropertyData)
-      return parentPropertyData->findProperty(container,PropName);
- 
   return 0;
 }
 
 const PropertyData::PropertySpec *PropertyData::findProperty(const PropertyContainer *container,const Property* prop) const
 {
   const int diff = (int) ((char*)prop - (char*)container);
+  // offsets are stored as short, anything outside cannot be a static property
+  if (diff < -32768 || diff > 32767)
+    return 0;
 
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    if(diff == It->Offset)
-      return &(*It);
-  
-  if(parentPropertyData)
-      return parentPropertyData->findProperty(container,prop);
+  const PropertyIndex& idx = getIndex();
+  PropertyIndex::OffsetMap::const_iterator pos = idx.byOffset.find((short)diff);
+  if (pos != idx.byOffset.end())
+    return idx.specs[pos->second];
 
   return 0;
 }
@@ -439,8 +584,9 @@ Property *PropertyData::getPropertyByName(const PropertyContainer *container,con
 
 void PropertyData::getPropertyMap(const PropertyContainer *container,std::map<std::string,Property*> &Map) const
 {
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    Map[It->Name] = (Property *) (It->Offset + (char *)container);
+  const std::vector<const PropertySpec*>& specs = getIndex().specs;
+  for (vector<const PropertySpec*>::const_iterator It = specs.begin(); It != specs.end(); ++It)
+    Map[(*It)->Name] = (Property *) ((*It)->Offset + (char *)container);
 /*
   std::map<std::string,PropertySpec>::const_iterator pos;
 
@@ -449,16 +595,14 @@ void PropertyData::getPropertyMap(const PropertyContainer *container,std::map<st
     Map[pos->first] = (Property *) (pos->second.Offset + (char *)container);
   }
   */
-
-  if(parentPropertyData)
-    parentPropertyData->getPropertyMap(container,Map);
-
 }
 
 void PropertyData::getPropertyList(const PropertyContainer *container,std::vector<Property*> &List) const
 {
-  for (vector<PropertyData::PropertySpec>::const_iterator It = propertyData.begin(); It != propertyData.end(); ++It)
-    List.push_back((Property *) (It->Offset + (char *)container) );
+  const std::vector<const PropertySpec*>& specs = getIndex().specs;
+  List.reserve(List.size() + specs.size());
+  for (vector<const PropertySpec*>::const_iterator It = specs.begin(); It != specs.end(); ++It)
+    List.push_back((Property *) ((*It)->Offset + (char *)container) );
 
 /*  std::map<std::string,PropertySpec>::const_iterator pos;
 
@@ -466,9 +610,6 @@ void PropertyData::getPropertyList(const PropertyContainer *container,std::vecto
   {
     List.push_back((Property *) (pos->second.Offset + (char *)container) );
   }*/
-  if(parentPropertyData)
-    parentPropertyData->getPropertyList(container,List);
-
 }
 
 
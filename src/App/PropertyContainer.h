@@ -31,6 +31,8 @@ namespace Base {
 class Writer;
 }
 
+template <typename T> class QAtomicPointer;
+
 
 namespace App
 {
@@ -56,6 +58,13 @@ struct AppExport PropertyData
     const char * Docu;
     short Offset,Type;
   };
+  struct PropertyIndex;
+
+  PropertyData();
+  PropertyData(const PropertyData&);
+  ~PropertyData();
+  PropertyData& operator=(const PropertyData&);
+
   // vector of all properties
   std::vector<PropertySpec> propertyData;
   const PropertyData *parentPropertyData;
@@ -76,6 +85,17 @@ struct AppExport PropertyData
   Property *getPropertyByName(const PropertyContainer *container,const char* name) const;
   void getPropertyMap(const PropertyContainer *container,std::map<std::string,Property*> &Map) const;
   void getPropertyList(const PropertyContainer *container,std::vector<Property*> &List) const;
+
+private:
+  /** Returns the lookup tables of this class and all its parent classes.
+   * The tables are built on first use and rebuilt if a property has been
+   * added to this class or one of its parents since. Properties are only
+   * added while the first instance of a class is constructed, so afterwards
+   * the tables stay valid and are read without locking.
+   */
+  const PropertyIndex& getIndex() const;
+  const PropertyIndex* getValidIndex() const;
+  QAtomicPointer<PropertyIndex>* index;
 };
 
 
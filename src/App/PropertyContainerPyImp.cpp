@@ -29,6 +29,9 @@
 
 #include "PropertyContainer.h"
 #include "Property.h"
+#include "PropertyStandard.h"
+#include "PropertyGeo.h"
+#include <Base/BufferViewPy.h>
 
 // inclution of the generated files (generated out of PropertyContainerPy.xml)
 #include "PropertyContainerPy.h"
@@ -36,6 +39,59 @@
 
 using namespace App;
 
+namespace {
+
+// Looks up the property by name each time the buffer is requested so that the
+// view cannot access a dynamic property that has been removed meanwhile.
+class PropertyListProvider : public Base::BufferProvider
+{
+public:
+    PropertyListProvider(PropertyContainer* c, const char* n) : container(c), name(n)
+    {
+    }
+    bool getLayout(Base::BufferLayout& layout) const
+    {
+        Property* prop = container->getPropertyByName(name.c_str());
+        if (!prop)
+            return false;
+        if (prop->getTypeId().isDerivedFrom(PropertyFloatList::getClassTypeId())) {
+            const std::vector<double>& values = static_cast<PropertyFloatList*>(prop)->getValues();
+            layout.data = values.empty() ? 0 : &values[0];
+            layout.rows = values.size();
+            layout.columns = 1;
+            layout.itemsize = sizeof(double);
+            layout.format = "d";
+        }
+        else if (prop->getTypeId().isDerivedFrom(PropertyIntegerList::getClassTypeId())) {
+            const std::vector<long>& values = static_cast<PropertyIntegerList*>(prop)->getValues();
+            layout.data = values.empty() ? 0 : &values[0];
+            layout.rows = values.size();
+            layout.columns = 1;
+            layout.itemsize = sizeof(long);
+            layout.format = "l";
+        }
+        else if (prop->getTypeId().isDerivedFrom(PropertyVectorList::getClassTypeId())) {
+            const std::vector<Base::Vector3d>& values = static_cast<PropertyVectorList*>(prop)->getValues();
+            layout.data = values.empty() ? 0 : &values[0].x;
+            layout.rows = values.size();
+            layout.columns = 3;
+            layout.itemsize = sizeof(double);
+            layout.format = "d";
+        }
+        else {
+            return false;
+        }
+        layout.stride = (layout.columns == 3 ? sizeof(Base::Vector3d) : layout.itemsize);
+        return true;
+    }
+
+private:
+    PropertyContainer* container;
+    std::string name;
+};
+
+}
+
 // returns a string which represent the object e.g. when printed in python
 std::string PropertyContainerPy::representation(void) const
 {
@@ -191,6 +247,30 @@ PyObject*  PropertyContainerPy::getDocumentationOfProperty(PyObject *args)
         return Py::new_reference_to(Py::String(""));
 }
 
+PyObject*  PropertyContainerPy::getPropertyBuffer(PyObject *args)
+{
+    char *pstr;
+    if (!PyArg_ParseTuple(args, "s", &pstr))     // convert args: Python->C
+        return NULL;                             // NULL triggers exception
+
+    Property* prop = getPropertyContainerPtr()->getPropertyByName(pstr);
+    if (!prop) {
+        PyErr_Format(PyExc_AttributeError, "Property container has no property '%s'", pstr);
+        return 0;
+    }
+
+    Base::BufferProvider* provider = new PropertyListProvider(getPropertyContainerPtr(), pstr);
+    Base::BufferLayout layout;
+    if (!provider->getLayout(layout)) {
+        delete provider;
+        PyErr_Format(PyExc_TypeError, "Property '%s' of type '%s' cannot be accessed as buffer",
+            pstr, prop->getTypeId().getName());
+        return 0;
+    }
+
+    return new Base::BufferViewPy(this, provider);
+}
+
 Py::List PropertyContainerPy::getPropertiesList(void) const
 {
     Py::List ret;
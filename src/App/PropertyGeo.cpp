@@ -33,6 +33,7 @@
 #include <Base/Writer.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
+#include <Base/BufferViewPy.h>
 #include <Base/Rotation.h>
 #include <Base/VectorPy.h>
 #include <Base/MatrixPy.h>
@@ -191,7 +192,8 @@ PropertyVectorList::PropertyVectorList()
 
 PropertyVectorList::~PropertyVectorList()
 {
-
+    // buffers of the values that are still in use keep the memory
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
 }
 
 //**************************************************************************
@@ -199,6 +201,7 @@ PropertyVectorList::~PropertyVectorList()
 
 void PropertyVectorList::setSize(int newSize)
 {
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(newSize);
 }
 
@@ -210,6 +213,7 @@ int PropertyVectorList::getSize(void) const
 void PropertyVectorList::setValue(const Base::Vector3d& lValue)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(1);
     _lValueList[0]=lValue;
     hasSetValue();
@@ -218,6 +222,7 @@ void PropertyVectorList::setValue(const Base::Vector3d& lValue)
 void PropertyVectorList::setValue(double x, double y, double z)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(1);
     _lValueList[0].Set(x,y,z);
     hasSetValue();
@@ -226,6 +231,7 @@ void PropertyVectorList::setValue(double x, double y, double z)
 void PropertyVectorList::setValues(const std::vector<Base::Vector3d>& values)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList = values;
     hasSetValue();
 }
@@ -242,7 +248,15 @@ PyObject *PropertyVectorList::getPyObject(void)
 
 void PropertyVectorList::setPyObject(PyObject *value)
 {
-    if (PyList_Check(value)) {
+    if (Base::BufferReader::check(value)) {
+        // n rows of x,y,z or a flat sequence of 3*n numbers
+        Base::BufferReader buffer(value, 3);
+        std::vector<Base::Vector3d> values(buffer.rows());
+        for (Py_ssize_t i=0; i<buffer.rows(); ++i)
+            values[i].Set(buffer.getFloat(i, 0), buffer.getFloat(i, 1), buffer.getFloat(i, 2));
+        setValues(values);
+    }
+    else if (PyList_Check(value)) {
         Py_ssize_t nSize = PyList_Size(value);
         std::vector<Base::Vector3d> values;
         values.resize(nSize);
@@ -296,18 +310,15 @@ void PropertyVectorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    if (uCt == 0)
+        return;
+    // a vector is a plain triple, so the list can be written as one array
     if (writer.getFileVersion() > 0) {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << it->x << it->y << it->z;
-        }
+        str.write(&_lValueList[0].x, 3 * uCt);
     }
     else {
-        for (std::vector<Base::Vector3d>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float x = (float)it->x;
-            float y = (float)it->y;
-            float z = (float)it->z;
-            str << x << y << z;
-        }
+        std::vector<float> values(&_lValueList[0].x, &_lValueList[0].x + 3 * uCt);
+        str.write(&values[0], 3 * uCt);
     }
 }
 
@@ -317,17 +328,13 @@ void PropertyVectorList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
-    if (reader.getFileVersion() > 0) {
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> it->x >> it->y >> it->z;
-        }
+    if (uCt > 0 && reader.getFileVersion() > 0) {
+        str.read(&values[0].x, 3 * uCt);
     }
-    else {
-        float x,y,z;
-        for (std::vector<Base::Vector3d>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> x >> y >> z;
-            it->Set(x, y, z);
-        }
+    else if (uCt > 0) {
+        std::vector<float> floats(3 * uCt);
+        str.read(&floats[0], 3 * uCt);
+        std::copy(floats.begin(), floats.end(), &values[0].x);
     }
     setValues(values);
 }
@@ -339,16 +346,37 @@ Property *PropertyVectorList::Copy(void) const
     return p;
 }
 
+Property *PropertyVectorList::Snapshot(void) const
+{
+    if (!ValueSnapshot::isBig(_lValueList.size()))
+        return Copy();
+    PropertyVectorList *p= new PropertyVectorList();
+    p->_snapshot = ValueSnapshot::create(_lValueList, _lastSnapshot);
+    return p;
+}
+
 void PropertyVectorList::Paste(const Property &from)
 {
+    const PropertyVectorList& prop = dynamic_cast<const PropertyVectorList&>(from);
     aboutToSetValue();
-    _lValueList = dynamic_cast<const PropertyVectorList&>(from)._lValueList;
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
+    if (prop._snapshot) {
+        prop._snapshot->restore(_lValueList);
+        // the values are equal to the snapshot again
+        _lastSnapshot = prop._snapshot;
+    }
+    else {
+        _lValueList = prop._lValueList;
+    }
     hasSetValue();
 }
 
 unsigned int PropertyVectorList::getMemSize (void) const
 {
-    return static_cast<unsigned int>(_lValueList.size() * sizeof(Base::Vector3d));
+    unsigned int size = static_cast<unsigned int>(_lValueList.size() * sizeof(Base::Vector3d));
+    if (_snapshot)
+        size += _snapshot->getMemSize();
+    return size;
 }
 
 //**************************************************************************
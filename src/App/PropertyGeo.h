@@ -31,6 +31,7 @@
 #include <Base/BoundBox.h>
 #include <Base/Placement.h>
 
+#include "ListSnapshot.h"
 #include "Property.h"
 #include "PropertyLinks.h"
 #include "ComplexGeoData.h"
@@ -152,12 +153,17 @@ public:
     virtual void RestoreDocFile(Base::Reader &reader);
 
     virtual Property *Copy(void) const;
+    virtual Property *Snapshot(void) const;
     virtual void Paste(const Property &from);
 
     virtual unsigned int getMemSize (void) const;
 
 private:
+    typedef ListSnapshot<Base::Vector3d> ValueSnapshot;
     std::vector<Base::Vector3d> _lValueList;
+    /// the values of a property created by Snapshot()
+    ValueSnapshot::Pointer _snapshot;
+    mutable ValueSnapshot::WeakPointer _lastSnapshot;
 };
 
 /// Property representing a 4x4 matrix
@@ -35,6 +35,7 @@
 #include <Base/Reader.h>
 #include <Base/Writer.h>
 #include <Base/Stream.h>
+#include <Base/BufferViewPy.h>
 
 #include "PropertyStandard.h"
 #include "MaterialPy.h"
@@ -587,11 +588,13 @@ PropertyIntegerList::PropertyIntegerList()
 
 PropertyIntegerList::~PropertyIntegerList()
 {
-
+    // buffers of the values that are still in use keep the memory
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
 }
 
 void PropertyIntegerList::setSize(int newSize)
 {
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(newSize);
 }
 
@@ -606,6 +609,7 @@ int PropertyIntegerList::getSize(void) const
 void PropertyIntegerList::setValue(long lValue)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(1);
     _lValueList[0]=lValue;
     hasSetValue();
@@ -614,6 +618,7 @@ void PropertyIntegerList::setValue(long lValue)
 void PropertyIntegerList::setValues(const std::vector<long>& values)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList = values;
     hasSetValue();
 }
@@ -628,7 +633,16 @@ PyObject *PropertyIntegerList::getPyObject(void)
 
 void PropertyIntegerList::setPyObject(PyObject *value)
 { 
-    if (PySequence_Check(value)) {
+    if (Base::BufferReader::check(value)) {
+        Base::BufferReader buffer(value, 1);
+        if (!buffer.isInteger())
+            throw Base::TypeError("buffer must contain integers");
+        std::vector<long> values(buffer.rows());
+        for (Py_ssize_t i=0; i<buffer.rows(); ++i)
+            values[i] = buffer.getInteger(i, 0);
+        setValues(values);
+    }
+    else if (PySequence_Check(value)) {
         Py_ssize_t nSize = PySequence_Size(value);
         std::vector<long> values;
         values.resize(nSize);
@@ -694,6 +708,7 @@ Property *PropertyIntegerList::Copy(void) const
 void PropertyIntegerList::Paste(const Property &from)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList = dynamic_cast<const PropertyIntegerList&>(from)._lValueList;
     hasSetValue();
 }
@@ -1037,7 +1052,8 @@ PropertyFloatList::PropertyFloatList()
 
 PropertyFloatList::~PropertyFloatList()
 {
-
+    // buffers of the values that are still in use keep the memory
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
 }
 
 //**************************************************************************
@@ -1045,6 +1061,7 @@ PropertyFloatList::~PropertyFloatList()
 
 void PropertyFloatList::setSize(int newSize)
 {
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(newSize);
 }
 
@@ -1056,6 +1073,7 @@ int PropertyFloatList::getSize(void) const
 void PropertyFloatList::setValue(double lValue)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList.resize(1);
     _lValueList[0]=lValue;
     hasSetValue();
@@ -1064,6 +1082,7 @@ void PropertyFloatList::setValue(double lValue)
 void PropertyFloatList::setValues(const std::vector<double>& values)
 {
     aboutToSetValue();
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
     _lValueList = values;
     hasSetValue();
 }
@@ -1078,7 +1097,14 @@ PyObject *PropertyFloatList::getPyObject(void)
 
 void PropertyFloatList::setPyObject(PyObject *value)
 { 
-    if (PyList_Check(value)) {
+    if (Base::BufferReader::check(value)) {
+        Base::BufferReader buffer(value, 1);
+        std::vector<double> values(buffer.rows());
+        for (Py_ssize_t i=0; i<buffer.rows(); ++i)
+            values[i] = buffer.getFloat(i, 0);
+        setValues(values);
+    }
+    else if (PyList_Check(value)) {
         Py_ssize_t nSize = PyList_Size(value);
         std::vector<double> values;
         values.resize(nSize);
@@ -1138,16 +1164,14 @@ void PropertyFloatList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    if (uCt == 0)
+        return;
     if (writer.getFileVersion() > 0) {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            str << *it;
-        }
+        str.write(&_lValueList[0], uCt);
     }
     else {
-        for (std::vector<double>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-            float v = (float)*it;
-            str << v;
-        }
+        std::vector<float> values(_lValueList.begin(), _lValueList.end());
+        str.write(&values[0], uCt);
     }
 }
 
@@ -1157,17 +1181,13 @@ void PropertyFloatList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<double> values(uCt);
-    if (reader.getFileVersion() > 0) {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            str >> *it;
-        }
+    if (uCt > 0 && reader.getFileVersion() > 0) {
+        str.read(&values[0], uCt);
     }
-    else {
-        for (std::vector<double>::iterator it = values.begin(); it != values.end(); ++it) {
-            float val;
-            str >> val;
-            (*it) = val;
-        }
+    else if (uCt > 0) {
+        std::vector<float> floats(uCt);
+        str.read(&floats[0], uCt);
+        std::copy(floats.begin(), floats.end(), values.begin());
     }
     setValues(values);
 }
@@ -1179,16 +1199,37 @@ Property *PropertyFloatList::Copy(void) const
     return p;
 }
 
+Property *PropertyFloatList::Snapshot(void) const
+{
+    if (!ValueSnapshot::isBig(_lValueList.size()))
+        return Copy();
+    PropertyFloatList *p= new PropertyFloatList();
+    p->_snapshot = ValueSnapshot::create(_lValueList, _lastSnapshot);
+    return p;
+}
+
 void PropertyFloatList::Paste(const Property &from)
 {
+    const PropertyFloatList& prop = dynamic_cast<const PropertyFloatList&>(from);
     aboutToSetValue();
-    _lValueList = dynamic_cast<const PropertyFloatList&>(from)._lValueList;
+    Base::BufferViewPy::detach(getContainer(), _lValueList);
+    if (prop._snapshot) {
+        prop._snapshot->restore(_lValueList);
+        // the values are equal to the snapshot again
+        _lastSnapshot = prop._snapshot;
+    }
+    else {
+        _lValueList = prop._lValueList;
+    }
     hasSetValue();
 }
 
 unsigned int PropertyFloatList::getMemSize (void) const
 {
-    return static_cast<unsigned int>(_lValueList.size() * sizeof(double));
+    unsigned int size = static_cast<unsigned int>(_lValueList.size() * sizeof(double));
+    if (_snapshot)
+        size += _snapshot->getMemSize();
+    return size;
 }
 
 //**************************************************************************
@@ -2272,9 +2313,14 @@ void PropertyColorList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    if (uCt == 0)
+        return;
+    std::vector<uint32_t> values;
+    values.reserve(uCt);
     for (std::vector<App::Color>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->getPackedValue();
+        values.push_back(it->getPackedValue());
     }
+    str.write(&values[0], uCt);
 }
 
 void PropertyColorList::RestoreDocFile(Base::Reader &reader)
@@ -2283,10 +2329,11 @@ void PropertyColorList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Color> values(uCt);
-    uint32_t value; // must be 32 bit long
-    for (std::vector<App::Color>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> value;
-        it->setPackedValue(value);
+    if (uCt > 0) {
+        std::vector<uint32_t> packed(uCt); // must be 32 bit long
+        str.read(&packed[0], uCt);
+        for (uint32_t i = 0; i < uCt; i++)
+            values[i].setPackedValue(packed[i]);
     }
     setValues(values);
 }
@@ -35,6 +35,7 @@
 
 #include <Base/Uuid.h>
 #include "Enumeration.h"
+#include "ListSnapshot.h"
 #include "Property.h"
 #include "Material.h"
 
@@ -561,11 +562,16 @@ public:
     virtual void RestoreDocFile(Base::Reader &reader);
     
     virtual Property *Copy(void) const;
+    virtual Property *Snapshot(void) const;
     virtual void Paste(const Property &from);
     virtual unsigned int getMemSize (void) const;
 
 private:
+    typedef ListSnapshot<double> ValueSnapshot;
     std::vector<double> _lValueList;
+    /// the values of a property created by Snapshot()
+    ValueSnapshot::Pointer _snapshot;
+    mutable ValueSnapshot::WeakPointer _lastSnapshot;
 };
 
 
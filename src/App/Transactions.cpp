@@ -84,7 +84,15 @@ Transaction::~Transaction()
 
 unsigned int Transaction::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    std::map<const DocumentObject*,TransactionObject*>::const_iterator It;
+    for (It = _Objects.begin(); It != _Objects.end(); ++It) {
+        size += It->second->getMemSize();
+        // a removed object is owned by the transaction
+        if (It->second->status == TransactionObject::Del)
+            size += It->first->getMemSize();
+    }
+    return size;
 }
 
 void Transaction::Save (Base::Writer &/*writer*/) const
@@ -259,12 +267,16 @@ void TransactionObject::setProperty(const Property* pcProp)
 {
     std::map<const Property*,Property*>::iterator pos = _PropChangeMap.find(pcProp);
     if (pos == _PropChangeMap.end())
-        _PropChangeMap[pcProp] = pcProp->Copy();
+        _PropChangeMap[pcProp] = pcProp->Snapshot();
 }
 
 unsigned int TransactionObject::getMemSize (void) const
 {
-    return 0;
+    unsigned int size = 0;
+    std::map<const Property*,Property*>::const_iterator It;
+    for (It = _PropChangeMap.begin(); It != _PropChangeMap.end(); ++It)
+        size += It->second->getMemSize();
+    return size;
 }
 
 void TransactionObject::Save (Base::Writer &/*writer*/) const
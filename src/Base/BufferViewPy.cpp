@@ -0,0 +1,512 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <cstring>
+# include <map>
+# include <sstream>
+#endif
+
+#include <boost/cstdint.hpp>
+#include <CXX/Objects.hxx>
+
+#include "BufferViewPy.h"
+#include "Exception.h"
+
+using namespace Base;
+
+namespace {
+// buffer address handed out for empty containers
+char emptyBuffer = 0;
+
+// memory that has been detached from an object while buffers of it were exported
+struct DetachedMemory
+{
+    std::vector<boost::shared_ptr<void> > data;
+};
+
+struct ExportEntry
+{
+    ExportEntry() : count(0) {}
+    // number of exported buffers
+    int count;
+    // shared by the views with exported buffers
+    boost::shared_ptr<DetachedMemory> memory;
+};
+
+// exported buffers per twin object, only accessed with the GIL held
+std::map<const void*, ExportEntry>& exportRegistry()
+{
+    static std::map<const void*, ExportEntry> registry;
+    return registry;
+}
+}
+
+BufferLayout::BufferLayout()
+  : data(0), rows(0), columns(0), stride(0), itemsize(0), format("B")
+{
+}
+
+//--------------------------------------------------------------------------
+// Type structure
+//--------------------------------------------------------------------------
+
+static PySequenceMethods BufferViewPy_SequenceMethods = {
+    BufferViewPy::length,                                   /*sq_length*/
+    0,                                                      /*sq_concat*/
+    0,                                                      /*sq_repeat*/
+    0,                                                      /*sq_item*/
+    0,                                                      /*sq_slice*/
+    0,                                                      /*sq_ass_item*/
+    0,                                                      /*sq_ass_slice*/
+    0,                                                      /*sq_contains*/
+    0,                                                      /*sq_inplace_concat*/
+    0                                                       /*sq_inplace_repeat*/
+};
+
+// The old buffer protocol is not supported because it does not tell when the
+// consumer is done with the memory.
+PyBufferProcs BufferViewPy::BufferProcs = {
+    0,                                                      /*bf_getreadbuffer*/
+    0,                                                      /*bf_getwritebuffer*/
+    0,                                                      /*bf_getsegcount*/
+    0,                                                      /*bf_getcharbuffer*/
+    BufferViewPy::getBuffer,                                /*bf_getbuffer*/
+    BufferViewPy::releaseBuffer                             /*bf_releasebuffer*/
+};
+
+PyTypeObject BufferViewPy::Type = {
+    PyObject_HEAD_INIT(&PyType_Type)
+    0,                                                      /*ob_size*/
+    "BufferView",                                           /*tp_name*/
+    sizeof(BufferViewPy),                                   /*tp_basicsize*/
+    0,                                                      /*tp_itemsize*/
+    /* methods */
+    PyDestructor,                                           /*tp_dealloc*/
+    0,                                                      /*tp_print*/
+    __getattr,                                              /*tp_getattr*/
+    __setattr,                                              /*tp_setattr*/
+    0,                                                      /*tp_compare*/
+    __repr,                                                 /*tp_repr*/
+    0,                                                      /*tp_as_number*/
+    &BufferViewPy_SequenceMethods,                          /*tp_as_sequence*/
+    0,                                                      /*tp_as_mapping*/
+    0,                                                      /*tp_hash*/
+    0,                                                      /*tp_call */
+    0,                                                      /*tp_str  */
+    0,                                                      /*tp_getattro*/
+    0,                                                      /*tp_setattro*/
+    /* --- Functions to access object as input/output buffer ---------*/
+    &BufferViewPy::BufferProcs,                             /* tp_as_buffer */
+    /* --- Flags to define presence of optional/expanded features */
+    Py_TPFLAGS_HAVE_CLASS|Py_TPFLAGS_HAVE_GETCHARBUFFER|Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags */
+    "Read-only view of a block of numbers that supports the buffer protocol", /*tp_doc */
+    0,                                                      /*tp_traverse */
+    0,                                                      /*tp_clear */
+    0,                                                      /*tp_richcompare */
+    0,                                                      /*tp_weaklistoffset */
+    0,                                                      /*tp_iter */
+    0,                                                      /*tp_iternext */
+    0,                                                      /*tp_methods */
+    0,                                                      /*tp_members */
+    0,                                                      /*tp_getset */
+    &PyObjectBase::Type,                                    /*tp_base */
+    0,                                                      /*tp_dict */
+    0,                                                      /*tp_descr_get */
+    0,                                                      /*tp_descr_set */
+    0,                                                      /*tp_dictoffset */
+    0,                                                      /*tp_init */
+    0,                                                      /*tp_alloc */
+    0,                                                      /*tp_new */
+    0,                                                      /*tp_free   Low-level free-memory routine */
+    0,                                                      /*tp_is_gc  For PyObject_IS_GC */
+    0,                                                      /*tp_bases */
+    0,                                                      /*tp_mro    method resolution order */
+    0,                                                      /*tp_cache */
+    0,                                                      /*tp_subclasses */
+    0,                                                      /*tp_weaklist */
+    0                                                       /*tp_del */
+};
+
+PyMethodDef BufferViewPy::Methods[] = {
+    {NULL, NULL, 0, NULL}		/* Sentinel */
+};
+
+PyParentObject BufferViewPy::Parents[] = {&PyObjectBase::Type,&BufferViewPy::Type, NULL};
+
+BufferViewPy::BufferViewPy(PyObject* o, BufferProvider* p, PyTypeObject *T)
+  : PyObjectBase(0, T), owner(o), key(0), provider(p), exports(0)
+{
+    Py_XINCREF(owner);
+    if (owner && PyObject_TypeCheck(owner, &PyObjectBase::Type))
+        key = static_cast<PyObjectBase*>(owner)->getTwinPointer();
+}
+
+BufferViewPy::~BufferViewPy()
+{
+    // every export holds a reference to the view, so this is only a safeguard
+    while (exports > 0)
+        removeExport();
+    Py_XDECREF(owner);
+    delete provider;
+}
+
+bool BufferViewPy::isExported(const void* key)
+{
+    if (!key)
+        return false;
+    const std::map<const void*, ExportEntry>& registry = exportRegistry();
+    return registry.find(key) != registry.end();
+}
+
+void BufferViewPy::checkExports(const void* key)
+{
+    if (isExported(key)) {
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        throw Py::Exception();
+    }
+}
+
+void BufferViewPy::keepAlive(const void* key, const boost::shared_ptr<void>& data)
+{
+    std::map<const void*, ExportEntry>& registry = exportRegistry();
+    std::map<const void*, ExportEntry>::iterator it = registry.find(key);
+    if (it == registry.end() || !it->second.memory)
+        return;
+    // the views that export buffers of the key keep the memory
+    it->second.memory->data.push_back(data);
+}
+
+void BufferViewPy::addExport()
+{
+    exports++;
+    if (key) {
+        ExportEntry& entry = exportRegistry()[key];
+        entry.count++;
+        if (!entry.memory)
+            entry.memory.reset(new DetachedMemory());
+        if (memory.empty() || memory.back() != entry.memory)
+            memory.push_back(entry.memory);
+    }
+}
+
+void BufferViewPy::removeExport()
+{
+    if (exports == 0)
+        return;
+    exports--;
+    if (key) {
+        std::map<const void*, ExportEntry>& registry = exportRegistry();
+        std::map<const void*, ExportEntry>::iterator it = registry.find(key);
+        if (it != registry.end() && --it->second.count == 0)
+            registry.erase(it);
+    }
+
+    // The memoryview of Python 2.7 may release a copy of a Py_buffer and keep
+    // using the original, so shape, strides and detached memory are only freed
+    // once no export is left.
+    if (exports == 0) {
+        for (std::vector<Py_ssize_t*>::iterator it = shapes.begin(); it != shapes.end(); ++it)
+            delete [] *it;
+        shapes.clear();
+        memory.clear();
+    }
+}
+
+bool BufferViewPy::getLayout(BufferLayout& layout) const
+{
+    // the owner may have been invalidated, e.g. by closing its document
+    if (owner && PyObject_TypeCheck(owner, &PyObjectBase::Type) &&
+        !static_cast<PyObjectBase*>(owner)->isValid())
+        return false;
+    if (!provider || !provider->getLayout(layout))
+        return false;
+    if (layout.rows == 0 || !layout.data) {
+        layout.data = &emptyBuffer;
+        layout.rows = 0;
+    }
+    return true;
+}
+
+PyObject *BufferViewPy::_repr(void)
+{
+    std::stringstream str;
+    BufferLayout layout;
+    if (getLayout(layout)) {
+        str << "<BufferView " << layout.rows << "x" << layout.columns
+            << " '" << layout.format << "'>";
+    }
+    else {
+        str << "<BufferView of deleted object>";
+    }
+    return Py_BuildValue("s", str.str().c_str());
+}
+
+PyObject *BufferViewPy::_getattr(char *attr)
+{
+    if (strcmp(attr, "shape") == 0 || strcmp(attr, "format") == 0 ||
+        strcmp(attr, "itemsize") == 0 || strcmp(attr, "readonly") == 0) {
+        BufferLayout layout;
+        if (!getLayout(layout)) {
+            PyErr_SetString(PyExc_ReferenceError, "The object of the buffer view has been deleted");
+            return 0;
+        }
+        if (strcmp(attr, "shape") == 0)
+            return Py_BuildValue("(nn)", layout.rows, layout.columns);
+        if (strcmp(attr, "format") == 0)
+            return PyString_FromString(layout.format);
+        if (strcmp(attr, "itemsize") == 0)
+            return PyInt_FromSsize_t(layout.itemsize);
+        Py_INCREF(Py_True);
+        return Py_True;
+    }
+
+    _getattr_up(PyObjectBase);
+}
+
+Py_ssize_t BufferViewPy::length(PyObject* self)
+{
+    BufferLayout layout;
+    if (!static_cast<BufferViewPy*>(self)->getLayout(layout)) {
+        PyErr_SetString(PyExc_ReferenceError, "The object of the buffer view has been deleted");
+        return -1;
+    }
+    return layout.rows;
+}
+
+int BufferViewPy::getBuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    view->obj = 0;
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "The buffer view is read-only");
+        return -1;
+    }
+
+    BufferLayout layout;
+    if (!static_cast<BufferViewPy*>(self)->getLayout(layout)) {
+        PyErr_SetString(PyExc_ReferenceError, "The object of the buffer view has been deleted");
+        return -1;
+    }
+
+    // records with additional data in between cannot be exported without strides
+    bool contiguous = (layout.rows <= 1 || layout.stride == layout.columns * layout.itemsize);
+    if (!contiguous) {
+        if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES ||
+            (flags & (PyBUF_C_CONTIGUOUS | PyBUF_F_CONTIGUOUS | PyBUF_ANY_CONTIGUOUS) & ~PyBUF_STRIDES)) {
+            PyErr_SetString(PyExc_BufferError, "The data of the buffer view is not contiguous");
+            return -1;
+        }
+    }
+    else if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS &&
+             layout.rows > 1 && layout.columns > 1) {
+        PyErr_SetString(PyExc_BufferError, "The data of the buffer view is not Fortran contiguous");
+        return -1;
+    }
+
+    // every export gets its own shape and strides that live until it is released
+    BufferViewPy* that = static_cast<BufferViewPy*>(self);
+    Py_ssize_t* dims = new Py_ssize_t[4];
+    that->shapes.push_back(dims);
+    dims[0] = layout.rows;
+    dims[1] = layout.columns;
+    dims[2] = layout.stride;
+    dims[3] = layout.itemsize;
+
+    view->buf = const_cast<void*>(layout.data);
+    view->obj = self;
+    Py_INCREF(self);
+    view->len = layout.rows * layout.columns * layout.itemsize;
+    view->readonly = 1;
+    view->itemsize = layout.itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(layout.format) : 0;
+    view->ndim = ((flags & PyBUF_ND) == PyBUF_ND) ? 2 : 1;
+    view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? dims : 0;
+    view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? dims + 2 : 0;
+    view->suboffsets = 0;
+    view->internal = 0;
+    that->addExport();
+    return 0;
+}
+
+void BufferViewPy::releaseBuffer(PyObject* self, Py_buffer* /*view*/)
+{
+    static_cast<BufferViewPy*>(self)->removeExport();
+}
+
+// ----------------------------------------------------------------------------
+
+bool BufferReader::check(PyObject* obj)
+{
+    if (PyString_Check(obj) || PyUnicode_Check(obj))
+        return false;
+    return PyObject_CheckBuffer(obj) ? true : false;
+}
+
+BufferReader::BufferReader(PyObject* obj, Py_ssize_t columns)
+  : type(0), numColumns(columns), numRows(0), rowStride(0), colStride(0)
+{
+    if (PyObject_GetBuffer(obj, &view, PyBUF_STRIDES | PyBUF_FORMAT) < 0) {
+        std::string error = "Cannot access buffer";
+        PyObject *ptype, *pvalue, *ptrace;
+        PyErr_Fetch(&ptype, &pvalue, &ptrace);
+        if (pvalue) {
+            PyObject* str = PyObject_Str(pvalue);
+            if (str) {
+                error += ": ";
+                error += PyString_AsString(str);
+                Py_DECREF(str);
+            }
+        }
+        Py_XDECREF(ptype);
+        Py_XDECREF(pvalue);
+        Py_XDECREF(ptrace);
+        throw Base::TypeError(error);
+    }
+
+    try {
+        // only native or little-endian single numbers are accepted
+        const char* fmt = view.format ? view.format : "B";
+        if (*fmt == '@' || *fmt == '=' || *fmt == '<')
+            fmt++;
+        if (fmt[0] == '\0' || fmt[1] != '\0')
+            throw Base::TypeError(std::string("Unsupported buffer format '") + view.format + "'");
+
+        switch (fmt[0]) {
+        case 'f':
+        case 'd':
+            type = fmt[0];
+            break;
+        case 'b': case 'h': case 'i': case 'l': case 'q':
+            type = 'i';
+            break;
+        case 'B': case 'H': case 'I': case 'L': case 'Q': case '?':
+            type = 'u';
+            break;
+        default:
+            throw Base::TypeError(std::string("Unsupported buffer format '") + view.format + "'");
+        }
+
+        bool sizeOk;
+        if (type == 'f')
+            sizeOk = (view.itemsize == 4);
+        else if (type == 'd')
+            sizeOk = (view.itemsize == 8);
+        else
+            sizeOk = (view.itemsize == 1 || view.itemsize == 2 || view.itemsize == 4 || view.itemsize == 8);
+        if (!sizeOk)
+            throw Base::TypeError("Unsupported item size of buffer");
+        if (view.suboffsets)
+            throw Base::TypeError("Indirect buffers are not supported");
+
+        if (view.ndim == 2 && view.shape && view.shape[1] == numColumns) {
+            numRows = view.shape[0];
+            rowStride = view.strides ? view.strides[0] : numColumns * view.itemsize;
+            colStride = view.strides ? view.strides[1] : view.itemsize;
+        }
+        else if (view.ndim == 1 || PyBuffer_IsContiguous(&view, 'C')) {
+            // a flat sequence of numbers, consecutive numbers form a row
+            Py_ssize_t count;
+            if (view.ndim == 1 && view.shape) {
+                count = view.shape[0];
+                colStride = view.strides ? view.strides[0] : view.itemsize;
+            }
+            else {
+                count = view.len / view.itemsize;
+                colStride = view.itemsize;
+            }
+            if (count % numColumns != 0) {
+                std::stringstream str;
+                str << "Number of buffer items must be a multiple of " << numColumns;
+                throw Base::ValueError(str.str());
+            }
+            numRows = count / numColumns;
+            rowStride = numColumns * colStride;
+        }
+        else {
+            std::stringstream str;
+            str << "Buffer must be flat or have " << numColumns << " columns";
+            throw Base::ValueError(str.str());
+        }
+    }
+    catch (...) {
+        PyBuffer_Release(&view);
+        throw;
+    }
+}
+
+BufferReader::~BufferReader()
+{
+    PyBuffer_Release(&view);
+}
+
+const char* BufferReader::address(Py_ssize_t row, Py_ssize_t col) const
+{
+    return static_cast<const char*>(view.buf) + row * rowStride + col * colStride;
+}
+
+double BufferReader::getFloat(Py_ssize_t row, Py_ssize_t col) const
+{
+    const char* ptr = address(row, col);
+    if (type == 'f') {
+        float value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    else if (type == 'd') {
+        double value;
+        memcpy(&value, ptr, sizeof(value));
+        return value;
+    }
+    return static_cast<double>(getInteger(row, col));
+}
+
+long BufferReader::getInteger(Py_ssize_t row, Py_ssize_t col) const
+{
+    if (type == 'f' || type == 'd')
+        return static_cast<long>(getFloat(row, col));
+
+    const char* ptr = address(row, col);
+    switch (view.itemsize) {
+    case 1:
+        return type == 'i' ? static_cast<long>(*reinterpret_cast<const boost::int8_t*>(ptr))
+                           : static_cast<long>(*reinterpret_cast<const boost::uint8_t*>(ptr));
+    case 2: {
+        boost::uint16_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return type == 'i' ? static_cast<long>(static_cast<boost::int16_t>(value)) : static_cast<long>(value);
+    }
+    case 4: {
+        boost::uint32_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return type == 'i' ? static_cast<long>(static_cast<boost::int32_t>(value)) : static_cast<long>(value);
+    }
+    default: {
+        boost::uint64_t value;
+        memcpy(&value, ptr, sizeof(value));
+        return type == 'i' ? static_cast<long>(static_cast<boost::int64_t>(value)) : static_cast<long>(value);
+    }
+    }
+}
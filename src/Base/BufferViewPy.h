@@ -0,0 +1,178 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef BASE_BUFFERVIEWPY_H
+#define BASE_BUFFERVIEWPY_H
+
+#include "PyObjectBase.h"
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace Base
+{
+
+/** Describes a block of \a rows records with \a columns numbers each.
+ * The numbers of a record are contiguous, consecutive records are \a stride
+ * bytes apart. This allows to describe e.g. the coordinates of MeshPoint
+ * without copying them even though each point carries additional data.
+ */
+struct BaseExport BufferLayout
+{
+    BufferLayout();
+
+    const void* data;
+    Py_ssize_t  rows;
+    Py_ssize_t  columns;
+    Py_ssize_t  stride;
+    Py_ssize_t  itemsize;
+    /// struct module format character of a single number, e.g. "f" or "d"
+    const char* format;
+};
+
+/** Abstract interface that gives access to the memory of a container.
+ * The layout is queried each time a consumer requests the buffer so that
+ * a view follows a reallocation of the underlying container.
+ */
+class BaseExport BufferProvider
+{
+public:
+    BufferProvider() {}
+    virtual ~BufferProvider() {}
+    /// Returns false if the data is not accessible any more.
+    virtual bool getLayout(BufferLayout&) const = 0;
+};
+
+/** Read-only Python view of a container that supports the buffer protocol.
+ * The view keeps a reference to the Python object that owns the data and
+ * exports the data as a two-dimensional array, so that e.g. numpy.asarray()
+ * or memoryview() can wrap it without copying.
+ * While a buffer is exported the data is registered under the twin object of
+ * the owner. The non-const methods and attribute setters of every Python
+ * object of that twin then raise a BufferError, because they might reallocate
+ * the exported memory. Changes made from C++, e.g. by a recompute or an undo,
+ * cannot be refused. Before they reallocate or free the memory they hand it
+ * over with detach() and continue with a copy, so the exported buffers keep
+ * the data as it was until they are released.
+ */
+class BaseExport BufferViewPy : public PyObjectBase
+{
+    Py_Header;
+
+public:
+    /// The view takes ownership of \a provider and keeps a reference to \a owner.
+    BufferViewPy(PyObject* owner, BufferProvider* provider, PyTypeObject *T = &Type);
+
+    PyObject *_repr(void);
+    PyObject *_getattr(char *attr);
+
+    static PyBufferProcs BufferProcs;
+    static int getBuffer(PyObject*, Py_buffer*, int);
+    static void releaseBuffer(PyObject*, Py_buffer*);
+    static Py_ssize_t length(PyObject*);
+
+    /// Returns true if data of the object \a key is currently exported.
+    static bool isExported(const void* key);
+    /** Sets a Python BufferError and throws Py::Exception if data of the
+     * object \a key is currently exported.
+     */
+    static void checkExports(const void* key);
+    /** Keeps \a data until no buffer of \a key is exported any more.
+     * \a data must own the exported memory.
+     */
+    static void keepAlive(const void* key, const boost::shared_ptr<void>& data);
+    /** If data of \a key is exported the content of \a container is moved
+     * into a copy that is kept alive for the exported buffers and
+     * \a container gets a copy of it. Afterwards \a container can be
+     * reallocated or destroyed. \a T must provide swap() like std::vector.
+     */
+    template <class T>
+    static void detach(const void* key, T& container)
+    {
+        if (!isExported(key))
+            return;
+        boost::shared_ptr<T> exported(new T());
+        exported->swap(container);
+        container = *exported;
+        keepAlive(key, exported);
+    }
+
+protected:
+    ~BufferViewPy();
+
+private:
+    bool getLayout(BufferLayout&) const;
+    void addExport();
+    void removeExport();
+
+private:
+    PyObject* owner;
+    const void* key;
+    BufferProvider* provider;
+    int exports;
+    /// shape and strides of the current exports
+    std::vector<Py_ssize_t*> shapes;
+    /// memory of the owner that the current exports refer to
+    std::vector<boost::shared_ptr<void> > memory;
+};
+
+/** Reads numbers from a Python object that supports the new buffer protocol,
+ * e.g. a numpy array or a BufferViewPy. The buffer is interpreted as rows of
+ * \a columns numbers: either a flat array whose length is a multiple of
+ * \a columns or a two-dimensional array with \a columns columns.
+ * Errors are reported as Base::TypeError or Base::ValueError.
+ */
+class BaseExport BufferReader
+{
+public:
+    /// Returns true if \a obj exports a numeric buffer. Strings are rejected.
+    static bool check(PyObject* obj);
+
+    BufferReader(PyObject* obj, Py_ssize_t columns);
+    ~BufferReader();
+
+    Py_ssize_t rows() const
+    { return numRows; }
+    /// Returns true if the buffer holds integer numbers
+    bool isInteger() const
+    { return type != 'f' && type != 'd'; }
+    double getFloat(Py_ssize_t row, Py_ssize_t col) const;
+    long getInteger(Py_ssize_t row, Py_ssize_t col) const;
+
+private:
+    const char* address(Py_ssize_t row, Py_ssize_t col) const;
+    BufferReader(const BufferReader&);
+    BufferReader& operator=(const BufferReader&);
+
+private:
+    Py_buffer view;
+    char type;
+    Py_ssize_t numColumns;
+    Py_ssize_t numRows;
+    Py_ssize_t rowStride;
+    Py_ssize_t colStride;
+};
+
+} // namespace Base
+
+#endif // BASE_BUFFERVIEWPY_H
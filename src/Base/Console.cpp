@@ -32,6 +32,11 @@
 # include <windows.h>
 # endif
 # include "fcntl.h"
+# include <QAtomicInt>
+# include <QMutex>
+# include <QMutexLocker>
+# include <QThread>
+# include <QWaitCondition>
 #endif
 
 #include "Console.h"
@@ -41,26 +46,214 @@
 using namespace Base;
 
 
+// size of the buffer a message gets formatted into
+#define FC_CONSOLE_FORMAT_LEN 4024
 
-char format[4024];  // global buffer 
-const unsigned int format_len = 4024;
 
+namespace Base {
+
+struct ConsoleP
+{
+    // serializes the calls of the observers and the access to the observer list
+    static QMutex mutex;
+};
+
+QMutex ConsoleP::mutex(QMutex::Recursive);
+
+/** The message queue of the asynchronous console mode.
+ * Any number of threads can append messages to this bounded ring buffer without
+ * locking, a single consumer thread passes them to the console observers.
+ * After an error message the producer waits until it has been delivered.
+ */
+class ConsoleQueue : public QThread
+{
+public:
+    ConsoleQueue(ConsoleSingleton& console);
+    ~ConsoleQueue();
+
+    /// appends a message and returns its ticket
+    int push(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* sMsg);
+    /// waits until all messages up to the ticket are delivered
+    void flush(int ticket);
+    /// returns the ticket of the last appended message
+    int last();
+    /// delivers the pending messages and stops the thread
+    void stop();
+
+protected:
+    void run();
+
+private:
+    bool pop(ConsoleSingleton::FreeCAD_ConsoleMsgType& type, std::string& sMsg);
+    void deliver();
+    void wakeConsumer();
+    static int diff(int a, int b)
+    { return static_cast<int>(static_cast<unsigned int>(a) - static_cast<unsigned int>(b)); }
+
+    // must be a power of two
+    enum { Size = 1024 };
+    // max. time in ms a producer waits for free space or an error to be flushed
+    enum { MaxWait = 1000 };
+
+    struct Entry
+    {
+        QAtomicInt sequence;
+        ConsoleSingleton::FreeCAD_ConsoleMsgType type;
+        std::string text;
+    };
+
+    Entry entries[Size];
+    QAtomicInt writePos;
+    QAtomicInt delivered;
+    QAtomicInt sleeping;
+    QAtomicInt running;
+    int readPos;
+    QMutex mutex;
+    QWaitCondition hasData;
+    QWaitCondition hasDelivered;
+    ConsoleSingleton& console;
+};
+
+} // namespace Base
+
+ConsoleQueue::ConsoleQueue(ConsoleSingleton& console)
+  : writePos(0), delivered(0), sleeping(0), running(1), readPos(0), console(console)
+{
+    for (int i=0; i<Size; i++)
+        entries[i].sequence = i;
+}
+
+ConsoleQueue::~ConsoleQueue()
+{
+}
+
+int ConsoleQueue::push(ConsoleSingleton::FreeCAD_ConsoleMsgType type, const char* sMsg)
+{
+    int pos = writePos.fetchAndAddOrdered(0);
+    Entry* entry;
+    for (;;) {
+        entry = &entries[pos & (Size-1)];
+        int dif = diff(entry->sequence.fetchAndAddAcquire(0), pos);
+        if (dif == 0) {
+            // the slot is free, try to reserve it
+            if (writePos.testAndSetOrdered(pos, pos+1))
+                break;
+        }
+        else if (dif < 0) {
+            // the queue is full, wait until the consumer has delivered some messages
+            wakeConsumer();
+            QMutexLocker locker(&mutex);
+            if (diff(delivered.fetchAndAddAcquire(0), pos - Size) <= 0)
+                hasDelivered.wait(&mutex, MaxWait);
+        }
+        pos = writePos.fetchAndAddOrdered(0);
+    }
+
+    entry->type = type;
+    entry->text = sMsg;
+    entry->sequence.fetchAndStoreRelease(pos+1);
+
+    // only take the lock if the consumer went to sleep
+    if (sleeping.fetchAndAddOrdered(0))
+        wakeConsumer();
+    return pos+1;
+}
+
+bool ConsoleQueue::pop(ConsoleSingleton::FreeCAD_ConsoleMsgType& type, std::string& sMsg)
+{
+    Entry& entry = entries[readPos & (Size-1)];
+    if (diff(entry.sequence.fetchAndAddAcquire(0), readPos+1) != 0)
+        return false;
+    type = entry.type;
+    sMsg.swap(entry.text);
+    entry.text.clear();
+    entry.sequence.fetchAndStoreRelease(readPos+Size);
+    readPos++;
+    return true;
+}
+
+void ConsoleQueue::deliver()
+{
+    ConsoleSingleton::FreeCAD_ConsoleMsgType type;
+    std::string text;
+    bool any = false;
+    while (pop(type, text)) {
+        console.NotifyObservers(type, text.c_str());
+        any = true;
+    }
+
+    if (any) {
+        delivered.fetchAndStoreRelease(readPos);
+        QMutexLocker locker(&mutex);
+        hasDelivered.wakeAll();
+    }
+}
+
+void ConsoleQueue::wakeConsumer()
+{
+    QMutexLocker locker(&mutex);
+    hasData.wakeOne();
+}
+
+int ConsoleQueue::last()
+{
+    return writePos.fetchAndAddOrdered(0);
+}
+
+void ConsoleQueue::flush(int ticket)
+{
+    // an observer that prints an error must not wait for itself
+    if (QThread::currentThread() == this)
+        return;
+    wakeConsumer();
+    QMutexLocker locker(&mutex);
+    while (diff(delivered.fetchAndAddAcquire(0), ticket) < 0 && running.fetchAndAddAcquire(0)) {
+        if (!hasDelivered.wait(&mutex, MaxWait))
+            break;
+    }
+}
+
+void ConsoleQueue::stop()
+{
+    running.fetchAndStoreOrdered(0);
+    wakeConsumer();
+    wait();
+}
+
+void ConsoleQueue::run()
+{
+    while (running.fetchAndAddAcquire(0)) {
+        deliver();
+
+        QMutexLocker locker(&mutex);
+        sleeping.fetchAndStoreOrdered(1);
+        // check again to not miss a message appended in the meantime
+        Entry& entry = entries[readPos & (Size-1)];
+        if (diff(entry.sequence.fetchAndAddAcquire(0), readPos+1) != 0 && running.fetchAndAddAcquire(0))
+            hasData.wait(&mutex);
+        sleeping.fetchAndStoreOrdered(0);
+    }
+
+    // pass the remaining messages
+    deliver();
+}
 
 //**************************************************************************
 // Construction destruction
 
 
 ConsoleSingleton::ConsoleSingleton(void)
-  :_bVerbose(false)
+  :_bVerbose(false), _uEnabledTypes(new QAtomicInt(0)), _pcQueue(0)
 {
 
 }
 
 ConsoleSingleton::~ConsoleSingleton()
 {
+    UnsetMode(Asynchronous);
     for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++)
         delete (*Iter);   
-
+    delete _uEnabledTypes;
 }
 
 
@@ -69,19 +262,45 @@ ConsoleSingleton::~ConsoleSingleton()
 
 /**  
  *  sets the console in a special mode
+ *  The Asynchronous mode must only be switched while no other thread prints
+ *  to the console, and all observers must accept calls from another thread.
  */
 void ConsoleSingleton::SetMode(ConsoleMode m)
 {
-    if(m && Verbose)
+    if(m & Verbose)
         _bVerbose = true;
+    if((m & Asynchronous) && !_pcQueue) {
+        _pcQueue = new ConsoleQueue(*this);
+        _pcQueue->start();
+    }
 }
 /**  
  *  unsets the console from a special mode
  */
 void ConsoleSingleton::UnsetMode(ConsoleMode m)
 {
-    if(m && Verbose)
+    if(m & Verbose)
         _bVerbose = false;
+    if((m & Asynchronous) && _pcQueue) {
+        _pcQueue->stop();
+        delete _pcQueue;
+        _pcQueue = 0;
+    }
+}
+
+/**
+ *  In asynchronous mode this waits until all messages issued so far have been
+ *  passed to the observers. In the synchronous mode nothing happens.
+ */
+void ConsoleSingleton::Flush(void)
+{
+    if (_pcQueue)
+        _pcQueue->flush(_pcQueue->last());
+}
+
+bool ConsoleSingleton::IsAsynchronous(void) const
+{
+    return _pcQueue != 0;
 }
 
 /**
@@ -126,6 +345,7 @@ ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsg
                 flags |= MsgType_Log;
             pObs->bLog = b;
         }
+        UpdateEnabledTypes();
         return flags;
     }
     else {
@@ -133,6 +353,11 @@ ConsoleMsgFlags ConsoleSingleton::SetEnabledMsgType(const char* sObs, ConsoleMsg
     }
 }
 
+bool ConsoleSingleton::IsMsgTypeEnabled(FreeCAD_ConsoleMsgType type) const
+{
+    return (_uEnabledTypes->fetchAndAddRelaxed(0) & type) != 0;
+}
+
 bool ConsoleSingleton::IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const
 {
     ConsoleObserver* pObs = Get(sObs);
@@ -171,11 +396,15 @@ bool ConsoleSingleton::IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType
  */
 void ConsoleSingleton::Message( const char *pMsg, ... )
 {
+    // don't format the message if nobody wants it
+    if (!IsMsgTypeEnabled(MsgType_Txt))
+        return;
+    char format[FC_CONSOLE_FORMAT_LEN];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
-    vsnprintf(format, format_len, pMsg, namelessVars);
+    vsnprintf(format, sizeof(format), pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyMessage(format);
+    Notify(MsgType_Txt, format);
 }
 
 /** Prints a Message
@@ -195,11 +424,15 @@ void ConsoleSingleton::Message( const char *pMsg, ... )
  */
 void ConsoleSingleton::Warning( const char *pMsg, ... )
 {
+    // don't format the message if nobody wants it
+    if (!IsMsgTypeEnabled(MsgType_Wrn))
+        return;
+    char format[FC_CONSOLE_FORMAT_LEN];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
-    vsnprintf(format, format_len, pMsg, namelessVars);
+    vsnprintf(format, sizeof(format), pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyWarning(format);
+    Notify(MsgType_Wrn, format);
 }
 
 /** Prints a Message
@@ -219,11 +452,15 @@ void ConsoleSingleton::Warning( const char *pMsg, ... )
  */
 void ConsoleSingleton::Error( const char *pMsg, ... )
 {
+    // don't format the message if nobody wants it
+    if (!IsMsgTypeEnabled(MsgType_Err))
+        return;
+    char format[FC_CONSOLE_FORMAT_LEN];
     va_list namelessVars;
     va_start(namelessVars, pMsg);  // Get the "..." vars
-    vsnprintf(format, format_len, pMsg, namelessVars);
+    vsnprintf(format, sizeof(format), pMsg, namelessVars);
     va_end(namelessVars);
-    NotifyError(format);
+    Notify(MsgType_Err, format);
 }
 
 
@@ -246,13 +483,14 @@ void ConsoleSingleton::Error( const char *pMsg, ... )
 
 void ConsoleSingleton::Log( const char *pMsg, ... )
 {
-    if (!_bVerbose)
+    if (!_bVerbose && IsMsgTypeEnabled(MsgType_Log))
     {
+        char format[FC_CONSOLE_FORMAT_LEN];
         va_list namelessVars;
         va_start(namelessVars, pMsg);  // Get the "..." vars
-        vsnprintf(format, format_len, pMsg, namelessVars);
+        vsnprintf(format, sizeof(format), pMsg, namelessVars);
         va_end(namelessVars);
-        NotifyLog(format);
+        Notify(MsgType_Log, format);
     }
 }
 
@@ -289,7 +527,9 @@ void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
     // double insert !!
     assert(_aclObservers.find(pcObserver) == _aclObservers.end() );
 
+    QMutexLocker locker(&ConsoleP::mutex);
     _aclObservers.insert(pcObserver);
+    UpdateEnabledTypes();
 }
 
 /** Detaches an Observer from Console
@@ -299,7 +539,56 @@ void ConsoleSingleton::AttachObserver(ConsoleObserver *pcObserver)
  */
 void ConsoleSingleton::DetachObserver(ConsoleObserver *pcObserver)
 {
+    // make sure the observer doesn't get any queued messages after detaching
+    Flush();
+    QMutexLocker locker(&ConsoleP::mutex);
     _aclObservers.erase(pcObserver);
+    UpdateEnabledTypes();
+}
+
+void ConsoleSingleton::UpdateEnabledTypes(void)
+{
+    QMutexLocker locker(&ConsoleP::mutex);
+    ConsoleMsgFlags types = 0;
+    for(std::set<ConsoleObserver * >::iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++) {
+        if((*Iter)->bMsg) types |= MsgType_Txt;
+        if((*Iter)->bLog) types |= MsgType_Log;
+        if((*Iter)->bWrn) types |= MsgType_Wrn;
+        if((*Iter)->bErr) types |= MsgType_Err;
+    }
+    _uEnabledTypes->fetchAndStoreRelease(types);
+}
+
+void ConsoleSingleton::Notify(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    if (_pcQueue) {
+        int ticket = _pcQueue->push(type, sMsg);
+        // errors must not get lost if the application terminates
+        if (type == MsgType_Err)
+            _pcQueue->flush(ticket);
+    }
+    else {
+        NotifyObservers(type, sMsg);
+    }
+}
+
+void ConsoleSingleton::NotifyObservers(FreeCAD_ConsoleMsgType type, const char *sMsg)
+{
+    QMutexLocker locker(&ConsoleP::mutex);
+    switch (type) {
+    case MsgType_Txt:
+        NotifyMessage(sMsg);
+        break;
+    case MsgType_Log:
+        NotifyLog(sMsg);
+        break;
+    case MsgType_Wrn:
+        NotifyWarning(sMsg);
+        break;
+    case MsgType_Err:
+        NotifyError(sMsg);
+        break;
+    }
 }
 
 void ConsoleSingleton::NotifyMessage(const char *sMsg)
@@ -336,6 +625,7 @@ void ConsoleSingleton::NotifyLog(const char *sMsg)
 
 ConsoleObserver *ConsoleSingleton::Get(const char *Name) const
 {
+    QMutexLocker locker(&ConsoleP::mutex);
     const char* OName;
     for(std::set<ConsoleObserver * >::const_iterator Iter=_aclObservers.begin();Iter!=_aclObservers.end();Iter++) {
         OName = (*Iter)->Name();   // get the name
@@ -386,6 +676,10 @@ PyMethodDef ConsoleSingleton::Methods[] = {
      "Set the status for either Log, Msg, Wrn or Error for an observer"},
     {"GetStatus",            (PyCFunction) ConsoleSingleton::sPyGetStatus, 1,
      "Get the status for either Log, Msg, Wrn or Error for an observer"},
+    {"SetAsynchronous",      (PyCFunction) ConsoleSingleton::sPySetAsynchronous, 1,
+     "SetAsynchronous(bool) -- Notify the observers from a separate thread"},
+    {"IsAsynchronous",       (PyCFunction) ConsoleSingleton::sPyIsAsynchronous, 1,
+     "IsAsynchronous() -- Check whether the observers are notified from a separate thread"},
     {NULL, NULL, 0, NULL}		/* Sentinel */
 };
 
@@ -551,6 +845,34 @@ PyObject *ConsoleSingleton::sPyGetStatus(PyObject * /*self*/, PyObject *args, Py
     }PY_CATCH;
 }
 
+PyObject *ConsoleSingleton::sPySetAsynchronous(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    PyObject *pBool;
+    if (!PyArg_ParseTuple(args, "O!", &PyBool_Type, &pBool))     // convert args: Python->C 
+        return NULL;                                            // NULL triggers exception 
+
+    PY_TRY{
+        bool async = PyObject_IsTrue(pBool) ? true : false;
+        // stopping the queue waits for the delivery of the pending messages
+        Py_BEGIN_ALLOW_THREADS
+        if (async)
+            Instance().SetMode(Asynchronous);
+        else
+            Instance().UnsetMode(Asynchronous);
+        Py_END_ALLOW_THREADS
+        Py_INCREF(Py_None);
+        return Py_None;
+    }PY_CATCH;
+}
+
+PyObject *ConsoleSingleton::sPyIsAsynchronous(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
+{
+    if (!PyArg_ParseTuple(args, ""))     // convert args: Python->C 
+        return NULL;                     // NULL triggers exception 
+
+    return PyBool_FromLong(Instance().IsAsynchronous() ? 1 : 0);
+}
+
 PyObject *ConsoleSingleton::sPySetStatus(PyObject * /*self*/, PyObject *args, PyObject * /*kwd*/)
 {
     char *pstr1;
@@ -573,6 +895,7 @@ PyObject *ConsoleSingleton::sPySetStatus(PyObject * /*self*/, PyObject *args, Py
                 pObs->bErr = (Bool==0)?false:true;
             else
                 Py_Error(Base::BaseExceptionFreeCADError,"Unknown Message Type (use Log,Err,Msg or Wrn)");
+            Instance().UpdateEnabledTypes();
 
             Py_INCREF(Py_None);
             return Py_None;
@@ -37,6 +37,8 @@
 #include <set>
 #include <string>
 
+class QAtomicInt;
+
 //**************************************************************************
 // Loging levels
 
@@ -59,6 +61,8 @@ typedef unsigned int ConsoleMsgFlags;
 
 namespace Base {
 
+class ConsoleQueue;
+
 /** The console observer class
  *  This class distribute the Messages issued to the FCConsole class. 
  *  If you need to catch some of the Messages you need to inherit from
@@ -126,6 +130,7 @@ public:
     /// enumaration for the console modes
     enum ConsoleMode{
         Verbose = 1,	// supress Log messages
+        Asynchronous = 2,	// notify the observers from a separate thread
     };
 
     enum FreeCAD_ConsoleMsgType { 
@@ -143,6 +148,14 @@ public:
     ConsoleMsgFlags SetEnabledMsgType(const char* sObs, ConsoleMsgFlags type, bool b);
     /// Enables or disables message types of a cetain console observer
     bool IsMsgTypeEnabled(const char* sObs, FreeCAD_ConsoleMsgType type) const;
+    /// Checks whether any console observer accepts the message type
+    bool IsMsgTypeEnabled(FreeCAD_ConsoleMsgType type) const;
+    /// Must be called after the message types of an attached observer were changed directly
+    void UpdateEnabledTypes(void);
+    /// Checks whether the observers are notified from a separate thread
+    bool IsAsynchronous(void) const;
+    /// Waits until all queued messages are passed to the observers
+    void Flush(void);
 
     /// singleton 
     static ConsoleSingleton &Instance(void);
@@ -161,8 +174,12 @@ protected:
     static PyObject *sPyError    (PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sPySetStatus(PyObject *self,PyObject *args,PyObject *kwd);
     static PyObject *sPyGetStatus(PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPySetAsynchronous(PyObject *self,PyObject *args,PyObject *kwd);
+    static PyObject *sPyIsAsynchronous (PyObject *self,PyObject *args,PyObject *kwd);
 
     bool _bVerbose;
+    /// OR'ed message types accepted by at least one observer
+    QAtomicInt* _uEnabledTypes;
 
     // Singleton!
     ConsoleSingleton(void);
@@ -174,6 +191,8 @@ private:
     static ConsoleSingleton *_pcSingleton;
 
     // observer processing 
+    void Notify(FreeCAD_ConsoleMsgType type, const char *sMsg);
+    void NotifyObservers(FreeCAD_ConsoleMsgType type, const char *sMsg);
     void NotifyMessage(const char *sMsg);
     void NotifyWarning(const char *sMsg);
     void NotifyError  (const char *sMsg);
@@ -181,6 +200,9 @@ private:
 
     // observer list
     std::set<ConsoleObserver * > _aclObservers;
+    // message queue of the asynchronous mode
+    ConsoleQueue* _pcQueue;
+    friend class ConsoleQueue;
 };
 
 /** Access to the Console
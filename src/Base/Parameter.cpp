@@ -52,6 +52,10 @@
 #   endif
 #   include <sstream>
 #   include <stdio.h>
+#   include <QAtomicInt>
+#   include <QAtomicPointer>
+#   include <QMutex>
+#   include <QMutexLocker>
 #endif
 
 
@@ -59,6 +63,7 @@
 #ifdef FC_OS_LINUX
 #   include <unistd.h>
 #endif
+#include <boost/unordered_map.hpp>
 
 #include "Parameter.h"
 #include "Exception.h"
@@ -83,6 +88,7 @@ using namespace Base;
 // - DOMPrintFilter
 // - DOMPrintErrorHandler
 // - XStr
+// - ParameterCache
 //++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 
@@ -183,6 +189,146 @@ inline bool DOMTreeErrorReporter::getSawErrors() const
     return fSawErrors;
 }
 
+/** Hashed index of the typed values of a parameter group.
+ * The values are kept in an immutable snapshot which is built from the DOM
+ * on the first lookup and dropped whenever the group gets modified, i.e.
+ * before its observers are notified. A reader only pins the snapshot by an
+ * atomic counter, so a lookup that hits the index neither locks nor transcodes.
+ * Snapshots dropped while readers are active are released by the next
+ * modification that happens without readers, or with the group itself.
+ */
+class ParameterCache
+{
+public:
+    typedef boost::unordered_map<std::string, bool> BoolMap;
+    typedef boost::unordered_map<std::string, long> IntMap;
+    typedef boost::unordered_map<std::string, unsigned long> UIntMap;
+    typedef boost::unordered_map<std::string, double> FloatMap;
+    typedef boost::unordered_map<std::string, std::string> TextMap;
+
+    struct Snapshot {
+        BoolMap  Bools;
+        IntMap   Ints;
+        UIntMap  UInts;
+        FloatMap Floats;
+        TextMap  Texts;
+    };
+
+    /// Pins the current snapshot of the group as long as the reader lives
+    class Reader
+    {
+    public:
+        Reader(ParameterCache& c, DOMElement* node) : cache(c) {
+            cache.readers.fetchAndAddOrdered(1);
+            snap = cache.snapshot;
+            if (!snap)
+                snap = cache.build(node);
+        }
+        ~Reader() {
+            cache.readers.fetchAndAddOrdered(-1);
+        }
+        const Snapshot* operator->() const {
+            return snap;
+        }
+
+    private:
+        ParameterCache& cache;
+        const Snapshot* snap;
+    };
+
+    /// Serializes a modification of the DOM and drops the snapshot when done
+    class Writer
+    {
+    public:
+        Writer(ParameterCache& c) : cache(c) {
+            cache.mutex.lock();
+        }
+        ~Writer() {
+            cache.invalidate();
+            cache.mutex.unlock();
+        }
+
+    private:
+        ParameterCache& cache;
+    };
+
+    ParameterCache() : snapshot(0), mutex(QMutex::Recursive) {
+    }
+    ~ParameterCache() {
+        delete static_cast<Snapshot*>(snapshot);
+        for (std::vector<Snapshot*>::iterator it = retired.begin(); it != retired.end(); ++it)
+            delete *it;
+    }
+
+private:
+    const Snapshot* build(DOMElement* node) {
+        QMutexLocker lock(&mutex);
+        // another reader may have been faster
+        Snapshot* snap = snapshot;
+        if (snap)
+            return snap;
+
+        snap = new Snapshot;
+        XStr attrName("Name"), attrValue("Value");
+        for (DOMNode *clChild = node ? node->getFirstChild() : 0; clChild != 0; clChild = clChild->getNextSibling()) {
+            if (clChild->getNodeType() != DOMNode::ELEMENT_NODE)
+                continue;
+            DOMElement* pcElem = static_cast<DOMElement*>(clChild);
+            DOMNode* pcName = pcElem->getAttributes()->getNamedItem(attrName.unicodeForm());
+            if (!pcName)
+                continue;
+
+            // like FindElement() the first element of a name wins, hence insert()
+            std::string type = StrX(pcElem->getNodeName()).c_str();
+            std::string name = StrX(pcName->getNodeValue()).c_str();
+            if (type == "FCBool") {
+                std::string value = StrX(pcElem->getAttribute(attrValue.unicodeForm())).c_str();
+                snap->Bools.insert(std::make_pair(name, value == "1"));
+            }
+            else if (type == "FCInt") {
+                long value = atol(StrX(pcElem->getAttribute(attrValue.unicodeForm())).c_str());
+                snap->Ints.insert(std::make_pair(name, value));
+            }
+            else if (type == "FCUInt") {
+                unsigned long value = strtoul(StrX(pcElem->getAttribute(attrValue.unicodeForm())).c_str(),0,10);
+                snap->UInts.insert(std::make_pair(name, value));
+            }
+            else if (type == "FCFloat") {
+                double value = atof(StrX(pcElem->getAttribute(attrValue.unicodeForm())).c_str());
+                snap->Floats.insert(std::make_pair(name, value));
+            }
+            else if (type == "FCText") {
+                // a text element without text node is handled like a missing one
+                DOMNode *pcText = pcElem->getFirstChild();
+                if (pcText)
+                    snap->Texts.insert(std::make_pair(name, std::string(StrXUTF8(pcText->getNodeValue()).c_str())));
+            }
+        }
+
+        snapshot.fetchAndStoreOrdered(snap);
+        return snap;
+    }
+
+    // must be called with the mutex held
+    void invalidate() {
+        Snapshot* snap = snapshot.fetchAndStoreOrdered(0);
+        if (snap)
+            retired.push_back(snap);
+        // a reader that is not counted yet will see the new snapshot
+        if (readers.testAndSetOrdered(0, 0)) {
+            for (std::vector<Snapshot*>::iterator it = retired.begin(); it != retired.end(); ++it)
+                delete *it;
+            retired.clear();
+        }
+    }
+
+private:
+    QAtomicPointer<Snapshot> snapshot;
+    QAtomicInt readers;
+    QMutex mutex;
+    std::vector<Snapshot*> retired;
+};
+
 
 //**************************************************************************
 //**************************************************************************
@@ -198,6 +344,7 @@ inline bool DOMTreeErrorReporter::getSawErrors() const
   */
 ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,const char* sName)
         : Base::Handled(), Subject<const char*>(),_pGroupNode(GroupNode)
+        , _pCache(new ParameterCache())
 {
     if (sName) _cName=sName;
 }
@@ -208,6 +355,7 @@ ParameterGrp::ParameterGrp(XERCES_CPP_NAMESPACE_QUALIFIER DOMElement *GroupNode,
   */
 ParameterGrp::~ParameterGrp()
 {
+    delete _pCache;
 }
 
 //**************************************************************************
@@ -396,23 +544,23 @@ bool ParameterGrp::HasGroup(const char* Name) const
 
 bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return preset
-    if (!pcElem) return bPreset;
-    // if yes check the value and return
-    if (strcmp(StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),"1"))
-        return false;
-    else
-        return true;
+    // look up the value in the index of this group
+    ParameterCache::Reader values(*_pCache, _pGroupNode);
+    ParameterCache::BoolMap::const_iterator it = values->Bools.find(Name);
+    // if not found return preset
+    if (it == values->Bools.end()) return bPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetBool(const char* Name, bool bValue)
 {
-    // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCBool",Name);
-    // and set the vaue
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // find or create the Element
+        DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCBool",Name);
+        // and set the vaue
+        pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(bValue?"1":"0").unicodeForm());
+    }
     // trigger observer
     Notify(Name);
 }
@@ -463,22 +611,25 @@ std::vector<std::pair<std::string,bool> > ParameterGrp::GetBoolMap(const char *
 
 long ParameterGrp::GetInt(const char* Name, long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return atol (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    // look up the value in the index of this group
+    ParameterCache::Reader values(*_pCache, _pGroupNode);
+    ParameterCache::IntMap::const_iterator it = values->Ints.find(Name);
+    // if not found return preset
+    if (it == values->Ints.end()) return lPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetInt(const char* Name, long lValue)
 {
     char cBuf[256];
-    // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCInt",Name);
-    // and set the vaue
     sprintf(cBuf,"%li",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // find or create the Element
+        DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCInt",Name);
+        // and set the vaue
+        pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    }
     // trigger observer
     Notify(Name);
 }
@@ -524,22 +675,25 @@ std::vector<std::pair<std::string,long> > ParameterGrp::GetIntMap(const char * s
 
 unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return preset
-    if (!pcElem) return lPreset;
-    // if yes check the value and return
-    return strtoul (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str(),0,10);
+    // look up the value in the index of this group
+    ParameterCache::Reader values(*_pCache, _pGroupNode);
+    ParameterCache::UIntMap::const_iterator it = values->UInts.find(Name);
+    // if not found return preset
+    if (it == values->UInts.end()) return lPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
 {
     char cBuf[256];
-    // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCUInt",Name);
-    // and set the vaue
     sprintf(cBuf,"%lu",lValue);
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // find or create the Element
+        DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCUInt",Name);
+        // and set the vaue
+        pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    }
     // trigger observer
     Notify(Name);
 }
@@ -585,22 +739,25 @@ std::vector<std::pair<std::string,unsigned long> > ParameterGrp::GetUnsignedMap(
 
 double ParameterGrp::GetFloat(const char* Name, double dPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return preset
-    if (!pcElem) return dPreset;
-    // if yes check the value and return
-    return atof (StrX(pcElem->getAttribute(XStr("Value").unicodeForm())).c_str());
+    // look up the value in the index of this group
+    ParameterCache::Reader values(*_pCache, _pGroupNode);
+    ParameterCache::FloatMap::const_iterator it = values->Floats.find(Name);
+    // if not found return preset
+    if (it == values->Floats.end()) return dPreset;
+    return it->second;
 }
 
 void  ParameterGrp::SetFloat(const char* Name, double dValue)
 {
     char cBuf[256];
-    // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCFloat",Name);
-    // and set the value
     sprintf(cBuf,"%.12f",dValue); // use %.12f instead of %f to handle values < 1.0e-6
-    pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // find or create the Element
+        DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCFloat",Name);
+        // and set the value
+        pcElem->setAttribute(XStr("Value").unicodeForm(), XStr(cBuf).unicodeForm());
+    }
     // trigger observer
     Notify(Name);
 }
@@ -660,17 +817,20 @@ void ParameterGrp::GetBlob(const char* /*Name*/, void* /*pBuf*/, long /*lMaxLeng
 
 void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 {
-    // find or create the Element
-    DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCText",Name);
-    // and set the value
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (!pcElem2) {
-        XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument *pDocument = _pGroupNode->getOwnerDocument();
-        DOMText *pText = pDocument->createTextNode(XUTF8Str(sValue).unicodeForm());
-        pcElem->appendChild(pText);
-    }
-    else {
-        pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // find or create the Element
+        DOMElement *pcElem = FindOrCreateElement(_pGroupNode,"FCText",Name);
+        // and set the value
+        DOMNode *pcElem2 = pcElem->getFirstChild();
+        if (!pcElem2) {
+            XERCES_CPP_NAMESPACE_QUALIFIER DOMDocument *pDocument = _pGroupNode->getOwnerDocument();
+            DOMText *pText = pDocument->createTextNode(XUTF8Str(sValue).unicodeForm());
+            pcElem->appendChild(pText);
+        }
+        else {
+            pcElem2->setNodeValue(XUTF8Str(sValue).unicodeForm());
+        }
     }
     // trigger observer
     Notify(Name);
@@ -679,22 +839,14 @@ void  ParameterGrp::SetASCII(const char* Name, const char *sValue)
 
 std::string ParameterGrp::GetASCII(const char* Name, const char * pPreset) const
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return preset
-    if (!pcElem) {
-        if (pPreset==0)
-            return std::string("");
-        else
-            return std::string(pPreset);
-    }
-    // if yes check the value and return
-    DOMNode *pcElem2 = pcElem->getFirstChild();
-    if (pcElem2)
-        return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
+    // look up the value in the index of this group
+    ParameterCache::Reader values(*_pCache, _pGroupNode);
+    ParameterCache::TextMap::const_iterator it = values->Texts.find(Name);
+    if (it != values->Texts.end())
+        return it->second;
+    // if not found return preset
     else if (pPreset==0)
         return std::string("");
-
     else
         return std::string(pPreset);
 }
@@ -751,26 +903,32 @@ void ParameterGrp::RemoveGrp(const char* Name)
     // remove group handle
     _GroupMap.erase(Name);
 
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCParamGroup",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCParamGroup",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
     // trigger observer
     Notify(Name);
 }
 
 void ParameterGrp::RemoveASCII(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCText",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
     // trigger observer
     Notify(Name);
 
@@ -778,13 +936,16 @@ void ParameterGrp::RemoveASCII(const char* Name)
 
 void ParameterGrp::RemoveBool(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCBool",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
 
     // trigger observer
     Notify(Name);
@@ -805,13 +966,16 @@ void ParameterGrp::RemoveBlob(const char* /*Name*/)
 
 void ParameterGrp::RemoveFloat(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCFloat",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
 
     // trigger observer
     Notify(Name);
@@ -819,13 +983,16 @@ void ParameterGrp::RemoveFloat(const char* Name)
 
 void ParameterGrp::RemoveInt(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCInt",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
 
     // trigger observer
     Notify(Name);
@@ -833,13 +1000,16 @@ void ParameterGrp::RemoveInt(const char* Name)
 
 void ParameterGrp::RemoveUnsigned(const char* Name)
 {
-    // check if Element in group
-    DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
-    // if not return
-    if (!pcElem)
-        return;
-    else
-        _pGroupNode->removeChild(pcElem);
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // check if Element in group
+        DOMElement *pcElem = FindElement(_pGroupNode,"FCUInt",Name);
+        // if not return
+        if (!pcElem)
+            return;
+        else
+            _pGroupNode->removeChild(pcElem);
+    }
 
     // trigger observer
     Notify(Name);
@@ -857,17 +1027,20 @@ void ParameterGrp::Clear(void)
     // remove group handles
     _GroupMap.clear();
 
-    // searching all nodes
-    for (DOMNode *clChild = _pGroupNode->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
-        vecNodes.push_back(clChild);
-    }
+    {
+        ParameterCache::Writer lock(*_pCache);
+        // searching all nodes
+        for (DOMNode *clChild = _pGroupNode->getFirstChild(); clChild != 0;  clChild = clChild->getNextSibling()) {
+            vecNodes.push_back(clChild);
+        }
 
-    // deleting the nodes
-    DOMNode* pcTemp;
-    for (std::vector<DOMNode*>::iterator It=vecNodes.begin();It!=vecNodes.end();It++) {
-        pcTemp = _pGroupNode->removeChild(*It);
-        //delete pcTemp;
-        pcTemp->release();
+        // deleting the nodes
+        DOMNode* pcTemp;
+        for (std::vector<DOMNode*>::iterator It=vecNodes.begin();It!=vecNodes.end();It++) {
+            pcTemp = _pGroupNode->removeChild(*It);
+            //delete pcTemp;
+            pcTemp->release();
+        }
     }
     // trigger observer
     Notify(0);
@@ -1160,7 +1333,10 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
     if (!rootElem)
         throw Exception("Malformed Parameter document: Root group not found");
 
-    _pGroupNode = FindElement(rootElem,"FCParamGroup","Root");
+    {
+        ParameterCache::Writer lock(*_pCache);
+        _pGroupNode = FindElement(rootElem,"FCParamGroup","Root");
+    }
 
     if (!_pGroupNode)
         throw Exception("Malformed Parameter document: Root group not found");
@@ -1299,6 +1475,7 @@ void  ParameterManager::CreateDocument(void)
 {
     // creating a document from screatch
     DOMImplementation* impl =  DOMImplementationRegistry::getDOMImplementation(XStr("Core").unicodeForm());
+    ParameterCache::Writer lock(*_pCache);
     delete _pDocument;
     _pDocument = impl->createDocument(
                      0,                                          // root element namespace URI.
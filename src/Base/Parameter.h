@@ -77,6 +77,7 @@ class InputSource;
 XERCES_CPP_NAMESPACE_END
 
 class ParameterManager;
+class ParameterCache;
 
 
 /** The parameter container class
@@ -263,6 +264,8 @@ protected:
     std::string _cName;
     /// map of already exported groups
     std::map <std::string ,Base::Reference<ParameterGrp> > _GroupMap;
+    /// hashed index of the typed values of this group
+    ParameterCache* _pCache;
 
 };
 
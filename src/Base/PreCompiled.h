@@ -116,6 +116,9 @@
 #include <QReadWriteLock>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QAtomicInt>
+#include <QThread>
+#include <QWaitCondition>
 #include <QUuid>
 
 
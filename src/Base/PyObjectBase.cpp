@@ -29,6 +29,7 @@
 #endif
 
 #include "PyObjectBase.h"
+#include "BufferViewPy.h"
 #include "Console.h"
 
 using namespace Base;
@@ -288,3 +289,8 @@ void PyObjectBase::startNotify()
             PyErr_Clear();
     }
 }
+
+bool PyObjectBase::isExported() const
+{
+    return BufferViewPy::isExported(_pcTwinPointer);
+}
@@ -298,6 +298,13 @@ public:
         return StatusBits.test(1);
     }
 
+    /// Returns true if data of the twin object is exported as buffer
+    bool isExported() const;
+
+    void* getTwinPointer() const {
+        return _pcTwinPointer;
+    }
+
     void setAttributeOf(const char* attr, const PyObjectBase* par);
     void startNotify();
 
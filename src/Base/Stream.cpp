@@ -28,6 +28,7 @@
 # include <QByteArray>
 # include <QDataStream>
 # include <QIODevice>
+# include <algorithm>
 # include <cstdlib>
 # include <string>
 # include <cstdio>
@@ -44,6 +45,41 @@
 
 using namespace Base;
 
+namespace {
+template <typename T>
+void writeArray(std::ostream& out, const T* v, std::size_t n, bool swap)
+{
+    if (!swap) {
+        out.write(reinterpret_cast<const char*>(v), n * sizeof(T));
+        return;
+    }
+
+    // swap a copy to keep the caller's data untouched
+    const std::size_t chunk = 1024;
+    T buf[chunk];
+    while (n > 0) {
+        std::size_t len = std::min<std::size_t>(n, chunk);
+        for (std::size_t i = 0; i < len; i++) {
+            buf[i] = v[i];
+            SwapEndian<T>(buf[i]);
+        }
+        out.write(reinterpret_cast<const char*>(buf), len * sizeof(T));
+        v += len;
+        n -= len;
+    }
+}
+
+template <typename T>
+void readArray(std::istream& in, T* v, std::size_t n, bool swap)
+{
+    in.read(reinterpret_cast<char*>(v), n * sizeof(T));
+    if (swap) {
+        for (std::size_t i = 0; i < n; i++)
+            SwapEndian<T>(v[i]);
+    }
+}
+}
+
 Stream::Stream() : _swap(false)
 {
 }
@@ -144,6 +180,30 @@ OutputStream& OutputStream::operator << (double d)
     return *this;
 }
 
+OutputStream& OutputStream::write(const int32_t* v, std::size_t n)
+{
+    writeArray<int32_t>(_out, v, n, _swap);
+    return *this;
+}
+
+OutputStream& OutputStream::write(const uint32_t* v, std::size_t n)
+{
+    writeArray<uint32_t>(_out, v, n, _swap);
+    return *this;
+}
+
+OutputStream& OutputStream::write(const float* v, std::size_t n)
+{
+    writeArray<float>(_out, v, n, _swap);
+    return *this;
+}
+
+OutputStream& OutputStream::write(const double* v, std::size_t n)
+{
+    writeArray<double>(_out, v, n, _swap);
+    return *this;
+}
+
 InputStream::InputStream(std::istream &rin) : _in(rin)
 {
 }
@@ -226,6 +286,30 @@ InputStream& InputStream::operator >> (double& d)
     return *this;
 }
 
+InputStream& InputStream::read(int32_t* v, std::size_t n)
+{
+    readArray<int32_t>(_in, v, n, _swap);
+    return *this;
+}
+
+InputStream& InputStream::read(uint32_t* v, std::size_t n)
+{
+    readArray<uint32_t>(_in, v, n, _swap);
+    return *this;
+}
+
+InputStream& InputStream::read(float* v, std::size_t n)
+{
+    readArray<float>(_in, v, n, _swap);
+    return *this;
+}
+
+InputStream& InputStream::read(double* v, std::size_t n)
+{
+    readArray<double>(_in, v, n, _swap);
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba) : _buffer(new QBuffer(&ba))
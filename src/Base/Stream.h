@@ -80,6 +80,18 @@ public:
     OutputStream& operator << (float f);
     OutputStream& operator << (double d);
 
+    /** @name Bulk output
+     * Writes \a n consecutive values with a single stream call instead of
+     * one call per value. If the byte order must be swapped this is done
+     * chunk-wise on an internal buffer, the passed values stay untouched.
+     */
+    //@{
+    OutputStream& write(const int32_t* v, std::size_t n);
+    OutputStream& write(const uint32_t* v, std::size_t n);
+    OutputStream& write(const float* v, std::size_t n);
+    OutputStream& write(const double* v, std::size_t n);
+    //@}
+
 private:
     OutputStream (const OutputStream&);
     void operator = (const OutputStream&);
@@ -110,6 +122,17 @@ public:
     InputStream& operator >> (float& f);
     InputStream& operator >> (double& d);
 
+    /** @name Bulk input
+     * Reads \a n consecutive values with a single stream call and swaps
+     * their byte order in one pass afterwards if needed.
+     */
+    //@{
+    InputStream& read(int32_t* v, std::size_t n);
+    InputStream& read(uint32_t* v, std::size_t n);
+    InputStream& read(float* v, std::size_t n);
+    InputStream& read(double* v, std::size_t n);
+    //@}
+
     operator bool() const
     {
         // test if _Ipfx succeeded
@@ -0,0 +1,473 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <deque>
+# include <string>
+# include <QMutex>
+# include <QMutexLocker>
+# include <QThread>
+# include <QWaitCondition>
+#endif
+
+#include "TaskScheduler.h"
+#include "Exception.h"
+#include "Sequencer.h"
+
+using namespace Base;
+
+namespace Base {
+
+class TaskQueue
+{
+public:
+    void pushBack(Task* task)
+    {
+        QMutexLocker locker(&mutex);
+        tasks.push_back(task);
+    }
+    Task* popBack()
+    {
+        QMutexLocker locker(&mutex);
+        if (tasks.empty())
+            return 0;
+        Task* task = tasks.back();
+        tasks.pop_back();
+        return task;
+    }
+    Task* popFront()
+    {
+        QMutexLocker locker(&mutex);
+        if (tasks.empty())
+            return 0;
+        Task* task = tasks.front();
+        tasks.pop_front();
+        return task;
+    }
+
+private:
+    QMutex mutex;
+    std::deque<Task*> tasks;
+};
+
+class TaskWorker : public QThread
+{
+public:
+    TaskWorker(TaskSchedulerP* s, int i) : scheduler(s), index(i)
+    {
+    }
+
+    TaskSchedulerP* scheduler;
+    int index;
+
+protected:
+    void run();
+};
+
+struct TaskGroupP
+{
+    enum Error {
+        NoError,
+        AbortError,
+        MemoryError,
+        GeneralError
+    };
+
+    TaskGroupP(CancellationToken* t)
+      : token(t), pending(0), aborted(false), error(NoError)
+    {
+    }
+    void setError(Error type, const char* msg)
+    {
+        QMutexLocker locker(&mutex);
+        if (error == NoError) {
+            error = type;
+            message = msg;
+        }
+        failed.fetchAndStoreOrdered(1);
+    }
+
+    CancellationToken* token;
+    int pending; /**< guarded by TaskSchedulerP::doneMutex */
+    QAtomicInt done;
+    QAtomicInt failed;
+    bool aborted;
+    QMutex mutex;
+    Error error;
+    std::string message;
+};
+
+struct TaskSchedulerP
+{
+    TaskSchedulerP() : budget(0), quit(false)
+    {
+    }
+
+    static int effectiveBudget(int budget)
+    {
+        if (budget > 0)
+            return budget;
+        return std::max<int>(1, QThread::idealThreadCount());
+    }
+
+    /** Creates the queues and worker threads on first use. Afterwards the
+     * containers aren't modified until the scheduler gets destroyed.
+     */
+    void start()
+    {
+        QMutexLocker locker(&mutex);
+        if (!queues.empty())
+            return;
+        int count = effectiveBudget(budget);
+        activeWorkers.fetchAndStoreOrdered(count - 1);
+        for (int i=0; i<count; i++)
+            queues.push_back(new TaskQueue());
+        for (int i=1; i<count; i++)
+            workers.push_back(new TaskWorker(this, i));
+        for (std::vector<TaskWorker*>::iterator it = workers.begin(); it != workers.end(); ++it)
+            (*it)->start();
+    }
+    void stop()
+    {
+        {
+            QMutexLocker locker(&mutex);
+            quit = true;
+            wakeUp.wakeAll();
+            parked.wakeAll();
+        }
+        for (std::vector<TaskWorker*>::iterator it = workers.begin(); it != workers.end(); ++it) {
+            (*it)->wait();
+            delete *it;
+        }
+        for (std::vector<TaskQueue*>::iterator it = queues.begin(); it != queues.end(); ++it)
+            delete *it;
+        workers.clear();
+        queues.clear();
+    }
+    void setBudget(int value)
+    {
+        QMutexLocker locker(&mutex);
+        budget = value;
+        if (!queues.empty()) {
+            int count = std::min<int>(effectiveBudget(budget), (int)queues.size());
+            activeWorkers.fetchAndStoreOrdered(count - 1);
+            parked.wakeAll();
+        }
+    }
+    /** Worker threads push to and pop from their own queue, all other threads share the first one. */
+    int currentIndex() const
+    {
+        TaskWorker* worker = dynamic_cast<TaskWorker*>(QThread::currentThread());
+        if (worker && worker->scheduler == this)
+            return worker->index;
+        return 0;
+    }
+    void push(Task* task)
+    {
+        queued.ref();
+        queues[currentIndex()]->pushBack(task);
+        QMutexLocker locker(&mutex);
+        wakeUp.wakeOne();
+    }
+    /** Takes the most recent task of the own queue or steals the oldest one of another queue. */
+    Task* take(int self)
+    {
+        Task* task = queues[self]->popBack();
+        int count = (int)queues.size();
+        for (int i=1; !task && i<count; i++)
+            task = queues[(self + i) % count]->popFront();
+        if (task)
+            queued.deref();
+        return task;
+    }
+    void execute(Task* task)
+    {
+        TaskGroup* group = task->group;
+        group->execute(task);
+
+        // the group may be destroyed as soon as its counter drops to zero
+        QMutexLocker locker(&doneMutex);
+        group->d->pending--;
+        taskDone.wakeAll();
+    }
+
+    int budget;
+    bool quit;
+    std::vector<TaskQueue*> queues;
+    std::vector<TaskWorker*> workers;
+    QMutex mutex; /**< guards starting, stopping and sleeping of the workers */
+    QWaitCondition wakeUp;
+    QWaitCondition parked;
+    QMutex doneMutex; /**< guards the pending counters of the task groups */
+    QWaitCondition taskDone;
+    QAtomicInt queued;
+    QAtomicInt activeWorkers;
+};
+
+void TaskWorker::run()
+{
+    TaskSchedulerP* d = scheduler;
+    for (;;) {
+        if (index <= d->activeWorkers.fetchAndAddOrdered(0)) {
+            Task* task = d->take(index);
+            if (task) {
+                d->execute(task);
+                continue;
+            }
+        }
+
+        QMutexLocker locker(&d->mutex);
+        if (d->quit)
+            break;
+        if (index > d->activeWorkers.fetchAndAddOrdered(0))
+            d->parked.wait(&d->mutex);
+        else if (d->queued.fetchAndAddOrdered(0) <= 0)
+            d->wakeUp.wait(&d->mutex);
+    }
+}
+
+}
+
+// ---------------------------------------------------------
+
+CancellationToken::CancellationToken() : seq(0)
+{
+}
+
+CancellationToken::CancellationToken(SequencerLauncher* s) : seq(s)
+{
+}
+
+CancellationToken::~CancellationToken()
+{
+}
+
+void CancellationToken::cancel()
+{
+    canceled.fetchAndStoreOrdered(1);
+}
+
+bool CancellationToken::isCanceled() const
+{
+    return canceled.fetchAndAddOrdered(0) != 0;
+}
+
+SequencerLauncher* CancellationToken::progress() const
+{
+    return seq;
+}
+
+// ---------------------------------------------------------
+
+Task::Task() : group(0), weight(1)
+{
+}
+
+Task::~Task()
+{
+}
+
+// ---------------------------------------------------------
+
+TaskGroup::TaskGroup(CancellationToken* token) : d(new TaskGroupP(token))
+{
+    TaskScheduler::Instance().d->start();
+}
+
+TaskGroup::~TaskGroup()
+{
+    join();
+    delete d;
+}
+
+void TaskGroup::spawn(Task* task, int weight)
+{
+    TaskSchedulerP* s = TaskScheduler::Instance().d;
+    task->group = this;
+    task->weight = weight;
+    {
+        QMutexLocker locker(&s->doneMutex);
+        d->pending++;
+    }
+    s->push(task);
+}
+
+bool TaskGroup::isCanceled() const
+{
+    if (d->failed.fetchAndAddOrdered(0) != 0)
+        return true;
+    return d->token && d->token->isCanceled();
+}
+
+void TaskGroup::execute(Task* task)
+{
+    if (!isCanceled()) {
+        try {
+            task->run();
+        }
+        catch (const Base::AbortException& e) {
+            d->setError(TaskGroupP::AbortError, e.what());
+        }
+        catch (const Base::MemoryException& e) {
+            d->setError(TaskGroupP::MemoryError, e.what());
+        }
+        catch (const Base::Exception& e) {
+            d->setError(TaskGroupP::GeneralError, e.what());
+        }
+        catch (const std::bad_alloc& e) {
+            d->setError(TaskGroupP::MemoryError, e.what());
+        }
+        catch (const std::exception& e) {
+            d->setError(TaskGroupP::GeneralError, e.what());
+        }
+        catch (...) {
+            d->setError(TaskGroupP::GeneralError, "Unknown exception in parallel task");
+        }
+    }
+
+    d->done.fetchAndAddOrdered(task->weight);
+    delete task;
+}
+
+void TaskGroup::join()
+{
+    TaskSchedulerP* s = TaskScheduler::Instance().d;
+    int self = s->currentIndex();
+    SequencerLauncher* seq = d->token ? d->token->progress() : 0;
+    int reported = 0;
+
+    for (;;) {
+        // only the waiting thread talks to the sequencer
+        if (seq && !d->aborted) {
+            int done = d->done.fetchAndAddOrdered(0);
+            if (done > reported) {
+                reported = done;
+                seq->setProgress(done);
+            }
+            if (seq->wasCanceled()) {
+                d->token->cancel();
+                d->aborted = true;
+            }
+        }
+
+        Task* task = s->take(self);
+        if (task) {
+            s->execute(task);
+            continue;
+        }
+
+        QMutexLocker locker(&s->doneMutex);
+        if (d->pending == 0)
+            break;
+        s->taskDone.wait(&s->doneMutex, 100);
+    }
+}
+
+void TaskGroup::wait()
+{
+    join();
+
+    if (d->aborted) {
+        d->aborted = false;
+        throw Base::AbortException("Aborting...");
+    }
+
+    TaskGroupP::Error error = d->error;
+    std::string message = d->message;
+    d->error = TaskGroupP::NoError;
+    d->message.clear();
+    d->failed.fetchAndStoreOrdered(0);
+
+    switch (error) {
+    case TaskGroupP::AbortError:
+        throw Base::AbortException(message.c_str());
+    case TaskGroupP::MemoryError:
+        throw Base::MemoryException();
+    case TaskGroupP::GeneralError:
+        throw Base::Exception(message);
+    default:
+        break;
+    }
+}
+
+// ---------------------------------------------------------
+
+TaskScheduler* TaskScheduler::_pcSingleton = 0;
+
+TaskScheduler& TaskScheduler::Instance(void)
+{
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+    if (!_pcSingleton)
+        _pcSingleton = new TaskScheduler();
+    return *_pcSingleton;
+}
+
+void TaskScheduler::Destruct(void)
+{
+    delete _pcSingleton;
+    _pcSingleton = 0;
+}
+
+TaskScheduler::TaskScheduler() : d(new TaskSchedulerP())
+{
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    d->stop();
+    delete d;
+}
+
+void TaskScheduler::setThreadBudget(int budget)
+{
+    d->setBudget(std::max<int>(0, budget));
+}
+
+int TaskScheduler::threadBudget() const
+{
+    QMutexLocker locker(&d->mutex);
+    return d->budget;
+}
+
+int TaskScheduler::concurrency() const
+{
+    QMutexLocker locker(&d->mutex);
+    if (d->queues.empty())
+        return TaskSchedulerP::effectiveBudget(d->budget);
+    return d->activeWorkers.fetchAndAddOrdered(0) + 1;
+}
+
+std::size_t TaskScheduler::chunkSize(std::size_t count, std::size_t grainSize) const
+{
+    std::size_t threads = static_cast<std::size_t>(concurrency());
+    if (threads <= 1 || count <= grainSize)
+        return count;
+    // a few chunks per thread balance the load if some chunks are more expensive
+    std::size_t chunks = 4 * threads;
+    std::size_t chunk = (count + chunks - 1) / chunks;
+    return std::max<std::size_t>(std::max<std::size_t>(chunk, grainSize), 1);
+}
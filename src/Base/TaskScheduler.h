@@ -0,0 +1,268 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef BASE_TASKSCHEDULER_H
+#define BASE_TASKSCHEDULER_H
+
+#include <algorithm>
+#include <vector>
+#include <QAtomicInt>
+
+namespace Base
+{
+
+class SequencerLauncher;
+class TaskGroup;
+struct TaskGroupP;
+struct TaskSchedulerP;
+
+/**
+ * A cancellation token is shared between the code that starts a parallel
+ * operation and the tasks it consists of. Once it is canceled tasks that
+ * haven't started yet are skipped and running tasks may poll isCanceled()
+ * to leave early.
+ *
+ * If a SequencerLauncher is passed the thread waiting for the tasks reports
+ * the progress to it and cancels the token when the user aborts the operation.
+ * In this case the waiting function throws an AbortException as soon as all
+ * running tasks have returned.
+ * @author FreeCAD Developers
+ */
+class BaseExport CancellationToken
+{
+public:
+    CancellationToken();
+    /** The number of steps of \a seq must be the number of items to process. */
+    explicit CancellationToken(SequencerLauncher* seq);
+    ~CancellationToken();
+
+    void cancel();
+    bool isCanceled() const;
+    SequencerLauncher* progress() const;
+
+private:
+    CancellationToken(const CancellationToken&);
+    CancellationToken& operator=(const CancellationToken&);
+
+private:
+    mutable QAtomicInt canceled;
+    SequencerLauncher* seq;
+};
+
+/**
+ * The abstract base class of a unit of work that is run by the TaskScheduler.
+ * @author FreeCAD Developers
+ */
+class BaseExport Task
+{
+public:
+    Task();
+    virtual ~Task();
+    virtual void run() = 0;
+
+private:
+    friend class TaskGroup;
+    friend struct TaskSchedulerP;
+    TaskGroup* group;
+    int weight;
+};
+
+/**
+ * A task group collects a set of tasks and waits until all of them have
+ * been run. While waiting the calling thread runs queued tasks itself, hence
+ * it's safe to create task groups inside of a task.
+ *
+ * If a task throws an exception all other tasks of the group that haven't
+ * started yet are skipped and wait() throws a Base::Exception with the message
+ * of the first exception.
+ * @author FreeCAD Developers
+ */
+class BaseExport TaskGroup
+{
+public:
+    explicit TaskGroup(CancellationToken* token = 0);
+    /** Waits for the tasks but doesn't throw any exceptions. */
+    ~TaskGroup();
+
+    /** Passes \a task to the scheduler which takes ownership of it. The \a weight
+     * is the number of items the task processes and is used for progress reporting.
+     */
+    void spawn(Task* task, int weight = 1);
+    /** Waits until all tasks have been run. */
+    void wait();
+    bool isCanceled() const;
+
+private:
+    void join();
+    void execute(Task*);
+
+private:
+    TaskGroup(const TaskGroup&);
+    TaskGroup& operator=(const TaskGroup&);
+
+    friend struct TaskSchedulerP;
+    TaskGroupP* d;
+};
+
+/**
+ * The TaskScheduler class is a pool of worker threads shared by all parallel
+ * algorithms of the application. Each worker has its own queue of tasks it
+ * processes in LIFO order and steals from the front of the queues of other
+ * workers once its own queue is exhausted.
+ *
+ * The thread budget limits the number of threads that run tasks at the same
+ * time including the thread waiting for a task group. A budget of 0 means to
+ * use QThread::idealThreadCount() and a budget of 1 runs everything serially.
+ * The worker threads are created on first use; a budget that exceeds the number
+ * of threads created at that time only takes effect after restart.
+ * @author FreeCAD Developers
+ */
+class BaseExport TaskScheduler
+{
+public:
+    static TaskScheduler& Instance(void);
+    static void Destruct(void);
+
+    void setThreadBudget(int);
+    int threadBudget() const;
+    /** Returns the number of threads that currently may run tasks. */
+    int concurrency() const;
+    /** Returns the size of the chunks a range of \a count items should be
+     * split into. If the result is not less than \a count the range should be
+     * processed serially.
+     */
+    std::size_t chunkSize(std::size_t count, std::size_t grainSize) const;
+
+private:
+    TaskScheduler();
+    ~TaskScheduler();
+
+    friend class TaskGroup;
+    TaskSchedulerP* d;
+    static TaskScheduler* _pcSingleton;
+};
+
+namespace Private {
+
+template <class Func>
+class RangeTask : public Task
+{
+public:
+    RangeTask(const Func& f, std::size_t b, std::size_t e)
+        : func(f), first(b), last(e)
+    {
+    }
+    void run()
+    {
+        func(first, last);
+    }
+
+private:
+    Func func;
+    std::size_t first, last;
+};
+
+template <class T, class Func>
+class ReduceTask : public Task
+{
+public:
+    ReduceTask(const Func& f, std::size_t b, std::size_t e, T& r)
+        : func(f), first(b), last(e), result(r)
+    {
+    }
+    void run()
+    {
+        result = func(first, last);
+    }
+
+private:
+    Func func;
+    std::size_t first, last;
+    T& result;
+};
+
+} // namespace Private
+
+/**
+ * Splits the range [\a begin, \a end) into chunks of at least \a grainSize items
+ * and calls \a func(first, last) for each of them in parallel. Each chunk gets
+ * its own copy of \a func.
+ */
+template <class Func>
+void parallel_for(std::size_t begin, std::size_t end, Func func,
+                  std::size_t grainSize = 1, CancellationToken* token = 0)
+{
+    if (begin >= end)
+        return;
+    std::size_t count = end - begin;
+    std::size_t chunk = TaskScheduler::Instance().chunkSize(count, grainSize);
+    if (chunk >= count && !token) {
+        func(begin, end);
+        return;
+    }
+
+    TaskGroup group(token);
+    for (std::size_t first = begin; first < end; first += chunk) {
+        std::size_t last = std::min<std::size_t>(first + chunk, end);
+        group.spawn(new Private::RangeTask<Func>(func, first, last), static_cast<int>(last - first));
+    }
+    group.wait();
+}
+
+/**
+ * Splits the range [\a begin, \a end) into chunks, calls \a func(first, last) for
+ * each of them in parallel and combines the partial results with \a join. The
+ * partial results are joined in the order of the chunks so that the result is
+ * independent of the scheduling.
+ */
+template <class T, class Func, class Join>
+T parallel_reduce(std::size_t begin, std::size_t end, const T& identity, Func func, Join join,
+                  std::size_t grainSize = 1, CancellationToken* token = 0)
+{
+    if (begin >= end)
+        return identity;
+    std::size_t count = end - begin;
+    std::size_t chunk = TaskScheduler::Instance().chunkSize(count, grainSize);
+    if (chunk >= count && !token)
+        return join(identity, func(begin, end));
+
+    std::vector<T> results((count + chunk - 1) / chunk, identity);
+    TaskGroup group(token);
+    std::size_t index = 0;
+    for (std::size_t first = begin; first < end; first += chunk, ++index) {
+        std::size_t last = std::min<std::size_t>(first + chunk, end);
+        group.spawn(new Private::ReduceTask<T, Func>(func, first, last, results[index]),
+                    static_cast<int>(last - first));
+    }
+    group.wait();
+
+    T value = identity;
+    for (typename std::vector<T>::iterator it = results.begin(); it != results.end(); ++it)
+        value = join(value, *it);
+    return value;
+}
+
+} // namespace Base
+
+#endif // BASE_TASKSCHEDULER_H
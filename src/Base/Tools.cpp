@@ -70,6 +70,29 @@ struct string_comp  : public std::binary_function<std::string,
 };
 }
 
+namespace {
+std::string makeNumberedName(const std::string& name, const std::string& num_suffix, int d)
+{
+    std::stringstream str;
+    str << name;
+    if (d > 0) {
+        str.fill('0');
+        str.width(d);
+    }
+    str << Base::string_comp::increment(num_suffix);
+    return str.str();
+}
+
+// splits a name into the part in front of the trailing digits and the digits
+void splitName(const std::string& name, std::string& base, std::string& digits)
+{
+    std::string::size_type pos = name.find_last_not_of("0123456789");
+    pos = (pos == std::string::npos) ? 0 : pos + 1;
+    base = name.substr(0, pos);
+    digits = name.substr(pos);
+}
+}
+
 std::string Base::Tools::getUniqueName(const std::string& name, const std::vector<std::string>& names, int d)
 {
     // find highest suffix
@@ -85,16 +108,77 @@ std::string Base::Tools::getUniqueName(const std::string& name, const std::vecto
         }
     }
 
-    std::stringstream str;
-    str << name;
-    if (d > 0) {
-        str.fill('0');
-        str.width(d);
+    return makeNumberedName(name, num_suffix, d);
+}
+
+// ----------------------------------------------------------------------------
+
+bool Base::UniqueNameManager::SuffixCompare::operator()(const std::string& s1, const std::string& s2) const
+{
+    return Base::string_comp()(s1, s2);
+}
+
+void Base::UniqueNameManager::addName(const std::string& name)
+{
+    std::string base, digits;
+    splitName(name, base, digits);
+    // a name without a numeric suffix doesn't matter for new names
+    if (!digits.empty())
+        suffixes[base].insert(digits);
+}
+
+void Base::UniqueNameManager::removeName(const std::string& name)
+{
+    std::string base, digits;
+    splitName(name, base, digits);
+    if (digits.empty())
+        return;
+    std::map<std::string, SuffixSet>::iterator it = suffixes.find(base);
+    if (it == suffixes.end())
+        return;
+    SuffixSet::iterator jt = it->second.find(digits);
+    if (jt != it->second.end())
+        it->second.erase(jt);
+    if (it->second.empty())
+        suffixes.erase(it);
+}
+
+void Base::UniqueNameManager::clear()
+{
+    suffixes.clear();
+}
+
+std::string Base::UniqueNameManager::makeUniqueName(const std::string& name, int d) const
+{
+    std::string base, digits;
+    splitName(name, base, digits);
+
+    // the names with a numeric suffix after 'name' are 'base' followed by
+    // 'digits' and at least one more digit
+    std::string num_suffix;
+    std::map<std::string, SuffixSet>::const_iterator it = suffixes.find(base);
+    if (it != suffixes.end()) {
+        const SuffixSet& set = it->second;
+        if (digits.empty()) {
+            num_suffix = *set.rbegin();
+        }
+        else {
+            // the shortest digit string that is longer than 'digits'
+            SuffixSet::const_iterator jt = set.lower_bound(std::string(digits.size() + 1, '0'));
+            for (; jt != set.end(); ++jt) {
+                if (jt->compare(0, digits.size(), digits) == 0) {
+                    std::string suffix(jt->substr(digits.size()));
+                    num_suffix = std::max<std::string>(num_suffix, suffix, Base::string_comp());
+                }
+            }
+        }
     }
-    str << Base::string_comp::increment(num_suffix);
-    return str.str();
+
+    return makeNumberedName(name, num_suffix, d);
 }
 
+// ----------------------------------------------------------------------------
+
 std::string Base::Tools::addNumber(const std::string& name, unsigned int num, int d)
 {
     std::stringstream str;
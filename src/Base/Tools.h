@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <map>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -156,6 +158,33 @@ struct BaseExport Tools
     static std::string escapedUnicodeFromUtf8(const char *s);
 };
 
+// ----------------------------------------------------------------------------
+
+/**
+ * Keeps the numeric suffixes of a set of names grouped by the part in front
+ * of the trailing digits. makeUniqueName() returns the same name as
+ * Tools::getUniqueName() does for the whole set, but only looks at the names
+ * that share the base of the given name. The same name can be added several
+ * times, e.g. for labels.
+ */
+class BaseExport UniqueNameManager
+{
+public:
+    void addName(const std::string&);
+    void removeName(const std::string&);
+    void clear();
+    std::string makeUniqueName(const std::string&, int d=0) const;
+
+private:
+    /// orders digit strings by their length first and then lexicographically
+    struct SuffixCompare
+    {
+        bool operator()(const std::string& s1, const std::string& s2) const;
+    };
+    typedef std::multiset<std::string, SuffixCompare> SuffixSet;
+    std::map<std::string, SuffixSet> suffixes;
+};
+
 } // namespace Base
 
 #endif // BASE_TOOLS_H
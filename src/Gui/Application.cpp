@@ -56,6 +56,7 @@
 #include <Base/Exception.h>
 #include <Base/Factory.h>
 #include <Base/FileInfo.h>
+#include <Base/TimeInfo.h>
 #include <Base/Tools.h>
 #include <Base/UnitsApi.h>
 #include <App/Document.h>
@@ -1481,7 +1482,9 @@ static void init_resources()
 void Application::initApplication(void)
 {
     try {
+        Base::TimeInfo timer;
         initTypes();
+        App::Application::addStartupPhase("Register Gui types", Base::TimeInfo::diffTimeF(timer));
         new Base::ScriptProducer( "FreeCADGuiInit", FreeCADGuiInit );
         init_resources();
         old_qtmsg_handler = qInstallMsgHandler(messageHandler);
@@ -1766,9 +1769,13 @@ void Application::runApplication(void)
         mw.startSplasher();
 
     // running the GUI init script
+    Base::TimeInfo timer;
+    // the InitGui.py of each module adds a nested phase
+    std::size_t phase = App::Application::addStartupPhase("Gui init script", 0.0);
     try {
         Base::Console().Log("Run Gui init script\n");
         Base::Interpreter().runString(Base::ScriptFactory().ProduceScript("FreeCADGuiInit"));
+        App::Application::setStartupPhaseDuration(phase, Base::TimeInfo::diffTimeF(timer));
     }
     catch (const Base::Exception& e) {
         Base::Console().Error("Error in FreeCADGuiInit.py: %s\n", e.what());
@@ -1781,6 +1788,11 @@ void Application::runApplication(void)
     mw.stopSplasher();
     mainApp.setActiveWindow(&mw);
 
+    // the remaining observers post their messages to the GUI thread
+    it = cfg.find("AsyncConsole");
+    if (it != cfg.end() && it->second == "1")
+        Base::Console().SetMode(Base::ConsoleSingleton::Asynchronous);
+
     // Activate the correct workbench
     std::string start = App::Application::Config()["StartWorkbench"];
     Base::Console().Log("Init: Activating default workbench %s\n", start.c_str());
@@ -1830,7 +1842,10 @@ void Application::runApplication(void)
     SoDebugError::setHandlerCallback( messageHandlerCoin, 0 );
 #endif
 
+    timer.setCurrent();
     app.activateWorkbench(start.c_str());
+    App::Application::addStartupPhase("Start workbench", Base::TimeInfo::diffTimeF(timer));
+    App::Application::dumpStartupTimeline();
 
 
 
@@ -26,8 +26,11 @@
 #ifndef _PreComp_
 # include <QApplication>
 # include <algorithm>
+# include <set>
+# include <vector>
 # include <boost/signals.hpp>
 # include <boost/bind.hpp>
+# include <QTimer>
 #endif
 
 #include <boost/unordered_set.hpp>
@@ -133,6 +136,13 @@ namespace Gui {
         void addToDocument(ViewProviderIndex*);
         void removeFromDocument(ViewProviderIndex*);
 
+    public:
+        typedef std::vector<ViewProviderDocumentObject*> ViewProviderList;
+
+    private:
+        // cached results of claimChildren() until a link property changes
+        mutable std::map<const ViewProviderDocumentObject*, ViewProviderList> claimed;
+
     public:
         const Gui::Document& d;
         DocumentIndex(const Gui::Document& d) : d(d)
@@ -147,6 +157,11 @@ namespace Gui {
         ViewProviderIndex* cloneViewProvider(const ViewProviderDocumentObject&) const;
         int rowOfViewProvider(const ViewProviderDocumentObject&) const;
         void findViewProviders(const ViewProviderDocumentObject&, QList<ViewProviderIndex*>&) const;
+        bool hasViewProvider(const ViewProviderDocumentObject&) const;
+        const ViewProviderList& claimChildren(const ViewProviderDocumentObject&) const;
+        ViewProviderList shownChildren(const ViewProviderDocumentObject&) const;
+        void invalidateChildren(const ViewProviderDocumentObject&);
+        void removeFromCache(const ViewProviderDocumentObject&);
         QVariant data(int role) const;
     };
 
@@ -161,12 +176,18 @@ namespace Gui {
         const Gui::ViewProviderDocumentObject& v;
         ViewProviderIndex(const Gui::ViewProviderDocumentObject& v, DocumentIndex* d);
         ~ViewProviderIndex();
-        ViewProviderIndex* clone() const;
-        void findViewProviders(const ViewProviderDocumentObject&, QList<ViewProviderIndex*>&) const;
+        DocumentIndex* document() const
+        { return d; }
+        /// the children are only created when the item gets expanded
+        bool isPopulated() const
+        { return populated; }
+        void setPopulated(bool on)
+        { populated = on; }
         QVariant data(int role) const;
 
     private:
         DocumentIndex* d;
+        bool populated;
     };
 
     // ------------------------------------------------------------------------
@@ -211,29 +232,101 @@ namespace Gui {
 
     void DocumentIndex::removeFromDocument(ViewProviderIndex* vp)
     {
-        vp_nodes[&vp->v].erase(vp);
+        std::map<const ViewProviderDocumentObject*, IndexSet>::iterator it;
+        it = vp_nodes.find(&vp->v);
+        if (it != vp_nodes.end()) {
+            it->second.erase(vp);
+            if (it->second.empty())
+                vp_nodes.erase(it);
+        }
     }
 
     ViewProviderIndex*
     DocumentIndex::cloneViewProvider(const ViewProviderDocumentObject& vp) const
     {
-        std::map<const ViewProviderDocumentObject*, boost::unordered_set<ViewProviderIndex*> >::const_iterator it;
-        it = vp_nodes.find(&vp);
-        if (it != vp_nodes.end()) {
-            boost::unordered_set<ViewProviderIndex*>::const_iterator v;
-            v = it->second.begin();
-            return (*v)->clone();
-        }
+        // no need to copy the sub-tree of another occurrence because the
+        // children get created on demand
         return new ViewProviderIndex(vp, const_cast<DocumentIndex*>(this));
     }
 
     void DocumentIndex::findViewProviders(const ViewProviderDocumentObject& vp,
         QList<ViewProviderIndex*>& index) const
     {
-        QList<DocumentModelIndex*>::const_iterator it;
-        for (it = childItems.begin(); it != childItems.end(); ++it) {
-            ViewProviderIndex* v = static_cast<ViewProviderIndex*>(*it);
-            v->findViewProviders(vp, index);
+        std::map<const ViewProviderDocumentObject*, IndexSet>::const_iterator it;
+        it = vp_nodes.find(&vp);
+        if (it != vp_nodes.end()) {
+            for (IndexSet::const_iterator jt = it->second.begin(); jt != it->second.end(); ++jt)
+                index.push_back(*jt);
+        }
+    }
+
+    bool DocumentIndex::hasViewProvider(const ViewProviderDocumentObject& vp) const
+    {
+        return vp_nodes.find(&vp) != vp_nodes.end();
+    }
+
+    const DocumentIndex::ViewProviderList&
+    DocumentIndex::claimChildren(const ViewProviderDocumentObject& vp) const
+    {
+        std::map<const ViewProviderDocumentObject*, ViewProviderList>::iterator it;
+        it = claimed.find(&vp);
+        if (it != claimed.end())
+            return it->second;
+
+        ViewProviderList& views = claimed[&vp];
+        std::vector<App::DocumentObject*> childs = vp.claimChildren();
+        for (std::vector<App::DocumentObject*>::iterator jt = childs.begin(); jt != childs.end(); ++jt) {
+            ViewProvider* view = d.getViewProvider(*jt);
+            if (view && view != &vp && view->getTypeId().isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+                views.push_back(static_cast<ViewProviderDocumentObject*>(view));
+        }
+
+        return views;
+    }
+
+    DocumentIndex::ViewProviderList
+    DocumentIndex::shownChildren(const ViewProviderDocumentObject& vp) const
+    {
+        // the children the model currently knows of: the cached claim and
+        // the items below every expanded occurrence of the object
+        ViewProviderList views;
+        std::map<const ViewProviderDocumentObject*, ViewProviderList>::const_iterator it;
+        it = claimed.find(&vp);
+        if (it != claimed.end())
+            views = it->second;
+
+        std::map<const ViewProviderDocumentObject*, IndexSet>::const_iterator jt;
+        jt = vp_nodes.find(&vp);
+        if (jt != vp_nodes.end()) {
+            for (IndexSet::const_iterator kt = jt->second.begin(); kt != jt->second.end(); ++kt) {
+                if (!(*kt)->isPopulated())
+                    continue;
+                int count = (*kt)->childCount();
+                for (int i=0; i<count; i++) {
+                    ViewProviderIndex* child = static_cast<ViewProviderIndex*>((*kt)->child(i));
+                    ViewProviderDocumentObject* view = const_cast<ViewProviderDocumentObject*>(&child->v);
+                    if (std::find(views.begin(), views.end(), view) == views.end())
+                        views.push_back(view);
+                }
+            }
+        }
+
+        return views;
+    }
+
+    void DocumentIndex::invalidateChildren(const ViewProviderDocumentObject& vp)
+    {
+        claimed.erase(&vp);
+    }
+
+    void DocumentIndex::removeFromCache(const ViewProviderDocumentObject& vp)
+    {
+        // the cached lists of other objects must not keep a dangling pointer
+        claimed.erase(&vp);
+        std::map<const ViewProviderDocumentObject*, ViewProviderList>::iterator it;
+        for (it = claimed.begin(); it != claimed.end(); ++it) {
+            ViewProviderList& views = it->second;
+            views.erase(std::remove(views.begin(), views.end(), &vp), views.end());
         }
     }
 
@@ -274,7 +367,7 @@ namespace Gui {
     // ------------------------------------------------------------------------
 
     ViewProviderIndex::ViewProviderIndex(const Gui::ViewProviderDocumentObject& v, DocumentIndex* d)
-        : v(v),d(d)
+        : v(v),d(d),populated(false)
     {
         if (d) d->addToDocument(this);
     }
@@ -284,28 +377,6 @@ namespace Gui {
         if (d) d->removeFromDocument(this);
     }
 
-    ViewProviderIndex* ViewProviderIndex::clone() const
-    {
-        ViewProviderIndex* copy = new ViewProviderIndex(this->v, this->d);
-        for (QList<DocumentModelIndex*>::const_iterator it = childItems.begin(); it != childItems.end(); ++it) {
-            ViewProviderIndex* c = static_cast<ViewProviderIndex*>(*it)->clone();
-            copy->appendChild(c);
-        }
-        return copy; 
-    }
-
-    void ViewProviderIndex::findViewProviders(const ViewProviderDocumentObject& vp,
-                                              QList<ViewProviderIndex*>& index) const
-    {
-        if (&this->v == &vp)
-            index.push_back(const_cast<ViewProviderIndex*>(this));
-        QList<DocumentModelIndex*>::const_iterator it;
-        for (it = childItems.begin(); it != childItems.end(); ++it) {
-            ViewProviderIndex* v = static_cast<ViewProviderIndex*>(*it);
-            v->findViewProviders(vp, index);
-        }
-    }
-
     QVariant ViewProviderIndex::data(int role) const
     {
         if (role == Qt::DecorationRole) {
@@ -341,7 +412,16 @@ namespace Gui {
         { rootItem = new ApplicationIndex(); }
         ~DocumentModelP()
         { delete rootItem; }
+        typedef boost::BOOST_SIGNALS_NAMESPACE::connection Connection;
         ApplicationIndex *rootItem;
+        // the model can be destroyed before the application and its documents
+        std::vector<Connection> appConnections;
+        std::map<const Gui::Document*, std::vector<Connection> > docConnections;
+        typedef std::set<const ViewProviderDocumentObject*> ObjectSet;
+        // objects whose link properties have changed since the last update,
+        // grouped by document so that closing a document can drop its entries
+        std::map<const Gui::Document*, ObjectSet> pendingObjects;
+        QTimer* updateTimer;
     };
 }
 
@@ -360,27 +440,42 @@ DocumentModel::DocumentModel(QObject* parent)
     }
 
     // Setup connections
-    Application::Instance->signalNewDocument.connect(boost::bind(&DocumentModel::slotNewDocument, this, _1));
-    Application::Instance->signalDeleteDocument.connect(boost::bind(&DocumentModel::slotDeleteDocument, this, _1));
-    Application::Instance->signalRenameDocument.connect(boost::bind(&DocumentModel::slotRenameDocument, this, _1));
-    Application::Instance->signalActiveDocument.connect(boost::bind(&DocumentModel::slotActiveDocument, this, _1));
-    Application::Instance->signalRelabelDocument.connect(boost::bind(&DocumentModel::slotRelabelDocument, this, _1));
+    std::vector<DocumentModelP::Connection>& conn = d->appConnections;
+    conn.push_back(Application::Instance->signalNewDocument.connect(boost::bind(&DocumentModel::slotNewDocument, this, _1)));
+    conn.push_back(Application::Instance->signalDeleteDocument.connect(boost::bind(&DocumentModel::slotDeleteDocument, this, _1)));
+    conn.push_back(Application::Instance->signalRenameDocument.connect(boost::bind(&DocumentModel::slotRenameDocument, this, _1)));
+    conn.push_back(Application::Instance->signalActiveDocument.connect(boost::bind(&DocumentModel::slotActiveDocument, this, _1)));
+    conn.push_back(Application::Instance->signalRelabelDocument.connect(boost::bind(&DocumentModel::slotRelabelDocument, this, _1)));
+
+    d->updateTimer = new QTimer(this);
+    d->updateTimer->setSingleShot(true);
+    d->updateTimer->setInterval(0);
+    connect(d->updateTimer, SIGNAL(timeout()), this, SLOT(onUpdateChildren()));
 }
 
 DocumentModel::~DocumentModel()
 {
+    std::vector<DocumentModelP::Connection>::iterator it;
+    for (it = d->appConnections.begin(); it != d->appConnections.end(); ++it)
+        it->disconnect();
+    std::map<const Gui::Document*, std::vector<DocumentModelP::Connection> >::iterator jt;
+    for (jt = d->docConnections.begin(); jt != d->docConnections.end(); ++jt) {
+        for (it = jt->second.begin(); it != jt->second.end(); ++it)
+            it->disconnect();
+    }
     delete d; d = 0;
 }
 
 void DocumentModel::slotNewDocument(const Gui::Document& Doc)
 {
-    Doc.signalNewObject.connect(boost::bind(&DocumentModel::slotNewObject, this, _1));
-    Doc.signalDeletedObject.connect(boost::bind(&DocumentModel::slotDeleteObject, this, _1));
-    Doc.signalChangedObject.connect(boost::bind(&DocumentModel::slotChangeObject, this, _1, _2));
-    Doc.signalRenamedObject.connect(boost::bind(&DocumentModel::slotRenameObject, this, _1));
-    Doc.signalActivatedObject.connect(boost::bind(&DocumentModel::slotActiveObject, this, _1));
-    Doc.signalInEdit.connect(boost::bind(&DocumentModel::slotInEdit, this, _1));
-    Doc.signalResetEdit.connect(boost::bind(&DocumentModel::slotResetEdit, this, _1));
+    std::vector<DocumentModelP::Connection>& conn = d->docConnections[&Doc];
+    conn.push_back(Doc.signalNewObject.connect(boost::bind(&DocumentModel::slotNewObject, this, _1)));
+    conn.push_back(Doc.signalDeletedObject.connect(boost::bind(&DocumentModel::slotDeleteObject, this, _1)));
+    conn.push_back(Doc.signalChangedObject.connect(boost::bind(&DocumentModel::slotChangeObject, this, _1, _2)));
+    conn.push_back(Doc.signalRenamedObject.connect(boost::bind(&DocumentModel::slotRenameObject, this, _1)));
+    conn.push_back(Doc.signalActivatedObject.connect(boost::bind(&DocumentModel::slotActiveObject, this, _1)));
+    conn.push_back(Doc.signalInEdit.connect(boost::bind(&DocumentModel::slotInEdit, this, _1)));
+    conn.push_back(Doc.signalResetEdit.connect(boost::bind(&DocumentModel::slotResetEdit, this, _1)));
 
     QModelIndex parent = createIndex(0,0,d->rootItem);
     int count_docs = d->rootItem->childCount();
@@ -391,6 +486,10 @@ void DocumentModel::slotNewDocument(const Gui::Document& Doc)
 
 void DocumentModel::slotDeleteDocument(const Gui::Document& Doc)
 {
+    // the view providers are destroyed without a signalDeletedObject
+    d->pendingObjects.erase(&Doc);
+    d->docConnections.erase(&Doc);
+
     int row = d->rootItem->findChild(Doc);
     if (row > -1) {
         QModelIndex parent = createIndex(0,0,d->rootItem);
@@ -453,9 +552,15 @@ void DocumentModel::slotDeleteObject(const Gui::ViewProviderDocumentObject& obj)
 {
     App::Document* doc = obj.getObject()->getDocument();
     Gui::Document* gdc = Application::Instance->getDocument(doc);
+    std::map<const Gui::Document*, DocumentModelP::ObjectSet>::iterator pending;
+    pending = d->pendingObjects.find(gdc);
+    if (pending != d->pendingObjects.end())
+        pending->second.erase(&obj);
     int row = d->rootItem->findChild(*gdc);
     if (row > -1) {
         DocumentIndex* doc_index = static_cast<DocumentIndex*>(d->rootItem->child(row));
+        doc_index->removeFromCache(obj);
+
         QList<ViewProviderIndex*> views;
         doc_index->findViewProviders(obj, views);
         for (QList<ViewProviderIndex*>::iterator it = views.begin(); it != views.end(); ++it) {
@@ -491,51 +596,108 @@ void DocumentModel::slotChangeObject(const Gui::ViewProviderDocumentObject& obj,
         }
     }
     else if (isPropertyLink(Prop)) {
+        // collect the changes and update the tree structure only once
         App::Document* doc = fea->getDocument();
         Gui::Document* gdc = Application::Instance->getDocument(doc);
-        std::vector<ViewProviderDocumentObject*> views = claimChildren(*gdc, obj);
+        d->pendingObjects[gdc].insert(&obj);
+        if (!d->updateTimer->isActive())
+            d->updateTimer->start();
+    }
+}
 
-        int row = d->rootItem->findChild(*gdc);
-        if (row > -1) {
-            QList<DocumentModelIndex*> del_items;
-            DocumentIndex* doc_index = static_cast<DocumentIndex*>(d->rootItem->child(row));
-            for (std::vector<ViewProviderDocumentObject*>::iterator vp = views.begin(); vp != views.end(); ++vp) {
-                int row = doc_index->rowOfViewProvider(**vp);
-                // is it a top-level child in the document
-                if (row >= 0) {
-                    DocumentModelIndex* child = doc_index->child(row);
-                    del_items.push_back(child);
-                    QModelIndex parent = createIndex(doc_index->row(), 0, doc_index);
-                    beginRemoveRows(parent, row, row);
-                    doc_index->removeChild(row);
-                    endRemoveRows();
-                }
-            }
+void DocumentModel::onUpdateChildren()
+{
+    std::map<const Gui::Document*, DocumentModelP::ObjectSet> objects;
+    objects.swap(d->pendingObjects);
+    std::map<const Gui::Document*, DocumentModelP::ObjectSet>::iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it) {
+        int row = d->rootItem->findChild(*it->first);
+        if (row < 0)
+            continue;
+        DocumentIndex* doc_index = static_cast<DocumentIndex*>(d->rootItem->child(row));
+        for (DocumentModelP::ObjectSet::iterator jt = it->second.begin(); jt != it->second.end(); ++jt)
+            updateChildren(doc_index, **jt);
+    }
+}
 
-            // get all occurrences of the view provider in the tree structure
-            QList<ViewProviderIndex*> obj_index;
-            doc_index->findViewProviders(obj, obj_index);
-            for (QList<ViewProviderIndex*>::iterator it = obj_index.begin(); it != obj_index.end(); ++it) {
-                QModelIndex parent = createIndex((*it)->row(),0,*it);
-                int count_obj = (*it)->childCount();
-                beginRemoveRows(parent, 0, count_obj);
-                // remove all children but do not yet delete them
-                QList<DocumentModelIndex*> items = (*it)->removeAll();
-                endRemoveRows();
-
-                beginInsertRows(parent, 0, (int)views.size());
-                for (std::vector<ViewProviderDocumentObject*>::iterator vp = views.begin(); vp != views.end(); ++vp) {
-                    ViewProviderIndex* clone = doc_index->cloneViewProvider(**vp);
-                    (*it)->appendChild(clone);
-                }
-                endInsertRows();
+void DocumentModel::updateChildren(DocumentIndex* doc_index, const ViewProviderDocumentObject& obj)
+{
+    // compare with what the model shows, the link has already changed
+    DocumentIndex::ViewProviderList old_views = doc_index->shownChildren(obj);
+    doc_index->invalidateChildren(obj);
+    const DocumentIndex::ViewProviderList& views = doc_index->claimChildren(obj);
+
+    // remove the claimed objects from the top-level of the document
+    QModelIndex doc_parent = createIndex(doc_index->row(), 0, doc_index);
+    for (DocumentIndex::ViewProviderList::const_iterator vp = views.begin(); vp != views.end(); ++vp) {
+        int row = doc_index->rowOfViewProvider(**vp);
+        if (row >= 0) {
+            DocumentModelIndex* child = doc_index->child(row);
+            beginRemoveRows(doc_parent, row, row);
+            doc_index->removeChild(row);
+            endRemoveRows();
+            delete child;
+        }
+    }
+
+    // get all occurrences of the view provider in the tree structure
+    bool layout = false;
+    QList<ViewProviderIndex*> obj_index;
+    doc_index->findViewProviders(obj, obj_index);
+    for (QList<ViewProviderIndex*>::iterator it = obj_index.begin(); it != obj_index.end(); ++it) {
+        // not yet expanded items get their children when needed
+        if (!(*it)->isPopulated()) {
+            layout = true;
+            continue;
+        }
 
-                del_items.append(items);
+        QModelIndex parent = createIndex((*it)->row(),0,*it);
+        int count_obj = (*it)->childCount();
+        if (count_obj > 0) {
+            beginRemoveRows(parent, 0, count_obj-1);
+            QList<DocumentModelIndex*> items = (*it)->removeAll();
+            endRemoveRows();
+            qDeleteAll(items);
+        }
+
+        if (!views.empty()) {
+            beginInsertRows(parent, 0, (int)views.size()-1);
+            for (DocumentIndex::ViewProviderList::const_iterator vp = views.begin(); vp != views.end(); ++vp) {
+                ViewProviderIndex* clone = doc_index->cloneViewProvider(**vp);
+                (*it)->appendChild(clone);
             }
+            endInsertRows();
+        }
+    }
+
+    // objects that are not claimed by any other object go back to the top-level
+    for (DocumentIndex::ViewProviderList::iterator vp = old_views.begin(); vp != old_views.end(); ++vp) {
+        if (std::find(views.begin(), views.end(), *vp) != views.end())
+            continue;
+        bool claimed = false;
+        std::vector<App::DocumentObject*> inList = (*vp)->getObject()->getInList();
+        for (std::vector<App::DocumentObject*>::iterator jt = inList.begin(); jt != inList.end() && !claimed; ++jt) {
+            ViewProvider* view = doc_index->d.getViewProvider(*jt);
+            if (view && view->getTypeId().isDerivedFrom(ViewProviderDocumentObject::getClassTypeId())) {
+                const DocumentIndex::ViewProviderList& other = doc_index->claimChildren
+                    (static_cast<ViewProviderDocumentObject&>(*view));
+                claimed = (std::find(other.begin(), other.end(), *vp) != other.end());
+            }
+        }
 
-            qDeleteAll(del_items);
+        if (!claimed && doc_index->rowOfViewProvider(**vp) < 0) {
+            int count_obj = doc_index->childCount();
+            beginInsertRows(doc_parent, count_obj, count_obj);
+            doc_index->appendChild(new ViewProviderIndex(**vp, doc_index));
+            endInsertRows();
         }
     }
+
+    // the expand indicator of collapsed items may have changed
+    if (layout) {
+        layoutAboutToBeChanged();
+        layoutChanged();
+    }
 }
 
 void DocumentModel::slotRenameObject(const Gui::ViewProviderDocumentObject& obj)
@@ -576,20 +738,6 @@ bool DocumentModel::isPropertyLink(const App::Property& prop) const
     return false;
 }
 
-std::vector<ViewProviderDocumentObject*>
-DocumentModel::claimChildren(const Gui::Document& doc, const ViewProviderDocumentObject& obj) const
-{
-    std::vector<ViewProviderDocumentObject*> views;
-    std::vector<App::DocumentObject*> childs = obj.claimChildren();
-    for (std::vector<App::DocumentObject*>::iterator it = childs.begin(); it != childs.end(); ++it) {
-        ViewProvider* view = doc.getViewProvider(*it);
-        if (view && view->getTypeId().isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
-            views.push_back(static_cast<ViewProviderDocumentObject*>(view));
-    }
-
-    return views;
-}
-
 int DocumentModel::columnCount (const QModelIndex & /*parent*/) const
 {
     return 1;
@@ -650,6 +798,48 @@ int DocumentModel::rowCount (const QModelIndex & parent) const
     return item->childCount();
 }
 
+bool DocumentModel::hasChildren (const QModelIndex & parent) const
+{
+    if (!parent.isValid())
+        return true; // the root item
+    DocumentModelIndex* item = 0;
+    item = static_cast<DocumentModelIndex*>(parent.internalPointer());
+    if (item->getTypeId() == ViewProviderIndex::getClassTypeId()) {
+        ViewProviderIndex* vp = static_cast<ViewProviderIndex*>(item);
+        if (!vp->isPopulated())
+            return !vp->document()->claimChildren(vp->v).empty();
+    }
+    return item->childCount() > 0;
+}
+
+bool DocumentModel::canFetchMore (const QModelIndex & parent) const
+{
+    if (!parent.isValid())
+        return false;
+    DocumentModelIndex* item = 0;
+    item = static_cast<DocumentModelIndex*>(parent.internalPointer());
+    if (item->getTypeId() == ViewProviderIndex::getClassTypeId())
+        return !static_cast<ViewProviderIndex*>(item)->isPopulated();
+    return false;
+}
+
+void DocumentModel::fetchMore (const QModelIndex & parent)
+{
+    if (!canFetchMore(parent))
+        return;
+    ViewProviderIndex* item = static_cast<ViewProviderIndex*>(parent.internalPointer());
+    DocumentIndex* doc_index = item->document();
+    item->setPopulated(true);
+
+    const DocumentIndex::ViewProviderList& views = doc_index->claimChildren(item->v);
+    if (views.empty())
+        return;
+    beginInsertRows(parent, 0, (int)views.size()-1);
+    for (DocumentIndex::ViewProviderList::const_iterator vp = views.begin(); vp != views.end(); ++vp)
+        item->appendChild(doc_index->cloneViewProvider(**vp));
+    endInsertRows();
+}
+
 QVariant DocumentModel::headerData (int section, Qt::Orientation orientation, int role) const
 {
     if (orientation == Qt::Horizontal) {
@@ -665,3 +855,5 @@ bool DocumentModel::setHeaderData (int, Qt::Orientation, const QVariant &, int)
 {
     return false;
 }
+
+#include "moc_DocumentModel.cpp"
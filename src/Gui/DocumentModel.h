@@ -35,8 +35,18 @@ namespace Gui {
 class Document;
 class ViewProviderDocumentObject;
 
+class DocumentIndex;
+
+/** Item model of the documents and their objects.
+ * The children of an object are not created before the view asks for them,
+ * i.e. when the item gets expanded. Structural changes caused by modified
+ * link properties are collected and processed once in the next turn of the
+ * event loop.
+ */
 class DocumentModel : public QAbstractItemModel
 {
+    Q_OBJECT
+
 public:
     DocumentModel(QObject* parent);
     virtual ~DocumentModel();
@@ -48,9 +58,15 @@ public:
     QModelIndex index (int row, int column, const QModelIndex & parent = QModelIndex()) const;
     QModelIndex parent (const QModelIndex & index) const;
     int rowCount (const QModelIndex & parent = QModelIndex()) const;
+    bool hasChildren (const QModelIndex & parent = QModelIndex()) const;
+    bool canFetchMore (const QModelIndex & parent) const;
+    void fetchMore (const QModelIndex & parent);
     QVariant headerData (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
     bool setHeaderData (int section, Qt::Orientation orientation, const QVariant & value, int role = Qt::EditRole);
 
+private Q_SLOTS:
+    void onUpdateChildren();
+
 private:
     void slotNewDocument(const Gui::Document&);
     void slotDeleteDocument(const Gui::Document&);
@@ -67,8 +83,7 @@ private:
 
     const Document* getDocument(const QModelIndex&) const;
     bool isPropertyLink(const App::Property&) const;
-    std::vector<ViewProviderDocumentObject*> claimChildren
-        (const Document&, const ViewProviderDocumentObject&) const;
+    void updateChildren(DocumentIndex*, const ViewProviderDocumentObject&);
 
 private:
     struct DocumentModelP *d;
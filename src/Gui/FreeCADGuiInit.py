@@ -97,8 +97,68 @@ class NoneWorkbench ( Workbench ):
 		"""Return the name of the associated C++ class."""
 		return "Gui::NoneWorkbench"
 
+class ManifestWorkbench ( Workbench ):
+	"""Stands in for a workbench declared in the Manifest.cfg of a module.
+The InitGui.py of the module is run when the workbench gets activated the
+first time and the workbench added there takes over this object.
+	"""
+	def Initialize(self):
+		"""Load the real workbench and initialize it."""
+		import os,time
+		StartTime = time.time()
+		InstallFile = os.path.join(self.ModuleDir,"InitGui.py")
+		self.Handler = None
+		self.AddWorkbench = Gui.addWorkbench
+		Gui.addWorkbench = self.catchWorkbench
+		try:
+			exec open(InstallFile).read() in globals().copy()
+		finally:
+			Gui.addWorkbench = self.AddWorkbench
+		Handler = self.Handler
+		del self.Handler
+		del self.AddWorkbench
+		if Handler is None:
+			raise RuntimeError(InstallFile + " doesn't add the workbench " + self.__class__.__name__)
+		Log('Init: Loading ' + InstallFile + ' on demand... done (%.3f s)\n' % (time.time()-StartTime))
+		# the C++ workbench may be already attached to this object
+		self.__class__ = Handler.__class__
+		self.__dict__.update(Handler.__dict__)
+		self.Initialize()
+	def catchWorkbench(self, wb):
+		"""Keep the declared workbench and add all others."""
+		if hasattr(wb, "__bases__"):
+			wb = wb()
+		if wb.__class__.__name__ == self.__class__.__name__:
+			self.Handler = wb
+		else:
+			self.AddWorkbench(wb)
+	def GetClassName(self):
+		"""Return the name of the associated C++ class."""
+		return self.ClassName
+
+def InitManifest(Dir, ManifestFile):
+	"""Adds the workbench declared in the Manifest.cfg of a module without
+	running its InitGui.py. Returns False if there is no such workbench."""
+	import os,types,ConfigParser
+	Manifest = ConfigParser.RawConfigParser()
+	Manifest.optionxform = str
+	Manifest.read(ManifestFile)
+	if not Manifest.has_section("Workbench"):
+		return False
+	Options = dict(Manifest.items("Workbench"))
+	Members = {}
+	Members["ModuleDir"] = Dir
+	Members["ClassName"] = Options.get("ClassName","Gui::PythonWorkbench")
+	Members["MenuText"] = Options.get("MenuText","")
+	Members["ToolTip"] = Options.get("ToolTip","")
+	if "Icon" in Options:
+		Members["Icon"] = os.path.join(Dir,Options["Icon"])
+	Handler = types.ClassType(Options["Name"],(ManifestWorkbench,),Members)
+	Gui.addWorkbench(Handler())
+	return True
+
 def InitApplications():
-	import sys,os
+	import sys,os,time
 	# Searching modules dirs +++++++++++++++++++++++++++++++++++++++++++++++++++
 	# (additional module paths are already cached)
 	ModDirs = FreeCAD.__path__
@@ -106,8 +166,19 @@ def InitApplications():
 	Log('Init:   Searching modules...\n')
 	for Dir in ModDirs:
 		if ((Dir != '') & (Dir != 'CVS') & (Dir != '__init__.py')):
+			ManifestFile = os.path.join(Dir,"Manifest.cfg")
 			InstallFile = os.path.join(Dir,"InitGui.py")
-			if (os.path.exists(InstallFile)):
+			StartTime = time.time()
+			Deferred = False
+			if (os.path.exists(ManifestFile)):
+				try:
+					Deferred = InitManifest(Dir,ManifestFile)
+				except Exception, inst:
+					Err('During initialization the error ' + str(inst) + ' occurred in ' + ManifestFile + '\n')
+			if Deferred:
+				InstallFile = ManifestFile
+				Log('Init:      Initializing ' + Dir + ' from manifest... done\n')
+			elif (os.path.exists(InstallFile)):
 				try:
 					#execfile(InstallFile)
 					exec open(InstallFile).read()
@@ -118,6 +189,8 @@ def InitApplications():
 					Log('Init:      Initializing ' + Dir + '... done\n')
 			else:
 				Log('Init:      Initializing ' + Dir + '(InitGui.py not found)... ignore\n')
+				continue
+			FreeCAD.addStartupPhase(os.path.join(os.path.basename(Dir),os.path.basename(InstallFile)),time.time()-StartTime,1)
 
 
 Log ('Init: Running FreeCADGuiInit.py start script...\n')
@@ -147,6 +220,7 @@ FreeCAD.addExportType("3D View (*.svg)","FreeCADGui")
 FreeCAD.addExportType("Portable Document Format (*.pdf)","FreeCADGui")
 
 del(InitApplications)
+del(InitManifest)
 del(NoneWorkbench)
 del(StandardWorkbench)
 
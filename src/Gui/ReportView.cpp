@@ -523,12 +523,15 @@ void ReportOutput::OnChange(Base::Subject<const char*> &rCaller, const char * sR
     ParameterGrp& rclGrp = ((ParameterGrp&)rCaller);
     if (strcmp(sReason, "checkLogging") == 0) {
         bLog = rclGrp.GetBool( sReason, bLog );
+        Base::Console().UpdateEnabledTypes();
     }
     else if (strcmp(sReason, "checkWarning") == 0) {
         bWrn = rclGrp.GetBool( sReason, bWrn );
+        Base::Console().UpdateEnabledTypes();
     }
     else if (strcmp(sReason, "checkError") == 0) {
         bErr = rclGrp.GetBool( sReason, bErr );
+        Base::Console().UpdateEnabledTypes();
     }
     else if (strcmp(sReason, "colorText") == 0) {
         unsigned long col = rclGrp.GetUnsigned( sReason );
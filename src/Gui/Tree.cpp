@@ -47,6 +47,7 @@
 #include <App/GeoFeatureGroup.h>
 
 #include "Tree.h"
+#include "TreeView.h"
 #include "Document.h"
 #include "BitmapFactory.h"
 #include "ViewProviderDocumentObject.h"
@@ -112,7 +113,11 @@ TreeWidget::TreeWidget(QWidget* parent)
     this->setMouseTracking(true); // needed for itemEntered() to work
 #endif
 
+    // the status of the items is only tested on demand, i.e. when an object
+    // was touched, recomputed or its visibility changed
     this->statusTimer = new QTimer(this);
+    this->statusTimer->setSingleShot(true);
+    this->statusTimer->setInterval(0);
 
     connect(this->statusTimer, SIGNAL(timeout()),
             this, SLOT(onTestStatus()));
@@ -125,8 +130,6 @@ TreeWidget::TreeWidget(QWidget* parent)
     connect(this, SIGNAL(itemSelectionChanged()),
             this, SLOT(onItemSelectionChanged()));
 
-    this->statusTimer->setSingleShot(true);
-    this->statusTimer->start(300);
     documentPixmap = new QPixmap(Gui::BitmapFactory().pixmap("Document"));
 }
 
@@ -655,17 +658,21 @@ void TreeWidget::slotActiveDocument(const Gui::Document& Doc)
 }
 
 
+void TreeWidget::scheduleTestStatus()
+{
+    if (!this->statusTimer->isActive())
+        this->statusTimer->start();
+}
+
 void TreeWidget::onTestStatus(void)
 {
+    // if hidden the dirty items are kept until the widget is shown again
     if (isVisible()) {
         std::map<const Gui::Document*,DocumentItem*>::iterator pos;
         for (pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
             pos->second->testStatus();
         }
     }
-
-    this->statusTimer->setSingleShot(true);
-    this->statusTimer->start(300);
 }
 
 void TreeWidget::onItemEntered(QTreeWidgetItem * item)
@@ -721,6 +728,12 @@ void TreeWidget::changeEvent(QEvent *e)
     QTreeWidget::changeEvent(e);
 }
 
+void TreeWidget::showEvent(QShowEvent *e)
+{
+    QTreeWidget::showEvent(e);
+    scheduleTestStatus();
+}
+
 void TreeWidget::onItemSelectionChanged ()
 {
     // we already got notified by the selection to update the tree items
@@ -830,9 +843,13 @@ TreeDockWidget::TreeDockWidget(Gui::Document* pcDocument,QWidget *parent)
   : DockWindow(pcDocument,parent)
 {
     setWindowTitle(tr("Tree view"));
-    this->treeWidget = new TreeWidget(this);
-    this->treeWidget->setRootIsDecorated(false);
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/TreeView");
+    // the model based tree view creates the items of an object on demand
+    if (hGrp->GetBool("UseDocumentModel", false))
+        this->treeWidget = new TreeView(this);
+    else
+        this->treeWidget = new TreeWidget(this);
+    this->treeWidget->setRootIsDecorated(false);
     this->treeWidget->setIndentation(hGrp->GetInt("Indentation", this->treeWidget->indentation()));
 
     QGridLayout* pLayout = new QGridLayout(this);
@@ -860,6 +877,9 @@ DocumentItem::DocumentItem(const Gui::Document* doc, QTreeWidgetItem * parent)
     connectResObject = doc->signalResetEdit.connect(boost::bind(&DocumentItem::slotResetEdit, this, _1));
     connectHltObject = doc->signalHighlightObject.connect(boost::bind(&DocumentItem::slotHighlightObject, this, _1,_2,_3));
     connectExpObject = doc->signalExpandObject.connect(boost::bind(&DocumentItem::slotExpandObject, this, _1,_2));
+    connectTchObject = doc->getDocument()->signalTouchedObject.connect(boost::bind(&DocumentItem::slotStatusObject, this, _1));
+    connectRecObject = doc->getDocument()->signalRecomputedObject.connect(boost::bind(&DocumentItem::slotStatusObject, this, _1));
+    connectVisObject = Application::Instance->signalChangedObject.connect(boost::bind(&DocumentItem::slotChangeViewObject, this, _1, _2));
 
     setFlags(Qt::ItemIsEnabled/*|Qt::ItemIsEditable*/);
 }
@@ -875,6 +895,9 @@ DocumentItem::~DocumentItem()
     connectResObject.disconnect();
     connectHltObject.disconnect();
     connectExpObject.disconnect();
+    connectTchObject.disconnect();
+    connectRecObject.disconnect();
+    connectVisObject.disconnect();
 }
 
 
@@ -909,6 +932,7 @@ void DocumentItem::slotNewObject(const Gui::ViewProviderDocumentObject& obj)
             item->setIcon(0, obj.getIcon());
             item->setText(0, QString::fromUtf8(displayName.c_str()));
             ObjectMap[objectName] = item;
+            markStatusDirty(item);
         }else {
             Base::Console().Warning("DocumentItem::slotNewObject: Cannot add view provider twice.\n");
         }
@@ -950,6 +974,7 @@ void DocumentItem::slotDeleteObject(const Gui::ViewProviderDocumentObject& view)
         }
 
         parent->takeChild(parent->indexOfChild(it->second));
+        DirtyItems.erase(it->second);
         delete it->second;
         ObjectMap.erase(it);
     }
@@ -1045,6 +1070,9 @@ void DocumentItem::slotChangeObject(const Gui::ViewProviderDocumentObject& view)
             // set the text label
             std::string displayName = obj->Label.getValue();
             parent_of_group->setText(0, QString::fromUtf8(displayName.c_str()));
+
+            // a changed property touches the object
+            markStatusDirty(parent_of_group);
     }
     else {
         Base::Console().Warning("Gui::DocumentItem::slotChangedObject(): Cannot change unknown object.\n");
@@ -1176,10 +1204,42 @@ const Gui::Document* DocumentItem::document() const
 //    }
 //}
 
+void DocumentItem::slotStatusObject(const App::DocumentObject& obj)
+{
+    const char* objectName = obj.getNameInDocument();
+    if (!objectName)
+        return;
+    std::map<std::string, DocumentObjectItem*>::iterator it = ObjectMap.find(objectName);
+    if (it != ObjectMap.end())
+        markStatusDirty(it->second);
+}
+
+void DocumentItem::slotChangeViewObject(const Gui::ViewProvider& view, const App::Property& prop)
+{
+    // only the visibility of the view provider affects the status of the item
+    if (!view.isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+        return;
+    const ViewProviderDocumentObject& vp = static_cast<const ViewProviderDocumentObject&>(view);
+    if (&prop != &vp.Visibility)
+        return;
+    App::DocumentObject* obj = vp.getObject();
+    if (obj && obj->getDocument() == pDocument->getDocument())
+        slotStatusObject(*obj);
+}
+
+void DocumentItem::markStatusDirty(DocumentObjectItem* item)
+{
+    if (DirtyItems.insert(item).second)
+        static_cast<TreeWidget*>(treeWidget())->scheduleTestStatus();
+}
+
 void DocumentItem::testStatus(void)
 {
-    for (std::map<std::string,DocumentObjectItem*>::iterator pos = ObjectMap.begin();pos!=ObjectMap.end();++pos) {
-        pos->second->testStatus();
+    // take the current items because testing the status may mark them again
+    std::set<DocumentObjectItem*> items;
+    items.swap(DirtyItems);
+    for (std::set<DocumentObjectItem*>::iterator pos = items.begin();pos!=items.end();++pos) {
+        (*pos)->testStatus();
     }
 }
 
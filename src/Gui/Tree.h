@@ -73,6 +73,11 @@ public:
     static const int ObjectType;
 
     void markItem(const App::DocumentObject* Obj,bool mark);
+    /** Requests a status update of the dirty items of all documents.
+     * Multiple requests are coalesced and handled once in the next turn of
+     * the event loop.
+     */
+    void scheduleTestStatus();
 
 protected:
     /// Observer message from the Selection
@@ -117,6 +122,7 @@ private:
     void slotRelabelDocument(const Gui::Document&);
 
     void changeEvent(QEvent *e);
+    void showEvent(QShowEvent *e);
 
 private:
     QAction* createGroupAction;
@@ -148,6 +154,7 @@ public:
     void clearSelection(void);
     void updateSelection(void);
     void selectItems(void);
+    /// Updates the status icons of all items that have been marked as dirty
     void testStatus(void);
     void setData(int column, int role, const QVariant & value);
 
@@ -167,11 +174,18 @@ protected:
     void slotResetEdit       (const Gui::ViewProviderDocumentObject&);
     void slotHighlightObject (const Gui::ViewProviderDocumentObject&,const Gui::HighlightMode&,bool);
     void slotExpandObject    (const Gui::ViewProviderDocumentObject&,const Gui::TreeItemMode&);
+    /** Marks the item of the given object as dirty if the object was touched,
+     * recomputed or its view provider changed the visibility.
+     */
+    void slotStatusObject    (const App::DocumentObject&);
+    void slotChangeViewObject(const Gui::ViewProvider&, const App::Property&);
+    void markStatusDirty(DocumentObjectItem*);
     std::vector<DocumentObjectItem*> getAllParents(DocumentObjectItem*) const;
 
 private:
     const Gui::Document* pDocument;
     std::map<std::string,DocumentObjectItem*> ObjectMap;
+    std::set<DocumentObjectItem*> DirtyItems;
 
     typedef boost::BOOST_SIGNALS_NAMESPACE::connection Connection;
     Connection connectNewObject;
@@ -183,6 +197,9 @@ private:
     Connection connectResObject;
     Connection connectHltObject;
     Connection connectExpObject;
+    Connection connectTchObject;
+    Connection connectRecObject;
+    Connection connectVisObject;
 };
 
 /** The link between the tree and a document object.
@@ -235,7 +252,7 @@ public:
     ~TreeDockWidget();
 
 private:
-    QTreeWidget* treeWidget;
+    QTreeView* treeWidget;
 };
 
 }
@@ -49,6 +49,7 @@
 #include "DlgCustomizeSpNavSettings.h"
 #include "InputField.h"
 #include "QuantitySpinBox.h"
+#include "TreeView.h"
 
 using namespace Gui;
 using namespace Gui::Dialog;
@@ -104,4 +105,5 @@ WidgetFactorySupplier::WidgetFactorySupplier()
     new WidgetProducer<Gui::FileChooser>;
     new WidgetProducer<Gui::UIntSpinBox>;
     new WidgetProducer<Gui::QuantitySpinBox>;
+    new WidgetProducer<Gui::TreeView>;
 }
@@ -36,8 +36,27 @@
 #endif // HAVE_CONFIG_H
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
 #include <sstream>
 #include <iostream>
+#include <set>
+#include <vector>
+
+#if defined(FC_OS_LINUX) || defined(FC_OS_MACOSX) || defined(FC_OS_BSD)
+# define FC_WORKER_SOCKET
+# include <unistd.h>
+# include <sys/socket.h>
+# include <sys/types.h>
+# include <sys/un.h>
+# include <sys/wait.h>
+#endif
+
+#if defined(__GLIBC__)
+# include <malloc.h>
+#endif
 
 // FreeCAD Base header
 #include <Base/Console.h>
@@ -45,9 +64,14 @@
 #include <Base/Parameter.h>
 #include <Base/Exception.h>
 #include <Base/Factory.h>
+#include <Base/FileInfo.h>
+#include <Base/TimeInfo.h>
+#include <CXX/Objects.hxx>
 
 // FreeCAD doc header
 #include <App/Application.h>
+#include <App/Document.h>
+#include <App/DocumentObject.h>
 
 
 using Base::Console;
@@ -64,6 +88,444 @@ const char sBanner[] = "(c) Juergen Riegel, Werner Mayer, Yorik van Havre 2001-2
 
 
 
+
+// Worker mode ===========================================================
+//
+// With --worker FreeCADCmd stays alive after start-up and processes jobs read
+// from stdin, with --worker-socket=<path> it processes jobs sent over a local
+// socket instead. Each job is a line with the input file and, optionally
+// separated by a tab, the output file:
+//
+//   <input file>[\t<output file>]
+//
+// The input file is opened or imported into a new document which is
+// recomputed, saved or exported to the output file (the file extension selects
+// the module) and closed. Every job is answered with a line:
+//
+//   ok\t<seconds>\t<input file>
+//   error\t<seconds>\t<input file>\t<message>
+//
+// The line 'quit' ends the worker, or the connection when using a socket.
+// With --worker-slots=<n> the socket is served by n forked processes so that
+// jobs run in parallel, each in its own process with its own documents.
+
+namespace {
+
+class WorkerJob
+{
+public:
+    WorkerJob(const std::string& line) : succeeded(false)
+    {
+        std::string::size_type pos = line.find('\t');
+        input = line.substr(0, pos);
+        if (pos != std::string::npos)
+            output = line.substr(pos + 1);
+    }
+
+    /// Runs the job and returns the reply line
+    std::string run()
+    {
+        Base::TimeInfo start;
+        std::string error;
+
+        // Opening a document can fail after it has been registered, and
+        // importers may open further documents. All documents that are not
+        // open yet now are closed after the job.
+        std::vector<App::Document*> docs = App::GetApplication().getDocuments();
+        for (std::vector<App::Document*>::iterator it = docs.begin(); it != docs.end(); ++it)
+            openDocs.insert((*it)->getName());
+
+        try {
+            process();
+        }
+        catch (const Base::Exception& e) {
+            error = e.what();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        catch (...) {
+            error = "Unknown exception";
+        }
+
+        cleanup();
+
+        // the reply is a single line
+        for (std::string::iterator it = error.begin(); it != error.end(); ++it) {
+            if (*it == '\n' || *it == '\r' || *it == '\t')
+                *it = ' ';
+        }
+
+        std::stringstream str;
+        str << (error.empty() ? "ok" : "error") << "\t"
+            << Base::TimeInfo::diffTimeF(start) << "\t" << input;
+        if (!error.empty())
+            str << "\t" << error;
+        str << "\n";
+        succeeded = error.empty();
+        return str.str();
+    }
+
+    bool succeeded;
+
+private:
+    void process()
+    {
+        App::Application& app = App::GetApplication();
+        Base::FileInfo fi(input);
+        if (!fi.exists())
+            throw Base::Exception("File not found");
+
+        if (fi.hasExtension("fcstd")) {
+            App::Document* doc = app.openDocument(fi.filePath().c_str());
+            if (!doc)
+                throw Base::Exception("Failed to open document");
+            docName = doc->getName();
+        }
+        else {
+            std::vector<std::string> mods = app.getImportModules(fi.extension().c_str());
+            if (mods.empty())
+                throw Base::Exception("File format not supported");
+            docName = app.newDocument("Job")->getName();
+            Base::PyGILStateLocker lock;
+            Py::Tuple args(2);
+            try {
+                args.setItem(0, Py::String(fi.filePath().c_str(), "utf-8"));
+                args.setItem(1, Py::String(docName));
+            }
+            catch (Py::Exception&) {
+                throw Base::PyException();
+            }
+            callModule(mods.front(), "insert", args);
+        }
+
+        App::Document* doc = app.getDocument(docName.c_str());
+        if (!doc)
+            throw Base::Exception("Document was closed while loading");
+        doc->recompute();
+        std::vector<App::DocumentObject*> objs = doc->getObjects();
+        for (std::vector<App::DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it) {
+            if ((*it)->isError()) {
+                std::stringstream str;
+                str << "Recompute of " << (*it)->getNameInDocument() << " failed: "
+                    << (*it)->getStatusString();
+                throw Base::Exception(str.str());
+            }
+        }
+
+        if (output.empty())
+            return;
+
+        Base::FileInfo fo(output);
+        if (fo.hasExtension("fcstd")) {
+            if (!doc->saveAs(fo.filePath().c_str()))
+                throw Base::Exception("Failed to save document");
+        }
+        else {
+            std::vector<std::string> mods = app.getExportModules(fo.extension().c_str());
+            if (mods.empty())
+                throw Base::Exception("Output format not supported");
+            Base::PyGILStateLocker lock;
+            Py::Tuple args(2);
+            try {
+                Py::Object pyDoc(doc->getPyObject(), true);
+                args.setItem(0, pyDoc.getAttr("Objects"));
+                args.setItem(1, Py::String(fo.filePath().c_str(), "utf-8"));
+            }
+            catch (Py::Exception&) {
+                throw Base::PyException();
+            }
+            callModule(mods.front(), "export", args);
+        }
+    }
+
+    /// Calls a function of an import or export module. The file names are
+    /// passed as Python objects, so they are never parsed as Python code.
+    static void callModule(const std::string& name, const char* func, const Py::Tuple& args)
+    {
+        Base::PyGILStateLocker lock;
+        try {
+            Py::Module mod(PyImport_ImportModule(name.c_str()), true);
+            Py::Callable method(mod.getAttr(func));
+            method.apply(args);
+        }
+        catch (Py::Exception&) {
+            throw Base::PyException();
+        }
+    }
+
+    /// Closes the documents of the job and gives the freed memory back to the
+    /// system so that a long-running worker doesn't grow from job to job
+    void cleanup()
+    {
+        std::vector<std::string> names;
+        std::vector<App::Document*> docs = App::GetApplication().getDocuments();
+        for (std::vector<App::Document*>::iterator it = docs.begin(); it != docs.end(); ++it) {
+            if (openDocs.find((*it)->getName()) == openDocs.end())
+                names.push_back((*it)->getName());
+        }
+
+        for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+            try {
+                App::GetApplication().closeDocument(it->c_str());
+            }
+            catch (const Base::Exception& e) {
+                Console().Error("Closing document %s failed: %s\n", it->c_str(), e.what());
+            }
+            catch (...) {
+                Console().Error("Closing document %s failed\n", it->c_str());
+            }
+        }
+
+        try {
+            Base::Interpreter().runString("import gc\ngc.collect()");
+        }
+        catch (const Base::Exception& e) {
+            Console().Error("Cleaning up job failed: %s\n", e.what());
+        }
+        catch (...) {
+            Console().Error("Cleaning up job failed\n");
+        }
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+    }
+
+    std::string input;
+    std::string output;
+    std::string docName;
+    std::set<std::string> openDocs;
+};
+
+class Worker
+{
+public:
+    Worker() : jobs(0), failed(0)
+    {
+    }
+    ~Worker()
+    {
+        Console().Message("Worker processed %lu jobs (%lu failed) in %s s\n",
+            jobs, failed, Base::TimeInfo::diffTime(start).c_str());
+    }
+    /// Processes a request line and returns false if the line was 'quit'
+    bool process(const std::string& request, std::string& reply)
+    {
+        std::string line = request;
+        if (!line.empty() && line[line.size()-1] == '\r')
+            line.erase(line.size()-1);
+        if (line == "quit")
+            return false;
+        if (line.empty())
+            return true;
+
+        WorkerJob job(line);
+        reply = job.run();
+        jobs++;
+        if (!job.succeeded)
+            failed++;
+        return true;
+    }
+
+private:
+    Base::TimeInfo start;
+    unsigned long jobs;
+    unsigned long failed;
+};
+
+int runWorkerStdin()
+{
+    // the replies get the original stdout, everything else that is printed
+    // by the application or the modules goes to stderr
+    FILE* replies = stdout;
+#if defined(FC_WORKER_SOCKET)
+    int fd = dup(fileno(stdout));
+    if (fd >= 0 && dup2(fileno(stderr), fileno(stdout)) >= 0)
+        replies = fdopen(fd, "w");
+#endif
+
+    Worker worker;
+    std::string line, reply;
+    while (std::getline(std::cin, line)) {
+        reply.clear();
+        if (!worker.process(line, reply))
+            break;
+        fputs(reply.c_str(), replies);
+        fflush(replies);
+    }
+    return 0;
+}
+
+#if defined(FC_WORKER_SOCKET)
+volatile sig_atomic_t stopWorker = 0;
+
+void stopWorkerHandler(int)
+{
+    stopWorker = 1;
+}
+
+bool sendAll(int fd, const std::string& data)
+{
+    const char* ptr = data.c_str();
+    std::string::size_type left = data.size();
+    while (left > 0) {
+        ssize_t n = send(fd, ptr, left, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        ptr += n;
+        left -= n;
+    }
+    return true;
+}
+
+void serveConnection(Worker& worker, int client)
+{
+    std::string buffer, reply;
+    char chunk[4096];
+    for (;;) {
+        std::string::size_type pos;
+        while ((pos = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            reply.clear();
+            if (!worker.process(line, reply))
+                return;
+            if (!sendAll(client, reply))
+                return;
+        }
+
+        ssize_t n = recv(client, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR && !stopWorker)
+            continue;
+        if (n <= 0)
+            return;
+        buffer.append(chunk, n);
+    }
+}
+
+void serveConnections(int server)
+{
+    Worker worker;
+    while (!stopWorker) {
+        int client = accept(server, 0, 0);
+        if (client < 0) {
+            if (errno == EINTR)
+                continue;
+            Console().Error("Accepting connection failed: %s\n", strerror(errno));
+            break;
+        }
+        serveConnection(worker, client);
+        close(client);
+    }
+}
+
+int runWorkerSocket(const std::string& path, int slots)
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        Console().Error("Socket path too long: %s\n", path.c_str());
+        return 1;
+    }
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        Console().Error("Creating socket failed: %s\n", strerror(errno));
+        return 1;
+    }
+    unlink(path.c_str());
+    if (bind(server, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(server, 64) < 0) {
+        Console().Error("Listening on %s failed: %s\n", path.c_str(), strerror(errno));
+        close(server);
+        return 1;
+    }
+
+    // SIGTERM and SIGINT let accept() return so that the worker can end cleanly
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = stopWorkerHandler;
+    sigaction(SIGTERM, &sa, 0);
+    sigaction(SIGINT, &sa, 0);
+
+    Console().Message("Worker listening on %s with %d job slot(s)\n", path.c_str(), slots);
+    if (slots <= 1) {
+        serveConnections(server);
+    }
+    else {
+        // Forking after start-up shares the loaded modules between the job
+        // slots while each slot gets its own documents. The slots must be
+        // forked before any job started the threads of the task scheduler.
+        // Neither is the consumer thread of the asynchronous console passed
+        // to the slots, so they print synchronously.
+        bool async = Console().IsAsynchronous();
+        if (async)
+            Console().UnsetMode(Base::ConsoleSingleton::Asynchronous);
+
+        std::vector<pid_t> children;
+        for (int i = 0; i < slots; i++) {
+            pid_t pid = fork();
+            if (pid == 0) {
+                serveConnections(server);
+                close(server);
+                _exit(0);
+            }
+            else if (pid > 0) {
+                children.push_back(pid);
+            }
+            else {
+                Console().Error("Forking job slot failed: %s\n", strerror(errno));
+            }
+        }
+
+        if (async)
+            Console().SetMode(Base::ConsoleSingleton::Asynchronous);
+
+        while (!children.empty()) {
+            pid_t pid = waitpid(-1, 0, 0);
+            if (pid < 0 && errno == EINTR) {
+                // pass the termination request to the job slots
+                for (std::vector<pid_t>::iterator it = children.begin(); it != children.end(); ++it)
+                    kill(*it, SIGTERM);
+                continue;
+            }
+            if (pid < 0)
+                break;
+            for (std::vector<pid_t>::iterator it = children.begin(); it != children.end(); ++it) {
+                if (*it == pid) {
+                    children.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+
+    close(server);
+    unlink(path.c_str());
+    return 0;
+}
+#endif
+
+int runWorker()
+{
+    std::map<std::string,std::string>& cfg = App::Application::Config();
+    if (cfg["WorkerSocket"].empty())
+        return runWorkerStdin();
+#if defined(FC_WORKER_SOCKET)
+    int slots = atoi(cfg["WorkerSlots"].c_str());
+    return runWorkerSocket(cfg["WorkerSocket"], slots);
+#else
+    Console().Error("Worker sockets are not supported on this platform\n");
+    return 1;
+#endif
+}
+
+}
+
+
 int main( int argc, char ** argv )
 {
     // Make sure that we use '.' as decimal point
@@ -122,7 +584,11 @@ int main( int argc, char ** argv )
     }
 
     // Run phase ===========================================================
-    Application::runApplication();
+    int ret = 0;
+    if (App::Application::Config()["RunMode"] == "Worker")
+        ret = runWorker();
+    else
+        Application::runApplication();
 
 
     // Destruction phase ===========================================================
@@ -136,6 +602,6 @@ int main( int argc, char ** argv )
 
     Console().Log("FreeCAD completely terminated\n");
 
-    return 0;
+    return ret;
 }
 
@@ -3329,13 +3329,13 @@ static PyObject * offset_mesh(PyObject *self, PyObject *args)
         for (unsigned long i=0; i<mesh.CountPoints(); i++)
         {
             // Satz von Dreiecken zu jedem Punkt
-            const std::set<unsigned long>& faceSet = rf2pt[i];
+            MeshCore::MeshIndexSpan faceSet = rf2pt[i];
             float fArea = 0.0;
             normal.Set(0.0,0.0,0.0);
 
 
             // Iteriere ber die Dreiecke zu jedem Punkt
-            for (std::set<unsigned long>::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
+            for (MeshCore::MeshIndexSpan::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
             {
                 // Einmal derefernzieren, um an das MeshFacet zu kommen und dem Kernel uebergeben, dass er ein MeshGeomFacet liefert
                 t_face = mesh.GetFacet(*it);
@@ -4085,13 +4085,13 @@ static PyObject * fit_iter(PyObject *self, PyObject *args)
             for (unsigned long i=0; i<mesh.CountPoints(); i++)
             {
                 // Satz von Dreiecken zu jedem Punkt
-                const std::set<unsigned long>& faceSet = rf2pt[i];
+                MeshCore::MeshIndexSpan faceSet = rf2pt[i];
                 float fArea = 0.0;
                 normal.Set(0.0,0.0,0.0);
 
 
                 // Iteriere ber die Dreiecke zu jedem Punkt
-                for (std::set<unsigned long>::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
+                for (MeshCore::MeshIndexSpan::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
                 {
                     // Einmal derefernzieren, um an das MeshFacet zu kommen und dem Kernel uebergeben, dass er ein MeshGeomFacet liefert
                     t_face = mesh.GetFacet(*it);
@@ -542,8 +542,12 @@ void Approximate::ParameterInnerPoints()
             std::vector<Base::Vector3f> NeiPnts;
             std::vector<unsigned long> nei;
             std::vector<unsigned int>::iterator nei_it;
-            PntNei = vv_it[v_it.Position()];
-            FacetNei = vf_it[v_it.Position()];
+            MeshCore::MeshIndexSpan pnts = vv_it[v_it.Position()];
+            MeshCore::MeshIndexSpan facets = vf_it[v_it.Position()];
+            PntNei.clear();
+            PntNei.insert(pnts.begin(), pnts.end());
+            FacetNei.clear();
+            FacetNei.insert(facets.begin(), facets.end());
             ReorderNeighbourList(PntNei,FacetNei,nei,v_it.Position());
             std::vector<double> Angle;
             std::vector<double> Magnitude;
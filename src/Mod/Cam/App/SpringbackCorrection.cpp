@@ -856,7 +856,7 @@ bool SpringbackCorrection::SmoothMesh(MeshCore::MeshKernel &Mesh, double d_max)
 
     MeshCore::MeshPointIterator v_it(Mesh);
     MeshCore::MeshRefPointToPoints vv_it(Mesh);
-    std::set<unsigned long>::const_iterator pnt_it;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it;
     MeshCore::MeshPointArray::_TConstIterator v_beg = Mesh.GetPoints().begin();
 
     Base::Vector3f N, L, coor;
@@ -870,7 +870,7 @@ bool SpringbackCorrection::SmoothMesh(MeshCore::MeshKernel &Mesh, double d_max)
         spnt.Set(0.0, 0.0, 0.0);
         locPointArray.push_back(*v_it);
         spnt += *v_it;
-        const std::set<unsigned long>& PntNei = vv_it[(*v_it)._ulProp];
+        MeshCore::MeshIndexSpan PntNei = vv_it[(*v_it)._ulProp];
 
         if (PntNei.size() < 3)
             continue;
@@ -955,7 +955,7 @@ bool SpringbackCorrection::SmoothMesh(MeshCore::MeshKernel &Mesh, std::vector<in
 
     MeshCore::MeshPointIterator v_it(Mesh);
     MeshCore::MeshRefPointToPoints vv_it(Mesh);
-    std::set<unsigned long>::const_iterator pnt_it;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it;
     MeshCore::MeshPointArray::_TConstIterator v_beg = Mesh.GetPoints().begin();
 
     Base::Vector3f N, L, coor;
@@ -968,7 +968,7 @@ bool SpringbackCorrection::SmoothMesh(MeshCore::MeshKernel &Mesh, std::vector<in
         spnt.Set(0.0, 0.0, 0.0);
         locPointArray.push_back(*v_it);
         spnt += *v_it;
-        const std::set<unsigned long>& PntNei = vv_it[(*v_it)._ulProp];
+        MeshCore::MeshIndexSpan PntNei = vv_it[(*v_it)._ulProp];
 
         if (PntNei.size() < 3)
             continue;
@@ -1125,9 +1125,9 @@ std::vector<int> SpringbackCorrection::InitFaceCheck(MeshCore::MeshKernel &mesh,
 
             for (int j=0; j<3; ++j)
             {
-                const std::set<unsigned long>& faceSet = p2fIt[mFacets[i]._aulPoints[j]];
+                MeshCore::MeshIndexSpan faceSet = p2fIt[mFacets[i]._aulPoints[j]];
 
-                for (std::set<unsigned long>::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
+                for (MeshCore::MeshIndexSpan::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
                 {
                     f_beg[*it].SetProperty(5);
                 }
@@ -1798,10 +1798,10 @@ bool SpringbackCorrection::FacetRegionGrowing(MeshCore::MeshKernel &mesh,
     MeshCore::MeshRefFacetToFacets ff_It(mesh);
 
     MeshCore::MeshFacet facet = FacetRegion.back();
-    const std::set<unsigned long>& FacetNei = ff_It[facet._ulProp];
+    MeshCore::MeshIndexSpan FacetNei = ff_It[facet._ulProp];
     MeshCore::MeshFacetArray::_TConstIterator f_beg = mesh.GetFacets().begin();
 
-    std::set<unsigned long>::const_iterator f_it;
+    MeshCore::MeshIndexSpan::const_iterator f_it;
     for (f_it = FacetNei.begin(); f_it != FacetNei.end(); ++f_it)
     {
         if (f_beg[*f_it]._ucFlag == MeshCore::MeshFacet::VISIT)
@@ -1917,14 +1917,14 @@ bool SpringbackCorrection::GetCurvature(TopoDS_Face aFace)
     MeshCore::MeshPointIterator v_it(m_Mesh);
     MeshCore::MeshRefPointToPoints vv_it(m_Mesh);
     MeshCore::MeshPointArray::_TConstIterator v_beg = m_Mesh.GetPoints().begin();
-    std::set<unsigned long> PntNei;
-    std::set<unsigned long> PntNei2;
-    std::set<unsigned long> PntNei3;
-    std::set<unsigned long> PntNei4;
-    std::set<unsigned long>::iterator pnt_it1;
-    std::set<unsigned long>::iterator pnt_it2;
-    std::set<unsigned long>::iterator pnt_it3;
-    std::set<unsigned long>::iterator pnt_it4;
+    MeshCore::MeshIndexSpan PntNei;
+    MeshCore::MeshIndexSpan PntNei2;
+    MeshCore::MeshIndexSpan PntNei3;
+    MeshCore::MeshIndexSpan PntNei4;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it1;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it2;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it3;
+    MeshCore::MeshIndexSpan::const_iterator pnt_it4;
     std::vector<unsigned long> nei;
     double curv;
 
@@ -30,14 +30,20 @@
 
 #include "PreCompiled.h"
 #include "best_fit.h"
+#include "kd_tree.h"
 #include "routine.h"
 #include <strstream>
+#include <cfloat>
+#include <functional>
 
 #include <Mod/Mesh/App/Core/Grid.h>
 #include <Mod/Mesh/App/Core/Builder.h>
 #include <Mod/Mesh/App/Core/TopoAlgorithm.h>
 
 #include <Base/Builder3D.h>
+#include <Base/Console.h>
+#include <Base/TaskScheduler.h>
+#include <Base/TimeInfo.h>
 
 #include <BRep_Tool.hxx>
 #include "BRepUtils.h"
@@ -57,10 +63,233 @@
 #include <Handle_Poly_Triangulation.hxx>
 #include <Poly_Triangulation.hxx>
 
-#include <ANN/ANN.h> // ANN declarations
-
 #include <SMESH_Gen.hxx>
 
+#define COARSE_SAMPLES 5000    // maximum number of mesh points to rate the coarse alignments
+
+
+namespace {
+
+// Searches the nearest target point for each query point of a range
+class NearestPoints
+{
+public:
+    NearestPoints(const kd_tree &t, const std::vector<Base::Vector3f> &q,
+                  std::vector<int> &n, std::vector<float> &d)
+      : tree(t), query(q), nearest(n), dists(d)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i=first; i<last; ++i)
+            nearest[i] = tree.Nearest(query[i], dists[i]);
+    }
+
+private:
+    const kd_tree &tree;
+    const std::vector<Base::Vector3f> &query;
+    std::vector<int> &nearest;
+    std::vector<float> &dists;
+};
+
+// Sum of the squared distances of the transformed sample points to the target points
+class SampleDistance
+{
+public:
+    SampleDistance(const kd_tree &t, const std::vector<Base::Vector3f> &s, const Base::Matrix4D &m)
+      : tree(t), sample(s), M(m)
+    {
+    }
+    double operator()(std::size_t first, std::size_t last) const
+    {
+        double sum = 0.0;
+        float dist;
+        for (std::size_t i=first; i<last; ++i)
+        {
+            tree.Nearest(M * sample[i], dist);
+            sum += dist;
+        }
+        return sum;
+    }
+
+private:
+    const kd_tree &tree;
+    const std::vector<Base::Vector3f> &sample;
+    Base::Matrix4D M;
+};
+
+// Normal equations of the linearized distances between the point pairs. The
+// unknowns are the rotation vector and the translation of the incremental
+// transformation.
+struct IcpSystem
+{
+    IcpSystem() : sqrDist(0.0), count(0)
+    {
+        for (int i=0; i<6; ++i)
+        {
+            b[i] = 0.0;
+            for (int j=0; j<6; ++j)
+                A[i][j] = 0.0;
+        }
+    }
+    void AddDistance(const Base::Vector3f &p, const Base::Vector3f &q,
+                     const Base::Vector3f &n, double w)
+    {
+        Base::Vector3f c = p % n;
+        double a[6] = { c.x, c.y, c.z, n.x, n.y, n.z };
+        double r = n * (q - p);
+        for (int i=0; i<6; ++i)
+        {
+            for (int j=i; j<6; ++j)
+                A[i][j] += w*a[i]*a[j];
+            b[i] += w*a[i]*r;
+        }
+    }
+    // Gaussian elimination with partial pivoting on the slightly damped system
+    bool Solve(double x[6]) const
+    {
+        double M[6][7];
+        double diag = 0.0;
+        for (int i=0; i<6; ++i)
+            diag = std::max<double>(diag, A[i][i]);
+        for (int i=0; i<6; ++i)
+        {
+            for (int j=0; j<6; ++j)
+                M[i][j] = i <= j ? A[i][j] : A[j][i];
+            M[i][i] += 1e-9*diag;
+            M[i][6] = b[i];
+        }
+
+        for (int k=0; k<6; ++k)
+        {
+            int pivot = k;
+            for (int i=k+1; i<6; ++i)
+            {
+                if (fabs(M[i][k]) > fabs(M[pivot][k]))
+                    pivot = i;
+            }
+            if (fabs(M[pivot][k]) < DBL_MIN)
+                return false;
+            for (int j=k; j<7; ++j)
+                std::swap(M[k][j], M[pivot][j]);
+            for (int i=k+1; i<6; ++i)
+            {
+                double f = M[i][k]/M[k][k];
+                for (int j=k; j<7; ++j)
+                    M[i][j] -= f*M[k][j];
+            }
+        }
+
+        for (int i=5; i>=0; --i)
+        {
+            double s = M[i][6];
+            for (int j=i+1; j<6; ++j)
+                s -= M[i][j]*x[j];
+            x[i] = s/M[i][i];
+        }
+        return true;
+    }
+
+    double A[6][6];
+    double b[6];
+    double sqrDist;
+    unsigned long count;
+};
+
+struct JoinIcpSystems
+{
+    IcpSystem operator()(IcpSystem a, const IcpSystem &b) const
+    {
+        for (int i=0; i<6; ++i)
+        {
+            a.b[i] += b.b[i];
+            for (int j=0; j<6; ++j)
+                a.A[i][j] += b.A[i][j];
+        }
+        a.sqrDist += b.sqrDist;
+        a.count += b.count;
+        return a;
+    }
+};
+
+// Searches the nearest target point for each source point of a range and adds
+// the distance to the tangent plane at the target point. Without target normals
+// the point-to-point distance is used. Pairs farther away than maxSqrDist are
+// treated as outliers.
+class IcpCorrespondences
+{
+public:
+    IcpCorrespondences(const kd_tree &t, const std::vector<Base::Vector3f> &tp,
+                       const std::vector<Base::Vector3f> &tn, const std::vector<double> &tw,
+                       const std::vector<Base::Vector3f> &sp, float d)
+      : tree(t), pnts(tp), normals(tn), weights(tw), source(sp), maxSqrDist(d)
+    {
+    }
+    IcpSystem operator()(std::size_t first, std::size_t last) const
+    {
+        IcpSystem sys;
+        bool usePlane = normals.size() == pnts.size();
+        bool useWeight = weights.size() == pnts.size();
+        float dist;
+        for (std::size_t i=first; i<last; ++i)
+        {
+            const Base::Vector3f &p = source[i];
+            int index = tree.Nearest(p, dist);
+            if (index < 0 || dist > maxSqrDist)
+                continue;
+
+            const Base::Vector3f &q = pnts[index];
+            double w = useWeight ? weights[index] : 1.0;
+            if (usePlane)
+            {
+                sys.AddDistance(p, q, normals[index], w);
+            }
+            else
+            {
+                sys.AddDistance(p, q, Base::Vector3f(1.0f,0.0f,0.0f), w);
+                sys.AddDistance(p, q, Base::Vector3f(0.0f,1.0f,0.0f), w);
+                sys.AddDistance(p, q, Base::Vector3f(0.0f,0.0f,1.0f), w);
+            }
+            sys.sqrDist += dist;
+            sys.count++;
+        }
+        return sys;
+    }
+
+private:
+    const kd_tree &tree;
+    const std::vector<Base::Vector3f> &pnts;
+    const std::vector<Base::Vector3f> &normals;
+    const std::vector<double> &weights;
+    const std::vector<Base::Vector3f> &source;
+    float maxSqrDist;
+};
+
+// Rotation around the rotation vector (x[0],x[1],x[2]) followed by the
+// translation (x[3],x[4],x[5])
+Base::Matrix4D IcpTransform(const double x[6])
+{
+    Base::Matrix4D M;
+    M.setToUnity();
+
+    double angle = sqrt(x[0]*x[0] + x[1]*x[1] + x[2]*x[2]);
+    if (angle > 0.0)
+    {
+        double kx = x[0]/angle, ky = x[1]/angle, kz = x[2]/angle;
+        double c = cos(angle), s = sin(angle), t = 1.0 - c;
+        M[0][0] = t*kx*kx + c;    M[0][1] = t*kx*ky - s*kz; M[0][2] = t*kx*kz + s*ky;
+        M[1][0] = t*kx*ky + s*kz; M[1][1] = t*ky*ky + c;    M[1][2] = t*ky*kz - s*kx;
+        M[2][0] = t*kx*kz - s*ky; M[2][1] = t*ky*kz + s*kx; M[2][2] = t*kz*kz + c;
+    }
+
+    M[0][3] = x[3];
+    M[1][3] = x[4];
+    M[2][3] = x[5];
+    return M;
+}
+
+}
+
 
 best_fit::best_fit()
 {
@@ -82,139 +311,67 @@ void best_fit::Load(const MeshCore::MeshKernel &mesh, const TopoDS_Shape &cad)
 
 double best_fit::ANN()
 {
-    ANNpointArray   dataPts;                // data points
-    ANNpoint        queryPt;                // query point
-    ANNidxArray     nnIdx;                    // near neighbor indices
-    ANNdistArray    dists;                    // near neighbor distances
-    ANNkd_tree*     kdTree;                    // search structure
-
-	Base::Builder3D log_error;
-
-    //MeshCore::MeshPointArray meshPnts = m_MeshWork.GetPoints();
-	m_pntCloud_2;
-    Base::Vector3f projPoint;
-
-    double error = 0.0;
-
-    int a_dim = 3;
-    int a_nbPnts =(int) m_pntCloud_2.size();        // Size vom eingescanntem Netz
-    int a_nbNear = 1;                               // anzahl der rckgabewerte
-    queryPt = annAllocPt(a_dim);                    // allocate query point storage
-    dataPts = annAllocPts(a_nbPnts, a_dim);         // allocate data points storage
-    nnIdx = new ANNidx[a_nbNear];                   // allocate near neigh indices
-    dists = new ANNdist[a_nbNear];                  // allocatenear neighbor dists
-
     m_LSPnts[0].clear();
     m_LSPnts[1].clear();
+    m_weights_loc = m_weights;
+    if (m_pntCloud_1.empty() || m_pntCloud_2.empty())
+        return 0.0;
 
-    for (int i=0; i<a_nbPnts; ++i)
-    {
-        dataPts[i][0] = m_pntCloud_2[i].x;
-        dataPts[i][1] = m_pntCloud_2[i].y;
-        dataPts[i][2] = m_pntCloud_2[i].z;
-    }
-
-    kdTree = new ANNkd_tree(        // build search structure
-        dataPts,                    // the data points
-        a_nbPnts,            // number of points
-        a_dim);                     // dimension of space
-
+    kd_tree tree(m_pntCloud_2);
+    std::vector<int> nearest(m_pntCloud_1.size());
+    std::vector<float> dists(m_pntCloud_1.size());
+    Base::parallel_for(0, m_pntCloud_1.size(), NearestPoints(tree, m_pntCloud_1, nearest, dists), 1000);
 
+    double error = 0.0;
     for (unsigned int i = 0 ; i < m_pntCloud_1.size() ; i++ )
     {
-        queryPt[0] = m_pntCloud_1[i].x;
-        queryPt[1] = m_pntCloud_1[i].y;
-        queryPt[2] = m_pntCloud_1[i].z;
-
-        kdTree->annkSearch(                        // search
-            queryPt,							   // query point
-            a_nbNear,						       // number of near neighbors
-            nnIdx,                                 // nearest neighbors (returned)
-            dists                                  // distance (returned)
-        );                                         // error bound
-
         m_LSPnts[1].push_back(m_pntCloud_1[i]);
-        m_LSPnts[0].push_back(m_pntCloud_2[nnIdx[0]]);
-
-		if(m_pntCloud_1[i].z <= m_pntCloud_2[nnIdx[0]].z)
-		{
-			log_error.addSingleLine(m_pntCloud_1[i],m_pntCloud_2[nnIdx[0]],8,1,0,0);
-		}
-		else
-		{
-			log_error.addSingleLine(m_pntCloud_1[i],m_pntCloud_2[nnIdx[0]],8,0,1,0);
-		}
-
-		//if(dists[0] > error)
-			error += dists[0];
-
+        m_LSPnts[0].push_back(m_pntCloud_2[nearest[i]]);
+        error += dists[i];
     }
 
-	log_error.saveToFile("c:/errorVec_fit.iv");
-
     error /= double(m_pntCloud_1.size());
-    m_weights_loc = m_weights;
-
-
-    delete [] nnIdx; // clean things up
-    delete [] dists;
-    delete kdTree;
-    annClose(); // done with ANN
-
     return error;
 }
 
 bool best_fit::Perform()
 {
     Base::Matrix4D M;
+    Base::TimeInfo start;
 
-    ofstream Runtime_BestFit;
-	time_t sec1, sec2;
-
-	Runtime_BestFit.open("c:/Runtime_BestFit.txt");
-	Runtime_BestFit << "Runtime Best-Fit" << std::endl;
-
-
-    cout << "tesselate shape" << endl;
+    Tesselate_Shape(m_Cad, m_CadMesh, 1); // Tesselates m_Cad Shape and stores Tesselation in m_CadMesh
+    Base::Console().Log("Best-fit: tesselate shape: %.3f s\n", Base::TimeInfo::diffTimeF(start));
 
-	sec1 = time(NULL);
-   	  Tesselate_Shape(m_Cad, m_CadMesh, 1); // Tesselates m_Cad Shape and stores Tesselation in m_CadMesh 
-	sec2 = time(NULL);
-
-	Runtime_BestFit << "Tesselate Shape: " << sec2 - sec1 << " sec" << std::endl;  
-
-	sec1 = time(NULL);
-      Comp_Weights(); // m_pntCloud_1, m_weights, m_normals des/r Cad-Meshs/Punktewolke werden hier gefllt
-    sec2 = time(NULL);
-
-	Runtime_BestFit << "Compute Weights: " << sec2 - sec1 << " sec" << std::endl;  
-	
+    start.setCurrent();
+    Comp_Weights(); // m_pntCloud_1, m_weights, m_normals des/r Cad-Meshs/Punktewolke werden hier gefllt
+    Base::Console().Log("Best-fit: compute weights: %.3f s\n", Base::TimeInfo::diffTimeF(start));
+    
 
-	/*RotMat(M, 180, 1);
+    /*RotMat(M, 180, 1);
     m_MeshWork.Transform(M);
-	return true;*/
+    return true;*/
 
 
-	//MeshCore::MeshPointArray pntarr = m_MeshWork.GetPoints();
-	//MeshCore::MeshFacetArray facetarr = m_MeshWork.GetFacets();
+    //MeshCore::MeshPointArray pntarr = m_MeshWork.GetPoints();
+    //MeshCore::MeshFacetArray facetarr = m_MeshWork.GetFacets();
 
-	//for(int i=0; i<pntarr.size(); ++i)
-	//{
-	//	pntarr[i].x -= 200;
-	//	pntarr[i].y -= 200;
-	//	pntarr[i].z += 50;
-	//}
+    //for(int i=0; i<pntarr.size(); ++i)
+    //{
+    //	pntarr[i].x -= 200;
+    //	pntarr[i].y -= 200;
+    //	pntarr[i].z += 50;
+    //}
+
+    //m_MeshWork.Assign(pntarr,facetarr);
 
-	//m_MeshWork.Assign(pntarr,facetarr);
 
+    start.setCurrent();
 
-    sec1 = time(NULL);
-	
-	MeshFit_Coarse();  // Transformation Mesh -> CAD
+    MeshFit_Coarse();  // Transformation Mesh -> CAD
     ShapeFit_Coarse(); // Translation    CAD  -> Origin
 
-	//return true;
-	
+    //return true;
+    
     M.setToUnity();
     M[0][3] = m_cad2orig.X();
     M[1][3] = m_cad2orig.Y();
@@ -224,26 +381,15 @@ bool best_fit::Perform()
     m_MeshWork.Transform(M);
     PointTransform(m_pntCloud_1,M);
 
-	MeshCore::MeshPointArray pnts = m_MeshWork.GetPoints();
-
-	for (unsigned int i=0; i<pnts.size(); ++i)
-	{
-		m_pntCloud_2.push_back(pnts[i]);
-
-	}
-
-    Runtime_BestFit << "- Error: " << ANN() << endl;
+    const MeshCore::MeshPointArray& pnts = m_MeshWork.GetPoints();
+    m_pntCloud_2.assign(pnts.begin(), pnts.end());
 
     Coarse_correction();
+    Base::Console().Log("Best-fit: coarse correction: %.3f s\n", Base::TimeInfo::diffTimeF(start));
 
-	sec2 = time(NULL);
-	Runtime_BestFit << "Coarse Correction: " << sec2-sec1 << " sec" << endl;
-
-    sec1 = time(NULL);
-	LSM();
-	sec2 = time(NULL);
-    Runtime_BestFit << "Least-Square-Matching: " << sec2-sec1 << " sec" << endl;
-	Runtime_BestFit.close();
+    start.setCurrent();
+    LSM();
+    Base::Console().Log("Best-fit: least-square-matching: %.3f s\n", Base::TimeInfo::diffTimeF(start));
 
     Base::Matrix4D T;
     T.setToUnity();
@@ -253,7 +399,7 @@ bool best_fit::Perform()
     m_MeshWork.Transform(T);
     m_CadMesh.Transform(T);
 
-	m_Mesh = m_MeshWork;
+    m_Mesh = m_MeshWork;
     CompTotalError();
 
     return true;
@@ -263,61 +409,52 @@ bool best_fit::Perform()
 
 bool best_fit::Perform_PointCloud()
 {
-	Base::Matrix4D M;
-
-	ofstream Runtime_BestFit;
-	time_t sec1, sec2;
-
-	Runtime_BestFit.open("c:/Runtime_BestFit_PntCld.txt");
-	Runtime_BestFit << "Runtime Best-Fit" << std::endl;
+    Base::Matrix4D M;
+    Base::TimeInfo start;
 
-	PointCloud_Coarse();  
+    PointCloud_Coarse();  
 
-	M.setToUnity();
+    M.setToUnity();
 
-	for(unsigned int i=0; i<m_pntCloud_1.size(); i++)
-		m_weights.push_back(1.0);
-	
-	M[0][3] = m_cad2orig.X();
-	M[1][3] = m_cad2orig.Y();
-	M[2][3] = m_cad2orig.Z();
+    for(unsigned int i=0; i<m_pntCloud_1.size(); i++)
+        m_weights.push_back(1.0);
+    
+    M[0][3] = m_cad2orig.X();
+    M[1][3] = m_cad2orig.Y();
+    M[2][3] = m_cad2orig.Z();
 
-	PointTransform(m_pntCloud_1,M);
-	PointTransform(m_pntCloud_2,M);
+    PointTransform(m_pntCloud_1,M);
+    PointTransform(m_pntCloud_2,M);
 
-	//Runtime_BestFit << "- Error: " << ANN() << endl;
-    sec1 = time(NULL);
-	Coarse_correction();
-	sec2 = time(NULL);
-	Runtime_BestFit << "Coarse Correction: " << sec2-sec1 << " sec" << endl;
+    start.setCurrent();
+    Coarse_correction();
+    Base::Console().Log("Best-fit: coarse correction: %.3f s\n", Base::TimeInfo::diffTimeF(start));
 
-	//M[0][3] = m_cad2orig.X();
-	//M[1][3] = m_cad2orig.Y();
-	//M[2][3] = m_cad2orig.Z();
+    //M[0][3] = m_cad2orig.X();
+    //M[1][3] = m_cad2orig.Y();
+    //M[2][3] = m_cad2orig.Z();
 
-	//PointTransform(m_pntCloud_1,M);
-	//PointTransform(m_pntCloud_2,M);
+    //PointTransform(m_pntCloud_1,M);
+    //PointTransform(m_pntCloud_2,M);
 
-	sec1 = time(NULL);
-	LSM();
-	sec2 = time(NULL);
-	Runtime_BestFit << "Least-Square-Matching: " << sec2-sec1 << " sec" << endl;
-	Runtime_BestFit.close();
+    start.setCurrent();
+    LSM();
+    Base::Console().Log("Best-fit: least-square-matching: %.3f s\n", Base::TimeInfo::diffTimeF(start));
 
-	Base::Matrix4D T;
-	T.setToUnity();
-	T[0][3] = -m_cad2orig.X();
-	T[1][3] = -m_cad2orig.Y();
-	T[2][3] = -m_cad2orig.Z();
-	PointTransform(m_pntCloud_1, T);
-	PointTransform(m_pntCloud_2, T);
-	m_MeshWork.Transform(T);
-	m_CadMesh.Transform(T);
+    Base::Matrix4D T;
+    T.setToUnity();
+    T[0][3] = -m_cad2orig.X();
+    T[1][3] = -m_cad2orig.Y();
+    T[2][3] = -m_cad2orig.Z();
+    PointTransform(m_pntCloud_1, T);
+    PointTransform(m_pntCloud_2, T);
+    m_MeshWork.Transform(T);
+    m_CadMesh.Transform(T);
 
-	m_Mesh = m_MeshWork;
-	CompTotalError();
+    m_Mesh = m_MeshWork;
+    CompTotalError();
 
-	return true;
+    return true;
 }
 
 /*
@@ -395,48 +532,43 @@ int best_fit::intersect_RayTriangle(const Base::Vector3f &normal,const MeshCore:
 
 bool best_fit::Coarse_correction()
 {
-    double error, error_tmp, rot = 0.0;
-    Base::Matrix4D M,T;
-	ofstream CoarseCorr;
-
-	CoarseCorr.open("c:/CoarseCorr.txt");
-
-    std::vector<Base::Vector3f> m_pntCloud_Work = m_pntCloud_2;
+    // The principal axes only determine the orientation up to a rotation of
+    // 180 degree around one of the axes. Rate the four candidates with the
+    // distances of a sample of the mesh points to the CAD points.
+    if (m_pntCloud_1.empty() || m_pntCloud_2.empty())
+        return false;
+
+    kd_tree tree(m_pntCloud_1);
+    std::vector<Base::Vector3f> sample;
+    std::size_t step = m_pntCloud_2.size()/COARSE_SAMPLES + 1;
+    for (std::size_t i=0; i<m_pntCloud_2.size(); i+=step)
+        sample.push_back(m_pntCloud_2[i]);
 
+    Base::Matrix4D M,T;
     T.setToUnity();
-    best_fit befi; 
-    
-	//error = CompError_GetPnts(m_pnts, m_normals)[0];  // startfehler    int n=360/rstep_corr;
-    
-	error = ANN();
+    double error = DBL_MAX;
 
-    for (int i=1; i<4; ++i)
+    for (int i=0; i<4; ++i)
     {
-        RotMat(M, 180, i);
-        PointTransform(m_pntCloud_2, M);
-		//m_MeshWork.Transform(M);
+        if (i == 0)
+            M.setToUnity();
+        else
+            RotMat(M, 180, i);
 
-        error_tmp = ANN();
-		
-		//error_tmp = CompError_GetPnts(m_pnts, m_normals)[0];
-        //error_tmp = befi.CompTotalError(m_MeshWork);
-		
-		CoarseCorr << i << ", " << error_tmp << endl;
+        double error_tmp = Base::parallel_reduce(0, sample.size(), 0.0,
+            SampleDistance(tree, sample, M), std::plus<double>(), 500);
+        error_tmp /= double(sample.size());
+        Base::Console().Log("Best-fit: coarse candidate %d: error = %g\n", i, error_tmp);
 
         if (error_tmp < error)
         {
             T = M;
             error = error_tmp;
         }
-
-        m_pntCloud_2 = m_pntCloud_Work;
     }
 
-	CoarseCorr << "BEST CHOICE: " << error << endl;
-	CoarseCorr.close();
     PointTransform(m_pntCloud_2, T);
-	m_MeshWork.Transform(T);
-
+    m_MeshWork.Transform(T);
 
     return true;
 }
@@ -444,311 +576,55 @@ bool best_fit::Coarse_correction()
 
 bool best_fit::LSM()
 {
-    double TOL  = 0.05;          // Abbruchkriterium des Newton-Verfahren
     int maxIter = 100;            // maximale Anzahl von Iterationen fr den Fall,
-							     // dass das Abbruchkriterium nicht erfllt wird
-
-   int mult = 2;                 // zur Halbierung der Schrittweite bei Misserfolg des Newton Verfahrens
+                                  // dass das Abbruchkriterium nicht erfllt wird
 
-    double val, tmp = 1e+10, delta, delta_tmp = 0.0;
-    Base::Matrix4D Tx,Ty,Tz,Rx,Ry,Rz,M;   // Transformaitonsmatrizen
+    // Point-to-plane ICP: the CAD points are fixed, the mesh points are moved
+    kd_tree tree(m_pntCloud_1);
 
-	ofstream anOutputFile;
-	anOutputFile.open("c:/outputBestFit.txt");
-    anOutputFile.precision(7);
-
-      int c=0; // Laufvariable
-    
-
-
-    std::vector<double> del_x(3,0.0);
-    std::vector<double>     x(3,0.0); // Startparameter entspricht Nullvektor
-
-    Base::Vector3f centr_l,centr_r, cent;  // Schwerpunkte der Punktestze
-
-    // Newton Verfahren: 1. Lse  H*del_x = -J
-    //                   2. Setze x = x + del_x
-
-    std::vector<double> Jac(3);           // 1.Ableitung der Fehlerfunktion (Jacobi-Matrix)
-    std::vector< std::vector<double> > H; // 2.Ableitung der Fehlerfunktion (Hesse-Matrix)
-
-    time_t seconds1, seconds2, sec1, sec2;
-    seconds1 = time(NULL);
+    Base::Matrix4D T;             // accumulated transformation of the mesh
+    T.setToUnity();
+    float maxSqrDist = FLT_MAX;
+    double rms, rms_prev = DBL_MAX;
+    double x[6];
 
-    while (true)
+    for (int c=0; c<maxIter; ++c)
     {
+        Base::TimeInfo start;
+        IcpSystem sys = Base::parallel_reduce(0, m_pntCloud_2.size(), IcpSystem(),
+            IcpCorrespondences(tree, m_pntCloud_1, m_normals, m_weights, m_pntCloud_2, maxSqrDist),
+            JoinIcpSystems(), 2000);
 
-        seconds1 = time(NULL);
-        //m_Mesh = m_MeshWork;
-        
-		// Fehlerberechnung vom CAD -> Mesh
-        //tmp = CompError_GetPnts(m_pnts, m_normals);      // hier: - Berechnung der LS-Punktestze
-        //      CompTotalError()                           //       - Berechnung der zugehrigen Gewichtungen
-
-		delta = delta_tmp;
-        delta_tmp = ANN();          // gibt durchschnittlichen absoluten Fehler aus
-		delta = delta - delta_tmp ; // hier wird die Fehlerverbesserung zum vorigen Iterationsschritt gespeichert
-
-		if (c==maxIter || delta < ERR_TOL && c>1) break; // Abbruchkriterium (falls maximale Iterationsschrite erreicht
-										                 //                   oder falls Fehlernderung unsignifikant gering)
-
-        seconds2 = time(NULL);
-		anOutputFile << c << ", " << delta_tmp << ", " << delta << "    -    Time: " << seconds2 - seconds1 << " sec" << endl;
-		seconds1 = time(NULL);
-
-		sec1 = time(NULL);
-        for (unsigned int i=0; i<x.size(); ++i) x[i] = 0.0; // setzt startwerte fr newton auf null
-
-
-        // Berechne gewichtete Schwerpunkte und verschiebe die Punktestze entsprechend:
-        centr_l.Scale(0.0,0.0,0.0);
-        centr_r.Scale(0.0,0.0,0.0);
-
-        Base::Vector3f p,q;
-		double Sum = 0.0;
-        for (unsigned int i=0; i<m_LSPnts[0].size(); ++i)
+        if (sys.count < 6 || !sys.Solve(x))
         {
-            p = m_LSPnts[0][i];
-            q = m_LSPnts[1][i];
-
-            p.Scale((float) m_weights_loc[i],(float) m_weights_loc[i],(float) m_weights_loc[i]);
-            q.Scale((float) m_weights_loc[i],(float) m_weights_loc[i],(float) m_weights_loc[i]);
-
-			Sum += m_weights_loc[i];
-			centr_l += p;
-            centr_r += q;
-        }
-
-		centr_l.Scale( -1.0f/float(Sum), -1.0f/float(Sum), -1.0f/float(Sum));
-		centr_r.Scale( -1.0f/(float)Sum, -1.0f/(float)Sum, -1.0f/(float)Sum);
-
-       /* float s = (float) m_LSPnts[0].size();
-        s = float(-1.0/s);
-
-        centr_l.Scale(s,s,s);
-        centr_r.Scale(s,s,s);*/
-
-
-
-        // Verschiebung der Schwerpunkte zum Ursprung
-        TransMat(Tx,centr_l.x,1);
-        TransMat(Ty,centr_l.y,2);
-        TransMat(Tz,centr_l.z,3);
-
-        M = Tx*Ty*Tz;
-        PointTransform(m_LSPnts[0],M);
-		PointTransform(m_pntCloud_1,M);
-		PointTransform(m_pntCloud_2,M);
-        m_MeshWork.Transform(M);
-
-        TransMat(Tx,centr_r.x,1); // Berechnung der Translationsmatrix in x-Richtung
-        TransMat(Ty,centr_r.y,2); // Berechnung der Translationsmatrix in y-Richtung
-        TransMat(Tz,centr_r.z,3); // Berechnung der Translationsmatrix in z-Richtung
-
-        M = Tx*Ty*Tz;                  // Zusammenfgen zu einer Gesamttranslationsmatrix
-        PointTransform(m_LSPnts[1],M); // Anwendung der Translation auf m_LSPnts
-        PointTransform(m_pntCloud_1,M);
-		//PointNormalTransform(m_pnts, m_normals, M); // Anwendung der Translation auf m_pnts
-        m_CadMesh.Transform(M);                       // Anwendung der Translation auf das CadMesh
-
-        sec2 = time(NULL);
-		anOutputFile << c+1 << " - Initialisierung und Transformation um gewichtete Schwerpunkte: " << sec2 - sec1 << " sec" << endl;
-
-		sec1 = time(NULL);
-        // Newton-Verfahren zur Berechnung der Rotationsmatrix:
-        while (true)
-        {
-
-            Jac = Comp_Jacobi(x);  // berechne 1.Ableitung
-            H   = Comp_Hess(x);    // berechne 2.Ableitung
-
-            val = 0.0;
-            for (unsigned int i=0; i<Jac.size(); ++i)
-            {
-                val += Jac[i]*Jac[i];
-            }
-            val = sqrt(val);
-
-            if (val < TOL) break; // Abbruchkriterium des Newton-Verfahren
-
-            if (val>tmp && mult < 1e+4)
-            {
-                for (unsigned int i=0; i<del_x.size(); ++i)
-                {
-                    x[i] -= del_x[i]/double(mult);  // Halbiere Schrittweite falls keine Verbesserung
-                }
-                mult *= 2;
-                continue;
-            }
-            else
-            {
-                mult = 2;
-            }
-
-            tmp = val;
-
-            del_x = Routines::NewtonStep(Jac,H);      // lst Gl.system:          H*del_x = -J
-            for (unsigned int i=0; i<x.size(); ++i)   // nchster Iterationswert: x = x + del_x
-            {
-                x[i] += del_x[i];
-            }
+            Base::Console().Warning("Best-fit: not enough point pairs in iteration %d\n", c+1);
+            break;
         }
 
-		sec2 = time(NULL);
-		anOutputFile << c+1 << " - Newton: " << seconds2 - seconds1 << " sec" << endl;
-        sec1 = time(NULL);
-        // Rotiere und verschiebe zurck zum Ursprung der !!! CAD-Geometrie !!!
-        RotMat  (Rx,(x[0]*180.0/PI),1);
-        RotMat  (Ry,(x[1]*180.0/PI),2);
-        RotMat  (Rz,(x[2]*180.0/PI),3);
-
-		Base::Matrix4D R = Rx*Ry*Rz;
-		centr_l.Scale(-1.0, -1.0, -1.0);
-
-		cent.x =(float)  (R[0][0]*centr_l.x + R[0][1]*centr_l.y + R[0][2]*centr_l.z);
-		cent.y =(float)  (R[1][0]*centr_l.x + R[1][1]*centr_l.y + R[1][2]*centr_l.z);
-		cent.z =(float)  (R[2][0]*centr_l.x + R[2][1]*centr_l.y + R[2][2]*centr_l.z);
-			 
-		TransMat(Tx, -centr_r.x - cent.x + centr_l.x, 1);
-        TransMat(Ty, -centr_r.y - cent.y + centr_l.y, 2);
-		TransMat(Tz, -centr_r.z - cent.z + centr_l.z, 3);
-
-        M = Tx*Ty*Tz*Rx*Ry*Rz; // Rotiere zuerst !!! (Rotationen stets um den Nullpunkt...)
-        
-		PointTransform(m_pntCloud_2,M);
-		m_MeshWork.Transform(M);
-
-		TransMat(Tx, -centr_r.x, 1);
-		TransMat(Ty, -centr_r.y, 2);
-		TransMat(Tz, -centr_r.z, 3);
-
-        M = Tx*Ty*Tz;
-		PointTransform(m_pntCloud_1,M);
-        m_CadMesh.Transform(M);
-        //PointNormalTransform(m_pnts, m_normals, M);
-
-   		sec2 = time(NULL);
-		
-		anOutputFile << c+1 << " - Trafo: " << seconds2 - seconds1 << " sec" << endl;
-        ++c;  //Erhhe Laufvariable 
-    }
-
-	anOutputFile.close();
-return true;
-
-    /*TransMat(Tx,-centr_l.x,1);
-       TransMat(Ty,-centr_l.y,2);
-    TransMat(Tz,-centr_l.z,3);
-
-    M = Tx*Ty*Tz;
-    PointTransform(m_LSPnts[0],M);
-
-    TransMat(Tx,-centr_r.x,1);
-       TransMat(Ty,-centr_r.y,2);
-    TransMat(Tz,-centr_r.z,3);
-
-    M = Tx*Ty*Tz;
-    PointTransform(m_LSPnts[1],M);
-
-    Base::Builder3D log;
-
-    for(unsigned int i=0; i<m_LSPnts[0].size(); ++i)
-     log.addSingleArrow(m_LSPnts[0][i],m_LSPnts[1][i]);
-
-    log.saveToFile("c:/newton_pnts.iv");*/
-
-  
-}
-
-
-std::vector<double> best_fit::Comp_Jacobi(const std::vector<double> &x)
-{
-    std::vector<double> F(3,0.0);
-    double s1 = sin(x[0]), c1 = cos(x[0]);
-    double s2 = sin(x[1]), c2 = cos(x[1]);
-    double s3 = sin(x[2]), c3 = cos(x[2]);
-
-    Base::Vector3f p,q;
-
-    for (unsigned int i=0; i<m_LSPnts[0].size(); ++i)
-    {
-        p = m_LSPnts[0][i];
-        q = m_LSPnts[1][i];
-
-        F[0] += ( q.y * ( (-c1*s2*c3-s1*s3) * p.x +  (c1*s2*s3-s1*c3) * p.y + (-c1*c2) * p.z ) +
-                  q.z * ( (-s1*s2*c3+c1*s3) * p.x +  (s1*s2*s3+c1*c3) * p.y + (-s1*c2) * p.z ) )*m_weights_loc[i];
-
-        F[1] += ( q.x * (          (-s2*c3) * p.x +           (s2*s3) * p.y +    (-c2) * p.z ) +
-                  q.y * (       (-s1*c2*c3) * p.x +        (s1*c2*s3) * p.y +  (s1*s2) * p.z ) +
-                  q.z * (        (c1*c2*c3) * p.x +       (-c1*c2*s3) * p.y + (-c1*s2) * p.z ) )*m_weights_loc[i];
-
-        F[2] += ( q.x * (          (-c2*s3) * p.x +          (-c2*c3) * p.y) +
-                  q.y * (  (s1*s2*s3+c1*c3) * p.x +  (s1*s2*c3-c1*s3) * p.y) +
-                  q.z * ( (-c1*s2*s3+s1*c3) * p.x + (-c1*s2*c3-s1*s3) * p.y) )*m_weights_loc[i];
-    }
-
-    return F;
-}
-
-std::vector<std::vector<double> > best_fit::Comp_Hess(const std::vector<double> &x)
-{
-    std::vector<std::vector<double> > DF(3);
-    for (unsigned int i=0; i<DF.size(); ++i)
-    {
-        DF[i].resize(3,0.0);
-    }
-
-    double s1 = sin(x[0]), c1 = cos(x[0]);
-    double s2 = sin(x[1]), c2 = cos(x[1]);
-    double s3 = sin(x[2]), c3 = cos(x[2]);
+        Base::Matrix4D M = IcpTransform(x);
+        PointTransform(m_pntCloud_2, M);
+        T = M * T;
 
-    double sum1 = 0.0, sum2 = 0.0, sum3 = 0.0, sum4 = 0.0, sum5 = 0.0, sum6 = 0.0;
+        rms = sqrt(sys.sqrDist/double(sys.count));
+        Base::Console().Log("Best-fit: iteration %d: rms = %g, %lu pairs, %.3f s\n",
+            c+1, rms, sys.count, Base::TimeInfo::diffTimeF(start));
 
-    Base::Vector3f p,q;
+        // Abbruchkriterium: Fehlernderung unsignifikant gering
+        if (rms == 0.0 || fabs(rms_prev - rms) < ERR_TOL)
+            break;
 
-    for (unsigned int i=0; i<m_LSPnts[0].size(); ++i)
-    {
-        p = m_LSPnts[0][i];
-        q = m_LSPnts[1][i];
-
-        sum1      = q.y * (  (s1*s2*c3-c1*s3) * p.x + (-s1*s2*s3-c1*c3) * p.y +  (s1*c2) * p.z ) +
-                    q.z * ( (-c1*s2*c3-s1*s3) * p.x +  (c1*s2*s3-s1*c3) * p.y + (-c1*c2) * p.z );
-
-        sum2      = q.x * (          (-c2*c3) * p.x +           (c2*s3) * p.y +     (s2) * p.z ) +
-                    q.y * (        (s1*s2*c3) * p.x +       (-s1*s2*s3) * p.y +  (s1*c2) * p.z ) +
-                    q.z * (       (-c1*s2*c3) * p.x +        (c1*s2*s3) * p.y + (-c1*c2) * p.z );
-
-        sum3      = q.x * (          (-c2*c3) * p.x +           (c2*s3) * p.y) +
-                    q.y * (  (s1*s2*c3-c1*s3) * p.x + (-s1*s2*s3-c1*c3) * p.y) +
-                    q.z * ( (-c1*s2*c3-s1*s3) * p.x +  (c1*s2*s3-s1*c3) * p.y);
-
-        sum4      = q.y * (       (-c1*c2*c3) * p.x +        (c1*c2*s3) * p.y +  (c1*s2) * p.z ) +
-                    q.z * (       (-s1*c2*c3) * p.x +        (s1*c2*s3) * p.y +  (s1*s2) * p.z );
-
-        sum5      = q.y * (  (c1*s2*s3-s1*c3) * p.x +  (c1*s2*c3+s1*s3) * p.y) +
-                    q.z * (  (s1*s2*s3+c1*c3) * p.x +  (s1*s2*c3-c1*s3) * p.y);
-
-        sum6      = q.x * (           (s2*s3) * p.x +           (s2*c3) * p.y) +
-                    q.y * (        (s1*c2*s3) * p.x +        (s1*c2*c3) * p.y) +
-                    q.z * (       (-c1*c2*s3) * p.x +       (-c1*c2*c3) * p.y);
-
-        DF[0][0] += sum1*m_weights_loc[i];
-        DF[1][1] += sum2*m_weights_loc[i];
-        DF[2][2] += sum3*m_weights_loc[i];
-        DF[0][1] += sum4*m_weights_loc[i];
-        DF[1][0] += sum4*m_weights_loc[i];
-        DF[0][2] += sum5*m_weights_loc[i];
-        DF[2][0] += sum5*m_weights_loc[i];
-        DF[1][2] += sum6*m_weights_loc[i];
-        DF[2][1] += sum6*m_weights_loc[i];
+        // pairs farther away than three times the rms error are outliers
+        rms_prev = rms;
+        maxSqrDist = float(9.0*rms*rms);
     }
 
-    return DF;
+    m_MeshWork.Transform(T);
+    return true;
 }
 
 bool best_fit::Comp_Weights()
 {
-	double weight_low = 1, weight_high = 2;
+    double weight_low = 1, weight_high = 2;
     TopExp_Explorer aExpFace;
     MeshCore::MeshKernel FaceMesh;
     MeshCore::MeshFacetArray facetArr;
@@ -930,39 +806,39 @@ bool best_fit::PointNormalTransform(std::vector<Base::Vector3f> &pnts,
 
 bool best_fit::output_best_fit_mesh()
 {
-	
-	SMDS_NodeIteratorPtr aNodeIter = m_meshtobefit->GetMeshDS()->nodesIterator();
+    
+    SMDS_NodeIteratorPtr aNodeIter = m_meshtobefit->GetMeshDS()->nodesIterator();
 
-	for(;aNodeIter->more();) 
-	{
-		const SMDS_MeshNode* aNode = aNodeIter->next();
-		m_meshtobefit->GetMeshDS()->MoveNode(aNode,m_pntCloud_2[(aNode->GetID()-1)].x,m_pntCloud_2[(aNode->GetID()-1)].y,m_pntCloud_2[(aNode->GetID()-1)].z);
-	}
-	m_meshtobefit->ExportUNV("c:/best_fit_mesh.unv");
+    for(;aNodeIter->more();) 
+    {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        m_meshtobefit->GetMeshDS()->MoveNode(aNode,m_pntCloud_2[(aNode->GetID()-1)].x,m_pntCloud_2[(aNode->GetID()-1)].y,m_pntCloud_2[(aNode->GetID()-1)].z);
+    }
+    m_meshtobefit->ExportUNV("c:/best_fit_mesh.unv");
 
-	return true;
+    return true;
 }
 
 bool best_fit::Initialize_Mesh_Geometrie_1()
 {
-	m_aMeshGen1 = new SMESH_Gen();
-	m_referencemesh = m_aMeshGen1->CreateMesh(1,false);
-	m_referencemesh->UNVToMesh("c:/cad_mesh_cenaero.unv");
-
-	m_pntCloud_1.clear();
-
-	//add the nodes
-	SMDS_NodeIteratorPtr aNodeIter = m_referencemesh->GetMeshDS()->nodesIterator();
-	for(;aNodeIter->more();) {
-		const SMDS_MeshNode* aNode = aNodeIter->next();
-		Base::Vector3f a3DVector;
-		a3DVector.Set((float) aNode->X(),(float)  aNode->Y(),(float)  aNode->Z()),
-		m_pntCloud_1.push_back(a3DVector);
+    m_aMeshGen1 = new SMESH_Gen();
+    m_referencemesh = m_aMeshGen1->CreateMesh(1,false);
+    m_referencemesh->UNVToMesh("c:/cad_mesh_cenaero.unv");
+
+    m_pntCloud_1.clear();
+
+    //add the nodes
+    SMDS_NodeIteratorPtr aNodeIter = m_referencemesh->GetMeshDS()->nodesIterator();
+    for(;aNodeIter->more();) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        Base::Vector3f a3DVector;
+        a3DVector.Set((float) aNode->X(),(float)  aNode->Y(),(float)  aNode->Z()),
+        m_pntCloud_1.push_back(a3DVector);
     }
 
 
 
-	return true;
+    return true;
 }
 
 
@@ -970,64 +846,64 @@ bool best_fit::Initialize_Mesh_Geometrie_1()
 bool best_fit::Initialize_Mesh_Geometrie_2()
 {
 
-	m_aMeshGen2 = new SMESH_Gen();
-	m_meshtobefit = m_aMeshGen2->CreateMesh(1,false);
-	m_meshtobefit->UNVToMesh("c:/mesh_cenaero.unv");
-
-	m_pntCloud_2.clear();
-
-	//add the nodes
-	SMDS_NodeIteratorPtr aNodeIter = m_meshtobefit->GetMeshDS()->nodesIterator();
-	for(;aNodeIter->more();) {
-		const SMDS_MeshNode* aNode = aNodeIter->next();
-		Base::Vector3f a3DVector;
-		a3DVector.Set((float) aNode->X(),(float)  aNode->Y(), (float) aNode->Z()),
-		m_pntCloud_2.push_back(a3DVector);
-	}
-
-	////add the 2D edge-Elements
-	//SMDS_EdgeIteratorPtr 	anEdgeIter = Reference_Mesh->GetMeshDS()->edgesIterator();
-	//for(;anEdgeIter->more();) {
-	//	const SMDS_MeshEdge* anElem = anEdgeIter->next();
-	//	myElements.push_back( anElem->GetID() );
-	//}
-	////add the 2D-Planar Elements like triangles 
-	//SMDS_FaceIteratorPtr 	aFaceIter = Reference_Mesh->GetMeshDS()->facesIterator();
-	//for(;aFaceIter->more();) {
-	//	const SMDS_MeshFace* anElem = aFaceIter->next();
-	//	int element_node_count = anElem->NbNodes();
-	//	myElements.push_back( anElem->GetID() );
-	//}
-	////Add the Volume-Elements
-	//SMDS_VolumeIteratorPtr aVolumeIter = Reference_Mesh->GetMeshDS()->volumesIterator();
-	//for(;aVolumeIter->more();) {
-	//	const SMDS_MeshVolume* anElem = aVolumeIter->next();
-	//	myElements.push_back( anElem->GetID() );
-	//}
-
-	//int testsize = myElements.size();
-
-	//SMDS_VolumeTool aTooling;
-
-
-	////Now take the Element-Vector and work with the elements
-	////check validity of element
-	//for (unsigned int i=0;i<myElements.size();i++)
-	//{
-	//	const SMDS_MeshElement* CurrentElement = Reference_Mesh->GetMeshDS()->FindElement(myElements[i]);
-	//	if (CurrentElement->GetType() == SMDSAbs_Volume) 
-	//	{
-	//		//We encountered a Surface-Element like a triangle and we have to check if its a triangle or not
-	//		aTooling.Set(CurrentElement);
-	//		//Now we have to check what kind of volume element we have
-	//		if(aTooling.GetVolumeType()== SMDS_VolumeTool::HEXA)
-	//		{
-	//			//Found a HEXA Element
-	//		}
-	//	}
-	//}
-
-	return true;
+    m_aMeshGen2 = new SMESH_Gen();
+    m_meshtobefit = m_aMeshGen2->CreateMesh(1,false);
+    m_meshtobefit->UNVToMesh("c:/mesh_cenaero.unv");
+
+    m_pntCloud_2.clear();
+
+    //add the nodes
+    SMDS_NodeIteratorPtr aNodeIter = m_meshtobefit->GetMeshDS()->nodesIterator();
+    for(;aNodeIter->more();) {
+        const SMDS_MeshNode* aNode = aNodeIter->next();
+        Base::Vector3f a3DVector;
+        a3DVector.Set((float) aNode->X(),(float)  aNode->Y(), (float) aNode->Z()),
+        m_pntCloud_2.push_back(a3DVector);
+    }
+
+    ////add the 2D edge-Elements
+    //SMDS_EdgeIteratorPtr 	anEdgeIter = Reference_Mesh->GetMeshDS()->edgesIterator();
+    //for(;anEdgeIter->more();) {
+    //	const SMDS_MeshEdge* anElem = anEdgeIter->next();
+    //	myElements.push_back( anElem->GetID() );
+    //}
+    ////add the 2D-Planar Elements like triangles 
+    //SMDS_FaceIteratorPtr 	aFaceIter = Reference_Mesh->GetMeshDS()->facesIterator();
+    //for(;aFaceIter->more();) {
+    //	const SMDS_MeshFace* anElem = aFaceIter->next();
+    //	int element_node_count = anElem->NbNodes();
+    //	myElements.push_back( anElem->GetID() );
+    //}
+    ////Add the Volume-Elements
+    //SMDS_VolumeIteratorPtr aVolumeIter = Reference_Mesh->GetMeshDS()->volumesIterator();
+    //for(;aVolumeIter->more();) {
+    //	const SMDS_MeshVolume* anElem = aVolumeIter->next();
+    //	myElements.push_back( anElem->GetID() );
+    //}
+
+    //int testsize = myElements.size();
+
+    //SMDS_VolumeTool aTooling;
+
+
+    ////Now take the Element-Vector and work with the elements
+    ////check validity of element
+    //for (unsigned int i=0;i<myElements.size();i++)
+    //{
+    //	const SMDS_MeshElement* CurrentElement = Reference_Mesh->GetMeshDS()->FindElement(myElements[i]);
+    //	if (CurrentElement->GetType() == SMDSAbs_Volume) 
+    //	{
+    //		//We encountered a Surface-Element like a triangle and we have to check if its a triangle or not
+    //		aTooling.Set(CurrentElement);
+    //		//Now we have to check what kind of volume element we have
+    //		if(aTooling.GetVolumeType()== SMDS_VolumeTool::HEXA)
+    //		{
+    //			//Found a HEXA Element
+    //		}
+    //	}
+    //}
+
+    return true;
 }
 
 bool best_fit::PointTransform(std::vector<Base::Vector3f> &pnts, const Base::Matrix4D &M)
@@ -1049,167 +925,167 @@ bool best_fit::PointTransform(std::vector<Base::Vector3f> &pnts, const Base::Mat
 
 bool best_fit::PointCloud_Coarse()
 {
-	GProp_GProps prop;
-	GProp_PrincipalProps pprop;
+    GProp_GProps prop;
+    GProp_PrincipalProps pprop;
 
-	MeshCore::PlaneFit FitFunc_1, FitFunc_2;
+    MeshCore::PlaneFit FitFunc_1, FitFunc_2;
 
-	Base::Vector3f pnt(0.0,0.0,0.0);
-	Base::Vector3f DirA_1, DirB_1, DirC_1, Grav_1,
-  		           DirA_2, DirB_2, DirC_2, Grav_2;
-	Base::Vector3f x,y,z;
-	Base::Builder3D log3d_mesh, log3d_cad;
-	gp_Pnt orig;
+    Base::Vector3f pnt(0.0,0.0,0.0);
+    Base::Vector3f DirA_1, DirB_1, DirC_1, Grav_1,
+                   DirA_2, DirB_2, DirC_2, Grav_2;
+    Base::Vector3f x,y,z;
+    Base::Builder3D log3d_mesh, log3d_cad;
+    gp_Pnt orig;
 
-	gp_Vec v1,v2,v3,v,vec; // Hauptachsenrichtungen
-	gp_Trsf trafo;
+    gp_Vec v1,v2,v3,v,vec; // Hauptachsenrichtungen
+    gp_Trsf trafo;
 
-	FitFunc_1.Clear();
-	FitFunc_2.Clear();
+    FitFunc_1.Clear();
+    FitFunc_2.Clear();
 
-	FitFunc_1.AddPoints(m_pntCloud_1);
-	FitFunc_2.AddPoints(m_pntCloud_2);
-	
-	FitFunc_1.Fit();
-	FitFunc_2.Fit();
+    FitFunc_1.AddPoints(m_pntCloud_1);
+    FitFunc_2.AddPoints(m_pntCloud_2);
+    
+    FitFunc_1.Fit();
+    FitFunc_2.Fit();
 
-	DirA_1 = FitFunc_1.GetDirU();
-	DirB_1 = FitFunc_1.GetDirV();
-	DirC_1 = FitFunc_1.GetNormal();
-	Grav_1 = FitFunc_1.GetGravity();
+    DirA_1 = FitFunc_1.GetDirU();
+    DirB_1 = FitFunc_1.GetDirV();
+    DirC_1 = FitFunc_1.GetNormal();
+    Grav_1 = FitFunc_1.GetGravity();
 
-	m_cad2orig.SetX(-Grav_1.x);
-	m_cad2orig.SetY(-Grav_1.y);
-	m_cad2orig.SetZ(-Grav_1.z);
+    m_cad2orig.SetX(-Grav_1.x);
+    m_cad2orig.SetY(-Grav_1.y);
+    m_cad2orig.SetZ(-Grav_1.z);
 
-	DirA_2 = FitFunc_2.GetDirU();
-	DirB_2 = FitFunc_2.GetDirV();
-	DirC_2 = FitFunc_2.GetNormal();
-	Grav_2 = FitFunc_2.GetGravity();
+    DirA_2 = FitFunc_2.GetDirU();
+    DirB_2 = FitFunc_2.GetDirV();
+    DirC_2 = FitFunc_2.GetNormal();
+    Grav_2 = FitFunc_2.GetGravity();
 
-	Base::Matrix4D T5, T1;
+    Base::Matrix4D T5, T1;
 
-	// Fllt Matrix T5 
-	T5[0][0] = DirA_1.x;
-	T5[1][0] = DirA_1.y;
-	T5[2][0] = DirA_1.z;
+    // Fllt Matrix T5 
+    T5[0][0] = DirA_1.x;
+    T5[1][0] = DirA_1.y;
+    T5[2][0] = DirA_1.z;
 
-	T5[0][1] = DirB_1.x;
-	T5[1][1] = DirB_1.y;
-	T5[2][1] = DirB_1.z;
+    T5[0][1] = DirB_1.x;
+    T5[1][1] = DirB_1.y;
+    T5[2][1] = DirB_1.z;
 
-	T5[0][2] = DirC_1.x;
-	T5[1][2] = DirC_1.y;
-	T5[2][2] = DirC_1.z;
+    T5[0][2] = DirC_1.x;
+    T5[1][2] = DirC_1.y;
+    T5[2][2] = DirC_1.z;
 
-	T5[0][3] = Grav_1.x;
-	T5[1][3] = Grav_1.y;
-	T5[2][3] = Grav_1.z;
+    T5[0][3] = Grav_1.x;
+    T5[1][3] = Grav_1.y;
+    T5[2][3] = Grav_1.z;
 
-	/*T5[0][0] = DirA_1.x;
-	T5[0][1] = DirA_1.y;
-	T5[0][2] = DirA_1.z;
+    /*T5[0][0] = DirA_1.x;
+    T5[0][1] = DirA_1.y;
+    T5[0][2] = DirA_1.z;
 
-	T5[1][0] = DirB_1.x;
-	T5[1][1] = DirB_1.y;
-	T5[1][2] = DirB_1.z;
+    T5[1][0] = DirB_1.x;
+    T5[1][1] = DirB_1.y;
+    T5[1][2] = DirB_1.z;
 
-	T5[2][0] = DirC_1.x;
-	T5[2][1] = DirC_1.y;
-	T5[2][2] = DirC_1.z;
+    T5[2][0] = DirC_1.x;
+    T5[2][1] = DirC_1.y;
+    T5[2][2] = DirC_1.z;
 
-	T5[0][3] = Grav_1.x;
-	T5[1][3] = Grav_1.y;
-	T5[2][3] = Grav_1.z;*/
+    T5[0][3] = Grav_1.x;
+    T5[1][3] = Grav_1.y;
+    T5[2][3] = Grav_1.z;*/
 
 
-	// Fllt Matrix T1
-	T1[0][0] = DirA_2.x;
-	T1[1][0] = DirA_2.y;
-	T1[2][0] = DirA_2.z;
+    // Fllt Matrix T1
+    T1[0][0] = DirA_2.x;
+    T1[1][0] = DirA_2.y;
+    T1[2][0] = DirA_2.z;
 
-	T1[0][1] = DirB_2.x;
-	T1[1][1] = DirB_2.y;
-	T1[2][1] = DirB_2.z;
+    T1[0][1] = DirB_2.x;
+    T1[1][1] = DirB_2.y;
+    T1[2][1] = DirB_2.z;
 
-	T1[0][2] = DirC_2.x;
-	T1[1][2] = DirC_2.y;
-	T1[2][2] = DirC_2.z;
+    T1[0][2] = DirC_2.x;
+    T1[1][2] = DirC_2.y;
+    T1[2][2] = DirC_2.z;
 
-	T1[0][3] = Grav_2.x;
-	T1[1][3] = Grav_2.y;
-	T1[2][3] = Grav_2.z;
+    T1[0][3] = Grav_2.x;
+    T1[1][3] = Grav_2.y;
+    T1[2][3] = Grav_2.z;
 
-	v1.SetX(T5[0][0]);v1.SetY(T5[0][1]);v1.SetZ(T5[0][2]);
-	v2.SetX(T5[1][0]);v2.SetY(T5[1][1]);v2.SetZ(T5[1][2]);
-	v3.SetX(T5[2][0]);v3.SetY(T5[2][1]);v3.SetZ(T5[2][2]);
+    v1.SetX(T5[0][0]);v1.SetY(T5[0][1]);v1.SetZ(T5[0][2]);
+    v2.SetX(T5[1][0]);v2.SetY(T5[1][1]);v2.SetZ(T5[1][2]);
+    v3.SetX(T5[2][0]);v3.SetY(T5[2][1]);v3.SetZ(T5[2][2]);
 
-	v1.Normalize();
-	v2.Normalize();
-	v3.Normalize();
+    v1.Normalize();
+    v2.Normalize();
+    v3.Normalize();
 
-	v = v1;
-	v.Cross(v2);
+    v = v1;
+    v.Cross(v2);
 
-	// right-hand-system check
-	if ( v.Dot(v3) < 0.0 )
-		v3 *= -1;
+    // right-hand-system check
+    if ( v.Dot(v3) < 0.0 )
+        v3 *= -1;
 
-	T1.inverse();
+    T1.inverse();
 
-	orig.SetX(T5[0][3]);orig.SetY(T5[1][3]);orig.SetZ(T5[2][3]);
+    orig.SetX(T5[0][3]);orig.SetY(T5[1][3]);orig.SetZ(T5[2][3]);
 
-	// plot CAD -> local coordinate system
+    // plot CAD -> local coordinate system
 
-	x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
-	y.x =  50.0f*(float)v2.X();	y.y =  50.0f*(float)v2.Y();	y.z =  50.0f*(float)v2.Z();
-	z.x =  50.0f*(float)v3.X();	z.y =  50.0f*(float)v3.Y();	z.z =  50.0f*(float)v3.Z();
+    x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
+    y.x =  50.0f*(float)v2.X();	y.y =  50.0f*(float)v2.Y();	y.z =  50.0f*(float)v2.Z();
+    z.x =  50.0f*(float)v3.X();	z.y =  50.0f*(float)v3.Y();	z.z =  50.0f*(float)v3.Z();
 
-	pnt.x = (float) orig.X();
-	pnt.y = (float) orig.Y();
-	pnt.z = (float) orig.Z();
+    pnt.x = (float) orig.X();
+    pnt.y = (float) orig.Y();
+    pnt.z = (float) orig.Z();
 
-	log3d_cad.addSingleArrow(pnt,x,3,1,0,0);
-	log3d_cad.addSingleArrow(pnt,y,3,0,1,0);
-	log3d_cad.addSingleArrow(pnt,z,3,0,0,1);
+    log3d_cad.addSingleArrow(pnt,x,3,1,0,0);
+    log3d_cad.addSingleArrow(pnt,y,3,0,1,0);
+    log3d_cad.addSingleArrow(pnt,z,3,0,0,1);
 
-	//log3d_cad.addSinglePoint(pnt,6,1,1,1);
+    //log3d_cad.addSinglePoint(pnt,6,1,1,1);
 
-	log3d_cad.saveToFile("c:/CAD_CoordSys.iv");
+    log3d_cad.saveToFile("c:/CAD_CoordSys.iv");
 
-	PointTransform(m_pntCloud_2,T5*T1);
+    PointTransform(m_pntCloud_2,T5*T1);
 
-	//m_MeshWork.Transform(T1);
-	// plot Mesh -> local coordinate system
+    //m_MeshWork.Transform(T1);
+    // plot Mesh -> local coordinate system
 
-	v1.SetX(T1[0][0]);v1.SetY(T1[0][1]);v1.SetZ(T1[0][2]);
-	v2.SetX(T1[1][0]);v2.SetY(T1[1][1]);v2.SetZ(T1[1][2]);
-	v3.SetX(T1[2][0]);v3.SetY(T1[2][1]);v3.SetZ(T1[2][2]);
+    v1.SetX(T1[0][0]);v1.SetY(T1[0][1]);v1.SetZ(T1[0][2]);
+    v2.SetX(T1[1][0]);v2.SetY(T1[1][1]);v2.SetZ(T1[1][2]);
+    v3.SetX(T1[2][0]);v3.SetY(T1[2][1]);v3.SetZ(T1[2][2]);
 
-	T1.inverse();
-	orig.SetX(T1[0][3]);orig.SetY(T1[1][3]);orig.SetZ(T1[2][3]);
+    T1.inverse();
+    orig.SetX(T1[0][3]);orig.SetY(T1[1][3]);orig.SetZ(T1[2][3]);
 
-	x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
-	y.x =  50.0f*(float)v2.X();	y.y =  50.0f*(float)v2.Y();	y.z =  50.0f*(float)v2.Z();
-	z.x =  50.0f*(float)v3.X();	z.y =  50.0f*(float)v3.Y();	z.z =  50.0f*(float)v3.Z();
+    x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
+    y.x =  50.0f*(float)v2.X();	y.y =  50.0f*(float)v2.Y();	y.z =  50.0f*(float)v2.Z();
+    z.x =  50.0f*(float)v3.X();	z.y =  50.0f*(float)v3.Y();	z.z =  50.0f*(float)v3.Z();
 
-	pnt.x = (float) orig.X();
-	pnt.y = (float) orig.Y();
-	pnt.z = (float) orig.Z();
+    pnt.x = (float) orig.X();
+    pnt.y = (float) orig.Y();
+    pnt.z = (float) orig.Z();
 
-	log3d_mesh.addSingleArrow(pnt,x,3,1,0,0);log3d_mesh.addSingleArrow(pnt,y,3,0,1,0);log3d_mesh.addSingleArrow(pnt,z,3,0,0,1);
-	log3d_mesh.addSinglePoint(0,0,0,20,1,1,1); // plotte Ursprung
-	//log3d_mesh.addSinglePoint(pnt,6,0,0,0);
-	log3d_mesh.saveToFile("c:/Mesh_CoordSys.iv");
+    log3d_mesh.addSingleArrow(pnt,x,3,1,0,0);log3d_mesh.addSingleArrow(pnt,y,3,0,1,0);log3d_mesh.addSingleArrow(pnt,z,3,0,0,1);
+    log3d_mesh.addSinglePoint(0,0,0,20,1,1,1); // plotte Ursprung
+    //log3d_mesh.addSinglePoint(pnt,6,0,0,0);
+    log3d_mesh.saveToFile("c:/Mesh_CoordSys.iv");
 
-	/*for(int i=0; i< m_pntCloud_2.size(); i++)
-	{
-		m_pntCloud_2[i].x = m_pntCloud_2[i].x + Grav_1.x - Grav_2.x;
-		m_pntCloud_2[i].y = m_pntCloud_2[i].y + Grav_1.y - Grav_2.y;
-		m_pntCloud_2[i].z = m_pntCloud_2[i].z + Grav_1.z - Grav_2.z;
-	}*/
+    /*for(int i=0; i< m_pntCloud_2.size(); i++)
+    {
+        m_pntCloud_2[i].x = m_pntCloud_2[i].x + Grav_1.x - Grav_2.x;
+        m_pntCloud_2[i].y = m_pntCloud_2[i].y + Grav_1.y - Grav_2.y;
+        m_pntCloud_2[i].z = m_pntCloud_2[i].z + Grav_1.z - Grav_2.z;
+    }*/
 
-	return true;
+    return true;
 }
 bool best_fit::MeshFit_Coarse()
 {
@@ -1232,11 +1108,11 @@ bool best_fit::MeshFit_Coarse()
     v2 = pprop.SecondAxisOfInertia();
     v3 = pprop.ThirdAxisOfInertia();*/
 
-	MeshCore::MeshEigensystem pca(m_CadMesh);
+    MeshCore::MeshEigensystem pca(m_CadMesh);
     pca.Evaluate();
     Base::Matrix4D T5 =  pca.Transform();
 
-	v1.SetX(T5[0][0]);v1.SetY(T5[0][1]);v1.SetZ(T5[0][2]);
+    v1.SetX(T5[0][0]);v1.SetY(T5[0][1]);v1.SetZ(T5[0][2]);
     v2.SetX(T5[1][0]);v2.SetY(T5[1][1]);v2.SetZ(T5[1][2]);
     v3.SetX(T5[2][0]);v3.SetY(T5[2][1]);v3.SetZ(T5[2][2]);
 
@@ -1252,37 +1128,37 @@ bool best_fit::MeshFit_Coarse()
     if ( v.Dot(v3) < 0.0 )
         v3 *= -1;
 
-	T5.inverse();
+    T5.inverse();
 
     orig.SetX(T5[0][3]);orig.SetY(T5[1][3]);orig.SetZ(T5[2][3]);
     //orig  = prop.CentreOfMass();
 
     // plot CAD -> local coordinate system
 
-	x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
+    x.x =  50.0f*(float)v1.X();	x.y =  50.0f*(float)v1.Y();	x.z =  50.0f*(float)v1.Z();
     y.x =  50.0f*(float)v2.X();	y.y =  50.0f*(float)v2.Y();	y.z =  50.0f*(float)v2.Z();
     z.x =  50.0f*(float)v3.X();	z.y =  50.0f*(float)v3.Y();	z.z =  50.0f*(float)v3.Z();
 
     pnt.x = (float) orig.X();
-	pnt.y = (float) orig.Y();
-	pnt.z = (float) orig.Z();
+    pnt.y = (float) orig.Y();
+    pnt.z = (float) orig.Z();
 
     log3d_cad.addSingleArrow(pnt,x,3,1,0,0);
-	log3d_cad.addSingleArrow(pnt,y,3,0,1,0);
-	log3d_cad.addSingleArrow(pnt,z,3,0,0,1);
-	
-	//log3d_cad.addSinglePoint(pnt,6,1,1,1);
-	
-	log3d_cad.saveToFile("c:/CAD_CoordSys.iv");
+    log3d_cad.addSingleArrow(pnt,y,3,0,1,0);
+    log3d_cad.addSingleArrow(pnt,z,3,0,0,1);
+    
+    //log3d_cad.addSinglePoint(pnt,6,1,1,1);
+    
+    log3d_cad.saveToFile("c:/CAD_CoordSys.iv");
 
     MeshCore::MeshEigensystem pca2(m_MeshWork);
     pca2.Evaluate();
     Base::Matrix4D T1 =  pca2.Transform();
     m_MeshWork.Transform(T5*T1);
-	//m_MeshWork.Transform(T1);
+    //m_MeshWork.Transform(T1);
     // plot Mesh -> local coordinate system
 
-	
+    
     v1.SetX(T1[0][0]);v1.SetY(T1[0][1]);v1.SetZ(T1[0][2]);
     v2.SetX(T1[1][0]);v2.SetY(T1[1][1]);v2.SetZ(T1[1][2]);
     v3.SetX(T1[2][0]);v3.SetY(T1[2][1]);v3.SetZ(T1[2][2]);
@@ -1292,18 +1168,18 @@ bool best_fit::MeshFit_Coarse()
     T1.inverse();
     orig.SetX(T1[0][3]);orig.SetY(T1[1][3]);orig.SetZ(T1[2][3]);
 
-	x.x = 50.0f*(float)v1.X();	x.y = 50.0f*(float)v1.Y();	x.z = 50.0f*(float)v1.Z();
+    x.x = 50.0f*(float)v1.X();	x.y = 50.0f*(float)v1.Y();	x.z = 50.0f*(float)v1.Z();
     y.x = 50.0f*(float)v2.X();	y.y = 50.0f*(float)v2.Y();	y.z = 50.0f*(float)v2.Z();
     z.x = 50.0f*(float)v3.X();	z.y = 50.0f*(float)v3.Y();	z.z = 50.0f*(float)v3.Z();
 
     pnt.x = (float) orig.X();
-	pnt.y = (float) orig.Y();
-	pnt.z = (float) orig.Z();
+    pnt.y = (float) orig.Y();
+    pnt.z = (float) orig.Z();
 
-	log3d_mesh.addSingleArrow(pnt,x,3,1,0,0);log3d_mesh.addSingleArrow(pnt,y,3,0,1,0);log3d_mesh.addSingleArrow(pnt,z,3,0,0,1);
-	log3d_mesh.addSinglePoint(0,0,0,20,1,1,1); // plotte Ursprung
+    log3d_mesh.addSingleArrow(pnt,x,3,1,0,0);log3d_mesh.addSingleArrow(pnt,y,3,0,1,0);log3d_mesh.addSingleArrow(pnt,z,3,0,0,1);
+    log3d_mesh.addSinglePoint(0,0,0,20,1,1,1); // plotte Ursprung
     //log3d_mesh.addSinglePoint(pnt,6,0,0,0);
-	log3d_mesh.saveToFile("c:/Mesh_CoordSys.iv");
+    log3d_mesh.saveToFile("c:/Mesh_CoordSys.iv");
 
     return true;
 }
@@ -1350,8 +1226,8 @@ bool best_fit::Tesselate_Face(const TopoDS_Face &aface, MeshCore::MeshKernel &me
 /*The next two lines have been from the occ6.2 adapt mesh library. They do not work within OCC6.3
       TriangleAdapt_Parameters MeshingParams;
        BRepMeshAdapt::Mesh(aface,deflection,MeshingParams);
-																*/
-	   BRepMesh_IncrementalMesh Mesh(aface,deflection);
+                                                                */
+       BRepMesh_IncrementalMesh Mesh(aface,deflection);
     }
     TopLoc_Location aLocation;
     // takes the triangulation of the face aFace:
@@ -1434,9 +1310,9 @@ bool best_fit::Tesselate_Shape(const TopoDS_Shape &shape, MeshCore::MeshKernel &
     //MeshParams._minNbPntsPerEdgeLine = 3;
     //MeshParams._minNbPntsPerEdgeOther = 3;
     //MeshParams._minEdgeSplit = 3;
-	MeshParams._maxTriangleSideSize = 10; //10
-	MeshParams._maxArea = 10; //50
-	*/
+    MeshParams._maxTriangleSideSize = 10; //10
+    MeshParams._maxArea = 10; //50
+    */
     BRepMesh_IncrementalMesh Mesh(shape,deflection);
     //BRepMesh::Mesh(shape,deflection);
     TopExp_Explorer aExpFace;
@@ -1518,12 +1394,12 @@ std::vector<Base::Vector3f> best_fit::Comp_Normals(MeshCore::MeshKernel &M)
         origPoint.y = mPnt.y;
         origPoint.z = mPnt.z;
 
-        const std::set<unsigned long>& faceSet = rf2pt[i];
+        MeshCore::MeshIndexSpan faceSet = rf2pt[i];
         fArea = 0.0;
         normal.Set(0.0,0.0,0.0);
 
         // Iteriere ber die Dreiecke zu jedem Punkt
-        for (std::set<unsigned long>::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
+        for (MeshCore::MeshIndexSpan::const_iterator it = faceSet.begin(); it != faceSet.end(); ++it)
         {
             // Zweimal derefernzieren, um an das MeshFacet zu kommen und dem Kernel uebergeben, dass er ein MeshGeomFacet liefert
             t_face = M.GetFacet(*it);
@@ -1737,7 +1613,7 @@ double best_fit::CompTotalError()
     unsigned int c=0;
     int i=0;
 
-	
+    
     m_LSPnts[0].clear();
     m_LSPnts[1].clear();
     for (p_it.Begin(); p_it.More(); p_it.Next())
@@ -1748,7 +1624,7 @@ double best_fit::CompTotalError()
             distVec  = projPoint - *p_it;
             sqrdis   = distVec*distVec;
 
-			m_LSPnts[1].push_back(*p_it);
+            m_LSPnts[1].push_back(*p_it);
             m_LSPnts[0].push_back(projPoint);
 
             if (((projPoint.z - p_it->z) / m_normals[i].z ) > 0)
@@ -1770,22 +1646,22 @@ double best_fit::CompTotalError()
                 //log3d.addText(*p_it,(text.str()).c_str());
             }
             else
-			{
-				log3d.addSingleArrow(*p_it, projPoint, 3, 0,0,0);
-				distVec  = projPoint - *p_it;
-				sqrdis   = distVec*distVec;
-
-				m_LSPnts[1].push_back(*p_it);
-				m_LSPnts[0].push_back(projPoint);
-
-				if (((projPoint.z - p_it->z) / m_normals[i].z ) > 0)
-					m_error[i] = sqrt(sqrdis);
-				else
-					m_error[i] = -sqrt(sqrdis);
-
-				err_avg += sqrdis;
-			}
-		}
+            {
+                log3d.addSingleArrow(*p_it, projPoint, 3, 0,0,0);
+                distVec  = projPoint - *p_it;
+                sqrdis   = distVec*distVec;
+
+                m_LSPnts[1].push_back(*p_it);
+                m_LSPnts[0].push_back(projPoint);
+
+                if (((projPoint.z - p_it->z) / m_normals[i].z ) > 0)
+                    m_error[i] = sqrt(sqrdis);
+                else
+                    m_error[i] = -sqrt(sqrdis);
+
+                err_avg += sqrdis;
+            }
+        }
         
 
         ++i;
@@ -1852,10 +1728,10 @@ double best_fit::CompTotalError()
     MeshCore::MeshRefPointToPoints vv_it(m_CadMesh);
     MeshCore::MeshPointArray::_TConstIterator v_beg = m_CadMesh.GetPoints().begin();
 
-    std::set<unsigned long>::const_iterator v_it;
+    MeshCore::MeshIndexSpan::const_iterator v_it;
     for (unsigned int i=0; i<FailProj.size(); ++i)
     {
-        const std::set<unsigned long>& PntNei = vv_it[FailProj[i]];
+        MeshCore::MeshIndexSpan PntNei = vv_it[FailProj[i]];
         m_error[FailProj[i]] = 0.0;
 
         for (v_it = PntNei.begin(); v_it !=PntNei.end(); ++v_it)
@@ -1917,21 +1793,21 @@ double best_fit::CompTotalError(MeshCore::MeshKernel &mesh)
             if (!malg2.NearestFacetOnRay(*p_it, m_normals[i], projPoint, facetIndex))   // nicht gridoptimiert
             {
                 c++;
-				FailProj.push_back(i);
+                FailProj.push_back(i);
             }
             else
-			{
-				distVec  = projPoint - *p_it;
-				sqrdis   = distVec*distVec;
-
-				if (((projPoint.z - p_it->z) / m_normals[i].z ) > 0)
-					m_error[i] += sqrt(sqrdis);
-				else
-					m_error[i] += -sqrt(sqrdis);
-
-				err_avg += sqrdis;
-			}
-		}
+            {
+                distVec  = projPoint - *p_it;
+                sqrdis   = distVec*distVec;
+
+                if (((projPoint.z - p_it->z) / m_normals[i].z ) > 0)
+                    m_error[i] += sqrt(sqrdis);
+                else
+                    m_error[i] += -sqrt(sqrdis);
+
+                err_avg += sqrdis;
+            }
+        }
         
 
         ++i;
@@ -1940,20 +1816,20 @@ double best_fit::CompTotalError(MeshCore::MeshKernel &mesh)
     MeshCore::MeshRefPointToPoints vv_it(m_CadMesh);
     MeshCore::MeshPointArray::_TConstIterator v_beg = m_CadMesh.GetPoints().begin();
 
-	double error;
-	std::set<unsigned long>::const_iterator v_it;
+    double error;
+    MeshCore::MeshIndexSpan::const_iterator v_it;
     for (unsigned int i=0; i<FailProj.size(); ++i)
     {
-        const std::set<unsigned long>& PntNei = vv_it[FailProj[i]];
-		error = 0.0;
+        MeshCore::MeshIndexSpan PntNei = vv_it[FailProj[i]];
+        error = 0.0;
 
 
         for (v_it = PntNei.begin(); v_it !=PntNei.end(); ++v_it)
         {
-			error += m_error[v_beg[*v_it]._ulProp];
+            error += m_error[v_beg[*v_it]._ulProp];
         }
 
-		error /= double(PntNei.size());
+        error /= double(PntNei.size());
         m_error[FailProj[i]] += error;
     }
 
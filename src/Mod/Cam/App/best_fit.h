@@ -47,7 +47,8 @@
 
  As output, it gives a transformed mesh (rotation + translation)
  based on a weighted ICP-Algorithm (ICP: Iterative Closed Point) wich fits the
- Topo_Shape
+ Topo_Shape. The nearest neighbours are searched with a kd_tree in parallel and
+ the timing and error of each iteration are written to the log.
 */
 
 class CamExport best_fit
@@ -105,7 +106,7 @@ public:
                average-error-value
     */
     double CompTotalError(MeshCore::MeshKernel &mesh);
-	
+    
     /*! \brief Computes a triangulation on shape.
 
         \param shape      specifies the shape to be tesselated
@@ -114,7 +115,7 @@ public:
                           triangulation
     */
     static bool Tesselate_Shape(const TopoDS_Shape &shape, MeshCore::MeshKernel &mesh, float deflection);
-	
+    
     /*! \brief Computes a triangulation on aface.
 
         \param aface      specifies the face to be tesselated
@@ -130,14 +131,16 @@ public:
         \param Mesh Input-Mesh
     */
     static std::vector<Base::Vector3f> Comp_Normals(MeshCore::MeshKernel &Mesh);
-	
+    
     /*! \brief Check and corrects mesh-position by rotating around all
-               coordinate-axes with 180 degree
+               coordinate-axes with 180 degree. The candidates are rated on a
+               sample of the mesh points.
     */
     bool Coarse_correction();
 
-    /*! \brief Determines two corresponding point-sets for the ICP-Method
-               using the Nearest-Neighbour-Algorithm
+    /*! \brief Determines two corresponding point-sets using the
+               Nearest-Neighbour-Algorithm and returns the mean squared
+               distance
     */
     double ANN();
 
@@ -154,8 +157,8 @@ public:
     MeshCore::MeshKernel m_CadMesh;  // Netz aus CAD-Triangulierung
 
 
-	std::vector<Base::Vector3f> m_pntCloud_1;
-	std::vector<Base::Vector3f> m_pntCloud_2;
+    std::vector<Base::Vector3f> m_pntCloud_1;
+    std::vector<Base::Vector3f> m_pntCloud_2;
 
 
     /*! \brief Stores the knots of m_CadMesh in relative order */
@@ -191,7 +194,7 @@ private:
         \param rotationAxis rotation-axis (1: x-axis, 2: y-axis, 3: z-axis)
     */
     inline bool RotMat(Base::Matrix4D &matrix, double degree, int rotationAxis);
-	
+    
     /*! \brief Computes the translation-matrix with reference to the given
                parameters
 
@@ -200,7 +203,7 @@ private:
         \param translationAxis translation-axis (1: x-axis, 2: y-axis, 3: z-axis)
     */
     inline bool TransMat(Base::Matrix4D &matrix, double translation, int translationAxis);
-	
+    
     /*! \brief Tranforms the point-set \p pnts and the corresponding
                surface-normals normals with reference to the input-matrix
 
@@ -211,46 +214,35 @@ private:
     inline bool PointNormalTransform(std::vector<Base::Vector3f> &pnts,
                                      std::vector<Base::Vector3f> &normals,
                                      Base::Matrix4D              &M);
-	
+    
     /*! \brief Tranforms the point-set pnts with reference to the input-matrix
 
         \param pnts point-vector to transform
         \param M    is the 4x4-input-matrix
     */
     bool PointTransform(std::vector<Base::Vector3f> &pnts, const Base::Matrix4D &M);
-	
+    
     /*! \brief Sets the weights for the ICP-Algorithm */
     bool Comp_Weights();
 
-    /*! \brief Performing the ICP-Algorithm */
-    bool LSM();
-
-    /*! \brief Returns the first derivative of the rotation-matrix at the
-               position x
-
-        \param params is a three-dimensional-vector specifying the rotation
-                      angle along the x-,y- and z-axis
-     */
-    std::vector<double> Comp_Jacobi(const std::vector<double> &params);
+    /*! \brief Performing the ICP-Algorithm
 
-    /*! \brief Returns the second derivative (Hessian matrix) of the rotation
-               matrix at the position x in form of a two-dimensional vector
-               of type double
-
-        \param params is a three-dimensional-vector specifying the rotation
-                      angle along the x-,y- and z-axis
+        Each iteration pairs the mesh points with their nearest CAD points
+        and minimizes the weighted distances to the tangent planes at the
+        CAD points. Pairs farther away than three times the last rms error
+        are ignored.
     */
-    std::vector<std::vector<double> > Comp_Hess (const std::vector<double> &params);
+    bool LSM();
 
     SMESH_Mesh *m_referencemesh;
     SMESH_Mesh *m_meshtobefit;
     SMESH_Gen *m_aMeshGen1;
     SMESH_Gen *m_aMeshGen2;
 
-	
     
-	//int intersect_RayTriangle(const Base::Vector3f &normal,const MeshCore::MeshGeomFacet &T, Base::Vector3f &P, Base::Vector3f &I);
-	// bool Intersect(const Base::Vector3f &normal,const MeshCore::MeshKernel &mesh, Base::Vector3f &P, Base::Vector3f &I);
+    
+    //int intersect_RayTriangle(const Base::Vector3f &normal,const MeshCore::MeshGeomFacet &T, Base::Vector3f &P, Base::Vector3f &I);
+    // bool Intersect(const Base::Vector3f &normal,const MeshCore::MeshKernel &mesh, Base::Vector3f &P, Base::Vector3f &I);
 };
 
 #endif
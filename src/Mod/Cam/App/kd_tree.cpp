@@ -0,0 +1,184 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+#endif
+
+#include <Base/BoundBox.h>
+
+#include "kd_tree.h"
+
+#define LEAF_SIZE 8
+
+
+namespace {
+
+struct AxisCompare
+{
+    AxisCompare(const std::vector<Base::Vector3f> &p, int a) : pnts(p), axis(a)
+    {
+    }
+    bool operator()(int i, int j) const
+    {
+        return pnts[i][axis] < pnts[j][axis];
+    }
+
+    const std::vector<Base::Vector3f> &pnts;
+    unsigned short axis;
+};
+
+}
+
+kd_tree::kd_tree()
+{
+}
+
+kd_tree::kd_tree(const std::vector<Base::Vector3f> &pnts)
+{
+    Build(pnts);
+}
+
+kd_tree::~kd_tree()
+{
+}
+
+void kd_tree::Build(const std::vector<Base::Vector3f> &pnts)
+{
+    m_nodes.clear();
+    m_pnts.clear();
+    m_index.resize(pnts.size());
+    for (unsigned int i=0; i<m_index.size(); ++i)
+        m_index[i] = i;
+
+    if (pnts.empty())
+        return;
+
+    m_nodes.reserve(2*pnts.size()/LEAF_SIZE + 1);
+    m_nodes.push_back(Node());
+    BuildNode(0, 0, pnts.size(), pnts);
+
+    // store the points in the order of the leaves to keep the queries local
+    m_pnts.resize(pnts.size());
+    for (unsigned int i=0; i<m_index.size(); ++i)
+        m_pnts[i] = pnts[m_index[i]];
+}
+
+void kd_tree::BuildNode(unsigned int node, unsigned int first, unsigned int last,
+                        const std::vector<Base::Vector3f> &pnts)
+{
+    if (last - first <= LEAF_SIZE)
+    {
+        Node& leaf = m_nodes[node];
+        leaf.split = 0.0f;
+        leaf.axis  = -1;
+        leaf.first = first;
+        leaf.last  = last;
+        leaf.child = 0;
+        return;
+    }
+
+    // split at the median of the widest extent
+    Base::BoundBox3f box;
+    for (unsigned int i=first; i<last; ++i)
+        box.Add(pnts[m_index[i]]);
+
+    int axis = 0;
+    if (box.LengthY() > box.LengthX())
+        axis = 1;
+    if (box.LengthZ() > (axis == 0 ? box.LengthX() : box.LengthY()))
+        axis = 2;
+
+    unsigned int mid = (first + last) / 2;
+    std::nth_element(m_index.begin()+first, m_index.begin()+mid, m_index.begin()+last,
+                     AxisCompare(pnts, axis));
+
+    unsigned int child = m_nodes.size();
+    m_nodes.push_back(Node());
+    m_nodes.push_back(Node());
+
+    Node& inner = m_nodes[node];
+    inner.split = pnts[m_index[mid]][axis];
+    inner.axis  = axis;
+    inner.first = first;
+    inner.last  = last;
+    inner.child = child;
+
+    BuildNode(child,   first, mid,  pnts);
+    BuildNode(child+1, mid,   last, pnts);
+}
+
+int kd_tree::Nearest(const Base::Vector3f &pnt, float &sqrDist) const
+{
+    int best = -1;
+    sqrDist = FLT_MAX;
+    if (m_nodes.empty())
+        return -1;
+
+    // nodes still to visit together with a lower bound of their distance
+    unsigned int stack[64];
+    float bound[64];
+    int top = 0;
+    stack[top] = 0;
+    bound[top] = 0.0f;
+    ++top;
+
+    while (top > 0)
+    {
+        --top;
+        if (bound[top] >= sqrDist)
+            continue;
+
+        const Node* node = &m_nodes[stack[top]];
+        while (node->axis >= 0)
+        {
+            float diff = pnt[node->axis] - node->split;
+            unsigned int nearChild = diff < 0.0f ? node->child : node->child+1;
+            unsigned int farChild  = diff < 0.0f ? node->child+1 : node->child;
+            stack[top] = farChild;
+            bound[top] = diff*diff;
+            ++top;
+            node = &m_nodes[nearChild];
+        }
+
+        for (unsigned int i=node->first; i<node->last; ++i)
+        {
+            float dist = Base::DistanceP2(pnt, m_pnts[i]);
+            if (dist < sqrDist)
+            {
+                sqrDist = dist;
+                best = i;
+            }
+        }
+    }
+
+    return best >= 0 ? m_index[best] : -1;
+}
+
+std::size_t kd_tree::Size() const
+{
+    return m_pnts.size();
+}
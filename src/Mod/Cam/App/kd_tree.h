@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef CAM_KD_TREE_H
+#define CAM_KD_TREE_H
+
+#include <vector>
+#include <Base/Vector3D.h>
+
+
+/*! \brief A k-d tree for nearest-neighbour queries on a point set
+
+ The tree is built once from the points and is not modified by the queries,
+ so Nearest() can be called from several threads at the same time.
+*/
+
+class CamExport kd_tree
+{
+public:
+    kd_tree();
+    explicit kd_tree(const std::vector<Base::Vector3f> &pnts);
+    ~kd_tree();
+
+    /*! \brief Builds the tree from the point set \p pnts */
+    void Build(const std::vector<Base::Vector3f> &pnts);
+
+    /*! \brief Returns the index of the point nearest to \p pnt or -1 if
+               the tree is empty
+
+        \param pnt     query point
+        \param sqrDist squared distance to the nearest point
+    */
+    int Nearest(const Base::Vector3f &pnt, float &sqrDist) const;
+
+    /*! \brief Returns the number of points in the tree */
+    std::size_t Size() const;
+
+private:
+    struct Node
+    {
+        float split;          // splitting coordinate of an inner node
+        int axis;             // 0: x, 1: y, 2: z, -1: leaf
+        unsigned int first;   // leaf: range of the points
+        unsigned int last;
+        unsigned int child;   // inner node: left child, the right one follows
+    };
+
+    void BuildNode(unsigned int node, unsigned int first, unsigned int last,
+                   const std::vector<Base::Vector3f> &pnts);
+
+    std::vector<Node> m_nodes;
+    std::vector<Base::Vector3f> m_pnts;  // points in the order of the leaves
+    std::vector<int> m_index;            // original index of m_pnts
+};
+
+#endif
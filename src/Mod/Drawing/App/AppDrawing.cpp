@@ -14,8 +14,11 @@
 # include <Python.h>
 #endif
 
+#include <boost/bind.hpp>
+
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
+#include <App/Application.h>
  
 #include "FeaturePage.h"
 #include "FeatureView.h"
@@ -25,6 +28,7 @@
 #include "FeatureProjection.h"
 #include "FeatureClip.h"
 #include "PageGroup.h"
+#include "ProjectionAlgos.h"
 
 extern struct PyMethodDef Drawing_methods[];
 
@@ -63,6 +67,9 @@ void DrawingExport initDrawing()
     Drawing::FeatureViewAnnotation  ::init();
     Drawing::FeatureViewSymbol      ::init();
     Drawing::FeatureClip            ::init();
+
+    // the cached projections hold the shapes of the closed document
+    App::GetApplication().signalDeleteDocument.connect(boost::bind(&Drawing::ProjectionAlgos::clearCache));
 }
 
 } // extern "C"
@@ -171,18 +171,29 @@ TopoDS_Edge DrawingOutput::asBSpline(const BRepAdaptor_Curve& c, int maxDegree)
     return TopoDS_Edge();
 }
 
-SVGOutput::SVGOutput()
+SVGOutput::SVGOutput() : openPath(false)
 {
 }
 
 std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
 {
     std::stringstream result;
+    exportEdges(input, result);
+    return result.str();
+}
 
+void SVGOutput::exportEdges(const TopoDS_Shape& input, std::ostream& result)
+{
     TopExp_Explorer edges(input, TopAbs_EDGE);
     for (int i = 1 ; edges.More(); edges.Next(),i++) {
         const TopoDS_Edge& edge = TopoDS::Edge(edges.Current());
         BRepAdaptor_Curve adapt(edge);
+        GeomAbs_CurveType type = adapt.GetType();
+        if (type == GeomAbs_Circle || type == GeomAbs_Ellipse ||
+            type == GeomAbs_BSplineCurve || type == GeomAbs_BezierCurve) {
+            closePath(result);
+        }
+
         if (adapt.GetType() == GeomAbs_Circle) {
             printCircle(adapt, result);
         }
@@ -208,7 +219,7 @@ std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
         }
     }
 
-    return result.str();
+    closePath(result);
 }
 
 void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
@@ -420,13 +431,50 @@ void SVGOutput::printGeneric(const BRepAdaptor_Curve& c, int id, std::ostream& o
     Handle(Poly_Polygon3D) polygon = BRep_Tool::Polygon3D(c.Edge(), location);
     if (!polygon.IsNull()) {
         const TColgp_Array1OfPnt& nodes = polygon->Nodes();
-        char c = 'M';
-        out << "<path id= \"" /*<< ViewName*/ << id << "\" d=\" "; 
-        for (int i = nodes.Lower(); i <= nodes.Upper(); i++){
-            out << c << " " << nodes(i).X() << " " << nodes(i).Y()<< " " ; 
-            c = 'L';
+        int first = nodes.Lower();
+        int last = nodes.Upper();
+        int step = 1;
+
+        // a polyline that starts or ends at the end of the open path continues it
+        bool connected = false;
+        if (openPath) {
+            double tol = Precision::SquareConfusion();
+            if (nodes(first).SquareDistance(lastPoint) < tol) {
+                connected = true;
+            }
+            else if (nodes(last).SquareDistance(lastPoint) < tol) {
+                std::swap(first, last);
+                step = -1;
+                connected = true;
+            }
+        }
+
+        // After a move-to the coordinate pairs are implicit line-to commands
+        int i = first;
+        if (connected) {
+            i += step;
+        }
+        else {
+            if (openPath)
+                out << " ";
+            else
+                out << "<path d=\"";
+            out << "M" << nodes(i).X() << " " << nodes(i).Y();
+            i += step;
         }
+        for (; i != last + step; i += step)
+            out << " " << nodes(i).X() << " " << nodes(i).Y();
+
+        openPath = true;
+        lastPoint = nodes(last);
+    }
+}
+
+void SVGOutput::closePath(std::ostream& out)
+{
+    if (openPath) {
         out << "\" />" << endl;
+        openPath = false;
     }
 }
 
@@ -439,7 +487,12 @@ DXFOutput::DXFOutput()
 std::string DXFOutput::exportEdges(const TopoDS_Shape& input)
 {
     std::stringstream result;
+    exportEdges(input, result);
+    return result.str();
+}
 
+void DXFOutput::exportEdges(const TopoDS_Shape& input, std::ostream& result)
+{
     TopExp_Explorer edges(input, TopAbs_EDGE);
     for (int i = 1 ; edges.More(); edges.Next(),i++) {
         const TopoDS_Edge& edge = TopoDS::Edge(edges.Current());
@@ -458,8 +511,6 @@ std::string DXFOutput::exportEdges(const TopoDS_Shape& input)
             printGeneric(adapt, i, result);
         }
     }
-
-    return result.str();
 }
 
 void DXFOutput::printHeader( std::ostream& out)
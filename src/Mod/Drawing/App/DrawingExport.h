@@ -25,7 +25,9 @@
 #define DRAWING_EXPORT_H
 
 #include <string>
+#include <iosfwd>
 #include <TopoDS_Edge.hxx>
+#include <gp_Pnt.hxx>
 
 class TopoDS_Shape;
 class BRepAdaptor_Curve;
@@ -47,6 +49,10 @@ class DrawingExport SVGOutput : public DrawingOutput
 public:
     SVGOutput();
     std::string exportEdges(const TopoDS_Shape&);
+    /** Writes the edges to \a out as they are converted. Polylines that continue
+     * where the previous one ended are merged into one path.
+     */
+    void exportEdges(const TopoDS_Shape&, std::ostream& out);
 
 private:
     void printCircle(const BRepAdaptor_Curve&, std::ostream&);
@@ -54,6 +60,11 @@ private:
     void printBSpline(const BRepAdaptor_Curve&, int id, std::ostream&);
     void printBezier(const BRepAdaptor_Curve&, int id, std::ostream&);
     void printGeneric(const BRepAdaptor_Curve&, int id, std::ostream&);
+    void closePath(std::ostream&);
+
+private:
+    bool openPath;
+    gp_Pnt lastPoint;
 };
 
 /* dxf output section - Dan Falck 2011/09/25  */
@@ -62,6 +73,8 @@ class DrawingExport DXFOutput : public DrawingOutput
 public:
     DXFOutput();
     std::string exportEdges(const TopoDS_Shape&);
+    /// Writes the edges to \a out as they are converted
+    void exportEdges(const TopoDS_Shape&, std::ostream& out);
 
 private:
     void printHeader(std::ostream& out);
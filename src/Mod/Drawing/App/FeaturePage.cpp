@@ -149,47 +149,19 @@ App::DocumentObjectExecReturn *FeaturePage::execute(void)
     string tempName = PageResult.getExchangeTempFile();
     ostringstream ofile;
     string tempendl = "--endOfLine--";
+    string marker = "<!-- DrawingContent -->";
 
+    // Only the template is kept in memory, the views are written to the
+    // file at the places of the marker
     while (!file.eof())
     {
         getline (file,line);
         // check if the marker in the template is found
-        if(line.find("<!-- DrawingContent -->") == string::npos)
+        if(line.find(marker) == string::npos)
             // if not -  write through
             ofile << line << tempendl;
         else
-        {
-            // get through the children and collect all the views
-            const std::vector<App::DocumentObject*> &Grp = Group.getValues();
-            for (std::vector<App::DocumentObject*>::const_iterator It= Grp.begin();It!=Grp.end();++It) {
-                if ( (*It)->getTypeId().isDerivedFrom(Drawing::FeatureView::getClassTypeId()) ) {
-                    Drawing::FeatureView *View = dynamic_cast<Drawing::FeatureView *>(*It);
-                    if (View->Visible.getValue()) {
-                        ofile << View->ViewResult.getValue();
-                        ofile << tempendl << tempendl << tempendl;
-                    }
-                } else if ( (*It)->getTypeId().isDerivedFrom(Drawing::FeatureClip::getClassTypeId()) ) {
-                    Drawing::FeatureClip *Clip = dynamic_cast<Drawing::FeatureClip *>(*It);
-                    if (Clip->Visible.getValue()) {
-                        ofile << Clip->ViewResult.getValue();
-                        ofile << tempendl << tempendl << tempendl;
-                    }
-                } else if ( (*It)->getTypeId().isDerivedFrom(App::DocumentObjectGroup::getClassTypeId()) ) {
-                    // getting children inside subgroups too
-                    App::DocumentObjectGroup *SubGroup = dynamic_cast<App::DocumentObjectGroup *>(*It);
-                    const std::vector<App::DocumentObject*> &SubGrp = SubGroup->Group.getValues();
-                    for (std::vector<App::DocumentObject*>::const_iterator Grit= SubGrp.begin();Grit!=SubGrp.end();++Grit) {
-                        if ( (*Grit)->getTypeId().isDerivedFrom(Drawing::FeatureView::getClassTypeId()) ) {
-                            Drawing::FeatureView *SView = dynamic_cast<Drawing::FeatureView *>(*Grit);
-                            if (SView->Visible.getValue()) {
-                                ofile << SView->ViewResult.getValue();
-                                ofile << tempendl << tempendl << tempendl;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+            ofile << marker;
     }
 
     file.close();
@@ -228,7 +200,13 @@ App::DocumentObjectExecReturn *FeaturePage::execute(void)
     string fmt = "\\n";
     outfragment = boost::regex_replace(outfragment, e3, fmt);
     ofstream outfinal(tempName.c_str());
-    outfinal << outfragment;
+    string::size_type pos = 0, next;
+    while ((next = outfragment.find(marker, pos)) != string::npos) {
+        outfinal.write(outfragment.data() + pos, next - pos);
+        writeViews(outfinal);
+        pos = next + marker.size();
+    }
+    outfinal.write(outfragment.data() + pos, outfragment.size() - pos);
     outfinal.close();
 
     PageResult.setValue(tempName.c_str());
@@ -236,6 +214,40 @@ App::DocumentObjectExecReturn *FeaturePage::execute(void)
     return App::DocumentObject::StdReturn;
 }
 
+void FeaturePage::writeViews(std::ostream& out) const
+{
+    // get through the children and collect all the views
+    const std::vector<App::DocumentObject*> &Grp = Group.getValues();
+    for (std::vector<App::DocumentObject*>::const_iterator It= Grp.begin();It!=Grp.end();++It) {
+        if ( (*It)->getTypeId().isDerivedFrom(Drawing::FeatureView::getClassTypeId()) ) {
+            Drawing::FeatureView *View = dynamic_cast<Drawing::FeatureView *>(*It);
+            if (View->Visible.getValue()) {
+                out << View->ViewResult.getValue();
+                out << "\n\n\n";
+            }
+        } else if ( (*It)->getTypeId().isDerivedFrom(Drawing::FeatureClip::getClassTypeId()) ) {
+            Drawing::FeatureClip *Clip = dynamic_cast<Drawing::FeatureClip *>(*It);
+            if (Clip->Visible.getValue()) {
+                out << Clip->ViewResult.getValue();
+                out << "\n\n\n";
+            }
+        } else if ( (*It)->getTypeId().isDerivedFrom(App::DocumentObjectGroup::getClassTypeId()) ) {
+            // getting children inside subgroups too
+            App::DocumentObjectGroup *SubGroup = dynamic_cast<App::DocumentObjectGroup *>(*It);
+            const std::vector<App::DocumentObject*> &SubGrp = SubGroup->Group.getValues();
+            for (std::vector<App::DocumentObject*>::const_iterator Grit= SubGrp.begin();Grit!=SubGrp.end();++Grit) {
+                if ( (*Grit)->getTypeId().isDerivedFrom(Drawing::FeatureView::getClassTypeId()) ) {
+                    Drawing::FeatureView *SView = dynamic_cast<Drawing::FeatureView *>(*Grit);
+                    if (SView->Visible.getValue()) {
+                        out << SView->ViewResult.getValue();
+                        out << "\n\n\n";
+                    }
+                }
+            }
+        }
+    }
+}
+
 std::vector<std::string> FeaturePage::getEditableTextsFromTemplate(void) const {
     //getting editable texts from "freecad:editable" attributes in SVG template
 
@@ -67,6 +67,14 @@ protected:
     /// get called after a document has been fully restored
     virtual void onDocumentRestored();
 
+private:
+    /** Writes the SVG fragments of all visible views
+     * The fragments are taken from the ViewResult property of the views
+     * which keeps them for the document file, the clips and the viewer.
+     * So only the page itself is streamed, not the views.
+     */
+    void writeViews(std::ostream&) const;
+
 private:
     int numChildren;
 };
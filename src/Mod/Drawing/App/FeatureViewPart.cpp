@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <set>
 # include <sstream>
 #endif
 
@@ -56,6 +57,7 @@
 
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <App/DocumentObjectGroup.h>
 #include <Mod/Part/App/PartFeature.h>
 
 #include "FeatureViewPart.h"
@@ -70,6 +72,7 @@ using namespace std;
 //===========================================================================
 
 App::PropertyFloatConstraint::Constraints FeatureViewPart::floatRange = {0.01,5.0,0.05};
+const char* FeatureViewPart::AlgorithmEnums[] = {"Exact","Polygonal",NULL};
 
 PROPERTY_SOURCE(Drawing::FeatureViewPart, Drawing::FeatureView)
 
@@ -87,12 +90,76 @@ FeatureViewPart::FeatureViewPart(void)
     ADD_PROPERTY_TYPE(HiddenWidth,(0.15),vgroup,App::Prop_None,"The thickness of the hidden lines, if enabled");
     ADD_PROPERTY_TYPE(Tolerance,(0.05),vgroup,App::Prop_None,"The tessellation tolerance");
     Tolerance.setConstraints(&floatRange);
+    ADD_PROPERTY_TYPE(Algorithm,((long)0),group,App::Prop_None,"Hidden line removal algorithm. Polygonal is faster but works on the tessellation of the shape");
+    Algorithm.setEnums(AlgorithmEnums);
 }
 
 FeatureViewPart::~FeatureViewPart()
 {
 }
 
+// Fills in the projection of a view, returns false if there is no shape
+static bool getProjectionRequest(const FeatureViewPart* view, ProjectionAlgos::Request& req)
+{
+    App::DocumentObject* link = view->Source.getValue();
+    if (!link || !link->getTypeId().isDerivedFrom(Part::Feature::getClassTypeId()))
+        return false;
+    req.Shape = static_cast<Part::Feature*>(link)->Shape.getShape()._Shape;
+    if (req.Shape.IsNull())
+        return false;
+    req.Direction = view->Direction.getValue();
+    req.Type = view->Algorithm.getValue() == 1 ? ProjectionAlgos::Polygonal : ProjectionAlgos::Exact;
+    req.Tolerance = view->Tolerance.getValue();
+    return true;
+}
+
+void FeatureViewPart::projectSiblingViews() const
+{
+    // Everything this view depends on is already recomputed. Other sources are
+    // only up to date if neither they nor their dependencies are touched.
+    std::vector<App::DocumentObject*> deps = getOutListRecursive();
+    std::set<App::DocumentObject*> ready(deps.begin(), deps.end());
+
+    std::vector<ProjectionAlgos::Request> requests;
+    std::vector<App::DocumentObject*> parents = getInList();
+    for (std::vector<App::DocumentObject*>::iterator it = parents.begin(); it != parents.end(); ++it) {
+        if (!(*it)->getTypeId().isDerivedFrom(App::DocumentObjectGroup::getClassTypeId()))
+            continue;
+        const std::vector<App::DocumentObject*>& views = static_cast<App::DocumentObjectGroup*>(*it)->Group.getValues();
+        for (std::vector<App::DocumentObject*>::const_iterator jt = views.begin(); jt != views.end(); ++jt) {
+            if (!(*jt)->getTypeId().isDerivedFrom(FeatureViewPart::getClassTypeId()))
+                continue;
+            FeatureViewPart* view = static_cast<FeatureViewPart*>(*jt);
+            App::DocumentObject* source = view->Source.getValue();
+            if (!source)
+                continue;
+            if (view != this && !view->isTouched() && !view->mustExecute() && !source->isTouched())
+                continue;
+            if (ready.find(source) == ready.end()) {
+                if (source->isTouched())
+                    continue;
+                std::vector<App::DocumentObject*> sourceDeps = source->getOutListRecursive();
+                bool touched = false;
+                for (std::vector<App::DocumentObject*>::iterator kt = sourceDeps.begin(); kt != sourceDeps.end(); ++kt) {
+                    if ((*kt)->isTouched()) {
+                        touched = true;
+                        break;
+                    }
+                }
+                if (touched)
+                    continue;
+            }
+
+            ProjectionAlgos::Request req;
+            if (getProjectionRequest(view, req))
+                requests.push_back(req);
+        }
+    }
+
+    if (requests.size() > 1)
+        ProjectionAlgos::executeAll(requests);
+}
+
 App::DocumentObjectExecReturn *FeatureViewPart::execute(void)
 {
     std::stringstream result;
@@ -109,9 +176,11 @@ App::DocumentObjectExecReturn *FeatureViewPart::execute(void)
     Base::Vector3d Dir = Direction.getValue();
     bool hidden = ShowHiddenLines.getValue();
     bool smooth = ShowSmoothLines.getValue();
+    ProjectionAlgos::HLRType hlr = Algorithm.getValue() == 1 ? ProjectionAlgos::Polygonal : ProjectionAlgos::Exact;
 
     try {
-        ProjectionAlgos Alg(shape,Dir);
+        projectSiblingViews();
+        ProjectionAlgos Alg(shape,Dir,hlr,Tolerance.getValue());
         result  << "<g" 
                 << " id=\"" << ViewName << "\"" << endl
                 << "   transform=\"rotate("<< Rotation.getValue() << ","<< X.getValue()<<","<<Y.getValue()<<") translate("<< X.getValue()<<","<<Y.getValue()<<") scale("<< Scale.getValue()<<","<<Scale.getValue()<<")\"" << endl
@@ -120,7 +189,7 @@ App::DocumentObjectExecReturn *FeatureViewPart::execute(void)
         ProjectionAlgos::ExtractionType type = ProjectionAlgos::Plain;
         if (hidden) type = (ProjectionAlgos::ExtractionType)(type|ProjectionAlgos::WithHidden);
         if (smooth) type = (ProjectionAlgos::ExtractionType)(type|ProjectionAlgos::WithSmooth);
-        result << Alg.getSVG(type, this->LineWidth.getValue() / this->Scale.getValue(), this->Tolerance.getValue(), this->HiddenWidth.getValue() / this->Scale.getValue());
+        Alg.writeSVG(result, type, this->LineWidth.getValue() / this->Scale.getValue(), this->Tolerance.getValue(), this->HiddenWidth.getValue() / this->Scale.getValue());
 
         result << "</g>" << endl;
 
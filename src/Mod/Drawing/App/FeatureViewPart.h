@@ -55,6 +55,7 @@ public:
     App::PropertyFloat  LineWidth;
     App::PropertyFloat  HiddenWidth;
     App::PropertyFloatConstraint  Tolerance;
+    App::PropertyEnumeration Algorithm;
 
 
     /** @name methods overide Feature */
@@ -68,8 +69,16 @@ public:
         return "DrawingGui::ViewProviderDrawingView";
     }
 
+protected:
+    /** Computes the projections of all views of the page that are recomputed and
+     * whose shapes are up to date in one go. The views then find their result in
+     * the cache of ProjectionAlgos.
+     */
+    void projectSiblingViews() const;
+
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
+    static const char* AlgorithmEnums[];
 };
 
 typedef App::FeaturePythonT<FeatureViewPart> FeatureViewPartPython;
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <list>
 # include <sstream>
 # include <BRepAdaptor_Curve.hxx>
 # include <Geom_Circle.hxx>
@@ -31,6 +32,9 @@
 # include <gp_Elips.hxx>
 #endif
 
+#include <QMutex>
+#include <QMutexLocker>
+
 #include <Bnd_Box.hxx>
 #include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
@@ -41,6 +45,8 @@
 #include <HLRAlgo_Projector.hxx>
 #include <HLRBRep_ShapeBounds.hxx>
 #include <HLRBRep_HLRToShape.hxx>
+#include <HLRBRep_PolyAlgo.hxx>
+#include <HLRBRep_PolyHLRToShape.hxx>
 #include <gp_Ax2.hxx>
 #include <gp_Pnt.hxx>
 #include <gp_Dir.hxx>
@@ -58,7 +64,9 @@
 #include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <TopTools_ListOfShape.hxx>
 #include <TColgp_Array1OfPnt2d.hxx>
+#include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepLib.hxx>
 #include <BRepAdaptor_CompCurve.hxx>
@@ -73,10 +81,15 @@
 #include <GeomConvert_BSplineCurveKnotSplitting.hxx>
 #include <Geom2d_BSplineCurve.hxx>
 
+#include <Standard.hxx>
+
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/TaskScheduler.h>
 #include <Base/Tools.h>
+#include <Base/Vector3D.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "ProjectionAlgos.h"
 #include "DrawingExport.h"
@@ -91,7 +104,14 @@ using namespace std;
 
 
 ProjectionAlgos::ProjectionAlgos(const TopoDS_Shape &Input, const Base::Vector3d &Dir)
-  : Input(Input), Direction(Dir)
+  : Input(Input), Direction(Dir), Type(Exact), Tolerance(0.0)
+{
+    execute();
+}
+
+ProjectionAlgos::ProjectionAlgos(const TopoDS_Shape &Input, const Base::Vector3d &Dir,
+                                 HLRType hlr, double tolerance)
+  : Input(Input), Direction(Dir), Type(hlr), Tolerance(tolerance)
 {
     execute();
 }
@@ -99,13 +119,13 @@ ProjectionAlgos::ProjectionAlgos(const TopoDS_Shape &Input, const Base::Vector3d
 ProjectionAlgos::~ProjectionAlgos()
 {
 }
-
-/*
-// no longer used, replaced invertY by adding
+
+/*
+// no longer used, replaced invertY by adding
 //                << "   transform=\"scale(1,-1)\"" << endl
-// to getSVG(...) below.
-// invertY, as here, wasn't right for intended purpose - always reflected in model Y direction rather
-// than SVG projection Y direction.  Also better to reflect about (0,0,0) rather than bbox centre
+// to getSVG(...) below.
+// invertY, as here, wasn't right for intended purpose - always reflected in model Y direction rather
+// than SVG projection Y direction.  Also better to reflect about (0,0,0) rather than bbox centre
 
 TopoDS_Shape ProjectionAlgos::invertY(const TopoDS_Shape& shape)
 {
@@ -120,49 +140,301 @@ TopoDS_Shape ProjectionAlgos::invertY(const TopoDS_Shape& shape)
     BRepBuilderAPI_Transform mkTrf(shape, mat);
     return mkTrf.Shape();
 }
-*/
-
-
-//added by tanderson. aka blobfish.
-//projection algorithms build a 2d curve(pcurve) but no 3d curve.
-//this causes problems with meshing algorithms after save and load.
-static const TopoDS_Shape& build3dCurves(const TopoDS_Shape &shape)
-{
-  TopExp_Explorer it;
-  for (it.Init(shape, TopAbs_EDGE); it.More(); it.Next())
-    BRepLib::BuildCurve3d(TopoDS::Edge(it.Current()));
-  return shape;
-}
-
-void ProjectionAlgos::execute(void)
+*/
+
+
+//added by tanderson. aka blobfish.
+//projection algorithms build a 2d curve(pcurve) but no 3d curve.
+//this causes problems with meshing algorithms after save and load.
+static const TopoDS_Shape& build3dCurves(const TopoDS_Shape &shape)
+{
+  TopExp_Explorer it;
+  for (it.Init(shape, TopAbs_EDGE); it.More(); it.Next())
+    BRepLib::BuildCurve3d(TopoDS::Edge(it.Current()));
+  return shape;
+}
+
+namespace {
+
+struct Projection
+{
+    TopoDS_Shape V, V1, VN, VO, VI;
+    TopoDS_Shape H, H1, HN, HO, HI;
+};
+
+Projection projectExact(const TopoDS_Shape& input, const Base::Vector3d& dir)
 {
     Handle( HLRBRep_Algo ) brep_hlr = new HLRBRep_Algo;
-    brep_hlr->Add(Input);
+    brep_hlr->Add(input);
 
-    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(Direction.x,Direction.y,Direction.z));
+    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(dir.x,dir.y,dir.z));
     HLRAlgo_Projector projector( transform );
     brep_hlr->Projector(projector);
     brep_hlr->Update();
     brep_hlr->Hide();
 
     // extracting the result sets:
-    HLRBRep_HLRToShape shapes( brep_hlr );
-
-    V  = build3dCurves(shapes.VCompound       ());// hard edge visibly
-    V1 = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
-    VN = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
-    VO = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
-    VI = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
-    H  = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
-    H1 = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
-    HN = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
-    HO = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
-    HI = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
-}
-
+    HLRBRep_HLRToShape shapes( brep_hlr );
+
+    Projection p;
+    p.V  = build3dCurves(shapes.VCompound       ());// hard edge visibly
+    p.V1 = build3dCurves(shapes.Rg1LineVCompound());// Smoth edges visibly
+    p.VN = build3dCurves(shapes.RgNLineVCompound());// contour edges visibly
+    p.VO = build3dCurves(shapes.OutLineVCompound());// contours apparents visibly
+    p.VI = build3dCurves(shapes.IsoLineVCompound());// isoparamtriques   visibly
+    p.H  = build3dCurves(shapes.HCompound       ());// hard edge       invisibly
+    p.H1 = build3dCurves(shapes.Rg1LineHCompound());// Smoth edges  invisibly
+    p.HN = build3dCurves(shapes.RgNLineHCompound());// contour edges invisibly
+    p.HO = build3dCurves(shapes.OutLineHCompound());// contours apparents invisibly
+    p.HI = build3dCurves(shapes.IsoLineHCompound());// isoparamtriques   invisibly
+    return p;
+}
+
+// The polygonal algorithm works on the triangulation of the input shape and
+// returns straight line segments. There are no iso-parametric lines.
+Projection projectPolygonal(const TopoDS_Shape& input, const Base::Vector3d& dir)
+{
+    Handle( HLRBRep_PolyAlgo ) poly_hlr = new HLRBRep_PolyAlgo;
+    poly_hlr->Load(input);
+
+    gp_Ax2 transform(gp_Pnt(0,0,0),gp_Dir(dir.x,dir.y,dir.z));
+    HLRAlgo_Projector projector( transform );
+    poly_hlr->Projector(projector);
+    poly_hlr->Update();
+
+    HLRBRep_PolyHLRToShape shapes;
+    shapes.Update(poly_hlr);
+
+    Projection p;
+    p.V  = build3dCurves(shapes.VCompound       ());
+    p.V1 = build3dCurves(shapes.Rg1LineVCompound());
+    p.VN = build3dCurves(shapes.RgNLineVCompound());
+    p.VO = build3dCurves(shapes.OutLineVCompound());
+    p.H  = build3dCurves(shapes.HCompound       ());
+    p.H1 = build3dCurves(shapes.Rg1LineHCompound());
+    p.HN = build3dCurves(shapes.RgNLineHCompound());
+    p.HO = build3dCurves(shapes.OutLineHCompound());
+    return p;
+}
+
+// Copies the geometry of a shape so that it can be projected in another thread
+// than the shapes of other views: the surfaces of the OCC kernel cache their last
+// evaluation and must not be shared between threads. For the polygonal algorithm
+// the copy is tessellated. BRepBuilderAPI_Copy doesn't copy the triangulation, so
+// the input shape, which may be the source of other views and is shown by its
+// view provider, keeps its own.
+TopoDS_Shape copyShape(const TopoDS_Shape& shape, bool withMesh, double tolerance)
+{
+    BRepBuilderAPI_Copy copy(shape);
+    TopoDS_Shape result = copy.Shape();
+    if (withMesh)
+        BRepMesh_IncrementalMesh(result, tolerance);
+    return result;
+}
+
+/* Keeps the results of the last projections. An entry holds a handle to the input
+ * shape so that a recomputed part, which always gets a new shape, never matches an
+ * old entry. Entries are kept in the order of their last use.
+ */
+class ProjectionCache
+{
+public:
+    static ProjectionCache& instance()
+    {
+        static ProjectionCache cache;
+        return cache;
+    }
+
+    bool find(const ProjectionAlgos::Request& req, Projection& result)
+    {
+        QMutexLocker lock(&mutex);
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (it->matches(req)) {
+                result = it->result;
+                entries.splice(entries.begin(), entries, it);
+                return true;
+            }
+        }
+        return false;
+    }
+    bool contains(const ProjectionAlgos::Request& req)
+    {
+        QMutexLocker lock(&mutex);
+        for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (it->matches(req))
+                return true;
+        }
+        return false;
+    }
+    void insert(const ProjectionAlgos::Request& req, const Projection& result)
+    {
+        QMutexLocker lock(&mutex);
+        Entry entry;
+        entry.request = req;
+        entry.result = result;
+        entries.push_front(entry);
+        if (entries.size() > maxEntries)
+            entries.pop_back();
+    }
+    void clear()
+    {
+        QMutexLocker lock(&mutex);
+        entries.clear();
+    }
+
+private:
+    ProjectionCache()
+    {
+    }
+
+    struct Entry
+    {
+        ProjectionAlgos::Request request;
+        Projection result;
+
+        bool matches(const ProjectionAlgos::Request& req) const
+        {
+            if (request.Type != req.Type || !request.Shape.IsEqual(req.Shape))
+                return false;
+            if (request.Direction != req.Direction)
+                return false;
+            // the exact projection doesn't depend on the tessellation
+            return (req.Type == ProjectionAlgos::Exact || request.Tolerance == req.Tolerance);
+        }
+    };
+
+    static const std::size_t maxEntries = 32;
+    QMutex mutex;
+    std::list<Entry> entries;
+};
+
+// Projects a range of requests, each of them on its own copy of the input shape
+class ProjectionTask
+{
+public:
+    ProjectionTask(const std::vector<const ProjectionAlgos::Request*>& r,
+                   const std::vector<TopoDS_Shape>& s)
+      : requests(r), shapes(s)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++) {
+            const ProjectionAlgos::Request& req = *requests[i];
+            if (shapes[i].IsNull())
+                continue;
+            try {
+                Projection p;
+                if (req.Type == ProjectionAlgos::Polygonal)
+                    p = projectPolygonal(shapes[i], req.Direction);
+                else
+                    p = projectExact(shapes[i], req.Direction);
+                ProjectionCache::instance().insert(req, p);
+            }
+            catch (Standard_Failure) {
+                // will be reported when the view computes it again
+            }
+        }
+    }
+
+private:
+    const std::vector<const ProjectionAlgos::Request*>& requests;
+    const std::vector<TopoDS_Shape>& shapes;
+};
+
+}
+
+void ProjectionAlgos::execute(void)
+{
+    Request req;
+    req.Shape = Input;
+    req.Direction = Direction;
+    req.Type = Type;
+    req.Tolerance = Tolerance;
+
+    Projection p;
+    if (!ProjectionCache::instance().find(req, p)) {
+        if (Type == Polygonal) {
+            // tessellate a copy like executeAll() so that the triangulation
+            // of the input shape isn't changed
+            p = projectPolygonal(copyShape(Input, true, Tolerance), Direction);
+        }
+        else {
+            p = projectExact(Input, Direction);
+        }
+        ProjectionCache::instance().insert(req, p);
+    }
+
+    V  = p.V;
+    V1 = p.V1;
+    VN = p.VN;
+    VO = p.VO;
+    VI = p.VI;
+    H  = p.H;
+    H1 = p.H1;
+    HN = p.HN;
+    HO = p.HO;
+    HI = p.HI;
+}
+
+void ProjectionAlgos::executeAll(const std::vector<Request>& requests)
+{
+    std::vector<const Request*> todo;
+    for (std::vector<Request>::const_iterator it = requests.begin(); it != requests.end(); ++it) {
+        if (isCached(*it))
+            continue;
+        bool duplicate = false;
+        for (std::vector<const Request*>::iterator jt = todo.begin(); jt != todo.end(); ++jt) {
+            if ((*jt)->Type == it->Type && (*jt)->Shape.IsEqual(it->Shape) &&
+                (*jt)->Direction == it->Direction && (*jt)->Tolerance == it->Tolerance) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate)
+            todo.push_back(&(*it));
+    }
+
+    if (todo.empty())
+        return;
+
+    // The copies read the input shapes, which may be shared by several views,
+    // and are therefore made and tessellated before the threads are started
+    std::vector<TopoDS_Shape> shapes;
+    shapes.reserve(todo.size());
+    for (std::vector<const Request*>::iterator it = todo.begin(); it != todo.end(); ++it) {
+        try {
+            shapes.push_back(copyShape((*it)->Shape, (*it)->Type == Polygonal, (*it)->Tolerance));
+        }
+        catch (Standard_Failure) {
+            // will be reported when the view computes it again
+            shapes.push_back(TopoDS_Shape());
+        }
+    }
+
+    Part::ReentrantMode reentrant;
+    Base::parallel_for(0, todo.size(), ProjectionTask(todo, shapes));
+}
+
+bool ProjectionAlgos::isCached(const Request& request)
+{
+    return ProjectionCache::instance().contains(request);
+}
+
+void ProjectionAlgos::clearCache()
+{
+    ProjectionCache::instance().clear();
+}
+
 std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double tolerance, double hiddenscale)
 {
     std::stringstream result;
+    writeSVG(result, type, scale, tolerance, hiddenscale);
+    return result.str();
+}
+
+void ProjectionAlgos::writeSVG(std::ostream& result, ExtractionType type, double scale, double tolerance, double hiddenscale)
+{
     SVGOutput output;
 
     if (!H.IsNull() && (type & WithHidden)) {
@@ -177,9 +449,9 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-dasharray=\"0.2,0.1\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(H)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(H, result);
+        result << "</g>" << endl;
     }
     if (!HO.IsNull() && (type & WithHidden)) {
         double width = hiddenscale;
@@ -193,9 +465,9 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-dasharray=\"0.02,0.1\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(HO)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(HO, result);
+        result << "</g>" << endl;
     }
     if (!VO.IsNull()) {
         double width = scale;
@@ -208,9 +480,9 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-linejoin=\"miter\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(VO)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(VO, result);
+        result << "</g>" << endl;
     }
     if (!V.IsNull()) {
         double width = scale;
@@ -223,9 +495,9 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-linejoin=\"miter\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(V)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(V, result);
+        result << "</g>" << endl;
     }
     if (!V1.IsNull() && (type & WithSmooth)) {
         double width = scale;
@@ -238,9 +510,9 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-linejoin=\"miter\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(V1)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(V1, result);
+        result << "</g>" << endl;
     }
     if (!H1.IsNull() && (type & WithSmooth) && (type & WithHidden)) {
         double width = hiddenscale;
@@ -254,11 +526,10 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
                 << "   stroke-dasharray=\"0.09,0.05\"" << endl
                 << "   fill=\"none\"" << endl
                 << "   transform=\"scale(1,-1)\"" << endl
-                << "  >" << endl
-                << output.exportEdges(H1)
-                << "</g>" << endl;
+                << "  >" << endl;
+        output.exportEdges(H1, result);
+        result << "</g>" << endl;
     }
-    return result.str();
 }
 
 /* dxf output section - Dan Falck 2011/09/25  */
@@ -266,38 +537,42 @@ std::string ProjectionAlgos::getSVG(ExtractionType type, double scale, double to
 std::string ProjectionAlgos::getDXF(ExtractionType type, double scale, double tolerance)
 {
     std::stringstream result;
+    writeDXF(result, type, scale, tolerance);
+    return result.str();
+}
+
+void ProjectionAlgos::writeDXF(std::ostream& result, ExtractionType type, double scale, double tolerance)
+{
     DXFOutput output;
 
     if (!H.IsNull() && (type & WithHidden)) {
         //float width = 0.15f/scale;
         BRepMesh_IncrementalMesh(H,tolerance);
-        result  << output.exportEdges(H);
+        output.exportEdges(H, result);
     }
     if (!HO.IsNull() && (type & WithHidden)) {
         //float width = 0.15f/scale;
         BRepMesh_IncrementalMesh(HO,tolerance);
-        result  << output.exportEdges(HO);
+        output.exportEdges(HO, result);
     }
     if (!VO.IsNull()) {
         //float width = 0.35f/scale;
         BRepMesh_IncrementalMesh(VO,tolerance);
-        result  << output.exportEdges(VO);
+        output.exportEdges(VO, result);
     }
     if (!V.IsNull()) {
         //float width = 0.35f/scale;
         BRepMesh_IncrementalMesh(V,tolerance);
-        result  << output.exportEdges(V);
+        output.exportEdges(V, result);
     }
     if (!V1.IsNull() && (type & WithSmooth)) {
         //float width = 0.35f/scale;
         BRepMesh_IncrementalMesh(V1,tolerance);
-        result  << output.exportEdges(V1);
+        output.exportEdges(V1, result);
     }
     if (!H1.IsNull() && (type & WithSmooth) && (type & WithHidden)) {
         //float width = 0.15f/scale;
         BRepMesh_IncrementalMesh(H1,tolerance);
-        result  << output.exportEdges(H1);
+        output.exportEdges(H1, result);
     }
-
-    return result.str();
 }
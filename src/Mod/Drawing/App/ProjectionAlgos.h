@@ -26,7 +26,9 @@
 
 #include <TopoDS_Shape.hxx>
 #include <Base/Vector3D.h>
+#include <iosfwd>
 #include <string>
+#include <vector>
 
 class BRepAdaptor_Curve;
 
@@ -38,13 +40,39 @@ namespace Drawing
 class DrawingExport ProjectionAlgos
 {
 public:
+    /// Hidden line removal algorithm
+    enum HLRType {
+        Exact = 0,      ///< exact HLR on the B-rep geometry
+        Polygonal = 1   ///< fast HLR on a triangulation of the shape
+    };
+
     /// Constructor
     ProjectionAlgos(const TopoDS_Shape &Input,const Base::Vector3d &Dir);
+    /// Constructor, \a tolerance is the tessellation tolerance used by the polygonal algorithm
+    ProjectionAlgos(const TopoDS_Shape &Input,const Base::Vector3d &Dir, HLRType hlr, double tolerance);
     virtual ~ProjectionAlgos();
 
     void execute(void);
 //    static TopoDS_Shape invertY(const TopoDS_Shape&);
 
+    /// A projection to compute with executeAll()
+    struct Request {
+        TopoDS_Shape Shape;
+        Base::Vector3d Direction;
+        HLRType Type;
+        double Tolerance;
+    };
+    /** Computes the projections concurrently. The results are kept in the cache
+     * that execute() looks at first, so that the ProjectionAlgos of the requests
+     * are created without doing the hidden line removal again. Requests that fail
+     * are skipped and computed by execute() again.
+     */
+    static void executeAll(const std::vector<Request>& requests);
+    /// Returns true if the projection is already in the cache
+    static bool isCached(const Request& request);
+    /// Removes all cached projections, this is done whenever a document is closed
+    static void clearCache();
+
     enum ExtractionType {
         Plain = 0,
         WithHidden = 1,
@@ -53,6 +81,10 @@ public:
 
     std::string getSVG(ExtractionType type, double scale=0.35, double tolerance=0.05, double hiddenscale=0.15);
     std::string getDXF(ExtractionType type, double scale, double tolerance);//added by Dan Falck 2011/09/25
+    /// Writes the SVG output to a stream, e.g. a file, without building it in memory first
+    void writeSVG(std::ostream&, ExtractionType type, double scale=0.35, double tolerance=0.05, double hiddenscale=0.15);
+    /// Writes the DXF output to a stream
+    void writeDXF(std::ostream&, ExtractionType type, double scale, double tolerance);
 
 
     const TopoDS_Shape &Input;
@@ -68,6 +100,10 @@ public:
     TopoDS_Shape HN;// contour edges invisibly
     TopoDS_Shape HO;// contours apparents invisibly
     TopoDS_Shape HI;// isoparamtriques   invisibly
+
+private:
+    HLRType Type;
+    double Tolerance;
 };
 
 } //namespace Drawing
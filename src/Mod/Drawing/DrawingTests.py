@@ -1,38 +1,240 @@
-import Part, Drawing
-Part.open("D:/_Projekte/FreeCAD/FreeCADData/Schenkel.stp")
-App.activeDocument().addObject('Drawing::FeaturePage','Page')
-App.activeDocument().Page.Template = 'D:/_Projekte/FreeCAD/FreeCAD_0.9_LibPack7/Mod/Drawing/Templates/A3_Landscape.svg'
-App.activeDocument().addObject('Drawing::FeatureViewPart','View')
-App.activeDocument().View.Source = App.activeDocument().Schenkel
-App.activeDocument().View.Direction = (0.0,1.0,0.0)
-App.activeDocument().View.X = 30.0
-App.activeDocument().View.Y = 30.0
-App.activeDocument().View.Scale = 1.0
-App.activeDocument().Page.addObject(App.activeDocument().View)
-
-App.activeDocument().addObject('Drawing::FeatureViewPart','View1')
-App.activeDocument().View1.Source = App.activeDocument().Schenkel
-App.activeDocument().View1.Direction = (0.0,0.0,1.0)
-App.activeDocument().View1.X = 70.0
-App.activeDocument().View1.Y = 30.0
-App.activeDocument().View1.Scale = 1.0
-App.activeDocument().Page.addObject(App.activeDocument().View1)
-
-App.activeDocument().addObject('Drawing::FeatureViewPart','View2')
-App.activeDocument().View2.Source = App.activeDocument().Schenkel
-App.activeDocument().View2.Direction = (1.0,0.0,0.0)
-App.activeDocument().View2.X = 70.0
-App.activeDocument().View2.Y = 200.0
-App.activeDocument().View2.Rotation = 90.0
-App.activeDocument().View2.Scale = 1.0
-App.activeDocument().Page.addObject(App.activeDocument().View2)
-
-App.activeDocument().addObject('Drawing::FeatureViewPart','View3')
-App.activeDocument().View3.Source = App.activeDocument().Schenkel
-App.activeDocument().View3.Direction = (1.0,1.0,1.0)
-App.activeDocument().View3.X = 280.0
-App.activeDocument().View3.Y = 90.0
-App.activeDocument().View3.Scale = 1.0
-App.activeDocument().Page.addObject(App.activeDocument().View3)
-
-App.activeDocument().recompute()
+import FreeCAD, Part, Drawing, unittest, re, os, tempfile
+App = FreeCAD
+
+def viewBody(view):
+    # the SVG fragment without the group header that holds the label and placement
+    result = view.ViewResult
+    return result[result.index(">")+1:]
+
+def pathBounds(svg):
+    # bounding box of the points of all paths, only straight lines are expected
+    xs = []
+    ys = []
+    for d in re.findall(r'd="([^"]*)"', svg):
+        numbers = [float(i) for i in re.findall(r'-?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?', d)]
+        xs += numbers[0::2]
+        ys += numbers[1::2]
+    return (min(xs), min(ys), max(xs), max(ys))
+
+def pathPolylines(svg):
+    # the polylines of all paths that only consist of straight lines, a merged
+    # path holds several polylines which start with a move-to
+    polylines = []
+    for d in re.findall(r'<path d="([^"]*)"', svg):
+        if re.search(r'[A-DF-LN-Za-df-ln-z]', d):
+            continue
+        for part in d.split("M")[1:]:
+            numbers = [float(i) for i in re.findall(r'-?\d+(?:\.\d*)?(?:[eE][-+]?\d+)?', part)]
+            polylines.append([App.Vector(numbers[i], numbers[i+1], 0) for i in range(0, len(numbers), 2)])
+    return polylines
+
+def polylineLength(polylines):
+    length = 0.0
+    for points in polylines:
+        for i in range(1, len(points)):
+            length += (points[i] - points[i-1]).Length
+    return length
+
+def dxfLines(dxf):
+    # the start and end points of the LINE entities
+    lines = []
+    codes = dxf.splitlines()
+    for i in range(0, len(codes) - 1):
+        if codes[i] == "0" and codes[i+1] == "LINE":
+            values = {}
+            j = i + 2
+            while j + 1 < len(codes) and codes[j] != "0":
+                values[codes[j]] = codes[j+1]
+                j += 2
+            lines.append((App.Vector(float(values["10"]), float(values["20"]), 0),
+                          App.Vector(float(values["11"]), float(values["21"]), 0)))
+    return lines
+
+def visibleEdges(shape, dir):
+    # the edges of the outline and the visible sharp edges, as exported by the Plain type
+    groups = Drawing.projectEx(shape, dir)
+    return groups[3].Edges + groups[0].Edges
+
+def oldPage(template, views):
+    # the page as it was built in memory before the views were streamed into the file
+    result = ""
+    for line in template.split("\n"):
+        if line.find("<!-- DrawingContent -->") < 0:
+            result += line + "\n"
+        else:
+            for view in views:
+                result += view.ViewResult + "\n\n\n"
+    return result
+
+class DrawingProjectionCases(unittest.TestCase):
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("DrawingTest")
+
+    def addView(self, name, source, algorithm):
+        view = self.Doc.addObject('Drawing::FeatureViewPart', name)
+        view.Source = source
+        view.Direction = (1.0,1.0,1.0)
+        view.Algorithm = algorithm
+        self.Doc.Page.addObject(view)
+        return view
+
+    def testAlgorithms(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.addObject('Drawing::FeaturePage','Page')
+        exact = self.addView("Exact", box, "Exact")
+        cached = self.addView("Cached", box, "Exact")
+        poly = self.addView("Polygonal", box, "Polygonal")
+        self.Doc.recompute()
+
+        # the views are projected together and the second one gets the cached result
+        self.failUnless(exact.ViewResult != "")
+        self.assertEqual(viewBody(exact), viewBody(cached))
+
+        # a view recomputed on its own must give the same output
+        body = viewBody(exact)
+        exact.touch()
+        self.Doc.recompute()
+        self.assertEqual(viewBody(exact), body)
+
+        # the polygonal algorithm sees the same outline of a box
+        a = pathBounds(viewBody(exact))
+        b = pathBounds(viewBody(poly))
+        for i in range(4):
+            self.assertAlmostEqual(a[i], b[i], 3)
+
+        # a changed source is projected again
+        box.Length = 20.0
+        self.Doc.recompute()
+        self.failUnless(viewBody(exact) != body)
+        self.assertEqual(viewBody(exact), viewBody(cached))
+
+    def testClosedDocument(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.addObject('Drawing::FeaturePage','Page')
+        exact = self.addView("Exact", box, "Exact")
+        self.Doc.recompute()
+        body = viewBody(exact)
+
+        # closing the document drops its cached projections, a new document
+        # computes the same projection again
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.newDocument("DrawingTest")
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.addObject('Drawing::FeaturePage','Page')
+        exact = self.addView("Exact", box, "Exact")
+        self.Doc.recompute()
+        self.assertEqual(viewBody(exact), body)
+
+    def testStreamedSVG(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.addObject('Drawing::FeaturePage','Page')
+        exact = self.addView("Exact", box, "Exact")
+        poly = self.addView("Polygonal", box, "Polygonal")
+        self.Doc.recompute()
+
+        # the view streams the same markup that projectToSVG returns as string
+        dir = App.Vector(1,1,1)
+        svg = Drawing.projectToSVG(box.Shape, dir, "", exact.LineWidth / exact.Scale, exact.Tolerance)
+        self.failUnless(svg in viewBody(exact))
+
+        # the merged paths draw the same lines as one path per edge did
+        edges = visibleEdges(box.Shape, dir)
+        polylines = pathPolylines(svg)
+        self.failUnless(len(polylines) > 0 and len(polylines) <= len(edges))
+        self.assertAlmostEqual(polylineLength(polylines), sum([e.Length for e in edges]), 3)
+        points = sum(polylines, [])
+        for e in edges:
+            for v in e.Vertexes:
+                self.failUnless(min([(v.Point - p).Length for p in points]) < 1e-3)
+
+        # the polygonal algorithm only returns line segments which are merged
+        polylines = pathPolylines(viewBody(poly))
+        self.failUnless(len(polylines) > 0)
+        self.assertAlmostEqual(polylineLength(polylines), sum([e.Length for e in edges]), 2)
+
+    def testStreamedDXF(self):
+        shape = Part.makeBox(10, 20, 30)
+        dir = App.Vector(1,1,1)
+        lines = dxfLines(Drawing.projectToDXF(shape, dir))
+        edges = visibleEdges(shape, dir)
+        self.assertEqual(len(lines), len(edges))
+        # every edge is written as one line
+        for e in edges:
+            p1 = e.valueAt(e.FirstParameter)
+            p2 = e.valueAt(e.LastParameter)
+            found = [l for l in lines if (l[0] - p1).Length < 1e-3 and (l[1] - p2).Length < 1e-3]
+            self.failUnless(len(found) > 0)
+
+    def testPageViews(self):
+        box = self.Doc.addObject("Part::Box","Box")
+        page = self.Doc.addObject('Drawing::FeaturePage','Page')
+        template = ('<svg xmlns="http://www.w3.org/2000/svg">\n'
+                    '  <rect width="10" height="10" />\n'
+                    '  <!-- DrawingContent -->\n'
+                    '</svg>\n')
+        name = os.path.join(tempfile.gettempdir(), "DrawingTestTemplate.svg")
+        f = open(name, "w")
+        f.write(template)
+        f.close()
+
+        first = self.addView("First", box, "Exact")
+        hidden = self.addView("Hidden", box, "Exact")
+        hidden.Visible = False
+        group = self.Doc.addObject("App::DocumentObjectGroup","Group")
+        page.addObject(group)
+        nested = self.Doc.addObject('Drawing::FeatureViewPart', "Nested")
+        nested.Source = box
+        nested.Direction = (0.0,0.0,1.0)
+        group.addObject(nested)
+        page.Template = name
+        self.Doc.recompute()
+        os.remove(name)
+
+        # the views are written at the place of the marker like before
+        f = open(page.PageResult)
+        result = f.read()
+        f.close()
+        self.assertEqual(result, oldPage(template, [first, nested]))
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.Doc.Name)
+
+def runExample():
+    # needs the STEP file of the part
+    Part.open("D:/_Projekte/FreeCAD/FreeCADData/Schenkel.stp")
+    App.activeDocument().addObject('Drawing::FeaturePage','Page')
+    App.activeDocument().Page.Template = 'D:/_Projekte/FreeCAD/FreeCAD_0.9_LibPack7/Mod/Drawing/Templates/A3_Landscape.svg'
+    App.activeDocument().addObject('Drawing::FeatureViewPart','View')
+    App.activeDocument().View.Source = App.activeDocument().Schenkel
+    App.activeDocument().View.Direction = (0.0,1.0,0.0)
+    App.activeDocument().View.X = 30.0
+    App.activeDocument().View.Y = 30.0
+    App.activeDocument().View.Scale = 1.0
+    App.activeDocument().Page.addObject(App.activeDocument().View)
+
+    App.activeDocument().addObject('Drawing::FeatureViewPart','View1')
+    App.activeDocument().View1.Source = App.activeDocument().Schenkel
+    App.activeDocument().View1.Direction = (0.0,0.0,1.0)
+    App.activeDocument().View1.X = 70.0
+    App.activeDocument().View1.Y = 30.0
+    App.activeDocument().View1.Scale = 1.0
+    App.activeDocument().Page.addObject(App.activeDocument().View1)
+
+    App.activeDocument().addObject('Drawing::FeatureViewPart','View2')
+    App.activeDocument().View2.Source = App.activeDocument().Schenkel
+    App.activeDocument().View2.Direction = (1.0,0.0,0.0)
+    App.activeDocument().View2.X = 70.0
+    App.activeDocument().View2.Y = 200.0
+    App.activeDocument().View2.Rotation = 90.0
+    App.activeDocument().View2.Scale = 1.0
+    App.activeDocument().Page.addObject(App.activeDocument().View2)
+
+    App.activeDocument().addObject('Drawing::FeatureViewPart','View3')
+    App.activeDocument().View3.Source = App.activeDocument().Schenkel
+    App.activeDocument().View3.Direction = (1.0,1.0,1.0)
+    App.activeDocument().View3.X = 280.0
+    App.activeDocument().View3.Y = 90.0
+    App.activeDocument().View3.Scale = 1.0
+    App.activeDocument().Page.addObject(App.activeDocument().View3)
+
+    App.activeDocument().recompute()
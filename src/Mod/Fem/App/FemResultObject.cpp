@@ -24,10 +24,22 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
+# include <cmath>
+# include <cstring>
+# include <limits>
 #endif
 
+#include <Base/BufferViewPy.h>
+#include <Base/Exception.h>
+#include <Base/TaskScheduler.h>
+
 #include "FemResultObject.h"
-#include <App/DocumentObjectPy.h>
+#include "FemResultObjectPy.h"
+#include "FemMeshObject.h"
+
+#include <SMESH_Mesh.hxx>
+#include <SMESHDS_Mesh.hxx>
 
 using namespace Fem;
 using namespace App;
@@ -42,11 +54,16 @@ FemResultObject::FemResultObject()
     ADD_PROPERTY_TYPE(DisplacementVectors,(), "Fem",Prop_None,"List of displacement vectors");
     ADD_PROPERTY_TYPE(DisplacementLengths,(0), "Fem",Prop_None,"List of displacement lengths");
     ADD_PROPERTY_TYPE(StressValues,(0), "Fem",Prop_None,"List of Von Misses strass values");
+    ADD_PROPERTY_TYPE(StressTensors,(0), "Fem",Prop_None,"List of stress tensors (s11, s22, s33, s12, s23, s31)");
     ADD_PROPERTY_TYPE(Mesh,(0), "General",Prop_None,"Link to the corrresponding mesh");
+
+    for (int i=0; i<NumFields; i++)
+        fieldValid[i] = false;
 }
 
 FemResultObject::~FemResultObject()
 {
+    releaseFields();
 }
 
 short FemResultObject::mustExecute(void) const
@@ -54,15 +71,394 @@ short FemResultObject::mustExecute(void) const
     return 0;
 }
 
+void FemResultObject::onChanged(const App::Property* prop)
+{
+    if (prop == &ElementNumbers || prop == &DisplacementVectors ||
+        prop == &StressValues || prop == &StressTensors) {
+        releaseFields();
+    }
+    App::DocumentObject::onChanged(prop);
+}
+
+void FemResultObject::releaseFields()
+{
+    // fields that are exported to Python as buffer are kept until released
+    bool exported = Base::BufferViewPy::isExported(this);
+    for (int i=0; i<NumFields; i++) {
+        fieldValid[i] = false;
+        boost::shared_ptr<std::vector<double> > values(new std::vector<double>());
+        values->swap(fieldCache[i]);
+        if (exported && !values->empty())
+            Base::BufferViewPy::keepAlive(this, values);
+    }
+}
+
 PyObject *FemResultObject::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
         // ref counter is set to 1
-        PythonObject = Py::Object(new DocumentObjectPy(this),true);
+        PythonObject = Py::Object(new FemResultObjectPy(this),true);
     }
     return Py::new_reference_to(PythonObject); 
 }
 
+// Derived fields ---------------------------------------------------------
+
+namespace {
+
+const char* FieldNames[] = {
+    "DisplacementX",
+    "DisplacementY",
+    "DisplacementZ",
+    "DisplacementMagnitude",
+    "VonMisesStress",
+    "MaxPrincipalStress",
+    "MidPrincipalStress",
+    "MinPrincipalStress"
+};
+
+// The number of nodes of a chunk that is worth to be processed by its own task
+const std::size_t GrainSize = 10000;
+
+class DisplacementComponent
+{
+public:
+    DisplacementComponent(const std::vector<Base::Vector3d>& d, std::vector<double>& v, int c)
+      : disp(d), values(v), comp(c)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++)
+            values[i] = disp[i][comp];
+    }
+
+private:
+    const std::vector<Base::Vector3d>& disp;
+    std::vector<double>& values;
+    int comp;
+};
+
+class DisplacementLength
+{
+public:
+    DisplacementLength(const std::vector<Base::Vector3d>& d, std::vector<double>& v)
+      : disp(d), values(v)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++) {
+            const Base::Vector3d& d = disp[i];
+            values[i] = std::sqrt(d.x*d.x + d.y*d.y + d.z*d.z);
+        }
+    }
+
+private:
+    const std::vector<Base::Vector3d>& disp;
+    std::vector<double>& values;
+};
+
+// http://en.wikipedia.org/wiki/Von_Mises_yield_criterion
+class VonMises
+{
+public:
+    VonMises(const std::vector<double>& t, std::vector<double>& v)
+      : tensors(t), values(v)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++) {
+            const double* s = &tensors[6*i];
+            double d1 = s[0] - s[1];
+            double d2 = s[1] - s[2];
+            double d3 = s[2] - s[0];
+            double sh = s[3]*s[3] + s[4]*s[4] + s[5]*s[5];
+            values[i] = std::sqrt(0.5 * (d1*d1 + d2*d2 + d3*d3 + 6.0*sh));
+        }
+    }
+
+private:
+    const std::vector<double>& tensors;
+    std::vector<double>& values;
+};
+
+// The eigenvalues of the symmetric stress tensor in closed form
+// (http://en.wikipedia.org/wiki/Eigenvalue_algorithm#3.C3.973_matrices)
+class PrincipalStress
+{
+public:
+    PrincipalStress(const std::vector<double>& t, std::vector<double>& s1,
+                    std::vector<double>& s2, std::vector<double>& s3)
+      : tensors(t), max(s1), mid(s2), min(s3)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        const double pi = 3.14159265358979323846;
+        for (std::size_t i = first; i < last; i++) {
+            const double* s = &tensors[6*i];
+            double p1 = s[3]*s[3] + s[4]*s[4] + s[5]*s[5];
+            double q = (s[0] + s[1] + s[2]) / 3.0;
+            double e1, e2, e3;
+            if (p1 == 0.0) {
+                // diagonal tensor
+                e1 = std::max(s[0], std::max(s[1], s[2]));
+                e3 = std::min(s[0], std::min(s[1], s[2]));
+            }
+            else {
+                double b11 = s[0] - q, b22 = s[1] - q, b33 = s[2] - q;
+                double p = std::sqrt((b11*b11 + b22*b22 + b33*b33 + 2.0*p1) / 6.0);
+                double det = b11 * (b22*b33 - s[4]*s[4])
+                           - s[3] * (s[3]*b33 - s[4]*s[5])
+                           + s[5] * (s[3]*s[4] - b22*s[5]);
+                double r = det / (2.0*p*p*p);
+                double phi;
+                if (r <= -1.0)
+                    phi = pi / 3.0;
+                else if (r >= 1.0)
+                    phi = 0.0;
+                else
+                    phi = std::acos(r) / 3.0;
+                e1 = q + 2.0*p*std::cos(phi);
+                e3 = q + 2.0*p*std::cos(phi + 2.0*pi/3.0);
+            }
+            e2 = 3.0*q - e1 - e3;
+            max[i] = e1;
+            mid[i] = e2;
+            min[i] = e3;
+        }
+    }
+
+private:
+    const std::vector<double>& tensors;
+    std::vector<double>& max;
+    std::vector<double>& mid;
+    std::vector<double>& min;
+};
+
+struct FieldStats
+{
+    double min, max, sum;
+};
+
+class StatsOfRange
+{
+public:
+    StatsOfRange(const std::vector<double>& v) : values(v)
+    {
+    }
+    FieldStats operator()(std::size_t first, std::size_t last) const
+    {
+        FieldStats s;
+        s.min = std::numeric_limits<double>::max();
+        s.max = -std::numeric_limits<double>::max();
+        s.sum = 0.0;
+        for (std::size_t i = first; i < last; i++) {
+            double v = values[i];
+            if (v < s.min)
+                s.min = v;
+            if (v > s.max)
+                s.max = v;
+            s.sum += v;
+        }
+        return s;
+    }
+
+private:
+    const std::vector<double>& values;
+};
+
+struct JoinStats
+{
+    FieldStats operator()(const FieldStats& a, const FieldStats& b) const
+    {
+        FieldStats s;
+        s.min = std::min(a.min, b.min);
+        s.max = std::max(a.max, b.max);
+        s.sum = a.sum + b.sum;
+        return s;
+    }
+};
+
+// Averages the values of the nodes[offsets[i]..offsets[i+1]) of each element
+class ElementAverage
+{
+public:
+    ElementAverage(const std::vector<double>& n, const std::vector<std::size_t>& o,
+                   const std::vector<int>& i, std::vector<double>& v)
+      : nodeValues(n), offsets(o), nodes(i), values(v)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++) {
+            double sum = 0.0;
+            for (std::size_t j = offsets[i]; j < offsets[i+1]; j++)
+                sum += nodeValues[nodes[j]];
+            values[i] = sum / double(offsets[i+1] - offsets[i]);
+        }
+    }
+
+private:
+    const std::vector<double>& nodeValues;
+    const std::vector<std::size_t>& offsets;
+    const std::vector<int>& nodes;
+    std::vector<double>& values;
+};
+
+// Collects the result indices of the nodes of each element of the iterator
+template <class Iterator>
+void collectElements(Iterator it, const std::vector<int>& nodeIndex, std::vector<long>& elements,
+                     std::vector<std::size_t>& offsets, std::vector<int>& nodes)
+{
+    while (it->more()) {
+        const SMDS_MeshElement* elem = it->next();
+        std::size_t start = nodes.size();
+        for (int i = 0; i < elem->NbNodes(); i++) {
+            int id = elem->GetNode(i)->GetID();
+            if (id >= 0 && id < (int)nodeIndex.size() && nodeIndex[id] >= 0)
+                nodes.push_back(nodeIndex[id]);
+        }
+        if (nodes.size() > start) {
+            elements.push_back(elem->GetID());
+            offsets.push_back(nodes.size());
+        }
+    }
+}
+
+}
+
+const char* FemResultObject::getFieldName(Field field)
+{
+    if (field < 0 || field >= NumFields)
+        return 0;
+    return FieldNames[field];
+}
+
+FemResultObject::Field FemResultObject::getField(const char* name)
+{
+    for (int i=0; i<NumFields; i++) {
+        if (strcmp(name, FieldNames[i]) == 0)
+            return Field(i);
+    }
+    return NumFields;
+}
+
+const std::vector<double>& FemResultObject::getFieldValues(Field field) const
+{
+    if (field < 0 || field >= NumFields)
+        throw Base::ValueError("Invalid result field");
+    if (fieldValid[field])
+        return fieldCache[field];
+
+    std::size_t count = ElementNumbers.getSize();
+    switch (field) {
+    case DisplacementX:
+    case DisplacementY:
+    case DisplacementZ:
+    case DisplacementMagnitude:
+        {
+            const std::vector<Base::Vector3d>& disp = DisplacementVectors.getValues();
+            if (disp.size() != count)
+                throw Base::ValueError("Result has no displacements for all nodes");
+            std::vector<double>& values = fieldCache[field];
+            values.resize(count);
+            if (field == DisplacementMagnitude)
+                Base::parallel_for(0, count, DisplacementLength(disp, values), GrainSize);
+            else
+                Base::parallel_for(0, count, DisplacementComponent(disp, values, field - DisplacementX), GrainSize);
+        }   break;
+    case VonMisesStress:
+        {
+            const std::vector<double>& tensors = StressTensors.getValues();
+            std::vector<double>& values = fieldCache[field];
+            if (tensors.size() == 6*count) {
+                values.resize(count);
+                Base::parallel_for(0, count, VonMises(tensors, values), GrainSize);
+            }
+            else if (StressValues.getSize() == (int)count) {
+                // results without tensors only have the equivalent stress
+                values = StressValues.getValues();
+            }
+            else {
+                throw Base::ValueError("Result has no stresses for all nodes");
+            }
+        }   break;
+    default:
+        {
+            const std::vector<double>& tensors = StressTensors.getValues();
+            if (tensors.size() != 6*count)
+                throw Base::ValueError("Result has no stress tensors for all nodes");
+            // all principal stresses are computed at once
+            fieldCache[MaxPrincipalStress].resize(count);
+            fieldCache[MidPrincipalStress].resize(count);
+            fieldCache[MinPrincipalStress].resize(count);
+            Base::parallel_for(0, count, PrincipalStress(tensors,
+                fieldCache[MaxPrincipalStress], fieldCache[MidPrincipalStress],
+                fieldCache[MinPrincipalStress]), GrainSize);
+            fieldValid[MaxPrincipalStress] = true;
+            fieldValid[MidPrincipalStress] = true;
+            fieldValid[MinPrincipalStress] = true;
+        }   break;
+    }
+
+    fieldValid[field] = true;
+    return fieldCache[field];
+}
+
+void FemResultObject::getFieldStats(Field field, double& min, double& avg, double& max) const
+{
+    const std::vector<double>& values = getFieldValues(field);
+    if (values.empty()) {
+        min = avg = max = 0.0;
+        return;
+    }
+
+    FieldStats init;
+    init.min = std::numeric_limits<double>::max();
+    init.max = -std::numeric_limits<double>::max();
+    init.sum = 0.0;
+    FieldStats s = Base::parallel_reduce(0, values.size(), init, StatsOfRange(values), JoinStats(), GrainSize);
+    min = s.min;
+    max = s.max;
+    avg = s.sum / double(values.size());
+}
+
+void FemResultObject::getElementValues(Field field, std::vector<long>& elements, std::vector<double>& values) const
+{
+    App::DocumentObject* obj = Mesh.getValue();
+    if (!obj || !obj->getTypeId().isDerivedFrom(FemMeshObject::getClassTypeId()))
+        throw Base::ValueError("Result has no linked FEM mesh");
+    const std::vector<double>& nodeValues = getFieldValues(field);
+
+    // map the node ids to the index of their result
+    const std::vector<long>& ids = ElementNumbers.getValues();
+    long maxId = 0;
+    for (std::vector<long>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+        maxId = std::max(maxId, *it);
+    std::vector<int> nodeIndex(maxId+1, -1);
+    for (std::size_t i = 0; i < ids.size(); i++) {
+        if (ids[i] >= 0)
+            nodeIndex[ids[i]] = (int)i;
+    }
+
+    // the mesh data structure is walked serially, the averaging is done in parallel
+    const FemMesh& mesh = static_cast<FemMeshObject*>(obj)->FemMesh.getValue();
+    const SMESHDS_Mesh* data = const_cast<SMESH_Mesh*>(mesh.getSMesh())->GetMeshDS();
+    std::vector<std::size_t> offsets(1, 0);
+    std::vector<int> nodes;
+    elements.clear();
+    if (data->NbVolumes() > 0)
+        collectElements(data->volumesIterator(), nodeIndex, elements, offsets, nodes);
+    else
+        collectElements(data->facesIterator(), nodeIndex, elements, offsets, nodes);
+
+    values.resize(elements.size());
+    Base::parallel_for(0, elements.size(), ElementAverage(nodeValues, offsets, nodes, values), GrainSize);
+}
+
 // Python feature ---------------------------------------------------------
 
 namespace App {
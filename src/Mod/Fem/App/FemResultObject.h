@@ -38,6 +38,19 @@ class AppFemExport FemResultObject : public App::DocumentObject
     PROPERTY_HEADER(Fem::FemResultObject);
 
 public:
+    /// Quantities derived from the nodal results
+    enum Field {
+        DisplacementX,
+        DisplacementY,
+        DisplacementZ,
+        DisplacementMagnitude,
+        VonMisesStress,
+        MaxPrincipalStress,
+        MidPrincipalStress,
+        MinPrincipalStress,
+        NumFields
+    };
+
     /// Constructor
     FemResultObject(void);
     virtual ~FemResultObject();
@@ -53,6 +66,30 @@ public:
     App::PropertyFloatList DisplacementLengths;
     /// Von Mises Stress values of analysis
     App::PropertyFloatList StressValues;
+    /// Stress tensors (s11, s22, s33, s12, s23, s31) of the nodes of analysis
+    App::PropertyFloatList StressTensors;
+
+    /** @name Derived fields
+     * The fields are computed in parallel on first access and cached until
+     * one of the nodal result properties changes.
+     */
+    //@{
+    /// Returns the name of the field, as used by the Python interface
+    static const char* getFieldName(Field);
+    /// Returns NumFields if there is no field with this name
+    static Field getField(const char* name);
+    /** Returns the value of the field for each node of ElementNumbers.
+     * Throws Base::ValueError if the results needed for the field are missing.
+     */
+    const std::vector<double>& getFieldValues(Field) const;
+    /// Returns the minimum, average and maximum of the field
+    void getFieldStats(Field, double& min, double& avg, double& max) const;
+    /** Averages the nodal values of the field over each volume element of the
+     * linked mesh, or over each face if there are no volumes. Elements without
+     * any result node are skipped.
+     */
+    void getElementValues(Field, std::vector<long>& elements, std::vector<double>& values) const;
+    //@}
 
     /// returns the type name of the ViewProvider
     virtual const char* getViewProviderName(void) const {
@@ -64,6 +101,15 @@ public:
     virtual short mustExecute(void) const;
     virtual PyObject *getPyObject(void);
 
+protected:
+    virtual void onChanged(const App::Property* prop);
+
+private:
+    void releaseFields();
+
+private:
+    mutable std::vector<double> fieldCache[NumFields];
+    mutable bool fieldValid[NumFields];
 
 };
 
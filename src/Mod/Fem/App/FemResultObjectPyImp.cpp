@@ -0,0 +1,147 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#include <Base/BufferViewPy.h>
+
+#include "FemResultObject.h"
+
+// inclusion of the generated files (generated out of FemResultObjectPy.xml)
+#include "FemResultObjectPy.h"
+#include "FemResultObjectPy.cpp"
+
+using namespace Fem;
+
+namespace {
+
+// Gives access to the cached values of a derived field. The cache is
+// recomputed if the results have changed since the view was created.
+class FieldProvider : public Base::BufferProvider
+{
+public:
+    FieldProvider(FemResultObject* o, FemResultObject::Field f) : object(o), field(f)
+    {
+    }
+    bool getLayout(Base::BufferLayout& layout) const
+    {
+        try {
+            const std::vector<double>& values = object->getFieldValues(field);
+            layout.data = values.empty() ? 0 : &values[0];
+            layout.rows = values.size();
+            layout.columns = 1;
+            layout.stride = sizeof(double);
+            layout.itemsize = sizeof(double);
+            layout.format = "d";
+            return true;
+        }
+        catch (const Base::Exception&) {
+            return false;
+        }
+    }
+
+private:
+    FemResultObject* object;
+    FemResultObject::Field field;
+};
+
+FemResultObject::Field getFieldByName(const char* name)
+{
+    FemResultObject::Field field = FemResultObject::getField(name);
+    if (field == FemResultObject::NumFields) {
+        std::string msg = std::string("Unknown result field: ") + name;
+        throw Base::ValueError(msg.c_str());
+    }
+    return field;
+}
+
+}
+
+// returns a string which represent the object e.g. when printed in python
+std::string FemResultObjectPy::representation(void) const
+{
+    return std::string("<Fem::FemResultObject>");
+}
+
+PyObject* FemResultObjectPy::getField(PyObject *args)
+{
+    char* name;
+    if (!PyArg_ParseTuple(args, "s", &name))
+        return 0;
+
+    FemResultObject::Field field = getFieldByName(name);
+    // compute the field now to report missing results
+    getFemResultObjectPtr()->getFieldValues(field);
+    return new Base::BufferViewPy(this, new FieldProvider(getFemResultObjectPtr(), field));
+}
+
+PyObject* FemResultObjectPy::getFieldStats(PyObject *args)
+{
+    char* name;
+    if (!PyArg_ParseTuple(args, "s", &name))
+        return 0;
+
+    double min, avg, max;
+    getFemResultObjectPtr()->getFieldStats(getFieldByName(name), min, avg, max);
+    return Py_BuildValue("(ddd)", min, avg, max);
+}
+
+PyObject* FemResultObjectPy::getElementValues(PyObject *args)
+{
+    char* name;
+    if (!PyArg_ParseTuple(args, "s", &name))
+        return 0;
+
+    std::vector<long> elements;
+    std::vector<double> values;
+    getFemResultObjectPtr()->getElementValues(getFieldByName(name), elements, values);
+
+    Py::List ids(elements.size());
+    Py::List vals(values.size());
+    for (std::size_t i = 0; i < elements.size(); i++) {
+        ids.setItem(i, Py::Int(elements[i]));
+        vals.setItem(i, Py::Float(values[i]));
+    }
+    Py::Tuple tuple(2);
+    tuple.setItem(0, ids);
+    tuple.setItem(1, vals);
+    return Py::new_reference_to(tuple);
+}
+
+Py::List FemResultObjectPy::getFieldNames(void) const
+{
+    Py::List names;
+    for (int i = 0; i < FemResultObject::NumFields; i++)
+        names.append(Py::String(FemResultObject::getFieldName(FemResultObject::Field(i))));
+    return names;
+}
+
+PyObject *FemResultObjectPy::getCustomAttributes(const char* /*attr*/) const
+{
+    return 0;
+}
+
+int FemResultObjectPy::setCustomAttributes(const char* /*attr*/, PyObject* /*obj*/)
+{
+    return 0;
+}
@@ -69,15 +69,9 @@ class FemTools(QtCore.QRunnable, QtCore.QObject):
             self.reset_mesh_color()
             return
         if self.result_object:
-            if result_type == "Sabs":
-                values = self.result_object.StressValues
-            elif result_type == "Uabs":
-                values = self.result_object.DisplacementLengths
-            else:
-                match = {"U1": 0, "U2": 1, "U3": 2}
-                d = zip(*self.result_object.DisplacementVectors)
-                values = list(d[match[result_type]])
-            self.mesh.ViewObject.setNodeColorByScalars(self.result_object.ElementNumbers, values)
+            match = {"Sabs": "VonMisesStress", "Uabs": "DisplacementMagnitude",
+                     "U1": "DisplacementX", "U2": "DisplacementY", "U3": "DisplacementZ"}
+            self.mesh.ViewObject.setNodeColorByResult(self.result_object, match[result_type])
 
     def show_displacement(self, displacement_factor=0.0):
         self.mesh.ViewObject.setNodeDisplacementByVectors(self.result_object.ElementNumbers,
@@ -3,6 +3,7 @@
 
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/TaskScheduler.h>
 
 #include <App/DocumentObjectPy.h>
 
@@ -61,6 +62,29 @@ App::Color calcColor(double value,double min, double max)
     return App::Color (0,0,0);
 }
 
+namespace {
+
+class NodeColors
+{
+public:
+    NodeColors(const std::vector<double>& v, std::vector<App::Color>& c, double l, double h)
+      : values(v), colors(c), min(l), max(h)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++)
+            colors[i] = calcColor(values[i], min, max);
+    }
+
+private:
+    const std::vector<double>& values;
+    std::vector<App::Color>& colors;
+    double min, max;
+};
+
+}
+
 
 PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
 {
@@ -100,6 +124,42 @@ PyObject* ViewProviderFemMeshPy::setNodeColorByScalars(PyObject *args)
     Py_Return;
 }
 
+PyObject* ViewProviderFemMeshPy::setNodeColorByResult(PyObject *args)
+{
+    PyObject *object;
+    char *name = 0;
+    if (!PyArg_ParseTuple(args, "O!|s", &(App::DocumentObjectPy::Type), &object, &name))
+        return 0;
+
+    App::DocumentObject* obj = static_cast<App::DocumentObjectPy*>(object)->getDocumentObjectPtr();
+    if (!obj->getTypeId().isDerivedFrom(Fem::FemResultObject::getClassTypeId())) {
+        PyErr_SetString(PyExc_TypeError, "Object is not a FEM result");
+        return 0;
+    }
+
+    Fem::FemResultObject* result = static_cast<Fem::FemResultObject*>(obj);
+    Fem::FemResultObject::Field field = Fem::FemResultObject::VonMisesStress;
+    if (name) {
+        field = Fem::FemResultObject::getField(name);
+        if (field == Fem::FemResultObject::NumFields) {
+            PyErr_Format(PyExc_ValueError, "Unknown result field: %s", name);
+            return 0;
+        }
+    }
+
+    // the field values are cached by the result object, so only the colors are computed
+    const std::vector<double>& values = result->getFieldValues(field);
+    const std::vector<long>& ids = result->ElementNumbers.getValues();
+    if (values.empty())
+        Py_Return;
+
+    double min, avg, max;
+    result->getFieldStats(field, min, avg, max);
+    std::vector<App::Color> node_colors(values.size());
+    Base::parallel_for(0, values.size(), NodeColors(values, node_colors, min, max), 10000);
+    this->getViewProviderFemMeshPtr()->setColorByNodeId(ids, node_colors);
+    Py_Return;
+}
 
 PyObject* ViewProviderFemMeshPy::setNodeDisplacementByVectors(PyObject *args)
 {
@@ -0,0 +1,107 @@
+#***************************************************************************
+#*                                                                         *
+#*   Copyright (c) 2026 - FreeCAD Developers                               *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   This program is distributed in the hope that it will be useful,       *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Library General Public License for more details.                  *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with this program; if not, write to the Free Software   *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************
+
+
+import FreeCAD
+import Fem
+import math
+import struct
+import unittest
+
+# Stress tensors (s11, s22, s33, s12, s23, s31) with their von Mises stress
+# and principal stresses computed by hand
+stress_tensors = [
+    # uniaxial tension
+    ((100.0, 0.0, 0.0, 0.0, 0.0, 0.0), 100.0, (100.0, 0.0, 0.0)),
+    # pure shear
+    ((0.0, 0.0, 0.0, 50.0, 0.0, 0.0), math.sqrt(7500.0), (50.0, 0.0, -50.0)),
+    # hydrostatic pressure
+    ((-30.0, -30.0, -30.0, 0.0, 0.0, 0.0), 0.0, (-30.0, -30.0, -30.0)),
+    # shear in the yz plane: 20 +/- 5 and 10
+    ((10.0, 20.0, 20.0, 0.0, 5.0, 0.0), math.sqrt(175.0), (25.0, 15.0, 10.0)),
+    # Mohr's circle in the xy plane: 10 +/- 25 and 5
+    ((30.0, -10.0, 5.0, 15.0, 0.0, 0.0), math.sqrt(1900.0), (35.0, 5.0, -15.0)),
+]
+
+
+def field_values(result, name):
+    view = memoryview(result.getField(name))
+    return struct.unpack("%dd" % len(result.ElementNumbers), view.tobytes())
+
+
+class FemResultTest(unittest.TestCase):
+    def setUp(self):
+        self.doc = FreeCAD.newDocument("FemResultTest")
+        self.result = self.doc.addObject("Fem::FemResultObject", "Result")
+        tensors = []
+        for t in stress_tensors:
+            tensors.extend(t[0])
+        self.result.ElementNumbers = range(1, len(stress_tensors) + 1)
+        self.result.StressTensors = tensors
+        self.result.DisplacementVectors = [FreeCAD.Vector(3, 4, 0)] * len(stress_tensors)
+
+    def testVonMisesStress(self):
+        values = field_values(self.result, "VonMisesStress")
+        for value, t in zip(values, stress_tensors):
+            self.assertAlmostEqual(value, t[1], 9)
+        vmin, vavg, vmax = self.result.getFieldStats("VonMisesStress")
+        expected = [t[1] for t in stress_tensors]
+        self.assertAlmostEqual(vmin, min(expected), 9)
+        self.assertAlmostEqual(vmax, max(expected), 9)
+        self.assertAlmostEqual(vavg, sum(expected) / len(expected), 9)
+
+    def testPrincipalStress(self):
+        names = ("MaxPrincipalStress", "MidPrincipalStress", "MinPrincipalStress")
+        for i, name in enumerate(names):
+            values = field_values(self.result, name)
+            for value, t in zip(values, stress_tensors):
+                self.assertAlmostEqual(value, t[2][i], 9)
+
+    def testDisplacement(self):
+        self.assertEqual(field_values(self.result, "DisplacementX"), (3.0,) * len(stress_tensors))
+        self.assertEqual(field_values(self.result, "DisplacementMagnitude"), (5.0,) * len(stress_tensors))
+
+    def testInvalidationWhileExported(self):
+        self.doc.UndoMode = 1
+        self.doc.openTransaction("Scale")
+        self.result.StressTensors = [2.0 * s for s in self.result.StressTensors]
+        self.doc.commitTransaction()
+        view = memoryview(self.result.getField("VonMisesStress"))
+        data = view.tobytes()
+        # the results cannot be changed from Python while the field is in use
+        try:
+            self.result.StressTensors = []
+        except BufferError:
+            pass
+        else:
+            self.fail("Exported result changed")
+        # undo changes the results from C++, the view keeps the old field
+        self.doc.undo()
+        self.assertEqual(view.tobytes(), data)
+        values = field_values(self.result, "VonMisesStress")
+        for value, old, t in zip(values, struct.unpack("%dd" % len(values), data), stress_tensors):
+            self.assertAlmostEqual(value, t[1], 9)
+            self.assertAlmostEqual(old, 2.0 * t[1], 9)
+        del view
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.doc.Name)
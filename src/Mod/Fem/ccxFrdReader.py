@@ -24,7 +24,6 @@
 
 import FreeCAD
 import os
-from math import pow, sqrt
 
 __title__ = "FreeCAD Calculix library"
 __author__ = "Juergen Riegel "
@@ -121,7 +120,6 @@ def readResult(frd_input):
 
 
 def importFrd(filename, Analysis=None):
-    mstress = []
     global displacement
     displacement = []
     m = readResult(filename)
@@ -161,47 +159,25 @@ def importFrd(filename, Analysis=None):
         if 'Stress' in m:
             stress = m['Stress']
             if len(stress) > 0:
+                # the tensors (s11, s22, s33, s12, s23, s31) of all nodes in one flat list
+                tensors = []
                 for i in stress.values():
-                    # Von mises stress (http://en.wikipedia.org/wiki/Von_Mises_yield_criterion)
-                    s11 = i[0]
-                    s22 = i[1]
-                    s33 = i[2]
-                    s12 = i[3]
-                    s23 = i[4]
-                    s31 = i[5]
-                    s11s22 = pow(s11 - s22, 2)
-                    s22s33 = pow(s22 - s33, 2)
-                    s33s11 = pow(s33 - s11, 2)
-                    s12s23s31 = 6 * (pow(s12, 2) + pow(s23, 2) * pow(s31, 2))
-                    mstress.append(sqrt(0.5 * (s11s22 + s22s33 + s33s11 + s12s23s31)))
-
-                results.StressValues = mstress
+                    tensors.extend(i)
+                results.StressTensors = tensors
                 if (results.ElementNumbers != 0 and results.ElementNumbers != stress.keys()):
                     print "Inconsistent FEM results: element number for Stress doesn't equal element number for Displacement"
                     results.ElementNumbers = stress.keys()
+                # Von mises stress (http://en.wikipedia.org/wiki/Von_Mises_yield_criterion)
+                results.StressValues = results.getField("VonMisesStress")
                 if(MeshObject):
                     results.Mesh = MeshObject
 
-        l = len(displacement)
-        x_max, y_max, z_max = map(max, zip(*displacement))
-        x_min, y_min, z_min = map(min, zip(*displacement))
-        sum_list = map(sum, zip(*displacement))
-        x_avg, y_avg, z_avg = [i / l for i in sum_list]
-        s_max = max(mstress)
-        s_min = min(mstress)
-        s_avg = sum(mstress) / l
-        disp_abs = []
-        for d in displacement:
-            disp_abs.append(sqrt(pow(d[0], 2) + pow(d[1], 2) + pow(d[2], 2)))
-        results.DisplacementLengths = disp_abs
-        a_max = max(disp_abs)
-        a_min = min(disp_abs)
-        a_avg = sum(disp_abs) / l
-        results.Stats = [x_min, x_avg, x_max,
-                         y_min, y_avg, y_max,
-                         z_min, z_avg, z_max,
-                         a_min, a_avg, a_max,
-                         s_min, s_avg, s_max]
+        # the derived fields are computed by the result object
+        results.DisplacementLengths = results.getField("DisplacementMagnitude")
+        stats = []
+        for f in ("DisplacementX", "DisplacementY", "DisplacementZ", "DisplacementMagnitude", "VonMisesStress"):
+            stats.extend(results.getFieldStats(f))
+        results.Stats = stats
         AnalysisObject.Member = AnalysisObject.Member + [results]
 
         if(FreeCAD.GuiUp):
@@ -266,7 +266,10 @@ static PyObject * importer(PyObject *self, PyObject *args)
         }
 
 #if 1
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+            .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Import");
         Import::ImportOCAF ocaf(hDoc, pcDoc, file.fileNamePure());
+        ocaf.setShareInstances(hGrp->GetBool("ShareInstances", false));
         ocaf.loadShapes();
 #else
         Import::ImportXCAF xcaf(hDoc, pcDoc, file.fileNamePure());
@@ -66,10 +66,13 @@
 
 #include "ImportOCAF.h"
 #include <Base/Console.h>
+#include <Base/Placement.h>
+#include <Base/TimeInfo.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/PartFeatureReference.h>
 #include <Mod/Part/App/ProgressIndicator.h>
 #include <Mod/Part/App/ImportIges.h>
 #include <Mod/Part/App/ImportStep.h>
@@ -81,7 +84,7 @@ using namespace Import;
 #define OCAF_KEEP_PLACEMENT
 
 ImportOCAF::ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name)
-    : pDoc(h), doc(d), default_name(name)
+    : pDoc(h), doc(d), default_name(name), shareInstances(false), numInstances(0)
 {
     aShapeTool = XCAFDoc_DocumentTool::ShapeTool (pDoc->Main());
     aColorTool = XCAFDoc_DocumentTool::ColorTool(pDoc->Main());
@@ -93,8 +96,18 @@ ImportOCAF::~ImportOCAF()
 
 void ImportOCAF::loadShapes()
 {
+    Base::TimeInfo start;
     myRefShapes.clear();
+    myPrototypes.clear();
+    myPrototypeIndex.Clear();
+    numInstances = 0;
     loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false);
+
+    if (shareInstances) {
+        Base::Console().Log("Imported %d shapes and %d shared instances in %f s\n",
+            (int)myPrototypes.size(), numInstances,
+            Base::TimeInfo::diffTimeF(start,Base::TimeInfo()));
+    }
 }
 
 void ImportOCAF::loadShapes(const TDF_Label& label, const TopLoc_Location& loc, const std::string& defaultname, const std::string& assembly, bool isRef)
@@ -208,6 +221,9 @@ void ImportOCAF::createShape(const TDF_Label& label, const TopLoc_Location& loc,
 
 void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location& loc, const std::string& name)
 {
+    if (shareInstances && createInstance(aShape, loc, name))
+        return;
+
     Part::Feature* part = static_cast<Part::Feature*>(doc->addObject("Part::Feature"));
     if (!loc.IsIdentity())
         part->Shape.setValue(aShape.Moved(loc));
@@ -215,6 +231,50 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         part->Shape.setValue(aShape);
     part->Label.setValue(name);
 
+    std::vector<App::Color> colors;
+    loadColors(aShape, colors);
+    if (!colors.empty())
+        applyColors(part, colors);
+
+    if (shareInstances) {
+        Prototype proto;
+        proto.shape = aShape;
+        proto.feature = part;
+        proto.colors = colors;
+        myPrototypeIndex.Bind(aShape.Located(TopLoc_Location()), (int)myPrototypes.size());
+        myPrototypes.push_back(proto);
+    }
+}
+
+bool ImportOCAF::createInstance(const TopoDS_Shape& aShape, const TopLoc_Location& loc, const std::string& name)
+{
+    // the key ignores the location, so all occurrences of a shape map to the same prototype
+    TopoDS_Shape key = aShape.Located(TopLoc_Location());
+    if (!myPrototypeIndex.IsBound(key))
+        return false;
+    const Prototype& proto = myPrototypes[myPrototypeIndex.Find(key)];
+    // a placement cannot express a reversed orientation
+    if (proto.shape.Orientation() != aShape.Orientation())
+        return false;
+
+    TopoDS_Shape moved = loc.IsIdentity() ? aShape : aShape.Moved(loc);
+    Base::Placement plm;
+    plm.fromMatrix(Part::TopoShape(moved).getTransform());
+
+    Part::FeatureReference* ref = static_cast<Part::FeatureReference*>
+        (doc->addObject("Part::FeatureReference"));
+    ref->Reference.setValue(proto.feature);
+    ref->Placement.setValue(plm);
+    ref->Label.setValue(name);
+    if (!proto.colors.empty())
+        applyColors(ref, proto.colors);
+
+    numInstances++;
+    return true;
+}
+
+void ImportOCAF::loadColors(const TopoDS_Shape& aShape, std::vector<App::Color>& colors) const
+{
     Quantity_Color aColor;
     App::Color color(0.8f,0.8f,0.8f);
     if (aColorTool->GetColor(aShape, XCAFDoc_ColorGen, aColor) ||
@@ -223,18 +283,7 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         color.r = (float)aColor.Red();
         color.g = (float)aColor.Green();
         color.b = (float)aColor.Blue();
-        std::vector<App::Color> colors;
         colors.push_back(color);
-        applyColors(part, colors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPart::getClassTypeId())) {
-            color.r = aColor.Red();
-            color.g = aColor.Green();
-            color.b = aColor.Blue();
-            static_cast<PartGui::ViewProviderPart*>(vp)->ShapeColor.setValue(color);
-        }
-#endif
     }
 
     TopTools_IndexedMapOfShape faces;
@@ -261,14 +310,9 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
         xp.Next();
     }
 
+    // the face colors contain the shape color for all faces without an own color
     if (found_face_color) {
-        applyColors(part, faceColors);
-#if 0//TODO
-        Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
-        if (vp && vp->isDerivedFrom(PartGui::ViewProviderPartExt::getClassTypeId())) {
-            static_cast<PartGui::ViewProviderPartExt*>(vp)->DiffuseColor.setValues(faceColors);
-        }
-#endif
+        colors.swap(faceColors);
     }
 }
 
@@ -302,6 +346,16 @@ void ExportOCAF::saveShape(Part::Feature* part, const std::vector<App::Color>& c
     TopoDS_Shape baseShape = shape;
 #endif
 
+#if defined(OCAF_KEEP_PLACEMENT)
+    // parts that share their geometry become further instances of the same
+    // product, its name and colors are those of the first part
+    TDF_Label protoLabel;
+    if (aShapeTool->FindShape(baseShape, protoLabel)) {
+        aShapeTool->AddComponent(rootLabel, protoLabel, aLoc);
+        return;
+    }
+#endif
+
     // Add shape and name
     TDF_Label shapeLabel = aShapeTool->NewShape();
     aShapeTool->SetShape(shapeLabel, baseShape);
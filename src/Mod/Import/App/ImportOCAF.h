@@ -29,6 +29,7 @@
 #include <Handle_XCAFDoc_ShapeTool.hxx>
 #include <Quantity_Color.hxx>
 #include <TopoDS_Shape.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
 #include <climits>
 #include <string>
 #include <set>
@@ -55,12 +56,26 @@ public:
     ImportOCAF(Handle_TDocStd_Document h, App::Document* d, const std::string& name);
     virtual ~ImportOCAF();
     void loadShapes();
+    /** If enabled only the first occurrence of a shape is created as Part::Feature.
+     * All further occurrences become Part::FeatureReference objects that only have
+     * their own placement and share the geometry and the tessellation.
+     */
+    void setShareInstances(bool on)
+    { shareInstances = on; }
 
 private:
     void loadShapes(const TDF_Label& label, const TopLoc_Location&, const std::string& partname, const std::string& assembly, bool isRef);
     void createShape(const TDF_Label& label, const TopLoc_Location&, const std::string&);
     void createShape(const TopoDS_Shape& label, const TopLoc_Location&, const std::string&);
-    virtual void applyColors(Part::Feature*, const std::vector<App::Color>&){}
+    bool createInstance(const TopoDS_Shape&, const TopLoc_Location&, const std::string&);
+    void loadColors(const TopoDS_Shape&, std::vector<App::Color>&) const;
+    virtual void applyColors(App::DocumentObject*, const std::vector<App::Color>&){}
+
+    struct Prototype {
+        TopoDS_Shape shape;
+        Part::Feature* feature;
+        std::vector<App::Color> colors;
+    };
 
 private:
     Handle_TDocStd_Document pDoc;
@@ -69,6 +84,10 @@ private:
     Handle_XCAFDoc_ColorTool aColorTool;
     std::string default_name;
     std::set<int> myRefShapes;
+    bool shareInstances;
+    int numInstances;
+    std::vector<Prototype> myPrototypes;
+    TopTools_DataMapOfShapeInteger myPrototypeIndex;
     static const int HashUpper = INT_MAX;
 };
 
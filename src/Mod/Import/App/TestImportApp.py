@@ -0,0 +1,97 @@
+#***************************************************************************
+#*   Copyright (c) 2026 FreeCAD Developers                                 *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Library General Public License for more details.                  *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, os, unittest, Part, Import
+import tempfile, time
+App = FreeCAD
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD Import module
+#---------------------------------------------------------------------------
+
+
+class ImportInstanceCases(unittest.TestCase):
+	def setUp(self):
+		# an assembly with one box that is placed six times
+		self.Doc = FreeCAD.newDocument("ImportTest")
+		box = self.Doc.addObject("Part::Feature", "Box")
+		box.Shape = Part.makeBox(1.0, 2.0, 3.0)
+		parts = [box]
+		for i in range(1, 6):
+			part = self.Doc.addObject("Part::Feature", "Copy")
+			# the copies share the geometry of the box
+			part.Shape = box.Shape
+			part.Placement = App.Placement(App.Vector(5.0*i, 1.0, 0.0), App.Rotation(App.Vector(0, 0, 1), 30.0*i))
+			parts.append(part)
+		self.Placements = [p.Placement for p in parts]
+		self.FileName = os.path.join(tempfile.gettempdir(), "ImportInstances.step")
+		Import.export(parts, self.FileName)
+
+	def importStep(self, share):
+		grp = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Import")
+		old = grp.GetBool("ShareInstances", False)
+		grp.SetBool("ShareInstances", share)
+		doc = FreeCAD.newDocument("ImportTestShared" if share else "ImportTestCopies")
+		try:
+			start = time.time()
+			Import.insert(self.FileName, doc.Name)
+			FreeCAD.Console.PrintMessage("Import of %s with ShareInstances=%s: %.3f s\n" % (self.FileName, share, time.time() - start))
+		finally:
+			grp.SetBool("ShareInstances", old)
+		return doc
+
+	def samePlacement(self, p1, p2):
+		# compare the mapping of a point that is not on any axis
+		v = App.Vector(1.0, 2.0, 3.0)
+		return (p1.multVec(v) - p2.multVec(v)).Length < 1e-6
+
+	def checkPlacements(self, placements):
+		self.failUnless(len(placements) == len(self.Placements))
+		for p in self.Placements:
+			found = [q for q in placements if self.samePlacement(p, q)]
+			self.failUnless(len(found) == 1)
+
+	def testCopies(self):
+		doc = self.importStep(False)
+		features = [o for o in doc.Objects if o.isDerivedFrom("Part::Feature")]
+		self.failUnless(len(features) == len(self.Placements))
+		self.failIf([o for o in doc.Objects if o.isDerivedFrom("Part::FeatureReference")])
+		self.checkPlacements([o.Placement for o in features])
+		FreeCAD.closeDocument(doc.Name)
+
+	def testSharedInstances(self):
+		doc = self.importStep(True)
+		features = [o for o in doc.Objects if o.isDerivedFrom("Part::Feature")]
+		references = [o for o in doc.Objects if o.isDerivedFrom("Part::FeatureReference")]
+		# the first occurrence holds the shape, all others only link to it
+		self.failUnless(len(features) == 1)
+		self.failUnless(len(references) == len(self.Placements) - 1)
+		proto = features[0]
+		self.failUnless(abs(proto.Shape.Volume - 6.0) < 1e-9)
+		for ref in references:
+			self.failUnless(ref.Reference == proto)
+		self.checkPlacements([proto.Placement] + [o.Placement for o in references])
+		FreeCAD.closeDocument(doc.Name)
+
+	def tearDown(self):
+		FreeCAD.closeDocument(self.Doc.Name)
+		os.remove(self.FileName)
@@ -92,7 +92,7 @@ public:
     }
 
 private:
-    void applyColors(Part::Feature* part, const std::vector<App::Color>& colors)
+    void applyColors(App::DocumentObject* part, const std::vector<App::Color>& colors)
     {
         Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(part);
         if (vp && vp->isDerivedFrom(PartGui::ViewProviderPartExt::getClassTypeId())) {
@@ -196,7 +196,10 @@ static PyObject * importer(PyObject *self, PyObject *args)
             return 0;
         }
 
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+            .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Import");
         ImportOCAFExt ocaf(hDoc, pcDoc, file.fileNamePure());
+        ocaf.setShareInstances(hGrp->GetBool("ShareInstances", false));
         ocaf.loadShapes();
         pcDoc->recompute();
     }
@@ -27,19 +27,13 @@
 #include <BRepBuilderAPI_MakeVertex.hxx>
 #include <TopoDS_Vertex.hxx>
 
-#include <QEventLoop>
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
-
 #include <boost/signals.hpp>
-#include <boost/bind.hpp>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
-#include <Base/FutureWatcherProgress.h>
 #include <Base/Parameter.h>
 #include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
 #include <Base/Tools.h>
 #include <App/Application.h>
 #include <Mod/Mesh/App/Mesh.h>
@@ -549,9 +543,8 @@ void PropertyDistanceList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<float>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << *it;
-    }
+    if (uCt > 0)
+        str.write(&_lValueList[0], uCt);
 }
 
 void PropertyDistanceList::RestoreDocFile(Base::Reader &reader)
@@ -560,9 +553,8 @@ void PropertyDistanceList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (std::vector<float>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> *it;
-    }
+    if (uCt > 0)
+        str.read(&values[0], uCt);
     setValues(values);
 }
 
@@ -587,21 +579,27 @@ unsigned int PropertyDistanceList::getMemSize (void) const
 
 // ----------------------------------------------------------------
 
-// helper class to use Qt's concurrent framework
+// helper class to inspect the points with Base::parallel_for
 struct DistanceInspection
 {
 
     DistanceInspection(float radius, InspectActualGeometry*  a,
-                       std::vector<InspectNominalGeometry*> n)
-                    : radius(radius), actual(a), nominal(n)
+                       std::vector<InspectNominalGeometry*> n,
+                       std::vector<float>& v)
+                    : radius(radius), actual(a), nominal(n), vals(v)
     {
     }
-    float mapped(unsigned long index)
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t index = first; index < last; index++)
+            vals[index] = mapped(index);
+    }
+    float mapped(unsigned long index) const
     {
         Base::Vector3f pnt = actual->getPoint(index);
 
         float fMinDist=FLT_MAX;
-        for (std::vector<InspectNominalGeometry*>::iterator it = nominal.begin(); it != nominal.end(); ++it) {
+        for (std::vector<InspectNominalGeometry*>::const_iterator it = nominal.begin(); it != nominal.end(); ++it) {
             float fDist = (*it)->getDistance(pnt);
             if (fabs(fDist) < fabs(fMinDist))
                 fMinDist = fDist;
@@ -618,6 +616,7 @@ struct DistanceInspection
     float radius;
     InspectActualGeometry*  actual;
     std::vector<InspectNominalGeometry*> nominal;
+    std::vector<float>& vals;
 };
 
 PROPERTY_SOURCE(Inspection::Feature, App::DocumentObject)
@@ -695,25 +694,12 @@ App::DocumentObjectExecReturn* Feature::execute(void)
 
 #if 0 // test with some huge data sets
     Standard::SetReentrant(Standard_True);
-    std::vector<unsigned long> index(actual->countPoints());
-    std::generate(index.begin(), index.end(), Base::iotaGen<unsigned long>(0));
-    DistanceInspection check(this->SearchRadius.getValue(), actual, inspectNominal);
-    QFuture<float> future = QtConcurrent::mapped
-        (index, boost::bind(&DistanceInspection::mapped, &check, _1));
-    //future.waitForFinished(); // blocks the GUI
-    Base::FutureWatcherProgress progress("Inspecting...", actual->countPoints());
-    QFutureWatcher<float> watcher;
-    QObject::connect(&watcher, SIGNAL(progressValueChanged(int)),
-                     &progress, SLOT(progressValueChanged(int)));
-    watcher.setFuture(future);
-
-    // keep it responsive during computation
-    QEventLoop loop;
-    QObject::connect(&watcher, SIGNAL(finished()), &loop, SLOT(quit()));
-    loop.exec();
-
-    std::vector<float> vals;
-    vals.insert(vals.end(), future.begin(), future.end());
+    unsigned long count = actual->countPoints();
+    Base::SequencerLauncher seq("Inspecting...", count);
+    Base::CancellationToken token(&seq);
+    std::vector<float> vals(count);
+    DistanceInspection check(this->SearchRadius.getValue(), actual, inspectNominal, vals);
+    Base::parallel_for(0, count, check, 1000, &token);
 #else
     unsigned long count = actual->countPoints();
     std::stringstream str;
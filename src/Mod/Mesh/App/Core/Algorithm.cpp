@@ -27,6 +27,9 @@
 # include <algorithm>
 #endif
 
+#include <boost/bind.hpp>
+#include <Base/TaskScheduler.h>
+
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
@@ -637,8 +640,8 @@ bool MeshAlgorithm::FillupHole(const std::vector<unsigned long>& boundary,
     unsigned long refPoint0 = *(boundary.begin());
     unsigned long refPoint1 = *(boundary.begin()+1);
     if (pP2FStructure) {
-        const std::set<unsigned long>& ring1 = (*pP2FStructure)[refPoint0];
-        const std::set<unsigned long>& ring2 = (*pP2FStructure)[refPoint1];
+        MeshIndexSpan ring1 = (*pP2FStructure)[refPoint0];
+        MeshIndexSpan ring2 = (*pP2FStructure)[refPoint1];
         std::vector<unsigned long> f_int;
         std::set_intersection(ring1.begin(), ring1.end(), ring2.begin(), ring2.end(),
             std::back_insert_iterator<std::vector<unsigned long> >(f_int));
@@ -1694,28 +1697,119 @@ float MeshAlgorithm::CalculateMinimumGridLength(float fLength, const Base::Bound
 
 // ----------------------------------------------------
 
-void MeshRefPointToFacets::Rebuild (void)
+void MeshAdjacency::Allocate (const std::vector<unsigned long>& counts)
 {
-    _map.clear();
+    _offsets.resize(counts.size() + 1);
+    _offsets[0] = 0;
+    for (std::size_t i = 0; i < counts.size(); i++)
+        _offsets[i+1] = _offsets[i] + counts[i];
 
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    _fill.assign(_offsets.begin(), _offsets.end() - 1);
+    _indices.clear();
+    _indices.resize(_offsets.back());
+}
+
+void MeshAdjacency::SortRows (unsigned long first, unsigned long last)
+{
+    for (unsigned long i = first; i < last; i++) {
+        std::vector<unsigned long>::iterator jt = _indices.begin() + _offsets[i];
+        std::vector<unsigned long>::iterator kt = _indices.begin() + _fill[i];
+        std::sort(jt, kt);
+        _fill[i] = std::unique(jt, kt) - _indices.begin();
+    }
+}
+
+void MeshAdjacency::Finish ()
+{
+    unsigned long count = Size();
+    Base::parallel_for(0, count, boost::bind(&MeshAdjacency::SortRows, this, _1, _2), 10000);
+
+    // close the gaps left by removed duplicates
+    unsigned long pos = 0;
+    for (unsigned long i = 0; i < count; i++) {
+        unsigned long first = _offsets[i];
+        unsigned long last = _fill[i];
+        _offsets[i] = pos;
+        for (unsigned long j = first; j < last; j++)
+            _indices[pos++] = _indices[j];
+    }
+    if (count > 0)
+        _offsets[count] = pos;
+
+    _indices.resize(pos);
+    std::vector<unsigned long>(_indices).swap(_indices);
+    std::vector<unsigned long>().swap(_fill);
+}
+
+void MeshAdjacency::Insert (unsigned long pos, unsigned long index)
+{
+    std::vector<unsigned long>::iterator first = _indices.begin() + _offsets[pos];
+    std::vector<unsigned long>::iterator last = _indices.begin() + _offsets[pos+1];
+    std::vector<unsigned long>::iterator it = std::lower_bound(first, last, index);
+    if (it != last && *it == index)
+        return;
+
+    _indices.insert(it, index);
+    for (std::vector<unsigned long>::iterator jt = _offsets.begin() + pos + 1; jt != _offsets.end(); ++jt)
+        (*jt)++;
+}
+
+void MeshAdjacency::Erase (unsigned long pos, unsigned long index)
+{
+    std::vector<unsigned long>::iterator first = _indices.begin() + _offsets[pos];
+    std::vector<unsigned long>::iterator last = _indices.begin() + _offsets[pos+1];
+    std::vector<unsigned long>::iterator it = std::lower_bound(first, last, index);
+    if (it == last || *it != index)
+        return;
+
+    _indices.erase(it);
+    for (std::vector<unsigned long>::iterator jt = _offsets.begin() + pos + 1; jt != _offsets.end(); ++jt)
+        (*jt)--;
+}
+
+void MeshAdjacency::Clear ()
+{
+    std::vector<unsigned long>().swap(_offsets);
+    std::vector<unsigned long>().swap(_indices);
+    std::vector<unsigned long>().swap(_fill);
+}
+
+unsigned long MeshAdjacency::MemSize () const
+{
+    return static_cast<unsigned long>((_offsets.capacity() + _indices.capacity() + _fill.capacity())
+        * sizeof(unsigned long));
+}
+
+// ----------------------------------------------------
+
+void MeshRefPointToFacets::Rebuild (void)
+{
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rPoints.size());
+    std::vector<unsigned long> counts(_rclMesh.CountPoints(), 0);
 
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        _map[pFIter->_aulPoints[0]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[1]].insert(pFIter - pFBegin);
-        _map[pFIter->_aulPoints[2]].insert(pFIter - pFBegin);
+    MeshFacetArray::_TConstIterator pFIter;
+    for (pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        counts[pFIter->_aulPoints[0]]++;
+        counts[pFIter->_aulPoints[1]]++;
+        counts[pFIter->_aulPoints[2]]++;
     }
+
+    _map.Allocate(counts);
+    unsigned long index = 0;
+    for (pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter, ++index) {
+        _map.Append(pFIter->_aulPoints[0], index);
+        _map.Append(pFIter->_aulPoints[1], index);
+        _map.Append(pFIter->_aulPoints[2], index);
+    }
+    _map.Finish();
 }
 
 Base::Vector3f MeshRefPointToFacets::GetNormal(unsigned long pos) const
 {
-    const std::set<unsigned long>& n = _map[pos];
+    MeshIndexSpan n = _map[pos];
     Base::Vector3f normal;
     MeshGeomFacet f;
-    for (std::set<unsigned long>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexSpan::const_iterator it = n.begin(); it != n.end(); ++it) {
         f = _rclMesh.GetFacet(*it);
         normal += f.Area() * f.GetNormal();
     }
@@ -1733,8 +1827,8 @@ std::set<unsigned long> MeshRefPointToFacets::NeighbourPoints(const std::vector<
     for (int i=0; i < level; i++) {
         std::set<unsigned long> cur;
         for (std::set<unsigned long>::iterator it = lp.begin(); it != lp.end(); ++it) {
-            const std::set<unsigned long>& ft = (*this)[*it];
-            for (std::set<unsigned long>::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
+            MeshIndexSpan ft = (*this)[*it];
+            for (MeshIndexSpan::const_iterator jt = ft.begin(); jt != ft.end(); ++jt) {
                 for (int j = 0; j < 3; j++) {
                     unsigned long index = f_it[*jt]._aulPoints[j];
                     if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
@@ -1774,9 +1868,9 @@ void MeshRefPointToFacets::SearchNeighbours(const MeshFacetArray& rFacets, unsig
     visited.insert(index);
     collect.Append(_rclMesh, index);
     for (int i = 0; i < 3; i++) {
-        const std::set<unsigned long> &f = (*this)[face._aulPoints[i]];
+        MeshIndexSpan f = (*this)[face._aulPoints[i]];
 
-        for (std::set<unsigned long>::const_iterator j = f.begin(); j != f.end(); ++j) {
+        for (MeshIndexSpan::const_iterator j = f.begin(); j != f.end(); ++j) {
             SearchNeighbours(rFacets, *j, rclCenter, fMaxDist2, visited, collect);
         }
     }
@@ -1788,7 +1882,7 @@ MeshRefPointToFacets::GetFacet (unsigned long index) const
     return _rclMesh.GetFacets().begin() + index;
 }
 
-const std::set<unsigned long>&
+MeshIndexSpan
 MeshRefPointToFacets::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1796,35 +1890,51 @@ MeshRefPointToFacets::operator[] (unsigned long pos) const
 
 void MeshRefPointToFacets::AddNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToFacets::RemoveNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
 
 void MeshRefFacetToFacets::Rebuild (void)
 {
-    _map.clear();
+    MeshRefPointToFacets  vertexFace(_rclMesh);
 
     const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    _map.resize(rFacets.size());
+    std::vector<unsigned long> counts(rFacets.size());
+    std::vector<unsigned long>::iterator cIter = counts.begin();
+    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter, ++cIter) {
+        *cIter = static_cast<unsigned long>(vertexFace[pFIter->_aulPoints[0]].size() +
+                                            vertexFace[pFIter->_aulPoints[1]].size() +
+                                            vertexFace[pFIter->_aulPoints[2]].size());
+    }
 
-    MeshRefPointToFacets  vertexFace(_rclMesh);
-    MeshFacetArray::_TConstIterator pFBegin = rFacets.begin();
-    for (MeshFacetArray::_TConstIterator pFIter = pFBegin; pFIter != rFacets.end(); ++pFIter) {
+    // each facet only writes into its own row, so the rows can be filled concurrently
+    _map.Allocate(counts);
+    Base::parallel_for(0, rFacets.size(),
+        boost::bind(&MeshRefFacetToFacets::FillRows, this, boost::cref(vertexFace), _1, _2), 10000);
+    _map.Finish();
+}
+
+void MeshRefFacetToFacets::FillRows (const MeshRefPointToFacets& vertexFace,
+                                     unsigned long first, unsigned long last)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    for (unsigned long index = first; index < last; index++) {
+        const MeshFacet& rFace = rFacets[index];
         for (int i = 0; i < 3; i++) {
-            const std::set<unsigned long>& faces = vertexFace[pFIter->_aulPoints[i]];
-            for (std::set<unsigned long>::const_iterator it = faces.begin(); it != faces.end(); ++it)
-                _map[pFIter - pFBegin].insert(*it);
+            MeshIndexSpan faces = vertexFace[rFace._aulPoints[i]];
+            for (MeshIndexSpan::const_iterator it = faces.begin(); it != faces.end(); ++it)
+                _map.Append(index, *it);
         }
     }
 }
 
-const std::set<unsigned long>&
+MeshIndexSpan
 MeshRefFacetToFacets::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1834,23 +1944,40 @@ MeshRefFacetToFacets::operator[] (unsigned long pos) const
 
 void MeshRefPointToPoints::Rebuild (void)
 {
-    _map.clear();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<unsigned long> counts(_rclMesh.CountPoints(), 0);
 
-    const MeshPointArray& rPoints = _rclMesh.GetPoints();
-    _map.resize(rPoints.size());
+    MeshFacetArray::_TConstIterator pFIter;
+    for (pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
+        counts[pFIter->_aulPoints[0]] += 2;
+        counts[pFIter->_aulPoints[1]] += 2;
+        counts[pFIter->_aulPoints[2]] += 2;
+    }
 
-    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
-    for (MeshFacetArray::_TConstIterator pFIter = rFacets.begin(); pFIter != rFacets.end(); ++pFIter) {
-        unsigned long ulP0 = pFIter->_aulPoints[0];
-        unsigned long ulP1 = pFIter->_aulPoints[1];
-        unsigned long ulP2 = pFIter->_aulPoints[2];
+    // gathering the neighbours over the facets of a point lets each point
+    // write only into its own row, so the rows can be filled concurrently
+    MeshRefPointToFacets vertexFace(_rclMesh);
+    _map.Allocate(counts);
+    Base::parallel_for(0, counts.size(),
+        boost::bind(&MeshRefPointToPoints::FillRows, this, boost::cref(vertexFace), _1, _2), 10000);
+    _map.Finish();
+}
 
-        _map[ulP0].insert(ulP1);
-        _map[ulP0].insert(ulP2);
-        _map[ulP1].insert(ulP0);
-        _map[ulP1].insert(ulP2);
-        _map[ulP2].insert(ulP0);
-        _map[ulP2].insert(ulP1);
+void MeshRefPointToPoints::FillRows (const MeshRefPointToFacets& vertexFace,
+                                     unsigned long first, unsigned long last)
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    for (unsigned long index = first; index < last; index++) {
+        MeshIndexSpan faces = vertexFace[index];
+        for (MeshIndexSpan::const_iterator it = faces.begin(); it != faces.end(); ++it) {
+            const MeshFacet& rFace = rFacets[*it];
+            for (int i = 0; i < 3; i++) {
+                if (rFace._aulPoints[i] == index) {
+                    _map.Append(index, rFace._aulPoints[(i+1)%3]);
+                    _map.Append(index, rFace._aulPoints[(i+2)%3]);
+                }
+            }
+        }
     }
 }
 
@@ -1860,8 +1987,8 @@ Base::Vector3f MeshRefPointToPoints::GetNormal(unsigned long pos) const
     MeshCore::PlaneFit pf;
     pf.AddPoint(rPoints[pos]);
     MeshCore::MeshPoint center = rPoints[pos];
-    const std::set<unsigned long>& cv = _map[pos];
-    for (std::set<unsigned long>::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+    MeshIndexSpan cv = _map[pos];
+    for (MeshIndexSpan::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
         pf.AddPoint(rPoints[*cv_it]);
         center += rPoints[*cv_it];
     }
@@ -1877,15 +2004,15 @@ float MeshRefPointToPoints::GetAverageEdgeLength(unsigned long index) const
 {
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     float len=0.0f;
-    const std::set<unsigned long>& n = (*this)[index];
+    MeshIndexSpan n = (*this)[index];
     const Base::Vector3f& p = rPoints[index];
-    for (std::set<unsigned long>::const_iterator it = n.begin(); it != n.end(); ++it) {
+    for (MeshIndexSpan::const_iterator it = n.begin(); it != n.end(); ++it) {
         len += Base::Distance(p, rPoints[*it]);
     }
     return (len/n.size());
 }
 
-const std::set<unsigned long>&
+MeshIndexSpan
 MeshRefPointToPoints::operator[] (unsigned long pos) const
 {
     return _map[pos];
@@ -1893,12 +2020,12 @@ MeshRefPointToPoints::operator[] (unsigned long pos) const
 
 void MeshRefPointToPoints::AddNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].insert(facet);
+    _map.Insert(pos, facet);
 }
 
 void MeshRefPointToPoints::RemoveNeighbour(unsigned long pos, unsigned long facet)
 {
-    _map[pos].erase(facet);
+    _map.Erase(pos, facet);
 }
 
 //----------------------------------------------------------------------------
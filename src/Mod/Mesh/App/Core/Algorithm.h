@@ -24,6 +24,7 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
 #include <set>
 #include <vector>
 #include <map>
@@ -354,6 +355,98 @@ private:
     std::vector<unsigned long>& indices;
 };
 
+/**
+ * The MeshIndexSpan class is a read-only view onto a sorted range of indices
+ * as stored by MeshAdjacency. It provides the subset of the std::set interface
+ * that is used to iterate over or to look up neighbours.
+ */
+class MeshIndexSpan
+{
+public:
+    typedef unsigned long value_type;
+    typedef std::size_t size_type;
+    typedef const unsigned long* const_iterator;
+    typedef const unsigned long* iterator;
+
+    MeshIndexSpan () : _begin(0), _end(0)
+    { }
+    MeshIndexSpan (const unsigned long* b, const unsigned long* e) : _begin(b), _end(e)
+    { }
+
+    const_iterator begin () const
+    { return _begin; }
+    const_iterator end () const
+    { return _end; }
+    size_type size () const
+    { return static_cast<size_type>(_end - _begin); }
+    bool empty () const
+    { return _begin == _end; }
+    /// Returns the position of \a index or end() if it is not part of the range.
+    const_iterator find (unsigned long index) const
+    {
+        const_iterator it = std::lower_bound(_begin, _end, index);
+        return (it != _end && *it == index) ? it : _end;
+    }
+    size_type count (unsigned long index) const
+    { return find(index) != _end ? 1 : 0; }
+
+private:
+    const unsigned long* _begin;
+    const unsigned long* _end;
+};
+
+/**
+ * The MeshAdjacency class stores for each element a sorted list of unique indices
+ * in compressed row form, i.e. all lists are packed into one array and an offset
+ * array marks where the list of each element starts.
+ * Compared to a vector of sets this needs a fraction of the memory, avoids one heap
+ * allocation per entry and keeps the neighbours of an element close together.
+ *
+ * The structure is built in two passes: Allocate() reserves the space for a given
+ * number of entries per element, Append() fills them in and Finish() sorts each
+ * list and removes duplicates. Lists of different elements can be filled from
+ * different threads.
+ */
+class MeshExport MeshAdjacency
+{
+public:
+    MeshAdjacency ()
+    { }
+
+    /// Reserves \a counts[i] entries for element i.
+    void Allocate (const std::vector<unsigned long>& counts);
+    /// Appends an index to the list of element \a pos. Must be called between Allocate() and Finish().
+    void Append (unsigned long pos, unsigned long index)
+    { _indices[_fill[pos]++] = index; }
+    /// Sorts the lists, removes duplicates and releases unused memory.
+    void Finish ();
+
+    /// Inserts \a index into the list of \a pos. This is an O(n) operation.
+    void Insert (unsigned long pos, unsigned long index);
+    /// Removes \a index from the list of \a pos. This is an O(n) operation.
+    void Erase (unsigned long pos, unsigned long index);
+    void Clear ();
+
+    /// Returns the number of elements.
+    unsigned long Size () const
+    { return _offsets.empty() ? 0 : static_cast<unsigned long>(_offsets.size() - 1); }
+    MeshIndexSpan operator[] (unsigned long pos) const
+    {
+        const unsigned long* data = _indices.empty() ? 0 : &_indices[0];
+        return MeshIndexSpan(data + _offsets[pos], data + _offsets[pos+1]);
+    }
+    /// Returns the number of bytes used.
+    unsigned long MemSize () const;
+
+private:
+    void SortRows (unsigned long first, unsigned long last);
+
+private:
+    std::vector<unsigned long> _offsets;
+    std::vector<unsigned long> _indices;
+    std::vector<unsigned long> _fill;
+};
+
 /**
  * The MeshRefPointToFacets builds up a structure to have access to all facets indexing
  * a point.
@@ -372,7 +465,7 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild (void);
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexSpan operator[] (unsigned long) const;
     MeshFacetArray::_TConstIterator GetFacet (unsigned long) const;
     std::set<unsigned long> NeighbourPoints(const std::vector<unsigned long>& , int level) const;
     void Neighbours (unsigned long ulFacetInd, float fMaxDist, MeshCollector& collect) const;
@@ -386,7 +479,7 @@ protected:
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshAdjacency _map;
 };
 
 /**
@@ -409,11 +502,15 @@ public:
 
     /// Returns a set of facets sharing one or more points with the facet with
     /// index \a ulFacetIndex.
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexSpan operator[] (unsigned long) const;
+
+private:
+    void FillRows (const MeshRefPointToFacets& vertexFace,
+                   unsigned long first, unsigned long last);
 
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshAdjacency _map;
 };
 
 /**
@@ -434,15 +531,19 @@ public:
 
     /// Rebuilds up data structure
     void Rebuild (void);
-    const std::set<unsigned long>& operator[] (unsigned long) const;
+    MeshIndexSpan operator[] (unsigned long) const;
     Base::Vector3f GetNormal(unsigned long) const;
     float GetAverageEdgeLength(unsigned long) const;
     void AddNeighbour(unsigned long, unsigned long);
     void RemoveNeighbour(unsigned long, unsigned long);
 
+private:
+    void FillRows (const MeshRefPointToFacets& vertexFace,
+                   unsigned long first, unsigned long last);
+
 protected:
     const MeshKernel  &_rclMesh; /**< The mesh kernel. */
-    std::vector<std::set<unsigned long> > _map;
+    MeshAdjacency _map;
 };
 
 /**
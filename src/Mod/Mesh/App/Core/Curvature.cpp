@@ -25,10 +25,6 @@
 # include <algorithm>
 #endif
 
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QtConcurrentMap>
-#include <boost/bind.hpp>
 
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4MeshCurvature.h>
@@ -40,10 +36,34 @@
 #include "Iterator.h"
 #include "Tools.h"
 #include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
 #include <Base/Tools.h>
 
 using namespace MeshCore;
 
+namespace {
+// Computes the curvature of a range of facets of the segment
+class CurvatureRange
+{
+public:
+    CurvatureRange(const FacetCurvature& f, const std::vector<unsigned long>& s,
+                   std::vector<CurvatureInfo>& r)
+      : face(f), segment(s), result(r)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++)
+            result[i] = face.Compute(segment[i]);
+    }
+
+private:
+    const FacetCurvature& face;
+    const std::vector<unsigned long>& segment;
+    std::vector<CurvatureInfo>& result;
+};
+}
+
 MeshCurvature::MeshCurvature(const MeshKernel& kernel)
   : myKernel(kernel), myMinPoints(20), myRadius(0.5f)
 {
@@ -73,14 +93,10 @@ void MeshCurvature::ComputePerFace(bool parallel)
         }
     }
     else {
-        QFuture<CurvatureInfo> future = QtConcurrent::mapped
-            (mySegment, boost::bind(&FacetCurvature::Compute, &face, _1));
-        QFutureWatcher<CurvatureInfo> watcher;
-        watcher.setFuture(future);
-        watcher.waitForFinished();
-        for (QFuture<CurvatureInfo>::const_iterator it = future.begin(); it != future.end(); ++it) {
-            myCurvature.push_back(*it);
-        }
+        Base::SequencerLauncher seq("Curvature estimation", mySegment.size());
+        Base::CancellationToken token(&seq);
+        myCurvature.resize(mySegment.size());
+        Base::parallel_for(0, mySegment.size(), CurvatureRange(face, mySegment, myCurvature), 100, &token);
     }
 }
 
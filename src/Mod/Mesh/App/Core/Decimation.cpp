@@ -0,0 +1,675 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <algorithm>
+# include <iterator>
+# include <queue>
+#endif
+
+#include <Base/TaskScheduler.h>
+
+#include "Decimation.h"
+#include "Algorithm.h"
+#include "Elements.h"
+#include "MeshKernel.h"
+#include "TopoAlgorithm.h"
+
+#include <Base/Vector3D.h>
+
+using namespace MeshCore;
+
+namespace MeshCore {
+namespace {
+
+/**
+ * Symmetric 4x4 matrix of the quadric error metric. Only the upper triangle
+ * is stored.
+ */
+class Quadric
+{
+public:
+    Quadric()
+    {
+        std::fill(m, m + 10, 0.0);
+    }
+    /// Squared distance to the plane n*x + d = 0 with unit normal \a n scaled by \a w.
+    Quadric(const Base::Vector3d& n, double d, double w)
+    {
+        m[0] = w*n.x*n.x; m[1] = w*n.x*n.y; m[2] = w*n.x*n.z; m[3] = w*n.x*d;
+        m[4] = w*n.y*n.y; m[5] = w*n.y*n.z; m[6] = w*n.y*d;
+        m[7] = w*n.z*n.z; m[8] = w*n.z*d;
+        m[9] = w*d*d;
+    }
+    Quadric& operator += (const Quadric& q)
+    {
+        for (int i=0; i<10; i++)
+            m[i] += q.m[i];
+        return *this;
+    }
+    double Error(const Base::Vector3d& p) const
+    {
+        return m[0]*p.x*p.x + 2.0*m[1]*p.x*p.y + 2.0*m[2]*p.x*p.z + 2.0*m[3]*p.x
+             + m[4]*p.y*p.y + 2.0*m[5]*p.y*p.z + 2.0*m[6]*p.y
+             + m[7]*p.z*p.z + 2.0*m[8]*p.z
+             + m[9];
+    }
+    /// Computes the point of minimal error. Returns false if the system is (nearly) singular.
+    bool Minimum(Base::Vector3d& p) const
+    {
+        double c00 = m[4]*m[7] - m[5]*m[5];
+        double c01 = m[2]*m[5] - m[1]*m[7];
+        double c02 = m[1]*m[5] - m[2]*m[4];
+        double c11 = m[0]*m[7] - m[2]*m[2];
+        double c12 = m[1]*m[2] - m[0]*m[5];
+        double c22 = m[0]*m[4] - m[1]*m[1];
+        double det = m[0]*c00 + m[1]*c01 + m[2]*c02;
+        double tr = m[0] + m[4] + m[7];
+        if (fabs(det) <= 1.0e-9 * tr * tr * tr)
+            return false;
+
+        p.x = -(c00*m[3] + c01*m[6] + c02*m[8]) / det;
+        p.y = -(c01*m[3] + c11*m[6] + c12*m[8]) / det;
+        p.z = -(c02*m[3] + c12*m[6] + c22*m[8]) / det;
+        return true;
+    }
+
+private:
+    double m[10];
+};
+
+struct EdgeCandidate
+{
+    double error;
+    unsigned long from, to;
+    unsigned long stampFrom, stampTo;
+    Base::Vector3d pos;
+
+    // std::priority_queue returns the largest element first
+    bool operator < (const EdgeCandidate& c) const
+    {
+        return error > c.error;
+    }
+};
+
+/**
+ * Decimates a single mesh kernel. Points marked in \a fixed are neither moved nor removed.
+ */
+class QuadricDecimator
+{
+public:
+    QuadricDecimator(MeshKernel& mesh, const std::vector<bool>& fixed,
+                     bool preserveBoundary, float featureAngle)
+      : _mesh(mesh), _topAlg(mesh), _fixed(fixed)
+      , _preserveBoundary(preserveBoundary), _cosFeature(cos(featureAngle))
+      , _numFacets(0)
+    {
+    }
+
+    void Run(unsigned long targetSize, double maxError)
+    {
+        Initialize();
+
+        std::vector<unsigned long> shared;
+        while (_numFacets > targetSize && !_queue.empty()) {
+            EdgeCandidate c = _queue.top();
+            _queue.pop();
+            if (c.error > maxError)
+                break;
+            // one of the points has changed since the candidate was computed
+            if (c.stampFrom != _stamps[c.from] || c.stampTo != _stamps[c.to])
+                continue;
+            if (!IsLegal(c, shared))
+                continue;
+            Collapse(c, shared);
+        }
+
+        std::priority_queue<EdgeCandidate>().swap(_queue);
+        std::vector<std::vector<unsigned long> >().swap(_pointFacets);
+
+        // keep the quadrics of the remaining points in the order of the cleaned up mesh
+        const MeshPointArray& points = _mesh.GetPoints();
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (points[i].IsValid())
+                _quadrics[count++] = _quadrics[i];
+        }
+        _quadrics.resize(count);
+
+        _topAlg.Cleanup();
+        _mesh.RebuildNeighbours();
+        _mesh.RecalcBoundBox();
+    }
+
+    /**
+     * The quadric of each point. If they are set before Run() they are used
+     * instead of the planes of the facets, e.g. to continue a decimation.
+     * After Run() they belong to the points of the decimated mesh.
+     */
+    std::vector<Quadric>& Quadrics()
+    {
+        return _quadrics;
+    }
+
+private:
+    Base::Vector3d Point(unsigned long index) const
+    {
+        const MeshPoint& p = _mesh.GetPoints()[index];
+        return Base::Vector3d(p.x, p.y, p.z);
+    }
+
+    void Initialize()
+    {
+        const MeshFacetArray& facets = _mesh.GetFacets();
+        unsigned long numPoints = _mesh.CountPoints();
+        _numFacets = _mesh.CountFacets();
+        _fixed.resize(numPoints, false);
+        _stamps.resize(numPoints, 0);
+        _pointFacets.resize(numPoints);
+        // the quadrics of a previous decimation already contain the planes of
+        // the original facets, the constraints are added again as edges across
+        // the seams of a partitioned mesh have none
+        bool carried = (_quadrics.size() == numPoints);
+        if (!carried)
+            _quadrics.assign(numPoints, Quadric());
+
+        {
+            MeshRefPointToFacets pf(_mesh);
+            for (unsigned long i = 0; i < numPoints; i++) {
+                MeshIndexSpan span = pf[i];
+                _pointFacets[i].assign(span.begin(), span.end());
+            }
+        }
+
+        // the planes of the adjacent facets
+        std::vector<Base::Vector3d> normals(_numFacets);
+        for (unsigned long i = 0; i < _numFacets; i++) {
+            const MeshFacet& f = facets[i];
+            Base::Vector3d p0 = Point(f._aulPoints[0]);
+            Base::Vector3d n = (Point(f._aulPoints[1]) - p0) % (Point(f._aulPoints[2]) - p0);
+            double len = n.Length();
+            if (len <= 0.0)
+                continue;
+            n = n / len;
+            normals[i] = n;
+            if (carried)
+                continue;
+
+            Quadric q(n, -(n * p0), 1.0);
+            for (int j = 0; j < 3; j++)
+                _quadrics[f._aulPoints[j]] += q;
+        }
+
+        // border and feature edges
+        for (unsigned long i = 0; i < _numFacets; i++) {
+            const MeshFacet& f = facets[i];
+            for (int j = 0; j < 3; j++) {
+                unsigned long p = f._aulPoints[j];
+                unsigned long q = f._aulPoints[(j+1)%3];
+                unsigned long n = f._aulNeighbours[j];
+                if (n == ULONG_MAX) {
+                    if (_preserveBoundary) {
+                        _fixed[p] = true;
+                        _fixed[q] = true;
+                    }
+                    else {
+                        AddConstraint(p, q, normals[i]);
+                    }
+                }
+                else if (n > i && normals[i] * normals[n] < _cosFeature) {
+                    AddConstraint(p, q, normals[i]);
+                    AddConstraint(p, q, normals[n]);
+                }
+            }
+        }
+
+        for (unsigned long i = 0; i < _numFacets; i++) {
+            const MeshFacet& f = facets[i];
+            for (int j = 0; j < 3; j++) {
+                unsigned long n = f._aulNeighbours[j];
+                if (n == ULONG_MAX || n > i)
+                    AddCandidate(f._aulPoints[j], f._aulPoints[(j+1)%3]);
+            }
+        }
+    }
+
+    // Adds the plane through the edge that is perpendicular to the facet with normal
+    // \a normal. This keeps the points of border and feature edges on the edge.
+    void AddConstraint(unsigned long p, unsigned long q, const Base::Vector3d& normal)
+    {
+        static const double weight = 10.0;
+        Base::Vector3d p0 = Point(p);
+        Base::Vector3d n = (Point(q) - p0) % normal;
+        double len = n.Length();
+        if (len <= 0.0)
+            return;
+        n = n / len;
+        Quadric c(n, -(n * p0), weight);
+        _quadrics[p] += c;
+        _quadrics[q] += c;
+    }
+
+    void AddCandidate(unsigned long p, unsigned long q)
+    {
+        if (_fixed[p] && _fixed[q])
+            return;
+
+        Quadric quad = _quadrics[p];
+        quad += _quadrics[q];
+        Base::Vector3d pp = Point(p), pq = Point(q);
+
+        EdgeCandidate c;
+        if (_fixed[p]) {
+            c.from = q; c.to = p; c.pos = pp;
+        }
+        else if (_fixed[q]) {
+            c.from = p; c.to = q; c.pos = pq;
+        }
+        else {
+            c.from = q; c.to = p;
+            Base::Vector3d mid = (pp + pq) * 0.5;
+            // reject solutions of ill-conditioned systems that lie far away from the edge
+            bool ok = quad.Minimum(c.pos) && Base::Distance(c.pos, mid) <= Base::Distance(pp, pq);
+            if (!ok) {
+                c.pos = mid;
+                if (quad.Error(pp) < quad.Error(c.pos))
+                    c.pos = pp;
+                if (quad.Error(pq) < quad.Error(c.pos))
+                    c.pos = pq;
+            }
+        }
+
+        c.error = std::max<double>(quad.Error(c.pos), 0.0);
+        c.stampFrom = _stamps[c.from];
+        c.stampTo = _stamps[c.to];
+        _queue.push(c);
+    }
+
+    void Neighbours(unsigned long p, std::vector<unsigned long>& points) const
+    {
+        const MeshFacetArray& facets = _mesh.GetFacets();
+        const std::vector<unsigned long>& pf = _pointFacets[p];
+        points.clear();
+        for (std::vector<unsigned long>::const_iterator it = pf.begin(); it != pf.end(); ++it) {
+            for (int i = 0; i < 3; i++) {
+                unsigned long q = facets[*it]._aulPoints[i];
+                if (q != p)
+                    points.push_back(q);
+            }
+        }
+        std::sort(points.begin(), points.end());
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+    }
+
+    bool IsLegal(const EdgeCandidate& c, std::vector<unsigned long>& shared) const
+    {
+        const std::vector<unsigned long>& ff = _pointFacets[c.from];
+        const std::vector<unsigned long>& ft = _pointFacets[c.to];
+
+        // the facets that get removed
+        shared.clear();
+        std::set_intersection(ff.begin(), ff.end(), ft.begin(), ft.end(), std::back_inserter(shared));
+        if (shared.empty() || shared.size() > 2)
+            return false;
+
+        // link condition: the only common neighbours of both points are the
+        // opposite points of the removed facets
+        std::vector<unsigned long> nf, nt, common;
+        Neighbours(c.from, nf);
+        Neighbours(c.to, nt);
+        std::set_intersection(nf.begin(), nf.end(), nt.begin(), nt.end(), std::back_inserter(common));
+        if (common.size() != shared.size())
+            return false;
+
+        if (shared.size() == 2) {
+            // an inner edge connecting two border points
+            if (nf.size() != ff.size() && nt.size() != ft.size())
+                return false;
+            // keep at least three facets around the remaining point
+            if (ff.size() + ft.size() < 7)
+                return false;
+        }
+        else if (ff.size() + ft.size() < 3) {
+            // an isolated facet
+            return false;
+        }
+
+        return !Flips(c.from, c.pos, shared) && !Flips(c.to, c.pos, shared);
+    }
+
+    // Checks if moving point \a p to \a pos flips or degenerates one of its facets
+    bool Flips(unsigned long p, const Base::Vector3d& pos, const std::vector<unsigned long>& shared) const
+    {
+        const MeshFacetArray& facets = _mesh.GetFacets();
+        const std::vector<unsigned long>& pf = _pointFacets[p];
+        for (std::vector<unsigned long>::const_iterator it = pf.begin(); it != pf.end(); ++it) {
+            if (std::binary_search(shared.begin(), shared.end(), *it))
+                continue;
+
+            const MeshFacet& f = facets[*it];
+            Base::Vector3d v[3];
+            for (int i = 0; i < 3; i++)
+                v[i] = Point(f._aulPoints[i]);
+            Base::Vector3d n0 = (v[1] - v[0]) % (v[2] - v[0]);
+            for (int i = 0; i < 3; i++) {
+                if (f._aulPoints[i] == p)
+                    v[i] = pos;
+            }
+            Base::Vector3d n1 = (v[1] - v[0]) % (v[2] - v[0]);
+
+            double l0 = n0.Length();
+            double l1 = n1.Length();
+            if (l1 <= 0.0)
+                return true;
+            if (l0 > 0.0 && n0 * n1 < 0.2 * l0 * l1)
+                return true;
+        }
+
+        return false;
+    }
+
+    void Collapse(const EdgeCandidate& c, const std::vector<unsigned long>& shared)
+    {
+        const MeshFacetArray& facets = _mesh.GetFacets();
+        std::vector<unsigned long>& ff = _pointFacets[c.from];
+        std::vector<unsigned long>& ft = _pointFacets[c.to];
+
+        EdgeCollapse ec;
+        ec._fromPoint = c.from;
+        ec._toPoint = c.to;
+        ec._removeFacets = shared;
+        std::set_difference(ff.begin(), ff.end(), shared.begin(), shared.end(),
+            std::back_inserter(ec._changeFacets));
+
+        // the opposite points lose the removed facets
+        for (std::vector<unsigned long>::const_iterator it = shared.begin(); it != shared.end(); ++it) {
+            const MeshFacet& f = facets[*it];
+            for (int i = 0; i < 3; i++) {
+                unsigned long p = f._aulPoints[i];
+                if (p != c.from && p != c.to) {
+                    std::vector<unsigned long>& pf = _pointFacets[p];
+                    pf.erase(std::lower_bound(pf.begin(), pf.end(), *it));
+                }
+            }
+        }
+
+        _topAlg.CollapseEdge(ec);
+        _mesh.SetPoint(c.to, static_cast<float>(c.pos.x),
+                             static_cast<float>(c.pos.y),
+                             static_cast<float>(c.pos.z));
+        _quadrics[c.to] += _quadrics[c.from];
+        _numFacets -= shared.size();
+
+        std::vector<unsigned long> rest, merged;
+        std::set_difference(ft.begin(), ft.end(), shared.begin(), shared.end(), std::back_inserter(rest));
+        std::merge(rest.begin(), rest.end(), ec._changeFacets.begin(), ec._changeFacets.end(),
+            std::back_inserter(merged));
+        ft.swap(merged);
+        std::vector<unsigned long>().swap(ff);
+
+        _stamps[c.from]++;
+        _stamps[c.to]++;
+
+        std::vector<unsigned long> points;
+        Neighbours(c.to, points);
+        for (std::vector<unsigned long>::iterator it = points.begin(); it != points.end(); ++it)
+            AddCandidate(c.to, *it);
+    }
+
+private:
+    MeshKernel& _mesh;
+    MeshTopoAlgorithm _topAlg;
+    std::vector<bool> _fixed;
+    bool _preserveBoundary;
+    double _cosFeature;
+    unsigned long _numFacets;
+    std::vector<Quadric> _quadrics;
+    std::vector<std::vector<unsigned long> > _pointFacets;
+    std::vector<unsigned long> _stamps;
+    std::priority_queue<EdgeCandidate> _queue;
+};
+
+// ----------------------------------------------------------------------------
+
+const int SharedPoint = -2;
+
+struct MeshPartition
+{
+    std::vector<unsigned long> facets;
+    unsigned long targetSize;
+    MeshKernel mesh;
+    std::vector<Quadric> quadrics;
+};
+
+/**
+ * Copies the facets of a partition into an own kernel and decimates it.
+ * Points that are shared with other partitions are kept fixed. The index
+ * of each point in the original mesh is kept in its property.
+ */
+class PartitionDecimator
+{
+public:
+    PartitionDecimator(const MeshKernel& mesh, const std::vector<int>& pointPart,
+                       std::vector<MeshPartition>& partitions,
+                       bool preserveBoundary, float featureAngle, double maxError)
+      : _mesh(mesh), _pointPart(pointPart), _partitions(partitions)
+      , _preserveBoundary(preserveBoundary), _featureAngle(featureAngle), _maxError(maxError)
+    {
+    }
+
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++)
+            Decimate(_partitions[i]);
+    }
+
+private:
+    void Decimate(MeshPartition& part) const
+    {
+        const MeshPointArray& points = _mesh.GetPoints();
+        const MeshFacetArray& facets = _mesh.GetFacets();
+
+        std::vector<unsigned long> index;
+        index.reserve(part.facets.size() * 3);
+        std::vector<unsigned long>::const_iterator it;
+        for (it = part.facets.begin(); it != part.facets.end(); ++it) {
+            const MeshFacet& f = facets[*it];
+            index.insert(index.end(), f._aulPoints, f._aulPoints + 3);
+        }
+        std::sort(index.begin(), index.end());
+        index.erase(std::unique(index.begin(), index.end()), index.end());
+
+        MeshPointArray localPoints(index.size());
+        std::vector<bool> fixed(index.size());
+        for (std::size_t i = 0; i < index.size(); i++) {
+            MeshPoint& p = localPoints[i];
+            p.Set(points[index[i]].x, points[index[i]].y, points[index[i]].z);
+            p._ulProp = index[i];
+            fixed[i] = (_pointPart[index[i]] == SharedPoint);
+        }
+
+        MeshFacetArray localFacets(part.facets.size());
+        MeshFacetArray::_TIterator jt = localFacets.begin();
+        for (it = part.facets.begin(); it != part.facets.end(); ++it, ++jt) {
+            const MeshFacet& f = facets[*it];
+            for (int i = 0; i < 3; i++) {
+                jt->_aulPoints[i] = std::lower_bound(index.begin(), index.end(),
+                    f._aulPoints[i]) - index.begin();
+            }
+        }
+        std::vector<unsigned long>().swap(part.facets);
+        std::vector<unsigned long>().swap(index);
+
+        part.mesh.Adopt(localPoints, localFacets, true);
+        QuadricDecimator dec(part.mesh, fixed, _preserveBoundary, _featureAngle);
+        dec.Run(part.targetSize, _maxError);
+        part.quadrics.swap(dec.Quadrics());
+    }
+
+private:
+    const MeshKernel& _mesh;
+    const std::vector<int>& _pointPart;
+    std::vector<MeshPartition>& _partitions;
+    bool _preserveBoundary;
+    float _featureAngle;
+    double _maxError;
+};
+
+}
+}
+
+// ----------------------------------------------------------------------------
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+  : _rclMesh(mesh), _preserveBoundary(true), _featureAngle(F_PI / 3.0f)
+{
+}
+
+MeshSimplify::~MeshSimplify()
+{
+}
+
+void MeshSimplify::Simplify(unsigned long targetSize, float tolerance)
+{
+    if (targetSize >= _rclMesh.CountFacets())
+        return;
+
+    int threads = Base::TaskScheduler::Instance().concurrency();
+    if (_rclMesh.CountFacets() >= 500000 && threads > 1) {
+        SimplifyPartitioned(targetSize, tolerance, threads);
+    }
+    else {
+        std::vector<bool> fixed;
+        QuadricDecimator dec(_rclMesh, fixed, _preserveBoundary, _featureAngle);
+        // the quadric error is a sum of squared distances, see header
+        dec.Run(targetSize, double(tolerance) * double(tolerance));
+    }
+}
+
+void MeshSimplify::SimplifyPartitioned(unsigned long targetSize, float tolerance, int parts)
+{
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    unsigned long numFacets = _rclMesh.CountFacets();
+
+    // split the mesh into slabs along the longest side of the bounding box
+    const Base::BoundBox3f& bbox = _rclMesh.GetBoundBox();
+    int axis = 0;
+    if (bbox.LengthY() > bbox.LengthX() && bbox.LengthY() >= bbox.LengthZ())
+        axis = 1;
+    else if (bbox.LengthZ() > bbox.LengthX() && bbox.LengthZ() > bbox.LengthY())
+        axis = 2;
+
+    std::vector<float> keys(numFacets);
+    for (unsigned long i = 0; i < numFacets; i++) {
+        const MeshFacet& f = facets[i];
+        keys[i] = points[f._aulPoints[0]][axis] +
+                  points[f._aulPoints[1]][axis] +
+                  points[f._aulPoints[2]][axis];
+    }
+
+    // estimate the split values from a sample so that all slabs get a similar number of facets
+    std::vector<float> sample;
+    unsigned long step = std::max<unsigned long>(1, numFacets / 100000);
+    for (unsigned long i = 0; i < numFacets; i += step)
+        sample.push_back(keys[i]);
+    std::sort(sample.begin(), sample.end());
+    std::vector<float> splits;
+    for (int i = 1; i < parts; i++)
+        splits.push_back(sample[i * sample.size() / parts]);
+
+    std::vector<MeshPartition> partitions(parts);
+    std::vector<int> pointPart(points.size(), -1);
+    for (unsigned long i = 0; i < numFacets; i++) {
+        int part = std::upper_bound(splits.begin(), splits.end(), keys[i]) - splits.begin();
+        partitions[part].facets.push_back(i);
+        const MeshFacet& f = facets[i];
+        for (int j = 0; j < 3; j++) {
+            int& pp = pointPart[f._aulPoints[j]];
+            if (pp == -1)
+                pp = part;
+            else if (pp != part)
+                pp = SharedPoint;
+        }
+    }
+    std::vector<float>().swap(keys);
+
+    for (std::vector<MeshPartition>::iterator it = partitions.begin(); it != partitions.end(); ++it) {
+        it->targetSize = static_cast<unsigned long>(static_cast<double>(targetSize) *
+            it->facets.size() / numFacets);
+    }
+
+    PartitionDecimator func(_rclMesh, pointPart, partitions, _preserveBoundary, _featureAngle,
+                            double(tolerance) * double(tolerance));
+    Base::parallel_for(0, partitions.size(), func);
+
+    // merge the partitions, shared points are added only once and get the
+    // sum of the quadrics of the partitions
+    MeshPointArray newPoints;
+    MeshFacetArray newFacets;
+    std::vector<Quadric> newQuadrics;
+    std::vector<unsigned long> sharedIndex(points.size(), ULONG_MAX);
+    for (std::vector<MeshPartition>::iterator it = partitions.begin(); it != partitions.end(); ++it) {
+        const MeshPointArray& localPoints = it->mesh.GetPoints();
+        const MeshFacetArray& localFacets = it->mesh.GetFacets();
+
+        std::vector<unsigned long> index(localPoints.size());
+        for (std::size_t i = 0; i < localPoints.size(); i++) {
+            const MeshPoint& p = localPoints[i];
+            unsigned long& pos = (pointPart[p._ulProp] == SharedPoint) ? sharedIndex[p._ulProp] : index[i];
+            if (pointPart[p._ulProp] != SharedPoint || pos == ULONG_MAX) {
+                pos = newPoints.size();
+                newPoints.push_back(MeshPoint(Base::Vector3f(p.x, p.y, p.z)));
+                newQuadrics.push_back(it->quadrics[i]);
+            }
+            else {
+                newQuadrics[pos] += it->quadrics[i];
+            }
+            index[i] = pos;
+        }
+
+        for (MeshFacetArray::_TConstIterator jt = localFacets.begin(); jt != localFacets.end(); ++jt) {
+            newFacets.push_back(MeshFacet(index[jt->_aulPoints[0]],
+                                          index[jt->_aulPoints[1]],
+                                          index[jt->_aulPoints[2]]));
+        }
+
+        it->mesh.Clear();
+        std::vector<Quadric>().swap(it->quadrics);
+    }
+
+    _rclMesh.Adopt(newPoints, newFacets, true);
+
+    // A serial pass over the whole mesh that handles the seams between the
+    // partitions. It continues with the quadrics of the partitions so that
+    // the tolerance still refers to the planes of the original facets.
+    if (targetSize < _rclMesh.CountFacets()) {
+        std::vector<bool> fixed;
+        QuadricDecimator dec(_rclMesh, fixed, _preserveBoundary, _featureAngle);
+        dec.Quadrics().swap(newQuadrics);
+        dec.Run(targetSize, double(tolerance) * double(tolerance));
+    }
+}
@@ -0,0 +1,96 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef MESH_DECIMATION_H
+#define MESH_DECIMATION_H
+
+#include "Definitions.h"
+
+namespace MeshCore
+{
+class MeshKernel;
+
+/**
+ * The MeshSimplify class reduces the number of facets of a mesh by collapsing
+ * edges in the order of their quadric error (Garland/Heckbert). Each point
+ * accumulates the planes of its adjacent facets and an edge is replaced by the
+ * point that minimizes the squared distance to the planes of both end points.
+ *
+ * An edge is only collapsed if this keeps the mesh manifold and does not flip
+ * any of the adjacent facets. The collapse itself is done with
+ * MeshTopoAlgorithm::CollapseEdge().
+ *
+ * Large meshes are split into spatial partitions that are simplified in
+ * parallel. Points shared by several partitions are kept fixed during that
+ * pass and the remaining seams are handled by a final pass over the whole mesh.
+ * This pass continues with the quadrics of the partitions, so the tolerance
+ * has the same meaning as for smaller meshes.
+ * @author FreeCAD Developers
+ */
+class MeshExport MeshSimplify
+{
+public:
+    MeshSimplify(MeshKernel&);
+    ~MeshSimplify();
+
+    /// Keep the points of open edges unchanged. Default is true.
+    void SetPreserveBoundary(bool on)
+    { _preserveBoundary = on; }
+    bool GetPreserveBoundary() const
+    { return _preserveBoundary; }
+    /**
+     * Edges whose adjacent facets enclose a larger angle than \a angle (in radian)
+     * are treated as sharp features. Points on such edges can only be moved along
+     * the feature. Default is 60 degree.
+     */
+    void SetFeatureAngle(float angle)
+    { _featureAngle = angle; }
+    float GetFeatureAngle() const
+    { return _featureAngle; }
+    /**
+     * Collapses edges until the mesh has at most \a targetSize facets or the
+     * next collapse exceeds \a tolerance.
+     *
+     * The tolerance bounds the quadric error of the new point: the square root
+     * of the sum of its squared distances to the planes of all original facets
+     * that have been merged into it. So the point never lies farther than
+     * \a tolerance from any of these planes. As the distances add up this is
+     * stricter than a bound of the largest distance, in curved regions the
+     * decimation may stop earlier than a Hausdorff distance of \a tolerance
+     * would require.
+     */
+    void Simplify(unsigned long targetSize, float tolerance = FLOAT_MAX);
+
+private:
+    void SimplifyPartitioned(unsigned long targetSize, float tolerance, int parts);
+
+private:
+    MeshKernel& _rclMesh;
+    bool _preserveBoundary;
+    float _featureAngle;
+};
+
+} // namespace MeshCore
+
+#endif // MESH_DECIMATION_H
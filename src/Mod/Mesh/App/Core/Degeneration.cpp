@@ -578,8 +578,8 @@ unsigned long MeshFixDegeneratedFacets::RemoveEdgeTooSmall (float fMinEdgeLength
 
             // Redirect all point-indices to the new neighbour point of all facets referencing the
             // deleted point
-            const std::set<unsigned long>& faces = clPt2Facets[pI->second];
-            for (std::set<unsigned long>::const_iterator pF = faces.begin(); pF != faces.end(); ++pF) {
+            MeshIndexSpan faces = clPt2Facets[pI->second];
+            for (MeshIndexSpan::const_iterator pF = faces.begin(); pF != faces.end(); ++pF) {
                 const MeshFacet &rclF = f_beg[*pF];
 
                 for (int i = 0; i < 3; i++) {
@@ -721,11 +721,11 @@ bool MeshEvalDentsOnSurface::Evaluate()
 
         // get the local neighbourhood of the point
         std::set<unsigned long> nb = clPt2Facets.NeighbourPoints(point,1);
-        const std::set<unsigned long>& faces = clPt2Facets[index];
+        MeshIndexSpan faces = clPt2Facets[index];
 
         for (std::set<unsigned long>::iterator pt = nb.begin(); pt != nb.end(); ++pt) {
             const MeshPoint& mp = rPntAry[*pt];
-            for (std::set<unsigned long>::const_iterator
+            for (MeshIndexSpan::const_iterator
                 ft = faces.begin(); ft != faces.end(); ++ft) {
                     // the point must not be part of the facet we test
                     if (f_beg[*ft]._aulPoints[0] == *pt)
@@ -737,7 +737,7 @@ bool MeshEvalDentsOnSurface::Evaluate()
                     // is the point projectable onto the facet?
                     rTriangle = _rclMesh.GetFacet(f_beg[*ft]);
                     if (rTriangle.IntersectWithLine(mp,rTriangle.GetNormal(),tmp)) {
-                        const std::set<unsigned long>& f = clPt2Facets[*pt];
+                        MeshIndexSpan f = clPt2Facets[*pt];
                         this->indices.insert(this->indices.end(), f.begin(), f.end());
                         break;
                     }
@@ -28,6 +28,10 @@
 # include <vector>
 #endif
 
+#include <QAtomicInt>
+#include <boost/bind.hpp>
+#include <Base/TaskScheduler.h>
+
 #include <Mod/Mesh/App/WildMagic4/Wm4Matrix3.h>
 #include <Mod/Mesh/App/WildMagic4/Wm4Vector3.h>
 
@@ -42,6 +46,7 @@
 #include <Base/Matrix.h>
 
 #include <Base/Sequencer.h>
+#include <Base/Tools.h>
 
 using namespace MeshCore;
 
@@ -469,10 +474,10 @@ bool MeshEvalPointManifolds::Evaluate ()
     unsigned long ctPoints = _rclMesh.CountPoints();
     for (unsigned long index=0; index < ctPoints; index++) {
         // get the local neighbourhood of the point
-        const std::set<unsigned long>& nf = vf_it[index];
-        const std::set<unsigned long>& np = vv_it[index];
+        MeshCore::MeshIndexSpan nf = vf_it[index];
+        MeshCore::MeshIndexSpan np = vv_it[index];
 
-        std::set<unsigned long>::size_type sp, sf;
+        MeshCore::MeshIndexSpan::size_type sp, sf;
         sp = np.size();
         sf = nf.size();
         // for an inner point the number of adjacent points is equal to the number of shared faces
@@ -586,76 +591,150 @@ bool MeshFixSingleFacet::Fixup ()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate ()
+namespace MeshCore {
+/**
+ * Broad phase of the self-intersection test. The facets are sorted by the
+ * lower coordinate of their bounding boxes along the longest side of the
+ * mesh and every facet is only tested against the following facets whose
+ * boxes start before its own box ends (sweep and prune). This way each pair of facets with overlapping boxes is
+ * visited exactly once. The sorted range is split into chunks that can be
+ * processed concurrently.
+ */
+class SelfIntersectionSweep
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
+public:
+    typedef std::pair<unsigned long, unsigned long> Pair;
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+    SelfIntersectionSweep(const MeshKernel& rclMesh, bool stop)
+      : kernel(rclMesh), facets(rclMesh.GetFacets()), axis(0), stopAtFirst(stop)
+    {
+        // along the longest side the boxes overlap the least, for a mesh that is
+        // flat in x sweeping along x would compare nearly all pairs
+        const Base::BoundBox3f& bbox = rclMesh.GetBoundBox();
+        if (bbox.LengthY() > bbox.LengthX() && bbox.LengthY() >= bbox.LengthZ())
+            axis = 1;
+        else if (bbox.LengthZ() > bbox.LengthX() && bbox.LengthZ() > bbox.LengthY())
+            axis = 2;
+
+        boxes.reserve(facets.size());
+        for (unsigned long i = 0; i < facets.size(); i++)
+            boxes.push_back(kernel.GetFacet(i).GetBoundBox());
+        order.resize(facets.size());
+        std::generate(order.begin(), order.end(), Base::iotaGen<unsigned long>(0));
+        std::sort(order.begin(), order.end(), LessMin(boxes, axis));
     }
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next();
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
+    std::vector<Pair> test(std::size_t first, std::size_t last) const
+    {
+        std::vector<Pair> pairs;
         Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
+        for (std::size_t pos = first; pos < last; pos++) {
+            if (stopAtFirst && found)
+                break;
+            unsigned long i = order[pos];
+            const Base::BoundBox3f& box1 = boxes[i];
+            const MeshFacet& rface1 = facets[i];
+            MeshGeomFacet facet1 = kernel.GetFacet(i);
+            for (std::size_t next = pos + 1; next < order.size(); next++) {
+                unsigned long j = order[next];
+                const Base::BoundBox3f& box2 = boxes[j];
+                if (Min(box2, axis) > Max(box1, axis))
+                    break; // no further facet can overlap
+                if (!(box1 && box2))
                     continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
+                // If the facets share a common vertex we do not check for self-intersections because they
                 // could but usually do not intersect each other and the algorithm below would detect false-positives,
                 // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
+                const MeshFacet& rface2 = facets[j];
+                if (shareVertex(rface1, rface2))
                     continue; // ignore facets sharing a common vertex
 
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                // test in the order of the facet indices like the grid based search did
+                MeshGeomFacet facet2 = kernel.GetFacet(j);
+                int ret = i < j ? facet1.IntersectWithFacet(facet2, pt1, pt2)
+                                : facet2.IntersectWithFacet(facet1, pt1, pt2);
+                if (ret == 2) {
+                    pairs.push_back(std::make_pair(std::min(i,j), std::max(i,j)));
+                    if (stopAtFirst) {
+                        found.fetchAndStoreRelaxed(1);
+                        return pairs;
                     }
                 }
             }
         }
+        return pairs;
     }
 
-    return true;
+private:
+    static float Min(const Base::BoundBox3f& box, int axis)
+    {
+        return axis == 0 ? box.MinX : (axis == 1 ? box.MinY : box.MinZ);
+    }
+    static float Max(const Base::BoundBox3f& box, int axis)
+    {
+        return axis == 0 ? box.MaxX : (axis == 1 ? box.MaxY : box.MaxZ);
+    }
+    static bool shareVertex(const MeshFacet& f1, const MeshFacet& f2)
+    {
+        for (int i=0; i<3; i++) {
+            if (f1._aulPoints[i] == f2._aulPoints[0] ||
+                f1._aulPoints[i] == f2._aulPoints[1] ||
+                f1._aulPoints[i] == f2._aulPoints[2])
+                return true;
+        }
+        return false;
+    }
+
+public:
+    struct Append {
+        std::vector<Pair> operator()(std::vector<Pair> a, const std::vector<Pair>& b) const {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        }
+    };
+
+private:
+    struct LessMin {
+        LessMin(const std::vector<Base::BoundBox3f>& b, int a) : boxes(b), axis(a) {}
+        bool operator()(unsigned long i, unsigned long j) const {
+            return Min(boxes[i], axis) < Min(boxes[j], axis);
+        }
+        const std::vector<Base::BoundBox3f>& boxes;
+        int axis;
+    };
+
+private:
+    const MeshKernel& kernel;
+    const MeshFacetArray& facets;
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<unsigned long> order;
+    int axis;
+    bool stopAtFirst;
+    mutable QAtomicInt found;
+};
+}
+
+void MeshEvalSelfIntersection::Intersect(bool stopAtFirst, std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
+{
+    SelfIntersectionSweep sweep(_rclMesh, stopAtFirst);
+
+    // chunks of less than 2500 facets are not worth the threading overhead
+    unsigned long count = _rclMesh.CountFacets();
+    Base::SequencerLauncher seq("Checking for self-intersections...", count);
+    Base::CancellationToken token(&seq);
+    intersection = Base::parallel_reduce(0, count, std::vector<SelfIntersectionSweep::Pair>(),
+        boost::bind(&SelfIntersectionSweep::test, &sweep, _1, _2),
+        SelfIntersectionSweep::Append(), 2500, &token);
+
+    // each pair is found once, so sorting gives a result independent of the chunking
+    std::sort(intersection.begin(), intersection.end());
+}
+
+bool MeshEvalSelfIntersection::Evaluate ()
+{
+    std::vector<std::pair<unsigned long, unsigned long> > intersection;
+    Intersect(true, intersection);
+    return intersection.empty();
 }
 
 void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsigned long, unsigned long> >& indices,
@@ -684,72 +763,9 @@ void MeshEvalSelfIntersection::GetIntersections(const std::vector<std::pair<unsi
 
 void MeshEvalSelfIntersection::GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >& intersection) const
 {
-    // Contains bounding boxes for every facet 
-    std::vector<Base::BoundBox3f> boxes;
-    //intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX, ulGridY, ulGridZ;
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for(cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX*ulGridY*ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        //Get the facet indices, belonging to the current grid unit
-        std::vector<unsigned long> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.size()==0)
-            continue;
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (std::vector<unsigned long>::iterator it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (std::vector<unsigned long>::iterator jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) // the identical facet
-                    continue;
-                // If the facets share a common vertex we do not check for self-intersections because they 
-                // could but usually do not intersect each other and the algorithm below would detect false-positives,
-                // otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[0] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[0] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[1] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[1] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[1] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-                if (rface1._aulPoints[2] == rface2._aulPoints[0] || 
-                    rface1._aulPoints[2] == rface2._aulPoints[1] ||
-                    rface1._aulPoints[2] == rface2._aulPoints[2])
-                    continue; // ignore facets sharing a common vertex
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.push_back(std::make_pair (*it,*jt));
-                    }
-                }
-            }
-        }
-    }
+    std::vector<std::pair<unsigned long, unsigned long> > pairs;
+    Intersect(false, pairs);
+    intersection.insert(intersection.end(), pairs.begin(), pairs.end());
 }
 
 std::vector<unsigned long> MeshFixSelfIntersection::GetFacets() const
@@ -297,6 +297,10 @@ public:
         std::vector<std::pair<Base::Vector3f, Base::Vector3f> >&) const;
     /// collect the index of all facets with self intersections
     void GetIntersections(std::vector<std::pair<unsigned long, unsigned long> >&) const;
+
+private:
+    /// collect each pair of intersecting facets once, sorted by their indices
+    void Intersect(bool stopAtFirst, std::vector<std::pair<unsigned long, unsigned long> >&) const;
 };
 
 /**
@@ -23,8 +23,11 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
 #endif
 
+#include <Base/TaskScheduler.h>
+
 #include "Smoothing.h"
 #include "MeshKernel.h"
 #include "Algorithm.h"
@@ -35,53 +38,131 @@
 
 using namespace MeshCore;
 
+namespace MeshCore {
 
-AbstractSmoothing::AbstractSmoothing(MeshKernel& m) : kernel(m)
+/**
+ * Structure-of-arrays copy of the point coordinates. A smoothing step reads
+ * the source arrays and writes the destination arrays, so the result does not
+ * depend on the order in which the points are processed.
+ */
+class SmoothingBuffer
 {
-}
+public:
+    SmoothingBuffer(const MeshPointArray& points)
+    {
+        std::size_t count = points.size();
+        for (int i = 0; i < 3; i++) {
+            src[i].resize(count);
+            dst[i].resize(count);
+        }
+        for (std::size_t j = 0; j < count; j++) {
+            src[0][j] = dst[0][j] = points[j].x;
+            src[1][j] = dst[1][j] = points[j].y;
+            src[2][j] = dst[2][j] = points[j].z;
+        }
+    }
+    /// Makes the result of the last step the source of the next step.
+    void Swap()
+    {
+        for (int i = 0; i < 3; i++)
+            src[i].swap(dst[i]);
+    }
+    void Apply(MeshKernel& kernel) const
+    {
+        std::size_t count = src[0].size();
+        for (std::size_t j = 0; j < count; j++)
+            kernel.SetPoint(j, src[0][j], src[1][j], src[2][j]);
+    }
 
-AbstractSmoothing::~AbstractSmoothing()
-{
-}
+    std::vector<float> src[3];
+    std::vector<float> dst[3];
+};
 
-void AbstractSmoothing::initialize(Component comp, Continuity cont)
-{
-    this->component = comp;
-    this->continuity = cont;
 }
 
-PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
-  : AbstractSmoothing(m)
-{
-}
+namespace {
 
-PlaneFitSmoothing::~PlaneFitSmoothing()
+// One umbrella step for the points in a range. Border points and points with
+// less than three neighbours keep their position.
+class UmbrellaStep
 {
-}
+public:
+    UmbrellaStep(SmoothingBuffer& b, const MeshRefPointToPoints& vv,
+                 const MeshRefPointToFacets& vf, double s,
+                 const std::vector<unsigned long>* ind)
+      : buf(b), vv_it(vv), vf_it(vf), stepsize(s), indices(ind)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        if (first >= last)
+            return;
+
+        const float* sx = &buf.src[0][0];
+        const float* sy = &buf.src[1][0];
+        const float* sz = &buf.src[2][0];
+        float* dx = &buf.dst[0][0];
+        float* dy = &buf.dst[1][0];
+        float* dz = &buf.dst[2][0];
+
+        for (std::size_t i = first; i < last; i++) {
+            unsigned long pos = indices ? (*indices)[i] : i;
+            MeshIndexSpan cv = vv_it[pos];
+            if (cv.size() < 3 || cv.size() != vf_it[pos].size()) {
+                dx[pos] = sx[pos];
+                dy[pos] = sy[pos];
+                dz[pos] = sz[pos];
+                continue;
+            }
 
-void PlaneFitSmoothing::Smooth(unsigned int iterations)
-{
-    MeshCore::MeshPoint center;
-    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+            double x=0.0, y=0.0, z=0.0;
+            for (MeshIndexSpan::const_iterator cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
+                x += sx[*cv_it];
+                y += sy[*cv_it];
+                z += sz[*cv_it];
+            }
 
-    MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
+            double w = 1.0/double(cv.size());
+            dx[pos] = (float)(sx[pos] + stepsize*(w*x - sx[pos]));
+            dy[pos] = (float)(sy[pos] + stepsize*(w*y - sy[pos]));
+            dz[pos] = (float)(sz[pos] + stepsize*(w*z - sz[pos]));
+        }
+    }
 
-    for (unsigned int i=0; i<iterations; i++) {
+private:
+    SmoothingBuffer& buf;
+    const MeshRefPointToPoints& vv_it;
+    const MeshRefPointToFacets& vf_it;
+    double stepsize;
+    const std::vector<unsigned long>* indices;
+};
+
+// Moves each point of a range towards the mean plane of its neighbourhood
+class PlaneFitStep
+{
+public:
+    PlaneFitStep(const MeshPointArray& p, MeshPointArray& r,
+                 const MeshRefPointToPoints& vv, float tol,
+                 const std::vector<unsigned long>* ind)
+      : points(p), result(r), vv_it(vv), tolerance(tol), indices(ind)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
         Base::Vector3f N, L;
-        for (v_it.Begin(); v_it.More(); v_it.Next()) {
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
+        for (std::size_t i = first; i < last; i++) {
+            unsigned long pos = indices ? (*indices)[i] : i;
+            const MeshPoint& p = points[pos];
+            MeshIndexSpan cv = vv_it[pos];
             if (cv.size() < 3)
                 continue;
 
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
+            MeshCore::PlaneFit pf;
+            pf.AddPoint(p);
+            Base::Vector3f center = p;
+            for (MeshIndexSpan::const_iterator cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
+                pf.AddPoint(points[*cv_it]);
+                center += points[*cv_it];
             }
 
             float scale = 1.0f/((float)cv.size()+1.0f);
@@ -93,16 +174,61 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
             N.Normalize();
 
             // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
+            L.Set(p.x - center.x, p.y - center.y, p.z - center.z);
             if (N*L < 0.0)
                 N.Scale(-1.0, -1.0, -1.0);
 
             // maximum value to move is distance to mean plane
-            float d = std::min<float>((float)fabs(this->tolerance),(float)fabs(N*L));
+            float d = std::min<float>((float)fabs(tolerance),(float)fabs(N*L));
             N.Scale(d,d,d);
 
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
+            result[pos].Set(p.x - N.x, p.y - N.y, p.z - N.z);
         }
+    }
+
+private:
+    const MeshPointArray& points;
+    MeshPointArray& result;
+    const MeshRefPointToPoints& vv_it;
+    float tolerance;
+    const std::vector<unsigned long>* indices;
+};
+
+}
+
+
+AbstractSmoothing::AbstractSmoothing(MeshKernel& m) : kernel(m)
+{
+}
+
+AbstractSmoothing::~AbstractSmoothing()
+{
+}
+
+void AbstractSmoothing::initialize(Component comp, Continuity cont)
+{
+    this->component = comp;
+    this->continuity = cont;
+}
+
+PlaneFitSmoothing::PlaneFitSmoothing(MeshKernel& m)
+  : AbstractSmoothing(m)
+{
+}
+
+PlaneFitSmoothing::~PlaneFitSmoothing()
+{
+}
+
+void PlaneFitSmoothing::Smooth(unsigned int iterations)
+{
+    MeshCore::MeshPointArray PointArray = kernel.GetPoints();
+    MeshCore::MeshRefPointToPoints vv_it(kernel);
+
+    // all points are computed from the positions of the previous iteration
+    PlaneFitStep step(kernel.GetPoints(), PointArray, vv_it, this->tolerance, 0);
+    for (unsigned int i=0; i<iterations; i++) {
+        Base::parallel_for(0, kernel.CountPoints(), step, 10000);
 
         // assign values without affecting iterators
         unsigned long count = kernel.CountPoints();
@@ -114,49 +240,12 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
 
 void PlaneFitSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshPoint center;
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
-
-    MeshCore::MeshPointIterator v_it(kernel);
     MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
+    PlaneFitStep step(kernel.GetPoints(), PointArray, vv_it, this->tolerance, &point_indices);
     for (unsigned int i=0; i<iterations; i++) {
-        Base::Vector3f N, L;
-        for (std::vector<unsigned long>::const_iterator it = point_indices.begin(); it != point_indices.end(); ++it) {
-            v_it.Set(*it);
-            MeshCore::PlaneFit pf;
-            pf.AddPoint(*v_it);
-            center = *v_it;
-            const std::set<unsigned long>& cv = vv_it[v_it.Position()];
-            if (cv.size() < 3)
-                continue;
-
-            std::set<unsigned long>::const_iterator cv_it;
-            for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-                pf.AddPoint(v_beg[*cv_it]);
-                center += v_beg[*cv_it];
-            }
-
-            float scale = 1.0f/((float)cv.size()+1.0f);
-            center.Scale(scale,scale,scale);
-
-            // get the mean plane of the current vertex with the surrounding vertices
-            pf.Fit();
-            N = pf.GetNormal();
-            N.Normalize();
-
-            // look in which direction we should move the vertex
-            L.Set(v_it->x - center.x, v_it->y - center.y, v_it->z - center.z);
-            if (N*L < 0.0)
-                N.Scale(-1.0, -1.0, -1.0);
-
-            // maximum value to move is distance to mean plane
-            float d = std::min<float>((float)fabs(this->tolerance),(float)fabs(N*L));
-            N.Scale(d,d,d);
-
-            PointArray[v_it.Position()].Set(v_it->x - N.x, v_it->y - N.y, v_it->z - N.z);
-        }
+        Base::parallel_for(0, point_indices.size(), step, 10000);
 
         // assign values without affecting iterators
         unsigned long count = kernel.CountPoints();
@@ -175,95 +264,46 @@ LaplaceSmoothing::~LaplaceSmoothing()
 {
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
+void LaplaceSmoothing::Umbrella(SmoothingBuffer& buf,
+                                const MeshRefPointToPoints& vv_it,
                                 const MeshRefPointToFacets& vf_it, double stepsize)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it,
-    v_beg = points.begin(), v_end = points.end();
-
-    unsigned long pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it,++pos) {
-        const std::set<unsigned long>& cv = vv_it[pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        unsigned int n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*((v_beg[*cv_it]).x-v_it->x);
-            dely += w*((v_beg[*cv_it]).y-v_it->y);
-            delz += w*((v_beg[*cv_it]).z-v_it->z);
-        }
-
-        float x = (float)(v_it->x+stepsize*delx);
-        float y = (float)(v_it->y+stepsize*dely);
-        float z = (float)(v_it->z+stepsize*delz);
-        kernel.SetPoint(pos,x,y,z);
-    }
+    Base::parallel_for(0, kernel.CountPoints(), UmbrellaStep(buf, vv_it, vf_it, stepsize, 0), 10000);
+    buf.Swap();
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
+void LaplaceSmoothing::Umbrella(SmoothingBuffer& buf,
+                                const MeshRefPointToPoints& vv_it,
                                 const MeshRefPointToFacets& vf_it, double stepsize,
                                 const std::vector<unsigned long>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
-
-    for (std::vector<unsigned long>::const_iterator pos = point_indices.begin(); pos != point_indices.end(); ++pos) {
-        const std::set<unsigned long>& cv = vv_it[*pos];
-        if (cv.size() < 3)
-            continue;
-        if (cv.size() != vf_it[*pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        unsigned int n_count = cv.size();
-        double w;
-        w=1.0/double(n_count);
-
-        double delx=0.0,dely=0.0,delz=0.0;
-        std::set<unsigned long>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it !=cv.end(); ++cv_it) {
-            delx += w*((v_beg[*cv_it]).x-(v_beg[*pos]).x);
-            dely += w*((v_beg[*cv_it]).y-(v_beg[*pos]).y);
-            delz += w*((v_beg[*cv_it]).z-(v_beg[*pos]).z);
-        }
-
-        float x = (float)((v_beg[*pos]).x+stepsize*delx);
-        float y = (float)((v_beg[*pos]).y+stepsize*dely);
-        float z = (float)((v_beg[*pos]).z+stepsize*delz);
-        kernel.SetPoint(*pos,x,y,z);
-    }
+    Base::parallel_for(0, point_indices.size(),
+        UmbrellaStep(buf, vv_it, vf_it, stepsize, &point_indices), 10000);
+    buf.Swap();
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    SmoothingBuffer buf(kernel.GetPoints());
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
+        Umbrella(buf, vv_it, vf_it, lambda);
     }
+    buf.Apply(kernel);
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    SmoothingBuffer buf(kernel.GetPoints());
 
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
+        Umbrella(buf, vv_it, vf_it, lambda, point_indices);
     }
+    buf.Apply(kernel);
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -277,28 +317,30 @@ TaubinSmoothing::~TaubinSmoothing()
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshPointArray::_TConstIterator v_it;
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    SmoothingBuffer buf(kernel.GetPoints());
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-        Umbrella(vv_it, vf_it, -(lambda+micro));
+        Umbrella(buf, vv_it, vf_it, lambda);
+        Umbrella(buf, vv_it, vf_it, -(lambda+micro));
     }
+    buf.Apply(kernel);
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations, const std::vector<unsigned long>& point_indices)
 {
-    MeshCore::MeshPointArray::_TConstIterator v_it;
     MeshCore::MeshRefPointToPoints vv_it(kernel);
     MeshCore::MeshRefPointToFacets vf_it(kernel);
+    SmoothingBuffer buf(kernel.GetPoints());
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations+1)/2; // two steps per iteration
     for (unsigned int i=0; i<iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-        Umbrella(vv_it, vf_it, -(lambda+micro), point_indices);
+        Umbrella(buf, vv_it, vf_it, lambda, point_indices);
+        Umbrella(buf, vv_it, vf_it, -(lambda+micro), point_indices);
     }
+    buf.Apply(kernel);
 }
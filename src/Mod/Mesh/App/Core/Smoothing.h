@@ -31,6 +31,7 @@ namespace MeshCore
 class MeshKernel;
 class MeshRefPointToPoints;
 class MeshRefPointToFacets;
+class SmoothingBuffer;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -83,9 +84,13 @@ public:
     void SetLambda(double l) { lambda = l;}
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&,
+    /** Moves each point by \a stepsize towards the center of its neighbours.
+     * The points are processed in parallel, the new positions are written to
+     * the other half of \a buf.
+     */
+    void Umbrella(SmoothingBuffer& buf, const MeshRefPointToPoints&,
                   const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
+    void Umbrella(SmoothingBuffer& buf, const MeshRefPointToPoints&,
                   const MeshRefPointToFacets&, double,
                   const std::vector<unsigned long>&);
 
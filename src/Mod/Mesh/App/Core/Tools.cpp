@@ -83,9 +83,9 @@ unsigned long MeshSearchNeighbours::NeighboursFromFacet (unsigned long ulFacetId
         std::set<unsigned long> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<unsigned long>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); pI++) {
-            const std::set<unsigned long> &rclISet = _clPt2Fa[*pI]; 
+            MeshIndexSpan rclISet = _clPt2Fa[*pI]; 
             // search all facets hanging on this point
-            for (std::set<unsigned long>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
+            for (MeshIndexSpan::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 if (rclF.IsFlag(MeshFacet::MARKED) == false) {
@@ -176,9 +176,9 @@ unsigned long MeshSearchNeighbours::NeighboursFromSampledFacets (unsigned long u
         std::set<unsigned long> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<unsigned long>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); pI++) {
-            const std::set<unsigned long> &rclISet = _clPt2Fa[*pI]; 
+            MeshIndexSpan rclISet = _clPt2Fa[*pI]; 
             // search all facets hanging on this point
-            for (std::set<unsigned long>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
+            for (MeshIndexSpan::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 if (rclF.IsFlag(MeshFacet::MARKED) == false) {
@@ -288,9 +288,9 @@ unsigned long MeshSearchNeighbours::NeighboursFacetFromFacet (unsigned long ulFa
         std::set<unsigned long> aclTmp;
         aclTmp.swap(_aclOuter);
         for (std::set<unsigned long>::iterator pI = aclTmp.begin(); pI != aclTmp.end(); pI++) {
-            const std::set<unsigned long> &rclISet = _clPt2Fa[*pI]; 
+            MeshIndexSpan rclISet = _clPt2Fa[*pI]; 
             // search all facets hanging on this point
-            for (std::set<unsigned long>::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
+            for (MeshIndexSpan::const_iterator pJ = rclISet.begin(); pJ != rclISet.end(); pJ++) {
                 const MeshFacet &rclF = f_beg[*pJ];
 
                 for (int i = 0; i < 3; i++) {
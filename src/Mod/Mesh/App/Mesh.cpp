@@ -38,6 +38,7 @@
 #include <Base/ViewProj.h>
 
 #include "Core/Builder.h"
+#include "Core/Decimation.h"
 #include "Core/MeshKernel.h"
 #include "Core/Grid.h"
 #include "Core/Iterator.h"
@@ -1073,6 +1074,16 @@ void MeshObject::collapseFacets(const std::vector<unsigned long>& facets)
     deletedFacets(facets);
 }
 
+void MeshObject::decimate(unsigned long targetSize, float tolerance)
+{
+    MeshCore::MeshSimplify simplify(_kernel);
+    simplify.Simplify(targetSize, tolerance);
+
+    // clear the segments because we don't know how the new
+    // topology looks like
+    this->_segments.clear();
+}
+
 void MeshObject::insertVertex(unsigned long facet, const Base::Vector3f& v)
 {
     MeshCore::MeshTopoAlgorithm topalg(_kernel);
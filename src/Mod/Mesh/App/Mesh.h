@@ -248,6 +248,8 @@ public:
     void collapseEdge(unsigned long, unsigned long);
     void collapseFacet(unsigned long);
     void collapseFacets(const std::vector<unsigned long>&);
+    /// Reduces the mesh to at most \a targetSize facets, see MeshCore::MeshSimplify
+    void decimate(unsigned long targetSize, float tolerance);
     void insertVertex(unsigned long, const Base::Vector3f& v);
     void snapVertex(unsigned long, const Base::Vector3f& v);
     //@}
@@ -32,6 +32,8 @@
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/VectorPy.h>
+#include <Base/BufferViewPy.h>
+#include <App/ListSnapshot.h>
 
 #include "Core/MeshKernel.h"
 #include "Core/MeshIO.h"
@@ -156,9 +158,8 @@ void PropertyNormalList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<Base::Vector3f>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->x << it->y << it->z;
-    }
+    if (uCt > 0)
+        str.write(&_lValueList[0].x, 3 * uCt);
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
@@ -167,9 +168,8 @@ void PropertyNormalList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (std::vector<Base::Vector3f>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> it->x >> it->y >> it->z;
-    }
+    if (uCt > 0)
+        str.read(&values[0].x, 3 * uCt);
     setValues(values);
 }
 
@@ -360,11 +360,9 @@ void PropertyCurvatureList::SaveDocFile (Base::Writer &writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (std::vector<CurvatureInfo>::const_iterator it = _lValueList.begin(); it != _lValueList.end(); ++it) {
-        str << it->fMaxCurvature << it->fMinCurvature;
-        str << it->cMaxCurvDir.x << it->cMaxCurvDir.y << it->cMaxCurvDir.z;
-        str << it->cMinCurvDir.x << it->cMinCurvDir.y << it->cMinCurvDir.z;
-    }
+    // the members of CurvatureInfo are eight floats in the order of the file format
+    if (uCt > 0)
+        str.write(&_lValueList[0].fMaxCurvature, 8 * uCt);
 }
 
 void PropertyCurvatureList::RestoreDocFile(Base::Reader &reader)
@@ -373,11 +371,8 @@ void PropertyCurvatureList::RestoreDocFile(Base::Reader &reader)
     uint32_t uCt=0;
     str >> uCt;
     std::vector<CurvatureInfo> values(uCt);
-    for (std::vector<CurvatureInfo>::iterator it = values.begin(); it != values.end(); ++it) {
-        str >> it->fMaxCurvature >> it->fMinCurvature;
-        str >> it->cMaxCurvDir.x >> it->cMaxCurvDir.y >> it->cMaxCurvDir.z;
-        str >> it->cMinCurvDir.x >> it->cMinCurvDir.y >> it->cMinCurvDir.z;
-    }
+    if (uCt > 0)
+        str.read(&values[0].fMaxCurvature, 8 * uCt);
 
     setValues(values);
 }
@@ -458,6 +453,7 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
     aboutToSetValue();
+    detachBuffers();
     *_meshObject = mesh;
     hasSetValue();
 }
@@ -465,6 +461,7 @@ void PropertyMeshKernel::setValue(const MeshObject& mesh)
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    detachBuffers();
     _meshObject->setKernel(mesh);
     hasSetValue();
 }
@@ -472,6 +469,7 @@ void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
     aboutToSetValue();
+    detachBuffers();
     _meshObject->swap(mesh);
     hasSetValue();
 }
@@ -479,6 +477,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
     aboutToSetValue();
+    detachBuffers();
     _meshObject->swap(mesh);
     hasSetValue();
 }
@@ -514,6 +513,8 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 {
     unsigned int size = 0;
     size += _meshObject->getMemSize();
+    if (_snapshot)
+        size += _snapshot->getMemSize();
     
     return size;
 }
@@ -521,6 +522,7 @@ unsigned int PropertyMeshKernel::getMemSize (void) const
 MeshObject* PropertyMeshKernel::startEditing()
 {
     aboutToSetValue();
+    detachBuffers();
     return (MeshObject*)_meshObject;
 }
 
@@ -532,6 +534,7 @@ void PropertyMeshKernel::finishEditing()
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
+    detachBuffers();
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
 }
@@ -539,12 +542,27 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D &rclMat)
 void PropertyMeshKernel::setPointIndices(const std::vector<std::pair<unsigned long, Base::Vector3f> >& inds)
 {
     aboutToSetValue();
+    detachBuffers();
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (std::vector<std::pair<unsigned long, Base::Vector3f> >::const_iterator it = inds.begin(); it != inds.end(); ++it)
         kernel.SetPoint(it->first, it->second);
     hasSetValue();
 }
 
+void PropertyMeshKernel::detachBuffers()
+{
+    // Buffers of the mesh arrays exported to Python must stay valid, so they
+    // get the current arrays and the mesh continues with a copy.
+    const void* key = static_cast<MeshObject*>(_meshObject);
+    if (!Base::BufferViewPy::isExported(key))
+        return;
+    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    boost::shared_ptr<MeshCore::MeshKernel> exported(new MeshCore::MeshKernel());
+    exported->Swap(kernel);
+    kernel = *exported;
+    Base::BufferViewPy::keepAlive(key, exported);
+}
+
 PyObject *PropertyMeshKernel::getPyObject(void)
 {
     if (!meshPyObject) {
@@ -563,6 +581,8 @@ void PropertyMeshKernel::setPyObject(PyObject *value)
         MeshPy* mesh = static_cast<MeshPy*>(value);
         // Do not allow to reassign the same instance
         if (&(*this->_meshObject) != mesh->getMeshObjectPtr()) {
+            // Copying reallocates the arrays of the mesh
+            Base::BufferViewPy::checkExports(&(*this->_meshObject));
             // Note: Copy the content, do NOT reference the same mesh object
             setValue(*(mesh->getMeshObjectPtr()));
         }
@@ -610,6 +630,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader &reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
+        detachBuffers();
         _meshObject->getKernel().Adopt(points, facets);
         hasSetValue();
     } 
@@ -627,6 +648,7 @@ void PropertyMeshKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyMeshKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
+    detachBuffers();
     _meshObject->load(reader);
     hasSetValue();
 }
@@ -639,11 +661,113 @@ App::Property *PropertyMeshKernel::Copy(void) const
     return prop;
 }
 
+namespace Mesh {
+
+// Compare all members but not the padding bytes
+struct MeshPointEqual
+{
+    bool operator()(const MeshCore::MeshPoint& p, const MeshCore::MeshPoint& q) const
+    {
+        return p.x == q.x && p.y == q.y && p.z == q.z &&
+               p._ucFlag == q._ucFlag && p._ulProp == q._ulProp;
+    }
+};
+
+struct MeshFacetEqual
+{
+    bool operator()(const MeshCore::MeshFacet& f, const MeshCore::MeshFacet& g) const
+    {
+        for (int i=0; i<3; i++) {
+            if (f._aulPoints[i] != g._aulPoints[i] || f._aulNeighbours[i] != g._aulNeighbours[i])
+                return false;
+        }
+        return f._ucFlag == g._ucFlag && f._ulProp == g._ulProp;
+    }
+};
+
+/**
+ * The points and facets of a mesh in chunks that are shared with the
+ * previous snapshot of the same property if unchanged.
+ */
+struct MeshSnapshot
+{
+    typedef App::ListSnapshot<MeshCore::MeshPoint, MeshPointEqual> PointSnapshot;
+    typedef App::ListSnapshot<MeshCore::MeshFacet, MeshFacetEqual> FacetSnapshot;
+
+    MeshSnapshot(const MeshObject& mesh, const MeshSnapshot* prev)
+    {
+        const MeshCore::MeshKernel& kernel = mesh.getKernel();
+        PointSnapshot::WeakPointer lastPoints;
+        FacetSnapshot::WeakPointer lastFacets;
+        if (prev) {
+            lastPoints = prev->points;
+            lastFacets = prev->facets;
+        }
+        points = PointSnapshot::create(kernel.GetPoints(), lastPoints);
+        facets = FacetSnapshot::create(kernel.GetFacets(), lastFacets);
+        transform = mesh.getTransform();
+        unsigned long count = mesh.countSegments();
+        segments.resize(count);
+        for (unsigned long i=0; i<count; i++)
+            segments[i] = mesh.getSegment(i).getIndices();
+    }
+
+    void restore(MeshObject& mesh) const
+    {
+        MeshCore::MeshPointArray rPoints;
+        MeshCore::MeshFacetArray rFacets;
+        points->restore(rPoints);
+        facets->restore(rFacets);
+        MeshCore::MeshKernel kernel;
+        kernel.Adopt(rPoints, rFacets);
+        // this also clears the segments
+        mesh.swap(kernel);
+        mesh.setTransform(transform);
+        for (std::vector<std::vector<unsigned long> >::const_iterator it = segments.begin(); it != segments.end(); ++it)
+            mesh.addSegment(*it);
+    }
+
+    unsigned int getMemSize() const
+    {
+        unsigned int size = points->getMemSize() + facets->getMemSize();
+        for (std::vector<std::vector<unsigned long> >::const_iterator it = segments.begin(); it != segments.end(); ++it)
+            size += it->size() * sizeof(unsigned long);
+        return size;
+    }
+
+    PointSnapshot::Pointer points;
+    FacetSnapshot::Pointer facets;
+    Base::Matrix4D transform;
+    std::vector<std::vector<unsigned long> > segments;
+};
+
+}
+
+App::Property *PropertyMeshKernel::Snapshot(void) const
+{
+    if (!MeshSnapshot::FacetSnapshot::isBig(_meshObject->countFacets()))
+        return Copy();
+
+    boost::shared_ptr<const MeshSnapshot> prev = _lastSnapshot.lock();
+    PropertyMeshKernel *prop = new PropertyMeshKernel();
+    prop->_snapshot.reset(new MeshSnapshot(*_meshObject, prev.get()));
+    _lastSnapshot = prop->_snapshot;
+    return prop;
+}
+
 void PropertyMeshKernel::Paste(const App::Property &from)
 {
     // Note: Copy the content, do NOT reference the same mesh object
     aboutToSetValue();
+    detachBuffers();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    if (prop._snapshot) {
+        prop._snapshot->restore(*this->_meshObject);
+        // the mesh is equal to the snapshot again
+        _lastSnapshot = prop._snapshot;
+    }
+    else {
+        *(this->_meshObject) = *(prop._meshObject);
+    }
     hasSetValue();
 }
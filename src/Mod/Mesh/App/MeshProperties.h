@@ -29,6 +29,8 @@
 #include <set>
 #include <string>
 #include <map>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include <Base/Handle.h>
 #include <Base/Matrix.h>
@@ -45,6 +47,7 @@ namespace Mesh
 {
 
 class MeshPy;
+struct MeshSnapshot;
 
 /** The normals property class.
  * Note: We need an own class for that to distinguish from the base vector list.
@@ -242,12 +245,20 @@ public:
     void RestoreDocFile(Base::Reader &reader);
 
     App::Property *Copy(void) const;
+    /// Shares the unchanged parts of big meshes with the previous snapshot
+    App::Property *Snapshot(void) const;
     void Paste(const App::Property &from);
     //@}
 
+private:
+    void detachBuffers();
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject;
+    /// the mesh of a property created by Snapshot()
+    boost::shared_ptr<const MeshSnapshot> _snapshot;
+    mutable boost::weak_ptr<const MeshSnapshot> _lastSnapshot;
 };
 
 } // namespace Mesh
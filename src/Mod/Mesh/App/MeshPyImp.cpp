@@ -28,6 +28,7 @@
 #include <Base/Builder3D.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/MatrixPy.h>
+#include <Base/BufferViewPy.h>
 
 #include "Mesh.h"
 #include "MeshPy.h"
@@ -43,6 +44,7 @@
 #include "Core/Grid.h"
 #include "Core/MeshKernel.h"
 #include "Core/Segmentation.h"
+#include "Core/Smoothing.h"
 #include "Core/Curvature.h"
 
 using namespace Mesh;
@@ -57,6 +59,56 @@ private:
     PropertyMeshKernel* prop;
 };
 
+namespace {
+
+// The buffer views fetch the mesh each time they are requested because the
+// kernel arrays may have been reallocated in the meantime.
+class MeshPointProvider : public Base::BufferProvider
+{
+public:
+    MeshPointProvider(MeshPy* m) : mesh(m)
+    {
+    }
+    bool getLayout(Base::BufferLayout& layout) const
+    {
+        const MeshCore::MeshPointArray& points = mesh->getMeshObjectPtr()->getKernel().GetPoints();
+        layout.data = points.empty() ? 0 : &points[0].x;
+        layout.rows = points.size();
+        layout.columns = 3;
+        layout.stride = sizeof(MeshCore::MeshPoint);
+        layout.itemsize = sizeof(float);
+        layout.format = "f";
+        return true;
+    }
+
+private:
+    MeshPy* mesh;
+};
+
+class MeshFacetProvider : public Base::BufferProvider
+{
+public:
+    MeshFacetProvider(MeshPy* m) : mesh(m)
+    {
+    }
+    bool getLayout(Base::BufferLayout& layout) const
+    {
+        const MeshCore::MeshFacetArray& facets = mesh->getMeshObjectPtr()->getKernel().GetFacets();
+        layout.data = facets.empty() ? 0 : &facets[0]._aulPoints[0];
+        layout.rows = facets.size();
+        layout.columns = 3;
+        layout.stride = sizeof(MeshCore::MeshFacet);
+        layout.itemsize = sizeof(unsigned long);
+        layout.format = "L";
+        return true;
+    }
+
+private:
+    MeshPy* mesh;
+};
+
+}
+
 int MeshPy::PyInit(PyObject* args, PyObject*)
 {
     PyObject *pcObj=0;
@@ -409,8 +461,23 @@ PyObject*  MeshPy::outer(PyObject *args)
 
 PyObject*  MeshPy::coarsen(PyObject *args)
 {
-    PyErr_SetString(PyExc_NotImplementedError, "Not yet implemented");
-    return 0;
+    float reduction=0.5f;
+    float tolerance=FLOAT_MAX;
+    if (!PyArg_ParseTuple(args, "|ff", &reduction, &tolerance))
+        return NULL;
+    if (reduction < 0.0f || reduction > 1.0f) {
+        PyErr_SetString(PyExc_ValueError, "Reduction must be in the range [0,1]");
+        return NULL;
+    }
+
+    PY_TRY {
+        MeshPropertyLock lock(this->parentProperty);
+        unsigned long count = getMeshObjectPtr()->countFacets();
+        unsigned long target = static_cast<unsigned long>(count * (1.0f - reduction));
+        getMeshObjectPtr()->decimate(target, tolerance);
+    } PY_CATCH;
+
+    Py_Return;
 }
 
 PyObject*  MeshPy::translate(PyObject *args)
@@ -685,6 +752,51 @@ PyObject*  MeshPy::setPoint(PyObject *args)
     Py_Return;
 }
 
+PyObject*  MeshPy::getPointBuffer(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    return new Base::BufferViewPy(this, new MeshPointProvider(this));
+}
+
+PyObject*  MeshPy::getFacetBuffer(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return NULL;
+    return new Base::BufferViewPy(this, new MeshFacetProvider(this));
+}
+
+PyObject*  MeshPy::setPointBuffer(PyObject *args)
+{
+    PyObject* obj;
+    if (!PyArg_ParseTuple(args, "O", &obj))
+        return NULL;
+    if (!Base::BufferReader::check(obj)) {
+        PyErr_SetString(PyExc_TypeError, "object does not support the buffer protocol");
+        return NULL;
+    }
+
+    PY_TRY {
+        Base::BufferReader buffer(obj, 3);
+        MeshCore::MeshKernel& kernel = getMeshObjectPtr()->getKernel();
+        if (static_cast<unsigned long>(buffer.rows()) != kernel.CountPoints()) {
+            PyErr_Format(PyExc_ValueError, "buffer has %ld points but the mesh has %lu",
+                static_cast<long>(buffer.rows()), kernel.CountPoints());
+            return NULL;
+        }
+
+        // same frame as getPointBuffer(), i.e. without the placement
+        MeshPropertyLock lock(this->parentProperty);
+        for (Py_ssize_t i = 0; i < buffer.rows(); i++) {
+            kernel.SetPoint(i, (float)buffer.getFloat(i, 0), (float)buffer.getFloat(i, 1),
+                               (float)buffer.getFloat(i, 2));
+        }
+        kernel.RecalcBoundBox();
+    } PY_CATCH;
+
+    Py_Return;
+}
+
 PyObject* MeshPy::countSegments(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -941,6 +1053,11 @@ PyObject*  MeshPy::fillupHoles(PyObject *args)
     float max_area = 0.0f;
     if (!PyArg_ParseTuple(args, "k|if", &len,&level,&max_area))
         return NULL;
+    // const to work on the mesh of a feature but adds facets
+    if (isExported()) {
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        return NULL;
+    }
     try {
         std::auto_ptr<MeshCore::AbstractPolygonTriangulator> tria;
         if (max_area > 0.0f) {
@@ -1041,6 +1158,11 @@ PyObject*  MeshPy::optimizeTopology(PyObject *args)
     float fMaxAngle=-1.0f;
     if (!PyArg_ParseTuple(args, "|f; specify the maximum allowed angle between the normals of two adjacent facets", &fMaxAngle))
         return NULL;
+    // const to work on the mesh of a feature but changes the facets
+    if (isExported()) {
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        return NULL;
+    }
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
@@ -1054,6 +1176,11 @@ PyObject*  MeshPy::optimizeEdges(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
         return NULL;
+    // const to work on the mesh of a feature but changes the facets
+    if (isExported()) {
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        return NULL;
+    }
 
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
@@ -1407,16 +1534,43 @@ PyObject*  MeshPy::trim(PyObject *args)
     Py_Return; 
 }
 
-PyObject*  MeshPy::smooth(PyObject *args)
+PyObject*  MeshPy::smooth(PyObject *args, PyObject *kwds)
 {
     int iter=1;
     float d_max=FLOAT_MAX;
-    if (!PyArg_ParseTuple(args, "|if", &iter,&d_max))
+    char* method=0;
+    double lambda=0.6307;
+    double micro=0.0424;
+    static char* keywords_smooth[] = {"Iteration","MaxDistance","Method","Lambda","Micro",NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ifsdd", keywords_smooth,
+                                     &iter,&d_max,&method,&lambda,&micro))
         return NULL;
 
+    if (method && d_max != FLOAT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "MaxDistance is not supported by the Laplace and Taubin methods");
+        return 0;
+    }
+
     PY_TRY {
         MeshPropertyLock lock(this->parentProperty);
-        getMeshObjectPtr()->smooth(iter, d_max);
+        if (!method) {
+            getMeshObjectPtr()->smooth(iter, d_max);
+        }
+        else if (strcmp(method, "Laplace") == 0) {
+            MeshCore::LaplaceSmoothing s(getMeshObjectPtr()->getKernel());
+            s.SetLambda(lambda);
+            s.Smooth(iter);
+        }
+        else if (strcmp(method, "Taubin") == 0) {
+            MeshCore::TaubinSmoothing s(getMeshObjectPtr()->getKernel());
+            s.SetLambda(lambda);
+            s.SetMicro(micro);
+            s.Smooth(iter);
+        }
+        else {
+            PyErr_Format(PyExc_ValueError, "Unknown smoothing method '%s'", method);
+            return 0;
+        }
     } PY_CATCH;
 
     Py_Return; 
@@ -71,6 +71,221 @@ class MeshGeoTestCases(unittest.TestCase):
 		res=f1.intersect(f2)
 		self.failUnless(len(res) == 0)
 
+class MeshSelfIntersectionCases(unittest.TestCase):
+	def testSelfIntersections(self):
+		s1 = Mesh.createSphere(10.0, 50)
+		self.failUnless(not s1.hasSelfIntersections())
+		s2 = Mesh.createSphere(10.0, 50)
+		s2.translate(5.0, 0.0, 0.0)
+		s1.addMesh(s2)
+		self.failUnless(s1.hasSelfIntersections())
+
+	def bruteForceIntersections(self, mesh):
+		# the pairwise test of the former grid based search without any broad phase
+		facets = mesh.Facets
+		for i in range(len(facets)):
+			p1 = set(facets[i].PointIndices)
+			for j in range(i+1, len(facets)):
+				if p1.intersection(facets[j].PointIndices):
+					continue
+				if len(facets[i].intersect(facets[j])) == 2:
+					return True
+		return False
+
+	def testThinMesh(self):
+		# a mesh that is flat in x, so the sweep must not run along x
+		m = FreeCAD.Matrix()
+		m.scale(0.01, 1.0, 1.0)
+		for offset, result in [(5.0, True), (25.0, False)]:
+			s1 = Mesh.createSphere(10.0, 8)
+			s2 = Mesh.createSphere(10.0, 8)
+			s2.translate(0.0, offset, 1.0)
+			s1.addMesh(s2)
+			s1.transform(m)
+			self.failUnless(s1.BoundBox.XLength < s1.BoundBox.YLength)
+			self.assertEqual(s1.hasSelfIntersections(), result)
+			self.assertEqual(s1.hasSelfIntersections(), self.bruteForceIntersections(s1))
+
+		s1 = Mesh.createSphere(10.0, 200)
+		s2 = Mesh.createSphere(10.0, 200)
+		s2.translate(0.0, 5.0, 0.0)
+		s1.addMesh(s2)
+		s1.transform(m)
+		start = time.time()
+		self.failUnless(s1.hasSelfIntersections())
+		FreeCAD.Console.PrintMessage("Self-intersection check of %d facets flat in x: %.3f s\n" % (s1.CountFacets, time.time() - start))
+
+	def testScaling(self):
+		# not a pass/fail test, prints the run time for growing meshes
+		for sampling in (50, 100, 200, 400):
+			s1 = Mesh.createSphere(10.0, sampling)
+			s2 = Mesh.createSphere(10.0, sampling)
+			s2.translate(5.0, 0.0, 0.0)
+			s1.addMesh(s2)
+			start = time.time()
+			s1.hasSelfIntersections()
+			FreeCAD.Console.PrintMessage("Self-intersection check of %d facets: %.3f s\n" % (s1.CountFacets, time.time() - start))
+
+class MeshDecimationCases(unittest.TestCase):
+	def testCoarsenSphere(self):
+		s = Mesh.createSphere(10.0, 100)
+		count = s.CountFacets
+		s.coarsen(0.9)
+		self.failUnless(s.CountFacets <= count / 10 + 1)
+		self.failUnless(s.isSolid())
+		self.failUnless(not s.hasNonManifolds())
+		self.failUnless(not s.hasSelfIntersections())
+
+	def testCoarsenTolerance(self):
+		s = Mesh.createSphere(10.0, 100)
+		count = s.CountFacets
+		s.coarsen(1.0, 0.01)
+		self.failUnless(s.CountFacets < count)
+		self.failUnless(s.CountFacets > 4)
+		self.failUnless(s.isSolid())
+		# the points stay close to the planes of the original facets
+		for p in s.Points:
+			self.failUnless(abs(p.Vector.Length - 10.0) < 0.05)
+
+	def testCoarsenToleranceLarge(self):
+		# large enough to be decimated in partitions on a multi-core machine
+		s = Mesh.createSphere(10.0, 510)
+		count = s.CountFacets
+		self.failUnless(count >= 500000)
+		s.coarsen(1.0, 0.01)
+		self.failUnless(s.CountFacets < count / 5)
+		self.failUnless(s.isSolid())
+		self.failUnless(not s.hasNonManifolds())
+		# the tolerance also holds at the seams of the partitions, the
+		# allowance covers the sagitta of the original facets
+		for p in s.Points:
+			self.failUnless(abs(p.Vector.Length - 10.0) < 0.011)
+
+class MeshSmoothingCases(unittest.TestCase):
+	def testSmoothing(self):
+		s = Mesh.createSphere(10.0, 100)
+		count = s.CountPoints
+		length = s.BoundBox.XLength
+		s.smooth(3)
+		self.failUnless(s.CountPoints == count)
+		self.failUnless(s.BoundBox.XLength < length)
+		self.failUnless(not s.hasNonManifolds())
+
+	def testTaubinSmoothing(self):
+		s1 = Mesh.createSphere(10.0, 200)
+		s2 = s1.copy()
+		length = s1.BoundBox.XLength
+		s1.smooth(Method='Taubin', Iteration=10)
+		s2.smooth(Method='Taubin', Iteration=10)
+		# Taubin smoothing almost keeps the volume
+		self.failUnless(s1.BoundBox.XLength > 0.99 * length)
+		# the result doesn't depend on how the points are distributed over the threads
+		for p1, p2 in zip(s1.Points, s2.Points):
+			self.failUnless(p1.Vector == p2.Vector)
+
+	def testInvalidMethod(self):
+		s = Mesh.createSphere(10.0, 20)
+		self.failUnlessRaises(ValueError, s.smooth, Method='Unknown')
+
+	def testMaxDistanceWithMethod(self):
+		s = Mesh.createSphere(10.0, 20)
+		self.failUnlessRaises(ValueError, s.smooth, Method='Laplace', MaxDistance=0.1)
+		self.failUnlessRaises(ValueError, s.smooth, Method='Taubin', MaxDistance=0.1)
+		s.smooth(MaxDistance=0.1)
+
+	def testLaplaceNeighbours(self):
+		# compare one Laplace step with the point and facet neighbours
+		# collected from the topology, the open border keeps its points
+		s = Mesh.createSphere(10.0, 120)
+		s.removeFacets(range(0, 500))
+		self.failUnless(s.CountPoints > 10000)
+		pts, facets = s.Topology
+		pointToPoints = [set() for p in pts]
+		pointToFacets = [0] * len(pts)
+		for f in facets:
+			for i in range(3):
+				pointToFacets[f[i]] += 1
+				pointToPoints[f[i]].add(f[(i+1)%3])
+				pointToPoints[f[i]].add(f[(i+2)%3])
+		s.smooth(Method='Laplace', Iteration=1, Lambda=0.5)
+		for p, q, nb, nf in zip(pts, s.Points, pointToPoints, pointToFacets):
+			if len(nb) < 3 or len(nb) != nf:
+				self.failUnless(p == q.Vector)
+				continue
+			c = FreeCAD.Vector()
+			for i in nb:
+				c = c + pts[i]
+			c.multiply(1.0 / len(nb))
+			self.failUnless((p + (c - p).multiply(0.5) - q.Vector).Length < 1e-4)
+
+class MeshBufferCases(unittest.TestCase):
+	def testPointBuffer(self):
+		s = Mesh.createSphere(10.0, 20)
+		points = s.getPointBuffer()
+		self.failUnless(points.shape == (s.CountPoints, 3) and points.format == 'f')
+		facets = s.getFacetBuffer()
+		self.failUnless(len(facets) == s.CountFacets)
+		view = memoryview(points)
+		self.failUnless(view.readonly and view.shape == (s.CountPoints, 3))
+
+	def testSetPointBuffer(self):
+		s1 = Mesh.createSphere(10.0, 20)
+		s2 = s1.copy()
+		s1.translate(1.0, 0.0, 0.0)
+		s2.setPointBuffer(s1.getPointBuffer())
+		for p1, p2 in zip(s1.Points, s2.Points):
+			self.failUnless(p1.Vector == p2.Vector)
+		# the number of points must match
+		s3 = Mesh.createSphere(10.0, 10)
+		self.failUnlessRaises(ValueError, s2.setPointBuffer, s3.getPointBuffer())
+
+	def testPointBufferPlacement(self):
+		# the placement only changes the transformation, not the kernel
+		s = Mesh.createSphere(10.0, 20)
+		s.Placement = FreeCAD.Placement(FreeCAD.Vector(5,0,0), FreeCAD.Rotation(FreeCAD.Vector(0,0,1),30))
+		points = [p.Vector for p in s.Points]
+		s.setPointBuffer(s.getPointBuffer())
+		for p1, p2 in zip(points, s.Points):
+			self.failUnless(p1 == p2.Vector)
+
+	def testExportedBuffer(self):
+		s = Mesh.createSphere(10.0, 20)
+		points = s.getPointBuffer()
+		view1 = memoryview(points)
+		view2 = memoryview(s.getFacetBuffer())
+		self.failUnless(view1.shape == (s.CountPoints, 3))
+		# the mesh cannot be changed while its data is in use
+		self.failUnlessRaises(BufferError, s.translate, 1.0, 0.0, 0.0)
+		self.failUnlessRaises(BufferError, s.fillupHoles, 3)
+		del view1
+		self.failUnlessRaises(BufferError, s.addFacet, 0,0,0, 1,0,0, 0,1,0)
+		del view2
+		s.translate(1.0, 0.0, 0.0)
+		s.addFacet(0,0,0, 1,0,0, 0,1,0)
+		self.failUnless(memoryview(points).shape == (s.CountPoints, 3))
+
+	def testExportedBufferUndo(self):
+		# undo and recompute change the mesh from C++ while its data is in use
+		doc = FreeCAD.newDocument("MeshBuffer")
+		doc.UndoMode = 1
+		sphere = doc.addObject("Mesh::Sphere", "Sphere")
+		doc.recompute()
+		doc.openTransaction("Radius")
+		sphere.Radius = 8.0
+		doc.recompute()
+		doc.commitTransaction()
+		points = memoryview(sphere.Mesh.getPointBuffer())
+		facets = memoryview(sphere.Mesh.getFacetBuffer())
+		data = points.tobytes(), facets.tobytes()
+		doc.undo()
+		self.failUnless(sphere.Radius == 5.0)
+		self.failUnless((points.tobytes(), facets.tobytes()) == data)
+		sphere.Sampling = 20
+		doc.recompute()
+		self.failUnless((points.tobytes(), facets.tobytes()) == data)
+		del points, facets
+		FreeCAD.closeDocument(doc.Name)
+
 class PivyTestCases(unittest.TestCase):
 	def setUp(self):
 		# set up a planar face with 2 triangles
@@ -45,6 +45,7 @@
 #include "FeatureCompound.h"
 #include "FeatureExtrusion.h"
 #include "FeatureFillet.h"
+#include "PartFeatureReference.h"
 #include "FeatureMirroring.h"
 #include "FeatureRevolution.h"
 #include "PartFeatures.h"
@@ -223,6 +224,7 @@ void PartExport initPart()
 
     Part::Feature               ::init();
     Part::FeatureExt            ::init();
+    Part::FeatureReference      ::init();
     Part::AttachableObject      ::init();
     Part::BodyBase              ::init();
     Part::FeaturePython         ::init();
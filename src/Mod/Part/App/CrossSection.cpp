@@ -23,16 +23,26 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
+# include <string>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
 # include <BRepAdaptor_Surface.hxx>
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepGProp_Face.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
 # include <Precision.hxx>
+# include <Standard.hxx>
+# include <Standard_Failure.hxx>
 # include <ShapeFix_Wire.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <TopExp.hxx>
@@ -40,14 +50,121 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopoDS.hxx>
+# include <TopoDS_Compound.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
 #endif
 
+#include <Base/TaskScheduler.h>
+#include <Base/Vector3D.h>
+
 #include "CrossSection.h"
+#include "Tools.h"
 
 using namespace Part;
 
+namespace Part {
+
+/// A solid, free shell or free face that is sliced on its own
+struct CrossSection::SliceItem
+{
+    TopoDS_Shape shape;
+    bool solid;
+    /// range of plane distances the shape spans
+    double dmin, dmax;
+    /// the ranges of the faces of a shell
+    std::vector< std::pair<double, double> > faces;
+};
+
+/**
+ * Computes the sections of a range of distances. The geometry of the OCC
+ * kernel caches its last evaluation and therefore is not thread-safe, so each
+ * task works on its own copies of the items it has to slice.
+ */
+class CrossSection::SliceTask
+{
+public:
+    SliceTask(const CrossSection& c, const std::vector<SliceItem>& i,
+              const std::vector< std::vector<std::size_t> >& b,
+              const std::vector<double>& d,
+              std::vector< std::list<TopoDS_Wire> >& w,
+              std::vector<std::string>& e)
+      : cs(c), items(i), bins(b), dist(d), wires(w), errors(e)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        std::vector<TopoDS_Shape> copies(items.size());
+        for (std::size_t i = first; i < last; i++) {
+            try {
+                const std::vector<std::size_t>& bin = bins[i];
+                for (std::vector<std::size_t>::const_iterator it = bin.begin(); it != bin.end(); ++it) {
+                    const SliceItem& item = items[*it];
+                    TopoDS_Shape& copy = copies[*it];
+                    if (copy.IsNull())
+                        copy = BRepBuilderAPI_Copy(item.shape).Shape();
+                    if (item.solid)
+                        cs.sliceSolid(dist[i], copy, wires[i]);
+                    else
+                        cs.sliceNonSolid(dist[i], facesInRange(dist[i], item, copy), wires[i]);
+                }
+            }
+            catch (Standard_Failure& e) {
+                const char* msg = e.GetMessageString();
+                errors[i] = (msg && msg[0] != '\0') ? msg : "Failed to compute cross-section";
+            }
+        }
+    }
+
+private:
+    // Only the faces of a shell that can be hit by the plane are intersected.
+    // The section of the remaining faces is the same as of the whole shell.
+    TopoDS_Shape facesInRange(double d, const SliceItem& item, const TopoDS_Shape& shape) const
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < item.faces.size(); i++) {
+            if (item.faces[i].first <= d && d <= item.faces[i].second)
+                count++;
+        }
+        if (count == item.faces.size())
+            return shape;
+
+        TopoDS_Compound comp;
+        BRep_Builder builder;
+        builder.MakeCompound(comp);
+        std::size_t index = 0;
+        for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next(), index++) {
+            if (item.faces[index].first <= d && d <= item.faces[index].second)
+                builder.Add(comp, xp.Current());
+        }
+        return comp;
+    }
+
+private:
+    const CrossSection& cs;
+    const std::vector<SliceItem>& items;
+    const std::vector< std::vector<std::size_t> >& bins;
+    const std::vector<double>& dist;
+    std::vector< std::list<TopoDS_Wire> >& wires;
+    std::vector<std::string>& errors;
+};
+
+}
+
+namespace {
+
+struct DistanceOrder
+{
+    DistanceOrder(const std::vector<double>& d) : dist(d) {}
+    bool operator()(std::size_t i, std::size_t j) const
+    {
+        return dist[i] < dist[j];
+    }
+    const std::vector<double>& dist;
+};
+
+}
+
 
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
@@ -73,6 +190,103 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return wires;
 }
 
+std::vector< std::list<TopoDS_Wire> > CrossSection::slices(const std::vector<double>& d,
+                                                            Base::CancellationToken* token) const
+{
+    // collect the same sub-shapes as slice() does
+    std::vector<SliceItem> items;
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
+        SliceItem item;
+        item.shape = xp.Current();
+        item.solid = true;
+        distanceRange(item.shape, item.dmin, item.dmax);
+        items.push_back(item);
+    }
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        SliceItem item;
+        item.shape = xp.Current();
+        item.solid = false;
+        item.dmin = DBL_MAX;
+        item.dmax = -DBL_MAX;
+        for (TopExp_Explorer xf(item.shape, TopAbs_FACE); xf.More(); xf.Next()) {
+            double dmin, dmax;
+            distanceRange(xf.Current(), dmin, dmax);
+            item.faces.push_back(std::make_pair(dmin, dmax));
+            item.dmin = std::min<double>(item.dmin, dmin);
+            item.dmax = std::max<double>(item.dmax, dmax);
+        }
+        items.push_back(item);
+    }
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        SliceItem item;
+        item.shape = xp.Current();
+        item.solid = false;
+        distanceRange(item.shape, item.dmin, item.dmax);
+        item.faces.push_back(std::make_pair(item.dmin, item.dmax));
+        items.push_back(item);
+    }
+
+    // put each item into the bins of all distances in its range
+    std::vector<std::size_t> order(d.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), DistanceOrder(d));
+    std::vector<double> sorted(d.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        sorted[i] = d[order[i]];
+
+    std::vector< std::vector<std::size_t> > bins(d.size());
+    for (std::size_t k = 0; k < items.size(); k++) {
+        std::vector<double>::iterator lo = std::lower_bound(sorted.begin(), sorted.end(), items[k].dmin);
+        std::vector<double>::iterator hi = std::upper_bound(sorted.begin(), sorted.end(), items[k].dmax);
+        for (std::vector<double>::iterator it = lo; it < hi; ++it)
+            bins[order[it - sorted.begin()]].push_back(k);
+    }
+
+    std::vector< std::list<TopoDS_Wire> > wires(d.size());
+    std::vector<std::string> errors(d.size());
+    {
+        ReentrantMode reentrant;
+        Base::parallel_for(0, d.size(), SliceTask(*this, items, bins, d, wires, errors), 1, token);
+    }
+
+    for (std::vector<std::string>::iterator it = errors.begin(); it != errors.end(); ++it) {
+        if (!it->empty())
+            Standard_Failure::Raise(it->c_str());
+    }
+
+    return wires;
+}
+
+void CrossSection::distanceRange(const TopoDS_Shape& shape, double& dmin, double& dmax) const
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    if (box.IsVoid()) {
+        dmin = DBL_MAX;
+        dmax = -DBL_MAX;
+        return;
+    }
+
+    // project the corners of the bounding box onto the plane normal
+    Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
+    box.Get(xmin, ymin, zmin, xmax, ymax, zmax);
+    dmin = DBL_MAX;
+    dmax = -DBL_MAX;
+    for (int i = 0; i < 8; i++) {
+        double dist = a * ((i & 1) ? xmax : xmin)
+                    + b * ((i & 2) ? ymax : ymin)
+                    + c * ((i & 4) ? zmax : zmin);
+        dmin = std::min<double>(dmin, dist);
+        dmax = std::max<double>(dmax, dist);
+    }
+
+    double tol = Precision::Confusion() * sqrt(a * a + b * b + c * c);
+    dmin -= tol;
+    dmax += tol;
+}
+
 void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
 {
     BRepAlgoAPI_Section cs(shape, gp_Pln(a,b,c,-d));
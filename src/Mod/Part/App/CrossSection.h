@@ -25,9 +25,14 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 
 class TopoDS_Shape;
 class TopoDS_Wire;
+
+namespace Base {
+class CancellationToken;
+}
 class TopTools_IndexedMapOfShape;
 
 namespace Part {
@@ -37,8 +42,20 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Computes the sections at all distances \a d in parallel. The solids, shells
+     * and faces of the shape are collected once and binned by the range of distances
+     * they span, so a section only intersects the parts its plane can hit.
+     * The i-th list of the result holds the wires of the i-th distance.
+     * If a \a token with a SequencerLauncher is given it reports the progress of
+     * the sections and throws an AbortException if the user cancels.
+     */
+    std::vector< std::list<TopoDS_Wire> > slices(const std::vector<double>& d,
+                                                  Base::CancellationToken* token = 0) const;
 
 private:
+    struct SliceItem;
+    class SliceTask;
+    void distanceRange(const TopoDS_Shape&, double& dmin, double& dmax) const;
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
     void sliceSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
     void connectEdges (const std::list<TopoDS_Edge>& edges, std::list<TopoDS_Wire>& wires) const;
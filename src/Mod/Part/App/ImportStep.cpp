@@ -35,6 +35,12 @@
 # include <TopoDS_Solid.hxx>
 # include <TopoDS_Compound.hxx>
 # include <TopExp_Explorer.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepMesh_IncrementalMesh.hxx>
+# include <Bnd_Box.hxx>
+# include <TopTools_MapOfShape.hxx>
+# include <Standard.hxx>
+# include <Standard_Version.hxx>
 # include <sstream>
 #endif
 
@@ -43,6 +49,7 @@
 #include <XSControl_WorkSession.hxx>
 #include <XSControl_TransferReader.hxx>
 #include <Transfer_TransientProcess.hxx>
+#include <Interface_InterfaceModel.hxx>
 
 #include <STEPConstruct_Styles.hxx>
 #include <TColStd_HSequenceOfTransient.hxx>
@@ -70,12 +77,15 @@
 
 #include <Base/Console.h>
 #include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
+#include <Base/Vector3D.h>
 #include <App/Application.h>
 #include <App/Document.h>
 
 #include "ImportStep.h"
 #include "PartFeature.h"
 #include "ProgressIndicator.h"
+#include "Tools.h"
 #include "encodeFilename.h"
 
 using namespace Part;
@@ -85,6 +95,121 @@ bool ReadColors (const Handle(XSControl_WorkSession) &WS, std::map<int, Quantity
 bool ReadNames (const Handle(XSControl_WorkSession) &WS);
 }
 
+namespace {
+
+// Transfers a range of roots in an own work session that shares the model
+class StepRootTransfer
+{
+public:
+    StepRootTransfer(const Handle(Interface_InterfaceModel)& m, std::vector<TopoDS_Shape>& s)
+      : model(m), shapes(s)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        try {
+            STEPControl_Reader reader(new XSControl_WorkSession, Standard_True);
+            reader.WS()->SetModel(model, Standard_False);
+            reader.WS()->InitTransferReader(4);
+            reader.NbRootsForTransfer();
+            for (std::size_t i = first; i < last; i++) {
+                Standard_Integer count = reader.NbShapes();
+                reader.TransferRoot((Standard_Integer)i + 1);
+                if (reader.NbShapes() > count)
+                    shapes[i] = reader.Shape(reader.NbShapes());
+            }
+        }
+        catch (Standard_Failure) {
+            Handle(Standard_Failure) e = Standard_Failure::Caught();
+            throw Base::Exception(e->GetMessageString());
+        }
+    }
+
+private:
+    Handle(Interface_InterfaceModel) model;
+    std::vector<TopoDS_Shape>& shapes;
+};
+
+// Computes the triangulation the view provider would create for each shape.
+// The triangulation is stored with the shape, hence the view provider
+// finds it afterwards and doesn't need to compute it again.
+class ShapeTessellation
+{
+public:
+    ShapeTessellation(const std::vector<TopoDS_Shape>& s, double dev, double ang)
+      : shapes(s), deviation(dev), angularDeflection(ang)
+    {
+    }
+    void operator()(std::size_t first, std::size_t last) const
+    {
+        for (std::size_t i = first; i < last; i++) {
+            try {
+                const TopoDS_Shape& shape = shapes[i];
+                Bnd_Box bounds;
+                BRepBndLib::Add(shape, bounds);
+                bounds.SetGap(0.0);
+                Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+                bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+                Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 *
+                    deviation;
+#if OCC_VERSION_HEX >= 0x060600
+                BRepMesh_IncrementalMesh(shape, deflection, Standard_False,
+                    angularDeflection / 180.0 * M_PI, Standard_True);
+#else
+                BRepMesh_IncrementalMesh(shape, deflection);
+#endif
+            }
+            catch (Standard_Failure) {
+                // the view provider will report it
+            }
+        }
+    }
+
+private:
+    const std::vector<TopoDS_Shape>& shapes;
+    double deviation;
+    double angularDeflection;
+};
+
+}
+
+void Part::TransferStepRoots(STEPControl_Reader& aReader, std::vector<TopoDS_Shape>& shapes)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part")->GetGroup("STEP");
+
+    Standard_Integer nbr = aReader.NbRootsForTransfer();
+    std::size_t count = static_cast<std::size_t>(nbr);
+    bool parallel = hGrp->GetBool("ParallelTransfer", false) &&
+        Base::TaskScheduler::Instance().chunkSize(count, 1) < count;
+
+    if (!parallel) {
+        //aReader.PrintCheckTransfer (failsonly, IFSelect_ItemsByEntity);
+        for (Standard_Integer n = 1; n<= nbr; n++) {
+            Base::Console().Log("STEP: Transferring Root %d\n",n);
+            aReader.TransferRoot(n);
+        }
+
+        Standard_Integer nbs = aReader.NbShapes();
+        for (Standard_Integer i=1; i<=nbs; i++)
+            shapes.push_back(aReader.Shape(i));
+        return;
+    }
+
+#if OCC_VERSION_HEX < 0x070000
+    // the reference counting of handles is only thread-safe in reentrant mode
+    Part::ReentrantMode reentrant;
+#endif
+
+    Base::Console().Log("STEP: Transferring %d roots in parallel\n",nbr);
+    std::vector<TopoDS_Shape> roots(count);
+    Base::parallel_for(0, count, StepRootTransfer(aReader.WS()->Model(), roots), 1);
+    for (std::vector<TopoDS_Shape>::iterator it = roots.begin(); it != roots.end(); ++it) {
+        if (!it->IsNull())
+            shapes.push_back(*it);
+    }
+}
+
 int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
 {
     STEPControl_Reader aReader;
@@ -110,16 +235,12 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
     pi->Show();
 
     // Root transfers
-    Standard_Integer nbr = aReader.NbRootsForTransfer();
-    //aReader.PrintCheckTransfer (failsonly, IFSelect_ItemsByEntity);
-    for (Standard_Integer n = 1; n<= nbr; n++) {
-        Base::Console().Log("STEP: Transferring Root %d\n",n);
-        aReader.TransferRoot(n);
-    }
+    std::vector<TopoDS_Shape> roots;
+    TransferStepRoots(aReader, roots);
     pi->EndScope();
 
     // Collecting resulting entities
-    Standard_Integer nbs = aReader.NbShapes();
+    Standard_Integer nbs = (Standard_Integer)roots.size();
     if (nbs == 0) {
         throw Base::Exception("No shapes found in file ");
     }
@@ -132,9 +253,12 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
         //ReadColors(aReader.WS(), hash_col);
         //ReadNames(aReader.WS());
 
+        // the shapes that become an own object
+        std::vector<TopoDS_Shape> items;
+
         for (Standard_Integer i=1; i<=nbs; i++) {
             Base::Console().Log("STEP:   Transferring Shape %d\n",i);
-            aShape = aReader.Shape(i);
+            aShape = roots[i-1];
 
             // load each solid as an own object
             TopExp_Explorer ex;
@@ -149,29 +273,7 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
                 //    name += ws->Model()->StringLabel(ent)->ToCString();
                 //}
 
-                Part::Feature *pcFeature;
-                pcFeature = static_cast<Part::Feature*>(pcDoc->addObject("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(aSolid);
-
-                // This is a trick to access the GUI via Python and set the color property
-                // of the associated view provider. If no GUI is up an exception is thrown
-                // and cleared immediately
-                std::map<int, Quantity_Color>::iterator it = hash_col.find(aSolid.HashCode(INT_MAX));
-                if (it != hash_col.end()) {
-                    try {
-                        Py::Object obj(pcFeature->getPyObject(), true);
-                        Py::Object vp(obj.getAttr("ViewObject"));
-                        Py::Tuple col(3);
-                        col.setItem(0, Py::Float(it->second.Red()));
-                        col.setItem(1, Py::Float(it->second.Green()));
-                        col.setItem(2, Py::Float(it->second.Blue()));
-                        vp.setAttr("ShapeColor", col);
-                        //Base::Console().Message("Set color to shape\n");
-                    }
-                    catch (Py::Exception& e) {
-                        e.clear();
-                    }
-                }
+                items.push_back(aSolid);
             }
             // load all non-solids now
             for (ex.Init(aShape, TopAbs_SHELL, TopAbs_SOLID); ex.More(); ex.Next())
@@ -185,8 +287,7 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
                 //    name += ws->Model()->StringLabel(ent)->ToCString();
                 //}
 
-                Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(aShell);
+                items.push_back(aShell);
             }
 
             // put all other free-flying shapes into a single compound
@@ -221,10 +322,64 @@ int Part::ImportStepParts(App::Document *pcDoc, const char* Name)
             }
 
             if (!emptyComp) {
-                std::string name = fi.fileNamePure();
-                Part::Feature *pcFeature = static_cast<Part::Feature*>(pcDoc->addObject
-                    ("Part::Feature", name.c_str()));
-                pcFeature->Shape.setValue(comp);
+                items.push_back(comp);
+            }
+        }
+
+        // If the Part view providers are available the shapes will be displayed
+        // as soon as they are added. Do the expensive tessellation in parallel
+        // before, the view providers then re-use it. Like the parallel
+        // transfer of the roots this is only done on request.
+        Base::Reference<ParameterGrp> hStep = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part/STEP");
+        if (hStep->GetBool("ParallelTransfer", false) &&
+            Base::Type::fromName("PartGui::ViewProviderPartExt") != Base::Type::badType()) {
+            Base::Reference<ParameterGrp> hPart = App::GetApplication().GetParameterGroupByPath
+                ("User parameter:BaseApp/Preferences/Mod/Part");
+            double deviation = hPart->GetFloat("MeshDeviation",0.2);
+            double angularDeflection = hPart->GetFloat("MeshAngularDeflection",28.65);
+
+            // occurrences of the same shape must not be meshed at the same time
+            std::vector<TopoDS_Shape> unique;
+            TopTools_MapOfShape located;
+            for (std::vector<TopoDS_Shape>::iterator jt = items.begin(); jt != items.end(); ++jt) {
+                if (located.Add(jt->Located(TopLoc_Location())))
+                    unique.push_back(*jt);
+            }
+#if OCC_VERSION_HEX < 0x070000
+            // the shapes share locations and sub-shapes whose handles are
+            // only reference counted thread-safe in reentrant mode
+            Part::ReentrantMode reentrant;
+#endif
+            Base::parallel_for(0, unique.size(),
+                ShapeTessellation(unique, deviation, angularDeflection), 1);
+        }
+
+        // the document objects must be created in the main thread
+        std::string name = fi.fileNamePure();
+        for (std::vector<TopoDS_Shape>::iterator jt = items.begin(); jt != items.end(); ++jt) {
+            Part::Feature *pcFeature;
+            pcFeature = static_cast<Part::Feature*>(pcDoc->addObject("Part::Feature", name.c_str()));
+            pcFeature->Shape.setValue(*jt);
+
+            // This is a trick to access the GUI via Python and set the color property
+            // of the associated view provider. If no GUI is up an exception is thrown
+            // and cleared immediately
+            std::map<int, Quantity_Color>::iterator it = hash_col.find(jt->HashCode(INT_MAX));
+            if (it != hash_col.end()) {
+                try {
+                    Py::Object obj(pcFeature->getPyObject(), true);
+                    Py::Object vp(obj.getAttr("ViewObject"));
+                    Py::Tuple col(3);
+                    col.setItem(0, Py::Float(it->second.Red()));
+                    col.setItem(1, Py::Float(it->second.Green()));
+                    col.setItem(2, Py::Float(it->second.Blue()));
+                    vp.setAttr("ShapeColor", col);
+                    //Base::Console().Message("Set color to shape\n");
+                }
+                catch (Py::Exception& e) {
+                    e.clear();
+                }
             }
         }
     }
@@ -28,6 +28,9 @@
 
 #include <TopoDS_Shape.hxx>
 #include <App/ComplexGeoData.h>
+#include <vector>
+
+class STEPControl_Reader;
 
 namespace App {
 class Document;
@@ -41,6 +44,15 @@ namespace Part
  */
 PartExport int ImportStepParts(App::Document *pcDoc, const char* Name);
 
+/** Transfers all roots of the file loaded by \a reader and returns one shape
+ * per root in the order of the roots. If the user parameter
+ * Mod/Part/STEP/ParallelTransfer is set the roots are split into chunks that
+ * are transferred on worker threads, each of them with its own work session.
+ * Entities referenced by roots of different chunks are then transferred more
+ * than once and do not share their geometry.
+ */
+PartExport void TransferStepRoots(STEPControl_Reader& reader, std::vector<TopoDS_Shape>& shapes);
+
 
 
 } //namespace Part
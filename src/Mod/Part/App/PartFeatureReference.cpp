@@ -26,6 +26,7 @@
 #ifndef _PreComp_
 # include <gp_Trsf.hxx>
 # include <gp_Ax1.hxx>
+# include <set>
 #endif
 
 
@@ -40,6 +41,7 @@
 #include <Base/Rotation.h>
 
 #include "PartFeatureReference.h"
+#include "PartFeature.h"
 
 using namespace Part;
 
@@ -79,6 +81,34 @@ TopLoc_Location FeatureReference::getLocation() const
     return TopLoc_Location(trf);
 }
 
+Feature* FeatureReference::getPrototype() const
+{
+    // follow the chain of references down to the feature holding the shape
+    std::set<const App::DocumentObject*> visited;
+    App::DocumentObject* obj = Reference.getValue();
+    while (obj && obj->getTypeId().isDerivedFrom(FeatureReference::getClassTypeId())) {
+        if (!visited.insert(obj).second)
+            return 0; // cyclic reference
+        obj = static_cast<FeatureReference*>(obj)->Reference.getValue();
+    }
+
+    if (obj && obj->getTypeId().isDerivedFrom(Feature::getClassTypeId()))
+        return static_cast<Feature*>(obj);
+    return 0;
+}
+
+TopoShape FeatureReference::getShape() const
+{
+    Feature* proto = getPrototype();
+    if (!proto)
+        return TopoShape();
+    const TopoDS_Shape& shape = proto->Shape.getValue();
+    if (shape.IsNull())
+        return TopoShape();
+    // only the location differs, the geometry is shared with the prototype
+    return TopoShape(shape.Located(getLocation()));
+}
+
 // ---------------------------------------------------------
-
-
+
+
@@ -34,8 +34,10 @@ namespace Part
 {
 
 class PartFeaturePy;
+class Feature;
 
-/** Base class of all shape feature classes in FreeCAD
+/** A lightweight occurrence of another shape feature. It only stores a link
+ * to the prototype and its own placement, the underlying geometry is shared.
  */
 class PartExport FeatureReference : public App::GeoFeature
 {
@@ -55,6 +57,11 @@ public:
     virtual short mustExecute(void) const;
     //@}
 
+    /// returns the feature at the end of the reference chain holding the shape
+    Feature* getPrototype() const;
+    /// returns the shape of the prototype moved to the placement of this object
+    TopoShape getShape() const;
+
     /// returns the type name of the ViewProvider
     virtual const char* getViewProviderName(void) const {
         return "PartGui::ViewProviderPartReference";
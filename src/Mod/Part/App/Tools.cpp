@@ -28,6 +28,7 @@
 # include <GeomAPI_IntSS.hxx>
 # include <Geom_Line.hxx>
 # include <Precision.hxx>
+# include <Standard.hxx>
 #endif
 
 #include <Base/Vector3D.h>
@@ -81,3 +82,16 @@ bool Part::intersect(const gp_Pln& pln1, const gp_Pln& pln2, gp_Lin& lin)
 
     return found;
 }
+
+Part::ReentrantMode::ReentrantMode()
+  : wasReentrant(Standard::IsReentrant() ? true : false)
+{
+    if (!wasReentrant)
+        Standard::SetReentrant(Standard_True);
+}
+
+Part::ReentrantMode::~ReentrantMode()
+{
+    if (!wasReentrant)
+        Standard::SetReentrant(Standard_False);
+}
@@ -93,6 +93,26 @@ bool intersect(const gp_Pln& pln1, const gp_Pln& pln2, gp_Lin& lin);
 PartExport
 bool tangentialArc(const gp_Pnt& p0, const gp_Vec& v0, const gp_Pnt& p1, gp_Pnt& c, gp_Dir& a);
 
+/**
+ * Switches OCC into reentrant mode as long as the object lives, which is
+ * needed while several threads call OCC at the same time. The previous mode
+ * is restored afterwards because the reentrant mode slows down every
+ * following OCC call.
+ */
+class PartExport ReentrantMode
+{
+public:
+    ReentrantMode();
+    ~ReentrantMode();
+
+private:
+    ReentrantMode(const ReentrantMode&);
+    ReentrantMode& operator=(const ReentrantMode&);
+
+private:
+    bool wasReentrant;
+};
+
 } //namespace Part
 
 
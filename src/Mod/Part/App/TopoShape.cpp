@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
 # include <cstdlib>
 # include <sstream>
@@ -160,6 +161,8 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
 
 
 #include "TopoShape.h"
@@ -171,6 +174,7 @@
 #include "modelRefine.h"
 #include "Tools.h"
 #include "encodeFilename.h"
+#include "ImportStep.h"
 
 using namespace Part;
 
@@ -610,9 +614,23 @@ void TopoShape::importStep(const char *FileName)
         pi->Show();
 
         // Root transfers
-        aReader.TransferRoots();
+        std::vector<TopoDS_Shape> roots;
+        TransferStepRoots(aReader, roots);
         // one shape that contains all subshapes
-        this->_Shape = aReader.OneShape();
+        if (roots.size() == 1) {
+            this->_Shape = roots.front();
+        }
+        else if (roots.size() > 1) {
+            BRep_Builder builder;
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            for (std::vector<TopoDS_Shape>::iterator it = roots.begin(); it != roots.end(); ++it)
+                builder.Add(comp, *it);
+            this->_Shape = comp;
+        }
+        else {
+            this->_Shape = TopoDS_Shape();
+        }
         pi->EndScope();
     }
     catch (Standard_Failure) {
@@ -1406,11 +1424,13 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
+    // the wires are added in the order of ascending distance
+    std::vector<double> dist(d);
+    std::sort(dist.begin(), dist.end());
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (std::vector<double>::const_iterator jt = d.begin(); jt != d.end(); ++jt) {
-        wire_list.push_back(cs.slice(*jt));
-    }
+    Base::SequencerLauncher seq("Cross-sections...", dist.size());
+    Base::CancellationToken token(&seq);
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(dist, &token);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
@@ -799,6 +799,11 @@ PyObject*  TopoShapePy::slices(PyObject *args)
         PyErr_SetString(PartExceptionOCCError, e->GetMessageString());
         return NULL;
     }
+    catch (const Base::Exception& e) {
+        // e.g. if the user has canceled
+        PyErr_SetString(PartExceptionOCCError, e.what());
+        return NULL;
+    }
     catch (const std::exception& e) {
         PyErr_SetString(PartExceptionOCCError, e.what());
         return NULL;
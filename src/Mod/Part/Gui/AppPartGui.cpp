@@ -30,6 +30,7 @@
 #include "SoFCShapeObject.h"
 #include "ViewProvider.h"
 #include "ViewProviderExt.h"
+#include "ViewProviderReference.h"
 #include "ViewProviderPython.h"
 #include "ViewProviderBox.h"
 #include "ViewProviderCurveNet.h"
@@ -107,6 +108,7 @@ void PartGuiExport initPartGui()
     PartGui::SoFCControlPoints              ::initClass();
     PartGui::ViewProviderPartExt            ::init();
     PartGui::ViewProviderPart               ::init();
+    PartGui::ViewProviderPartReference      ::init();
     PartGui::ViewProviderEllipsoid          ::init();
     PartGui::ViewProviderPython             ::init();
     PartGui::ViewProviderBox                ::init();
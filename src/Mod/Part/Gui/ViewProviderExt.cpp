@@ -633,11 +633,17 @@ SoDetail* ViewProviderPartExt::getDetail(const char* subelement) const
 }
 
 std::vector<Base::Vector3d> ViewProviderPartExt::getModelPoints(const SoPickedPoint* pp) const
+{
+    return getModelPoints(pp, static_cast<Part::Feature*>(getObject())->Shape.getValue());
+}
+
+std::vector<Base::Vector3d> ViewProviderPartExt::getModelPoints(const SoPickedPoint* pp,
+                                                                const TopoDS_Shape& topo) const
 {
     try {
         std::vector<Base::Vector3d> pts;
         std::string element = this->getElement(pp->getDetail());
-        const Part::TopoShape& shape = static_cast<Part::Feature*>(getObject())->Shape.getShape();
+        Part::TopoShape shape(topo);
 
         TopoDS_Shape subShape = shape.getSubShape(element.c_str());
 
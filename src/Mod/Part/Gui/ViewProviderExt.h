@@ -130,6 +130,7 @@ protected:
     void updateVisual(const TopoDS_Shape &);
     void GetNormals(const TopoDS_Face&  theFace, const Handle(Poly_Triangulation)& aPolyTri,
                     TColgp_Array1OfDir& theNormals);
+    std::vector<Base::Vector3d> getModelPoints(const SoPickedPoint *, const TopoDS_Shape&) const;
 
     // nodes for the data representation
     SoMaterialBinding * pcShapeBind;
@@ -150,6 +151,9 @@ protected:
     bool VisualTouched;
 
 private:
+    // shares the tessellation of the referenced shape
+    friend class ViewProviderPartReference;
+
     // settings stuff
     bool noPerVertexNormals;
     bool qualityNormals;
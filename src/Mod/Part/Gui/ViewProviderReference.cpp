@@ -24,262 +24,161 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
-# include <Poly_Polygon3D.hxx>
-# include <BRepBndLib.hxx>
-# include <BRepMesh_IncrementalMesh.hxx>
-# include <BRep_Tool.hxx>
-# include <BRepTools.hxx>
-# include <BRepAdaptor_Curve.hxx>
-# include <BRepAdaptor_Surface.hxx>
-# include <GeomAbs_CurveType.hxx>
-# include <GeomAbs_SurfaceType.hxx>
-# include <Geom_BezierCurve.hxx>
-# include <Geom_BSplineCurve.hxx>
-# include <Geom_BezierSurface.hxx>
-# include <Geom_BSplineSurface.hxx>
-# include <GeomAPI_ProjectPointOnSurf.hxx>
-# include <GeomLProp_SLProps.hxx>
-# include <gp_Trsf.hxx>
-# include <Poly_Array1OfTriangle.hxx>
-# include <Poly_Triangulation.hxx>
-# include <TColgp_Array1OfPnt.hxx>
-# include <TopoDS.hxx>
-# include <TopoDS_Edge.hxx>
-# include <TopoDS_Wire.hxx>
-# include <TopoDS_Face.hxx>
-# include <TopoDS_Shape.hxx>
-# include <TopoDS_Iterator.hxx>
-# include <TopExp_Explorer.hxx>
-# include <TopExp.hxx>
-# include <TopTools_IndexedMapOfShape.hxx>
-# include <Poly_PolygonOnTriangulation.hxx>
-# include <TColStd_Array1OfInteger.hxx>
-# include <TopTools_ListOfShape.hxx>
-# include <Inventor/SoPickedPoint.h>
-# include <Inventor/events/SoMouseButtonEvent.h>
+# include <Inventor/actions/SoSearchAction.h>
 # include <Inventor/nodes/SoCoordinate3.h>
-# include <Inventor/nodes/SoDrawStyle.h>
-# include <Inventor/nodes/SoIndexedFaceSet.h>
-# include <Inventor/nodes/SoLineSet.h>
-# include <Inventor/nodes/SoLocateHighlight.h>
-# include <Inventor/nodes/SoMaterial.h>
+# include <Inventor/nodes/SoGroup.h>
 # include <Inventor/nodes/SoNormal.h>
 # include <Inventor/nodes/SoNormalBinding.h>
-# include <Inventor/nodes/SoPointSet.h>
-# include <Inventor/nodes/SoShapeHints.h>
-# include <Inventor/nodes/SoSwitch.h>
-# include <Inventor/nodes/SoGroup.h>
-# include <Inventor/nodes/SoSphere.h>
-# include <Inventor/nodes/SoScale.h>
 #endif
+#include <Inventor/SoFullPath.h>
 
 /// Here the FreeCAD includes sorted by Base,App,Gui......
-#include <Base/Console.h>
-#include <Base/Parameter.h>
-#include <Base/Exception.h>
-#include <App/Application.h>
-#include <App/Document.h>
-#include <Gui/Selection.h>
-#include <Gui/View3DInventorViewer.h>
+#include <Gui/Application.h>
 
-
-#include "ViewProvider.h"
 #include "ViewProviderReference.h"
-#include "SoFCShapeObject.h"
+#include "SoBrepFaceSet.h"
+#include "SoBrepEdgeSet.h"
+#include "SoBrepPointSet.h"
 
 #include <Mod/Part/App/PartFeature.h>
-#include <Mod/Part/App/PrimitiveFeature.h>
+#include <Mod/Part/App/PartFeatureReference.h>
 
 
 using namespace PartGui;
 
-PROPERTY_SOURCE(PartGui::ViewProviderPartReference, Gui::ViewProviderGeometryObject)
+PROPERTY_SOURCE(PartGui::ViewProviderPartReference, PartGui::ViewProviderPartExt)
 
 //**************************************************************************
 // Construction/Destruction
 
-ViewProviderPartReference::ViewProviderPartReference() : pcControlPoints(0)
+ViewProviderPartReference::ViewProviderPartReference()
 {
-    App::Material mat;
-    mat.ambientColor.set(0.2f,0.2f,0.2f);
-    mat.diffuseColor.set(0.1f,0.1f,0.1f);
-    mat.specularColor.set(0.0f,0.0f,0.0f);
-    mat.emissiveColor.set(0.0f,0.0f,0.0f);
-    mat.shininess = 0.0f;
-    mat.transparency = 0.0f;
-    //ADD_PROPERTY(LineMaterial,(mat));
-    //ADD_PROPERTY(PointMaterial,(mat));
-    //ADD_PROPERTY(LineColor,(mat.diffuseColor));
-    //ADD_PROPERTY(PointColor,(mat.diffuseColor));
-    //ADD_PROPERTY(LineWidth,(2.0f));
-    //LineWidth.setConstraints(&floatRange);
-    //PointSize.setConstraints(&floatRange);
-    //ADD_PROPERTY(PointSize,(2.0f));
-    //ADD_PROPERTY(ControlPoints,(false));
-    //ADD_PROPERTY(Lighting,(1));
-    //Lighting.setEnums(LightingEnums);
-
-    //EdgeRoot = new SoSeparator();
-    //EdgeRoot->ref();
-    //FaceRoot = new SoSeparator();
-    //FaceRoot->ref();
-    //VertexRoot = new SoSeparator();
-    //VertexRoot->ref();
-    //pcLineMaterial = new SoMaterial;
-    //pcLineMaterial->ref();
-    //LineMaterial.touch();
-
-    //pcPointMaterial = new SoMaterial;
-    //pcPointMaterial->ref();
-    //PointMaterial.touch();
-
-    //pcLineStyle = new SoDrawStyle();
-    //pcLineStyle->ref();
-    //pcLineStyle->style = SoDrawStyle::LINES;
-    //pcLineStyle->lineWidth = LineWidth.getValue();
-
-    //pcPointStyle = new SoDrawStyle();
-    //pcPointStyle->ref();
-    //pcPointStyle->style = SoDrawStyle::POINTS;
-    //pcPointStyle->pointSize = PointSize.getValue();
-
-    //pShapeHints = new SoShapeHints;
-    //pShapeHints->shapeType = SoShapeHints::UNKNOWN_SHAPE_TYPE;
-    //pShapeHints->ref();
-    //Lighting.touch();
-
+    // the tessellation is owned by the view provider of the prototype
+    VisualTouched = false;
     sPixmap = "Tree_Part";
-    //loadParameter();
 }
 
 ViewProviderPartReference::~ViewProviderPartReference()
 {
-    //EdgeRoot->unref();
-    //FaceRoot->unref();
-    //VertexRoot->unref();
-    //pcLineMaterial->unref();
-    //pcPointMaterial->unref();
-    //pcLineStyle->unref();
-    //pcPointStyle->unref();
-    //pShapeHints->unref();
 }
 
-void ViewProviderPartReference::onChanged(const App::Property* prop)
+void ViewProviderPartReference::attach(App::DocumentObject *pcFeat)
 {
-    //if (prop == &LineWidth) {
-    //    pcLineStyle->lineWidth = LineWidth.getValue();
-    //}
-    //else if (prop == &PointSize) {
-    //    pcPointStyle->pointSize = PointSize.getValue();
-    //}
-    //else if (prop == &LineColor) {
-    //    const App::Color& c = LineColor.getValue();
-    //    pcLineMaterial->diffuseColor.setValue(c.r,c.g,c.b);
-    //    if (c != LineMaterial.getValue().diffuseColor)
-    //    LineMaterial.setDiffuseColor(c);
-    //}
-    //else if (prop == &PointColor) {
-    //    const App::Color& c = PointColor.getValue();
-    //    pcPointMaterial->diffuseColor.setValue(c.r,c.g,c.b);
-    //    if (c != PointMaterial.getValue().diffuseColor)
-    //    PointMaterial.setDiffuseColor(c);
-    //}
-    //else if (prop == &LineMaterial) {
-    //    const App::Material& Mat = LineMaterial.getValue();
-    //    if (LineColor.getValue() != Mat.diffuseColor)
-    //    LineColor.setValue(Mat.diffuseColor);
-    //    pcLineMaterial->ambientColor.setValue(Mat.ambientColor.r,Mat.ambientColor.g,Mat.ambientColor.b);
-    //    pcLineMaterial->diffuseColor.setValue(Mat.diffuseColor.r,Mat.diffuseColor.g,Mat.diffuseColor.b);
-    //    pcLineMaterial->specularColor.setValue(Mat.specularColor.r,Mat.specularColor.g,Mat.specularColor.b);
-    //    pcLineMaterial->emissiveColor.setValue(Mat.emissiveColor.r,Mat.emissiveColor.g,Mat.emissiveColor.b);
-    //    pcLineMaterial->shininess.setValue(Mat.shininess);
-    //    pcLineMaterial->transparency.setValue(Mat.transparency);
-    //}
-    //else if (prop == &PointMaterial) {
-    //    const App::Material& Mat = PointMaterial.getValue();
-    //    if (PointColor.getValue() != Mat.diffuseColor)
-    //    PointColor.setValue(Mat.diffuseColor);
-    //    pcPointMaterial->ambientColor.setValue(Mat.ambientColor.r,Mat.ambientColor.g,Mat.ambientColor.b);
-    //    pcPointMaterial->diffuseColor.setValue(Mat.diffuseColor.r,Mat.diffuseColor.g,Mat.diffuseColor.b);
-    //    pcPointMaterial->specularColor.setValue(Mat.specularColor.r,Mat.specularColor.g,Mat.specularColor.b);
-    //    pcPointMaterial->emissiveColor.setValue(Mat.emissiveColor.r,Mat.emissiveColor.g,Mat.emissiveColor.b);
-    //    pcPointMaterial->shininess.setValue(Mat.shininess);
-    //    pcPointMaterial->transparency.setValue(Mat.transparency);
-    //}
-    //else if (prop == &ControlPoints) {
-    //    App::DocumentObject* obj = this->pcObject;
-    //    App::Property* shape = obj->getPropertyByName("Shape");
-    //    showControlPoints(ControlPoints.getValue(), shape);
-    //}
-    //else if (prop == &Lighting) {
-    //    if (Lighting.getValue() == 0)
-    //        pShapeHints->vertexOrdering = SoShapeHints::UNKNOWN_ORDERING;
-    //    else
-    //        pShapeHints->vertexOrdering = SoShapeHints::COUNTERCLOCKWISE;
-    //}
-    //else {
-    //    ViewProviderGeometryObject::onChanged(prop);
-    //}
+    ViewProviderPartExt::attach(pcFeat);
+    shareVisual();
 }
 
-void ViewProviderPartReference::attach(App::DocumentObject *pcFeat)
+void ViewProviderPartReference::onChanged(const App::Property* prop)
 {
-    // call parent attach method
-    ViewProviderGeometryObject::attach(pcFeat);
-
-    SoGroup* pcNormalRoot = new SoGroup();
-    SoGroup* pcFlatRoot = new SoGroup();
-    SoGroup* pcWireframeRoot = new SoGroup();
-    SoGroup* pcPointsRoot = new SoGroup();
-
-    // enable two-side rendering
-    pShapeHints->vertexOrdering = SoShapeHints::COUNTERCLOCKWISE;
-    pShapeHints->shapeType = SoShapeHints::UNKNOWN_SHAPE_TYPE;
-
-    // normal viewing with edges and points
-    pcNormalRoot->addChild(pShapeHints);
-    pcNormalRoot->addChild(FaceRoot);
-    pcNormalRoot->addChild(EdgeRoot);
-    pcNormalRoot->addChild(VertexRoot);
-
-    // just faces with no edges or points
-    pcFlatRoot->addChild(pShapeHints);
-    pcFlatRoot->addChild(FaceRoot);
-
-    // only edges
-    pcWireframeRoot->addChild(EdgeRoot);
-    pcWireframeRoot->addChild(VertexRoot);
-
-    // normal viewing with edges and points
-    pcPointsRoot->addChild(VertexRoot);
-
-    // putting all together with the switch
-    addDisplayMaskMode(pcNormalRoot, "Reference");
+    // Deviation and AngularDeflection apply to the prototype only and
+    // there is no own shape that could be re-tessellated
+    VisualTouched = false;
+    if (prop == &Visibility && Visibility.getValue())
+        shareVisual();
+    ViewProviderPartExt::onChanged(prop);
+    VisualTouched = false;
 }
 
-void ViewProviderPartReference::setDisplayMode(const char* ModeName)
+void ViewProviderPartReference::updateData(const App::Property* prop)
 {
-    if ( strcmp("Reference",ModeName)==0 )
-        setDisplayMaskMode("Reference");
-	
-    ViewProviderGeometryObject::setDisplayMode( ModeName );
+    if (prop->getTypeId() == App::PropertyLink::getClassTypeId())
+        shareVisual();
+    Gui::ViewProviderGeometryObject::updateData(prop);
 }
 
-std::vector<std::string> ViewProviderPartReference::getDisplayModes(void) const
+void ViewProviderPartReference::finishRestoring()
 {
-    // get the modes of the father
-    std::vector<std::string> StrList = ViewProviderGeometryObject::getDisplayModes();
+    // the prototype may have been restored after this object
+    shareVisual();
+    ViewProviderPartExt::finishRestoring();
+}
 
-    // add your own modes
-    StrList.push_back("Flat Lines");
-    StrList.push_back("Shaded");
-    StrList.push_back("Wireframe");
-    StrList.push_back("Points");
+std::vector<Base::Vector3d> ViewProviderPartReference::getModelPoints(const SoPickedPoint* pp) const
+{
+    Part::TopoShape shape = static_cast<Part::FeatureReference*>(getObject())->getShape();
+    return ViewProviderPartExt::getModelPoints(pp, shape.getShape());
+}
 
-    return StrList;
+ViewProviderPartExt* ViewProviderPartReference::getPrototype() const
+{
+    if (!pcObject)
+        return 0;
+    Part::Feature* proto = static_cast<Part::FeatureReference*>(pcObject)->getPrototype();
+    if (!proto)
+        return 0;
+    Gui::ViewProvider* vp = Gui::Application::Instance->getViewProvider(proto);
+    if (vp && vp->getTypeId().isDerivedFrom(ViewProviderPartExt::getClassTypeId()))
+        return static_cast<ViewProviderPartExt*>(vp);
+    return 0;
 }
 
+void ViewProviderPartReference::shareVisual()
+{
+    ViewProviderPartExt* vp = getPrototype();
+    if (!vp) {
+        faceset->coordIndex.disconnect();
+        faceset->partIndex.disconnect();
+        lineset->coordIndex.disconnect();
+        nodeset->startIndex.disconnect();
+        return;
+    }
+
+    // a hidden prototype doesn't tessellate its shape by itself
+    if (vp->VisualTouched) {
+        Part::Feature* proto = static_cast<Part::Feature*>(vp->getObject());
+        vp->updateVisual(proto->Shape.getValue());
+    }
+
+    // Coordinates and normals are used as they are. The index fields are
+    // connected instead because the selection and highlighting state is
+    // kept in the shape nodes and must not show up on all instances.
+    replaceNode(coords, vp->coords);
+    replaceNode(norm, vp->norm);
+    replaceNode(normb, vp->normb);
+    coords = vp->coords;
+    norm = vp->norm;
+    normb = vp->normb;
+
+    faceset->coordIndex.connectFrom(&vp->faceset->coordIndex);
+    faceset->partIndex.connectFrom(&vp->faceset->partIndex);
+    lineset->coordIndex.connectFrom(&vp->lineset->coordIndex);
+    nodeset->startIndex.connectFrom(&vp->nodeset->startIndex);
+
+    // check the material binding against the new number of faces
+    onChanged(&DiffuseColor);
+}
 
-void ViewProviderPartReference::updateData(const App::Property* prop)
+void ViewProviderPartReference::replaceNode(SoNode* node, SoNode* other)
 {
+    if (node == other)
+        return;
+
+    SoSearchAction sa;
+    sa.setNode(node);
+    sa.setInterest(SoSearchAction::ALL);
+    sa.setSearchingAll(TRUE);
+    sa.apply(pcRoot);
+
+    // collect the parents first, changing the graph invalidates the paths
+    std::vector<SoGroup*> parents;
+    const SoPathList& paths = sa.getPaths();
+    for (int i = 0; i < paths.getLength(); i++) {
+        SoFullPath* path = static_cast<SoFullPath*>(paths[i]);
+        if (path->getLength() > 1) {
+            SoGroup* parent = static_cast<SoGroup*>(path->getNodeFromTail(1));
+            parent->ref();
+            parents.push_back(parent);
+        }
+    }
+    sa.reset();
+
+    for (std::vector<SoGroup*>::iterator it = parents.begin(); it != parents.end(); ++it) {
+        int index = (*it)->findChild(node);
+        if (index >= 0)
+            (*it)->replaceChild(index, other);
+        (*it)->unref();
+    }
+
+    other->ref();
+    node->unref();
 }
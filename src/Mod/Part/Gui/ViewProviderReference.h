@@ -24,32 +24,18 @@
 #ifndef PARTGUI_ViewProviderPartReference_H
 #define PARTGUI_ViewProviderPartReference_H
 
-#include <Standard_math.hxx>
-#include <Standard_Boolean.hxx>
-#include <TopoDS_Shape.hxx>
-#include <Gui/ViewProviderGeometryObject.h>
-#include <Gui/ViewProviderBuilder.h>
-#include <map>
+#include "ViewProviderExt.h"
 
-class TopoDS_Shape;
-class TopoDS_Edge;
-class TopoDS_Wire;
-class TopoDS_Face;
-class SoSeparator;
-class SoGroup;
-class SoSwitch;
-class SoVertexShape;
-class SoPickedPoint;
-class SoShapeHints;
-class SoEventCallback;
-class SbVec3f;
-class SoSphere;
-class SoScale;
+class SoNode;
 
 namespace PartGui {
 
-
-class PartGuiExport ViewProviderPartReference : public Gui::ViewProviderGeometryObject
+/**
+ * The view provider for Part::FeatureReference. It doesn't tessellate anything
+ * itself but re-uses the coordinates and normals of the view provider of the
+ * prototype shape, only the transformation and the material are its own.
+ */
+class PartGuiExport ViewProviderPartReference : public ViewProviderPartExt
 {
     PROPERTY_HEADER(PartGui::ViewProviderPartReference);
 
@@ -59,55 +45,22 @@ public:
     /// destructor
     virtual ~ViewProviderPartReference();
 
-    // Display properties
-    //App::PropertyFloatConstraint LineWidth;
-    //App::PropertyFloatConstraint PointSize;
-    //App::PropertyColor LineColor;
-    //App::PropertyColor PointColor;
-    //App::PropertyMaterial LineMaterial;
-    //App::PropertyMaterial PointMaterial;
-    //App::PropertyBool ControlPoints;
-    //App::PropertyEnumeration Lighting;
-
-
     virtual void attach(App::DocumentObject *);
-    virtual void setDisplayMode(const char* ModeName);
-    /// returns a list of all possible modes
-    virtual std::vector<std::string> getDisplayModes(void) const;
-    /// Update the view representation
-    void reload();
-
     virtual void updateData(const App::Property*);
+    virtual void finishRestoring();
+    virtual std::vector<Base::Vector3d> getModelPoints(const SoPickedPoint *) const;
 
 protected:
     /// get called by the container whenever a property has been changed
     virtual void onChanged(const App::Property* prop);
-    //bool loadParameter();
-
-    // nodes for the data representation
-    SoGroup  *EdgeRoot;
-    SoGroup  *FaceRoot;
-    SoGroup  *VertexRoot;
-    SoMaterial   *pcLineMaterial;
-    SoMaterial   *pcPointMaterial;
-    SoDrawStyle  *pcLineStyle;
-    SoDrawStyle  *pcPointStyle;
-    SoSwitch     *pcControlPoints;
-    SoShapeHints *pShapeHints;
 
 private:
-    // settings stuff
-    float meshDeviation;
-    bool noPerVertexNormals;
-    bool qualityNormals;
-    static App::PropertyFloatConstraint::Constraints floatRange;
-    static const char* LightingEnums[];
+    ViewProviderPartExt* getPrototype() const;
+    void shareVisual();
+    void replaceNode(SoNode* node, SoNode* other);
 };
 
-
-
 } // namespace PartGui
 
 
 #endif // PARTGUI_ViewProviderPartReference_H
-
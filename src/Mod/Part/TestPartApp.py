@@ -20,6 +20,7 @@
 #**************************************************************************
 
 import FreeCAD, os, sys, unittest, Part
+import re, tempfile
 App = FreeCAD
 
 #---------------------------------------------------------------------------
@@ -40,3 +41,88 @@ class PartTestCases(unittest.TestCase):
 		#closing doc
 		FreeCAD.closeDocument("PartTest")
 		#print ("omit clos document for debuging")
+
+
+class PartStepCases(unittest.TestCase):
+	def setUp(self):
+		# write a STEP file with one root per box
+		self.TempPath = tempfile.gettempdir()
+		self.FileName = os.path.join(self.TempPath, "PartStepRoots.step")
+		header = None
+		data = []
+		offset = 0
+		for i in range(4):
+			name = os.path.join(self.TempPath, "PartStepRoot%d.step" % i)
+			Part.makeBox(1.0+i, 2.0, 3.0, App.Vector(5.0*i, 0.0, 0.0)).exportStep(name)
+			text = open(name).read()
+			os.remove(name)
+			head, body = text.split("DATA;", 1)
+			body = body.split("ENDSEC;", 1)[0]
+			if header is None:
+				header = head
+			ids = [int(j) for j in re.findall(r"#(\d+)", body)]
+			data.append(re.sub(r"#(\d+)", lambda m: "#%d" % (int(m.group(1)) + offset), body))
+			offset += max(ids)
+		f = open(self.FileName, "w")
+		f.write(header + "DATA;" + "".join(data) + "ENDSEC;\nEND-ISO-10303-21;\n")
+		f.close()
+
+	def readStep(self, parallel):
+		grp = App.ParamGet("User parameter:BaseApp/Preferences/Mod/Part/STEP")
+		old = grp.GetBool("ParallelTransfer", False)
+		grp.SetBool("ParallelTransfer", parallel)
+		try:
+			return Part.read(self.FileName)
+		finally:
+			grp.SetBool("ParallelTransfer", old)
+
+	def testParallelTransfer(self):
+		serial = self.readStep(False)
+		parallel = self.readStep(True)
+		self.failUnless(len(serial.Solids) == 4)
+		self.failUnless(len(parallel.Solids) == len(serial.Solids))
+		# the roots keep the order of the file
+		for s1, s2 in zip(serial.Solids, parallel.Solids):
+			self.failUnless(abs(s1.Volume - s2.Volume) < 1e-9)
+			self.failUnless(s1.BoundBox.isInside(s2.BoundBox.Center))
+			self.failUnless(len(s1.Faces) == len(s2.Faces))
+
+	def tearDown(self):
+		os.remove(self.FileName)
+
+
+class PartSliceCases(unittest.TestCase):
+	def setUp(self):
+		# solids, a free shell and a free face at different heights
+		box = Part.makeBox(4, 4, 4)
+		cyl = Part.makeCylinder(1, 3, App.Vector(10, 0, 1))
+		shell = Part.makeBox(2, 2, 2, App.Vector(0, 10, 2)).Shells[0]
+		face = Part.makePlane(3, 3, App.Vector(10, 10, 0), App.Vector(1, 0, 0))
+		self.Shape = Part.makeCompound([box, cyl, shell, face])
+
+	def compareSlices(self, dir, dist):
+		comp = self.Shape.slices(dir, dist)
+		# the wires of slices() are sorted by ascending distance
+		wires = []
+		for d in sorted(dist):
+			wires += self.Shape.slice(dir, d)
+		self.failUnless(len(comp.Wires) == len(wires), "%d wires instead of %d" % (len(comp.Wires), len(wires)))
+		for w1, w2 in zip(comp.Wires, wires):
+			self.failUnless(abs(w1.Length - w2.Length) < 1e-7)
+			self.failUnless(w1.BoundBox.Center.distanceToPoint(w2.BoundBox.Center) < 1e-7)
+		return comp
+
+	def testSlices(self):
+		dir = App.Vector(0, 0, 1)
+		comp = self.compareSlices(dir, [0.5, 1.5, 2.5, 3.5])
+		self.failUnless(len(comp.Wires) > 4)
+
+	def testUnsortedSlices(self):
+		self.compareSlices(App.Vector(0, 0, 1), [3.5, 0.5, 2.5, 1.5, 3.0])
+		self.compareSlices(App.Vector(1, 1, 1), [12.0, 3.0, 20.0, 7.5])
+
+	def testSliceWithoutHits(self):
+		dir = App.Vector(0, 0, 1)
+		self.failUnless(len(self.Shape.slices(dir, [100.0]).Wires) == 0)
+		self.failUnless(len(self.Shape.slices(dir, []).Wires) == 0)
+		self.compareSlices(dir, [-5.0, 2.5, 100.0])
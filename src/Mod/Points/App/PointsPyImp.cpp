@@ -27,6 +27,7 @@
 #include <Base/Builder3D.h>
 #include <Base/VectorPy.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/BufferViewPy.h>
 
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
@@ -77,6 +78,34 @@ int PointsPy::PyInit(PyObject* args, PyObject* /*kwd*/)
     return 0;
 }
 
+namespace {
+
+// Fetches the point kernel each time the buffer is requested because the
+// points may have been reallocated in the meantime.
+class PointProvider : public Base::BufferProvider
+{
+public:
+    PointProvider(PointsPy* p) : points(p)
+    {
+    }
+    bool getLayout(Base::BufferLayout& layout) const
+    {
+        const std::vector<PointKernel::value_type>& pts = points->getPointKernelPtr()->getBasicPoints();
+        layout.data = pts.empty() ? 0 : &pts[0].x;
+        layout.rows = pts.size();
+        layout.columns = 3;
+        layout.stride = sizeof(PointKernel::value_type);
+        layout.itemsize = sizeof(float);
+        layout.format = "f";
+        return true;
+    }
+
+private:
+    PointsPy* points;
+};
+
+}
+
 PyObject* PointsPy::copy(PyObject *args)
 {
     if (!PyArg_ParseTuple(args, ""))
@@ -138,6 +167,25 @@ PyObject* PointsPy::addPoints(PyObject * args)
     if (!PyArg_ParseTuple(args, "O", &obj))
         return 0;
 
+    if (Base::BufferReader::check(obj)) {
+        PY_TRY {
+            Base::BufferReader buffer(obj, 3);
+            PointKernel* kernel = getPointKernelPtr();
+            Base::Matrix4D mat = kernel->getTransform();
+            mat.inverse();
+            // the buffer may be a view of this kernel, so convert first
+            std::vector<PointKernel::value_type> pts(buffer.rows());
+            for (Py_ssize_t i = 0; i < buffer.rows(); i++) {
+                Base::Vector3d p(buffer.getFloat(i, 0), buffer.getFloat(i, 1), buffer.getFloat(i, 2));
+                p = mat * p;
+                pts[i].Set((float)p.x, (float)p.y, (float)p.z);
+            }
+            std::vector<PointKernel::value_type>& points = kernel->getBasicPoints();
+            points.insert(points.end(), pts.begin(), pts.end());
+        } PY_CATCH;
+        Py_Return;
+    }
+
     try {
         Py::Sequence list(obj);
         union PyType_Object pyType = {&(Base::VectorPy::Type)};
@@ -168,6 +216,13 @@ PyObject* PointsPy::addPoints(PyObject * args)
     Py_Return;
 }
 
+PyObject* PointsPy::getPointBuffer(PyObject * args)
+{
+    if (!PyArg_ParseTuple(args, ""))
+        return 0;
+    return new Base::BufferViewPy(this, new PointProvider(this));
+}
+
 Py::Int PointsPy::getCountPoints(void) const
 {
     return Py::Int((long)getPointKernelPtr()->size());
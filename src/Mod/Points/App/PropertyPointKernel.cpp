@@ -29,6 +29,7 @@
 # include <algorithm>
 #endif
 
+#include <Base/BufferViewPy.h>
 #include <Base/Exception.h>
 #include <Base/Matrix.h>
 #include <Base/Stream.h>
@@ -54,6 +55,7 @@ PropertyPointKernel::~PropertyPointKernel()
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
+    detachBuffers();
     *_cPoints = m;
     hasSetValue();
 }
@@ -83,6 +85,12 @@ void PropertyPointKernel::getFaces(std::vector<Base::Vector3d> &Points,
     _cPoints->getFaces(Points, Topo, Accuracy, flags);
 }
 
+void PropertyPointKernel::detachBuffers()
+{
+    // buffers of the points exported to Python keep the current memory
+    Base::BufferViewPy::detach(static_cast<PointKernel*>(_cPoints), _cPoints->getBasicPoints());
+}
+
 PyObject *PropertyPointKernel::getPyObject(void)
 {
     PointsPy* points = new PointsPy(&*_cPoints);
@@ -94,6 +102,8 @@ void PropertyPointKernel::setPyObject(PyObject *value)
 {
     if (PyObject_TypeCheck(value, &(PointsPy::Type))) {
         PointsPy  *pcObject = (PointsPy*)value;
+        // Copying reallocates the points
+        Base::BufferViewPy::checkExports(&(*_cPoints));
         setValue( *(pcObject->getPointKernelPtr()));
     }
     else {
@@ -137,6 +147,7 @@ void PropertyPointKernel::SaveDocFile (Base::Writer &writer) const
 void PropertyPointKernel::RestoreDocFile(Base::Reader &reader)
 {
     aboutToSetValue();
+    detachBuffers();
     _cPoints->RestoreDocFile(reader);
     hasSetValue();
 }
@@ -148,17 +159,40 @@ App::Property *PropertyPointKernel::Copy(void) const
     return prop;
 }
 
+App::Property *PropertyPointKernel::Snapshot(void) const
+{
+    if (!PointSnapshot::isBig(this->_cPoints->size()))
+        return Copy();
+
+    PropertyPointKernel* prop = new PropertyPointKernel();
+    prop->_cPoints->setTransform(this->_cPoints->getTransform());
+    prop->_snapshot = PointSnapshot::create(this->_cPoints->getBasicPoints(), _lastSnapshot);
+    return prop;
+}
+
 void PropertyPointKernel::Paste(const App::Property &from)
 {
     aboutToSetValue();
+    detachBuffers();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    if (prop._snapshot) {
+        prop._snapshot->restore(this->_cPoints->getBasicPoints());
+        this->_cPoints->setTransform(prop._cPoints->getTransform());
+        // the points are equal to the snapshot again
+        _lastSnapshot = prop._snapshot;
+    }
+    else {
+        *(this->_cPoints) = *(prop._cPoints);
+    }
     hasSetValue();
 }
 
 unsigned int PropertyPointKernel::getMemSize (void) const
 {
-    return sizeof(Base::Vector3f) * this->_cPoints->size();
+    unsigned int size = sizeof(Base::Vector3f) * this->_cPoints->size();
+    if (_snapshot)
+        size += _snapshot->getMemSize();
+    return size;
 }
 
 void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndices )
@@ -192,6 +226,7 @@ void PropertyPointKernel::removeIndices( const std::vector<unsigned long>& uIndi
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D &rclMat)
 {
     aboutToSetValue();
+    detachBuffers();
     _cPoints->transformGeometry(rclMat);
     hasSetValue();
 }
@@ -24,6 +24,7 @@
 #ifndef POINTS_PROPERTYPOINTKERNEL_H
 #define POINTS_PROPERTYPOINTKERNEL_H
 
+#include <App/ListSnapshot.h>
 #include "Points.h"
 
 namespace Points
@@ -68,6 +69,8 @@ public:
     //@{
     /// returns a new copy of the property (mainly for Undo/Redo and transactions)
     App::Property *Copy(void) const;
+    /// Shares the unchanged parts of big point clouds with the previous snapshot
+    App::Property *Snapshot(void) const;
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property &from);
     unsigned int getMemSize (void) const;
@@ -88,8 +91,15 @@ public:
     void removeIndices( const std::vector<unsigned long>& );
     //@}
 
+private:
+    void detachBuffers();
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    /// the points of a property created by Snapshot(), its kernel only keeps the placement
+    typedef App::ListSnapshot<PointKernel::value_type> PointSnapshot;
+    PointSnapshot::Pointer _snapshot;
+    mutable PointSnapshot::WeakPointer _lastSnapshot;
 };
 
 } // namespace Points
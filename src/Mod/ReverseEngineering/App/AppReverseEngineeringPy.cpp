@@ -48,7 +48,10 @@ static PyObject * approxSurface(PyObject *self, PyObject *args)
     PyObject *o;
     int orderU=4,orderV=4;
     int pointsU=6,pointsV=6;
-    if (!PyArg_ParseTuple(args, "O|iiii",&o,&orderU,&orderV,&pointsU,&pointsV))
+    int iterations=5;
+    double smoothing=0.1;
+    if (!PyArg_ParseTuple(args, "O|iiiiid",&o,&orderU,&orderV,&pointsU,&pointsV,
+                                           &iterations,&smoothing))
         return NULL;
 
     PY_TRY {
@@ -68,8 +71,11 @@ static PyObject * approxSurface(PyObject *self, PyObject *args)
         Handle_Geom_BSplineSurface hSurf;
 
         //pc.EnableSmoothing(true, 0.1f, 0.5f, 0.2f, 0.3f);
-        pc.EnableSmoothing(true, 0.1f, 1.0f, 0.0f, 0.0f);
-        hSurf = pc.CreateSurface(clPoints, 5, true, 1.0);
+        // a smoothing weight of zero gives the plain least-squares fit and
+        // zero iterations keep the parameters of the initial projection
+        if (smoothing > 0.0)
+            pc.EnableSmoothing(true, smoothing, 1.0f, 0.0f, 0.0f);
+        hSurf = pc.CreateSurface(clPoints, iterations, iterations > 0, 1.0);
         if (!hSurf.IsNull()) {
             return new Part::BSplineSurfacePy(new Part::GeomBSplineSurface(hSurf));
         }
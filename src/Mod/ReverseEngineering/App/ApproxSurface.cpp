@@ -22,13 +22,16 @@
 
 
 #include "PreCompiled.h"
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
+#include <Standard.hxx>
 #include <Geom_BSplineSurface.hxx>
+#include <Eigen/Sparse>
 
 #include <Mod/Mesh/App/Core/Approximation.h>
 #include <Base/Sequencer.h>
+#include <Base/TaskScheduler.h>
 #include <Base/Tools2D.h>
+#include <Base/Vector3D.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "ApproxSurface.h"
 
@@ -187,6 +190,57 @@ void BSplineBasis::AllBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncV
   }
 }
 
+int BSplineBasis::LocalBasisFunctions(double fParam, std::vector<double>& vFuncVals) const
+{
+  const int iMaxOrder = 32;
+  if (_iOrder < 1 || _iOrder > iMaxOrder)
+    Standard_RangeError::Raise("BSplineBasis");
+
+  int p = _iOrder-1;
+  int n = _vKnotVector.Length()-_iOrder-1;
+  fParam = std::max<double>(fParam, _vKnotVector(p));
+  fParam = std::min<double>(fParam, _vKnotVector(n+1));
+
+  // Knotenintervall wie in FindSpan bestimmen
+  int iSpan = n;
+  if (fParam < _vKnotVector(n+1))
+  {
+    int low = p;
+    int high = n+1;
+    iSpan = (low+high)/2;
+    while (fParam < _vKnotVector(iSpan) || fParam >= _vKnotVector(iSpan+1))
+    {
+      if (fParam < _vKnotVector(iSpan))
+        high = iSpan;
+      else
+        low = iSpan;
+      iSpan = (low+high)/2;
+    }
+  }
+
+  double zaehler_left[iMaxOrder];
+  double zaehler_right[iMaxOrder];
+  vFuncVals.resize(_iOrder);
+  vFuncVals[0] = 1.0;
+
+  for (int j=1; j<=p; j++)
+  {
+    zaehler_left[j]  = fParam - _vKnotVector(iSpan+1-j);
+    zaehler_right[j] = _vKnotVector(iSpan+j) - fParam;
+    double saved = 0.0;
+    for (int r=0; r<j; r++)
+    {
+      double tmp = vFuncVals[r]/(zaehler_right[r+1] + zaehler_left[j-r]);
+      vFuncVals[r] = saved + zaehler_right[r+1]*tmp;
+      saved = zaehler_left[j-r]*tmp;
+    }
+
+    vFuncVals[j] = saved;
+  }
+
+  return iSpan-p;
+}
+
 double BSplineBasis::BasisFunction(int iIndex, double fParam)
 {
   int m = _vKnotVector.Length()-1;
@@ -782,6 +836,229 @@ void ParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
 
 /////////////////// BSplineParameterCorrection
 
+namespace {
+
+// Normalgleichungen MtM*x = Mt*b. Zwei Kontrollpunkte (j,k) und (j+dj,k+dk) sind
+// nur gekoppelt, wenn |dj| < uOrder und |dk| < vOrder ist. Daher wird pro Zeile
+// von MtM nur ein Band von (2*uOrder-1)*(2*vOrder-1) Eintrgen gespeichert.
+struct NormalEquations
+{
+  int uCtrl, vCtrl, uOrder, vOrder;
+  std::vector<double> MTM;
+  std::vector<double> Mb[3];
+
+  NormalEquations() : uCtrl(0), vCtrl(0), uOrder(0), vOrder(0)
+  {
+  }
+  NormalEquations(int uC, int vC, int uO, int vO)
+    : uCtrl(uC), vCtrl(vC), uOrder(uO), vOrder(vO)
+  {
+    std::size_t dim = uCtrl*vCtrl;
+    MTM.resize(dim*BandSize(), 0.0);
+    for (int i=0; i<3; i++)
+      Mb[i].resize(dim, 0.0);
+  }
+  int BandSize() const
+  {
+    return (2*uOrder-1)*(2*vOrder-1);
+  }
+  int BandIndex(int dj, int dk) const
+  {
+    return (dj+uOrder-1)*(2*vOrder-1) + (dk+vOrder-1);
+  }
+  bool IsEmpty() const
+  {
+    return MTM.empty();
+  }
+  void Add(const NormalEquations& eq)
+  {
+    for (std::size_t i=0; i<MTM.size(); i++)
+      MTM[i] += eq.MTM[i];
+    for (int c=0; c<3; c++)
+    {
+      for (std::size_t i=0; i<Mb[c].size(); i++)
+        Mb[c][i] += eq.Mb[c][i];
+    }
+  }
+};
+
+struct AddNormalEquations
+{
+  NormalEquations operator()(NormalEquations a, const NormalEquations& b) const
+  {
+    if (a.IsEmpty())
+      return b;
+    if (!b.IsEmpty())
+      a.Add(b);
+    return a;
+  }
+};
+
+// Stellt die Normalgleichungen fr einen Teilbereich der Punkte auf
+class NormalEquationsAssembly
+{
+public:
+  NormalEquationsAssembly(const TColgp_Array1OfPnt& p, const TColgp_Array1OfPnt2d& uv,
+                          const BSplineBasis& u, const BSplineBasis& v,
+                          int uC, int vC, int uO, int vO)
+    : points(p), params(uv), uSpline(u), vSpline(v)
+    , uCtrl(uC), vCtrl(vC), uOrder(uO), vOrder(vO)
+  {
+  }
+  NormalEquations operator()(std::size_t first, std::size_t last) const
+  {
+    NormalEquations eq(uCtrl, vCtrl, uOrder, vOrder);
+    int band = eq.BandSize();
+    std::vector<double> Nu, Nv;
+    std::vector<double> w(uOrder*vOrder);
+
+    for (std::size_t i=first; i<last; i++)
+    {
+      int ii = points.Lower() + static_cast<int>(i);
+      const gp_Pnt& P = points(ii);
+      int ju = uSpline.LocalBasisFunctions(params(ii).X(), Nu);
+      int kv = vSpline.LocalBasisFunctions(params(ii).Y(), Nv);
+
+      for (int a=0; a<uOrder; a++)
+      {
+        for (int b=0; b<vOrder; b++)
+          w[a*vOrder+b] = Nu[a]*Nv[b];
+      }
+
+      for (int a=0; a<uOrder; a++)
+      {
+        for (int b=0; b<vOrder; b++)
+        {
+          double wab = w[a*vOrder+b];
+          if (wab == 0.0)
+            continue;
+          std::size_t row = (ju+a)*vCtrl + (kv+b);
+          eq.Mb[0][row] += wab*P.X();
+          eq.Mb[1][row] += wab*P.Y();
+          eq.Mb[2][row] += wab*P.Z();
+
+          double* MTM = &eq.MTM[row*band];
+          for (int c=0; c<uOrder; c++)
+          {
+            for (int d=0; d<vOrder; d++)
+              MTM[eq.BandIndex(c-a, d-b)] += wab*w[c*vOrder+d];
+          }
+        }
+      }
+    }
+
+    return eq;
+  }
+
+private:
+  const TColgp_Array1OfPnt& points;
+  const TColgp_Array1OfPnt2d& params;
+  const BSplineBasis& uSpline;
+  const BSplineBasis& vSpline;
+  int uCtrl, vCtrl, uOrder, vOrder;
+};
+
+struct CorrectionResult
+{
+  float fMaxDiff;
+  float fMaxScalar;
+
+  CorrectionResult() : fMaxDiff(0.0f), fMaxScalar(1.0f)
+  {
+  }
+};
+
+struct JoinCorrectionResults
+{
+  CorrectionResult operator()(const CorrectionResult& a, const CorrectionResult& b) const
+  {
+    CorrectionResult r;
+    r.fMaxDiff = std::max<float>(a.fMaxDiff, b.fMaxDiff);
+    r.fMaxScalar = std::min<float>(a.fMaxScalar, b.fMaxScalar);
+    return r;
+  }
+};
+
+// Fhrt einen Schritt der Parameterkorrektur fr einen Teilbereich der Punkte aus.
+// Geom_BSplineSurface puffert intern die Auswertung und darf daher nicht von mehreren
+// Threads gleichzeitig benutzt werden, so da jeder Teilbereich eine eigene Flche anlegt.
+class ParameterCorrectionStep
+{
+public:
+  ParameterCorrectionStep(const TColgp_Array2OfPnt& c,
+                          const TColStd_Array1OfReal& uK, const TColStd_Array1OfReal& vK,
+                          const TColStd_Array1OfInteger& uM, const TColStd_Array1OfInteger& vM,
+                          int uD, int vD,
+                          const TColgp_Array1OfPnt& p, TColgp_Array1OfPnt2d& uv)
+    : poles(c), uKnots(uK), vKnots(vK), uMults(uM), vMults(vM)
+    , uDegree(uD), vDegree(vD), points(p), params(uv)
+  {
+  }
+  CorrectionResult operator()(std::size_t first, std::size_t last) const
+  {
+    CorrectionResult res;
+    Handle(Geom_BSplineSurface) hSurf = new Geom_BSplineSurface
+                        (poles, uKnots, vKnots, uMults, vMults, uDegree, vDegree);
+
+    for (std::size_t i=first; i<last; i++)
+    {
+      int ii = points.Lower() + static_cast<int>(i);
+      double fDeltaU, fDeltaV, fU, fV;
+      gp_Vec P(points(ii).X(), points(ii).Y(), points(ii).Z());
+      gp_Pnt PntX;
+      gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
+      //Berechne die ersten beiden Ableitungen und Punkt an der Stelle (u,v)
+      hSurf->D2(params(ii).X(), params(ii).Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
+      gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
+      gp_Vec ErrorVec = X - P;
+
+      // Berechne Xu x Xv die Normale in X(u,v)
+      gp_Dir clNormal = Xu ^ Xv;
+
+      //Prfe, ob X = P
+      if (!(X.IsEqual(P,0.001,0.001)))
+      {
+        ErrorVec.Normalize();
+        if(fabs(clNormal*ErrorVec) < res.fMaxScalar)
+          res.fMaxScalar = (float)fabs(clNormal*ErrorVec);
+      }
+
+      fDeltaU =  ( (P-X) * Xu ) / ( (P-X)*Xuu - Xu*Xu );
+      if (fabs(fDeltaU) < FLOAT_EPS)
+        fDeltaU = 0.0f;
+      fDeltaV =  ( (P-X) * Xv ) / ( (P-X)*Xvv - Xv*Xv );
+      if (fabs(fDeltaV) < FLOAT_EPS)
+        fDeltaV = 0.0f;
+
+      //Ersetze die alten u/v-Werte durch die neuen
+      fU = params(ii).X() - fDeltaU;
+      fV = params(ii).Y() - fDeltaV;
+      if (fU <= 1.0f && fU >= 0.0f &&
+          fV <= 1.0f && fV >= 0.0f)
+      {
+        params(ii).SetX(fU);
+        params(ii).SetY(fV);
+        res.fMaxDiff = std::max<float>(float(fabs(fDeltaU)), res.fMaxDiff);
+        res.fMaxDiff = std::max<float>(float(fabs(fDeltaV)), res.fMaxDiff);
+      }
+    }
+
+    return res;
+  }
+
+private:
+  const TColgp_Array2OfPnt& poles;
+  const TColStd_Array1OfReal& uKnots;
+  const TColStd_Array1OfReal& vKnots;
+  const TColStd_Array1OfInteger& uMults;
+  const TColStd_Array1OfInteger& vMults;
+  int uDegree, vDegree;
+  const TColgp_Array1OfPnt& points;
+  TColgp_Array1OfPnt2d& params;
+};
+
+}
+
 
 BSplineParameterCorrection::BSplineParameterCorrection(unsigned short usUOrder, unsigned short usVOrder, 
                              unsigned short usUCtrlpoints, unsigned short usVCtrlpoints)
@@ -823,7 +1100,7 @@ void BSplineParameterCorrection::Init()
   // u-Richtung
   for (int i=0;i<=usUMax; i++)
   {
-    _vUKnots(i) = i / usUMax;
+    _vUKnots(i) = static_cast<double>(i) / usUMax;
     _vUMults(i) = 1;
   }
   _vUMults(0) = _usUOrder;
@@ -831,7 +1108,7 @@ void BSplineParameterCorrection::Init()
   // v-Richtung
   for (int i=0; i<=usVMax; i++)
   {
-    _vVKnots(i) = i / usVMax;
+    _vVKnots(i) = static_cast<double>(i) / usVMax;
     _vVMults(i) = 1;
   }
   _vVMults(0) = _usVOrder;
@@ -883,69 +1160,19 @@ void BSplineParameterCorrection::SetVKnots(const std::vector<double>& afKnots)
 void BSplineParameterCorrection::DoParameterCorrection(unsigned short usIter)
 {
   int i=0;
-  float fMaxDiff=0.0f, fMaxScalar=1.0f;
+  CorrectionResult res;
   double fWeight = _fSmoothInfluence;
 
-  Base::SequencerLauncher seq("Calc surface...", usIter*_pvcPoints->Length());
+  // Die Flchen der einzelnen Teilbereiche werden in eigenen Threads angelegt
+  Part::ReentrantMode reentrant;
+  Base::SequencerLauncher seq("Calc surface...", usIter);
 
   do
   {
-    fMaxScalar = 1.0f;
-    fMaxDiff   = 0.0f;
-
-    Geom_BSplineSurface* pclBSplineSurf = new Geom_BSplineSurface
-                        (_vCtrlPntsOfSurf,
-                         _vUKnots, 
-                         _vVKnots,
-                         _vUMults,
-                         _vVMults,
-                         _usUOrder-1,
-                         _usVOrder-1);
-
-    for (int ii=_pvcPoints->Lower();ii <=_pvcPoints->Upper();ii++)
-    {  
-
-      double fDeltaU, fDeltaV, fU, fV;
-      gp_Vec P((*_pvcPoints)(ii).X(), (*_pvcPoints)(ii).Y(), (*_pvcPoints)(ii).Z());
-      gp_Pnt PntX;
-      gp_Vec Xu, Xv, Xuv, Xuu, Xvv;
-      //Berechne die ersten beiden Ableitungen und Punkt an der Stelle (u,v)
-      pclBSplineSurf->D2((*_pvcUVParam)(ii).X(), (*_pvcUVParam)(ii).Y(), PntX, Xu, Xv, Xuu, Xvv, Xuv);
-      gp_Vec X(PntX.X(), PntX.Y(), PntX.Z());
-      gp_Vec ErrorVec = X - P;
-
-      // Berechne Xu x Xv die Normale in X(u,v)
-      gp_Dir clNormal = Xu ^ Xv;
-
-      //Prfe, ob X = P
-      if (!(X.IsEqual(P,0.001,0.001)))
-      {
-        ErrorVec.Normalize();
-        if(fabs(clNormal*ErrorVec) < fMaxScalar)
-          fMaxScalar = (float)fabs(clNormal*ErrorVec);
-      }
-
-      fDeltaU =  ( (P-X) * Xu ) / ( (P-X)*Xuu - Xu*Xu );
-      if (fabs(fDeltaU) < FLOAT_EPS)
-        fDeltaU = 0.0f;
-      fDeltaV =  ( (P-X) * Xv ) / ( (P-X)*Xvv - Xv*Xv );
-      if (fabs(fDeltaV) < FLOAT_EPS)
-        fDeltaV = 0.0f;
-
-      //Ersetze die alten u/v-Werte durch die neuen
-      fU = (*_pvcUVParam)(ii).X() - fDeltaU;
-      fV = (*_pvcUVParam)(ii).Y() - fDeltaV;
-      if (fU <= 1.0f && fU >= 0.0f &&
-          fV <= 1.0f && fV >= 0.0f)
-      {
-        (*_pvcUVParam)(ii).SetX(fU);
-        (*_pvcUVParam)(ii).SetY(fV);
-        fMaxDiff = std::max<float>(float(fabs(fDeltaU)), fMaxDiff);
-        fMaxDiff = std::max<float>(float(fabs(fDeltaV)), fMaxDiff);
-      }
-
-      seq.next();
-    }
+    ParameterCorrectionStep step(_vCtrlPntsOfSurf, _vUKnots, _vVKnots, _vUMults, _vVMults,
+                                 _usUOrder-1, _usVOrder-1, *_pvcPoints, *_pvcUVParam);
+    res = Base::parallel_reduce(0, _pvcPoints->Length(), CorrectionResult(),
+                                step, JoinCorrectionResults(), 500);
 
     if (_bSmoothing)
     {
@@ -955,147 +1182,101 @@ void BSplineParameterCorrection::DoParameterCorrection(unsigned short usIter)
     else
       SolveWithoutSmoothing();
 
+    seq.next();
     i++;
   }
-  while(i<usIter && fMaxDiff > FLOAT_EPS && fMaxScalar < 0.99);
+  while(i<usIter && res.fMaxDiff > FLOAT_EPS && res.fMaxScalar < 0.99);
 }
 
 bool BSplineParameterCorrection::SolveWithoutSmoothing()
 {
-  unsigned long ulSize = _pvcPoints->Length();
-  math_Matrix M  (0, ulSize-1, 0,_usUCtrlpoints*_usVCtrlpoints-1);
-  math_Matrix Xx (0, _usUCtrlpoints*_usVCtrlpoints-1,0,0);
-  math_Matrix Xy (0, _usUCtrlpoints*_usVCtrlpoints-1,0,0);
-  math_Matrix Xz (0, _usUCtrlpoints*_usVCtrlpoints-1,0,0);
-  math_Vector bx (0, ulSize-1);
-  math_Vector by (0, ulSize-1);
-  math_Vector bz (0, ulSize-1);
-
-  //Bestimmung der Koeffizientenmatrix des berbestimmten LGS
-  for (unsigned long i=0; i<ulSize; i++)
-  {
-    double fU = (*_pvcUVParam)(i).X();
-    double fV = (*_pvcUVParam)(i).Y();
-    unsigned long ulIdx=0;
-
-    for (unsigned short j=0; j<_usUCtrlpoints; j++)
-    {
-      for (unsigned short k=0; k<_usVCtrlpoints; k++)
-      {
-        M(i,ulIdx) = _clUSpline.BasisFunction(j,fU)*_clVSpline.BasisFunction(k,fV);
-        ulIdx++;
-      }
-    }
-  }
-
-  //Bestimmen der rechten Seite
-  for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++)
-  {
-    bx(ii) = (*_pvcPoints)(ii).X(); by(ii) = (*_pvcPoints)(ii).Y(); bz(ii) = (*_pvcPoints)(ii).Z();
-  }
+  return SolveNormalEquations(0.0);
+}
 
-  // Lse das berbest. LGS mit der Householder-Transformation
-  math_Householder hhX(M,bx);
-  math_Householder hhY(M,by);
-  math_Householder hhZ(M,bz);
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+  return SolveNormalEquations(fWeight);
+}
 
-  if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone()))
-    //LGS konnte nicht gelst werden
+bool BSplineParameterCorrection::SolveNormalEquations(double fWeight)
+{
+  int uCtrl = _usUCtrlpoints;
+  int vCtrl = _usVCtrlpoints;
+  int uOrder = _usUOrder;
+  int vOrder = _usVOrder;
+  int ulDim  = uCtrl*vCtrl;
+
+  //Aufstellen der Normalgleichungen, die Punkte werden in Teilbereichen summiert
+  NormalEquationsAssembly assembly(*_pvcPoints, *_pvcUVParam, _clUSpline, _clVSpline,
+                                   uCtrl, vCtrl, uOrder, vOrder);
+  NormalEquations eq = Base::parallel_reduce(0, _pvcPoints->Length(), NormalEquations(),
+                                             assembly, AddNormalEquations(), 5000);
+  if (eq.IsEmpty())
     return false;
-  Xx = hhX.AllValues();
-  Xy = hhY.AllValues();
-  Xz = hhZ.AllValues();
 
-  unsigned long ulIdx=0;
-  for (unsigned short j=0;j<_usUCtrlpoints;j++)
+  typedef Eigen::Triplet<double> Triplet;
+  std::vector<Triplet> triplets;
+  triplets.reserve(ulDim*eq.BandSize());
+  int band = eq.BandSize();
+  for (int j=0; j<uCtrl; j++)
   {
-    for (unsigned short k=0;k<_usVCtrlpoints;k++)
+    for (int k=0; k<vCtrl; k++)
     {
-      _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx,0),Xy(ulIdx,0),Xz(ulIdx,0));
-      ulIdx++;
-    }
-  }
-
-  return true;
-}
-
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
-{
-  unsigned long ulSize = _pvcPoints->Length();
-  unsigned long ulDim  = _usUCtrlpoints*_usVCtrlpoints;
-  math_Matrix M  (0, ulSize-1, 0,_usUCtrlpoints*_usVCtrlpoints-1);
-  math_Matrix MTM(0, _usUCtrlpoints*_usVCtrlpoints-1, 
-                  0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector Xx (0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector Xy (0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector Xz (0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector bx (0, ulSize-1);
-  math_Vector by (0, ulSize-1);
-  math_Vector bz (0, ulSize-1);
-  math_Vector Mbx(0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector Mby(0, _usUCtrlpoints*_usVCtrlpoints-1);
-  math_Vector Mbz(0, _usUCtrlpoints*_usVCtrlpoints-1);
-
-  //Bestimmung der Koeffizientenmatrix des berbestimmten LGS
-  for (unsigned long i=0; i<ulSize; i++)
-  {
-    double fU = (*_pvcUVParam)(i).X();
-    double fV = (*_pvcUVParam)(i).Y();
-    unsigned long ulIdx=0;
-
-    for (unsigned short j=0; j<_usUCtrlpoints; j++)
-    {
-      for (unsigned short k=0; k<_usVCtrlpoints; k++)
+      int row = j*vCtrl+k;
+      for (int dj=1-uOrder; dj<uOrder; dj++)
       {
-        M(i,ulIdx) = _clUSpline.BasisFunction(j,fU)*_clVSpline.BasisFunction(k,fV);
-        ulIdx++;
+        if (j+dj < 0 || j+dj >= uCtrl)
+          continue;
+        for (int dk=1-vOrder; dk<vOrder; dk++)
+        {
+          if (k+dk < 0 || k+dk >= vCtrl)
+            continue;
+          double val = eq.MTM[row*band + eq.BandIndex(dj,dk)];
+          if (val != 0.0)
+            triplets.push_back(Triplet(row, (j+dj)*vCtrl+(k+dk), val));
+        }
       }
     }
   }
-  //Das Produkt aus ihrer Transformierten und ihr selbst ergibt die quadratische Systemmatrix
-  for (unsigned long m=0; m<ulDim; m++)
+
+  //Glttungsterme, doppelte Eintrge werden von setFromTriplets() addiert
+  if (fWeight != 0.0)
   {
-    for (unsigned long n=m; n<ulDim; n++)
+    for (int m=0; m<ulDim; m++)
     {
-      MTM(m,n)=MTM(n,m)=M.Col(m)*M.Col(n);
+      for (int n=0; n<ulDim; n++)
+      {
+        double val = _clSmoothMatrix(m,n);
+        if (val != 0.0)
+          triplets.push_back(Triplet(m, n, fWeight*val));
+      }
     }
   }
 
-  //Bestimmen der rechten Seite
-  for (int ii=_pvcPoints->Lower(); ii<=_pvcPoints->Upper(); ii++)
-  {
-    bx(ii) = (*_pvcPoints)(ii).X(); by(ii) = (*_pvcPoints)(ii).Y(); bz(ii) = (*_pvcPoints)(ii).Z();
-  }
-  for (unsigned long i=0; i<ulDim; i++)
-  {
-    Mbx(i) = M.Col(i) * bx;
-    Mby(i) = M.Col(i) * by;
-    Mbz(i) = M.Col(i) * bz;
-  }
-
-  // Lse das LGS mit der LU-Zerlegung
-  math_Gauss mgGaussX(MTM+fWeight*_clSmoothMatrix);
-  math_Gauss mgGaussY(MTM+fWeight*_clSmoothMatrix);
-  math_Gauss mgGaussZ(MTM+fWeight*_clSmoothMatrix);
-
-  mgGaussX.Solve(Mbx,Xx);
-  if (!mgGaussX.IsDone())
-    return false;
+  Eigen::SparseMatrix<double> MTM(ulDim, ulDim);
+  MTM.setFromTriplets(triplets.begin(), triplets.end());
 
-  mgGaussY.Solve(Mby,Xy);
-  if (!mgGaussY.IsDone())
+  // Lse das LGS mit der Cholesky-Zerlegung
+  Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(MTM);
+  if (solver.info() != Eigen::Success)
+    //LGS konnte nicht gelst werden
     return false;
 
-  mgGaussZ.Solve(Mbz,Xz);
-  if (!mgGaussZ.IsDone())
-    return false;
+  Eigen::VectorXd X[3];
+  for (int c=0; c<3; c++)
+  {
+    Eigen::Map<const Eigen::VectorXd> Mb(&eq.Mb[c][0], ulDim);
+    X[c] = solver.solve(Mb);
+    if (solver.info() != Eigen::Success)
+      return false;
+  }
 
-  unsigned long ulIdx=0;
-  for (unsigned short j=0;j<_usUCtrlpoints;j++)
+  int ulIdx=0;
+  for (int j=0;j<uCtrl;j++)
   {
-    for (unsigned short k=0;k<_usVCtrlpoints;k++)
+    for (int k=0;k<vCtrl;k++)
     {
-      _vCtrlPntsOfSurf(j,k) = gp_Pnt(Xx(ulIdx),Xy(ulIdx),Xz(ulIdx));
+      _vCtrlPntsOfSurf(j,k) = gp_Pnt(X[0](ulIdx),X[1](ulIdx),X[2](ulIdx));
       ulIdx++;
     }
   }
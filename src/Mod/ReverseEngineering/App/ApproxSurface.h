@@ -173,6 +173,16 @@ public:
    */
   virtual void AllBasisFunctions(double fParam, TColStd_Array1OfReal& vFuncVals);
 
+  /**
+   * Berechnet wie AllBasisFunctions die an der Stelle fParam nicht verschwindenden
+   * Basisfunktionen, legt dabei aber keine Hilfsfelder an und verndert keine Member.
+   * Die Methode darf daher von mehreren Threads gleichzeitig aufgerufen werden.
+   * @param fParam Parameterwert, wird auf den Definitionsbereich beschrnkt
+   * @param vFuncVals Liste der _iOrder Funktionswerte
+   * @return Index der ersten nicht verschwindenden Basisfunktion
+   */
+  int LocalBasisFunctions(double fParam, std::vector<double>& vFuncVals) const;
+
   /**
    * Berechnet den Funktionswert Nik(t) an der Stelle fParam
    * (aus: Piegl/Tiller 96 The NURBS-Book)
@@ -370,16 +380,24 @@ protected:
   virtual void DoParameterCorrection(unsigned short usIter);
 
   /**
-   * Lst ein berbestimmtes LGS mit Hilfe der Householder-Transformation
+   * Lst das berbestimmte LGS ber die Normalgleichungen
    */
   virtual bool SolveWithoutSmoothing();
 
   /**
-   * Lst ein regulres Gleichungssystem durch LU-Zerlegung. Es flieen je nach Gewichtung
+   * Lst die Normalgleichungen des berbestimmten LGS. Es flieen je nach Gewichtung
    * Glttungsterme mit ein
    */
   virtual bool SolveWithSmoothing(double fWeight);
 
+  /**
+   * Stellt die Normalgleichungen dnn besetzt auf und lst sie mit einer
+   * Cholesky-Zerlegung. Da jede Basisfunktion nur auf _usUOrder bzw. _usVOrder
+   * Knotenintervallen ungleich Null ist, trgt jeder Punkt nur zu einem kleinen
+   * Block der Systemmatrix bei. Mit fWeight > 0 flieen die Glttungsterme mit ein.
+   */
+  bool SolveNormalEquations(double fWeight);
+
 public:
   /**
    * Setzen des Knotenvektors
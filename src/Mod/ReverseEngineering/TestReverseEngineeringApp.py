@@ -0,0 +1,159 @@
+#   (c) FreeCAD Developers 2026                               LGPL        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, unittest, math
+import ReverseEngineering
+
+#---------------------------------------------------------------------------
+# define the test cases to test the FreeCAD ReverseEngineering module
+#---------------------------------------------------------------------------
+
+
+def samplePoints(f):
+	"""Samples f on a grid that is symmetric to the x and y axes, for an even f
+	the fitted plane is the xy plane and the parameters are affine in x and y"""
+	points = []
+	params = []
+	for i in range(21):
+		x = (i - 10) / 5.0
+		for j in range(11):
+			y = (j - 5) / 5.0
+			points.append(FreeCAD.Vector(x, y, f(x, y)))
+			params.append(((x + 2.0) / 4.0, (y + 1.0) / 2.0))
+	return points, params
+
+def knotSequence(knots, mults):
+	seq = []
+	for k, m in zip(knots, mults):
+		seq += [k] * m
+	return seq
+
+def basisFunctions(knots, degree, t):
+	"""The values of all basis functions of a clamped knot sequence at t"""
+	count = len(knots) - degree - 1
+	# t equal to the last knot belongs to the last span
+	span = degree
+	while span < count - 1 and t >= knots[span+1]:
+		span += 1
+	N = [0.0] * (len(knots) - 1)
+	N[span] = 1.0
+	for p in range(1, degree + 1):
+		for i in range(len(knots) - p - 1):
+			value = 0.0
+			d = knots[i+p] - knots[i]
+			if d > 0.0:
+				value += (t - knots[i]) / d * N[i]
+			d = knots[i+p+1] - knots[i+1]
+			if d > 0.0:
+				value += (knots[i+p+1] - t) / d * N[i+1]
+			N[i] = value
+	return N[:count]
+
+def denseFit(points, params, uknots, vknots, udegree, vdegree):
+	"""The former solver: the normal equations of all control points are set
+	up as a dense matrix and solved with Gaussian elimination"""
+	nu = len(uknots) - udegree - 1
+	nv = len(vknots) - vdegree - 1
+	dim = nu * nv
+	MtM = [[0.0] * dim for i in range(dim)]
+	Mtb = [[0.0] * 3 for i in range(dim)]
+	for p, (u, v) in zip(points, params):
+		bu = basisFunctions(uknots, udegree, u)
+		bv = basisFunctions(vknots, vdegree, v)
+		row = [bu[j] * bv[k] for j in range(nu) for k in range(nv)]
+		for m in range(dim):
+			if row[m] == 0.0:
+				continue
+			for n in range(dim):
+				MtM[m][n] += row[m] * row[n]
+			Mtb[m][0] += row[m] * p.x
+			Mtb[m][1] += row[m] * p.y
+			Mtb[m][2] += row[m] * p.z
+	for c in range(dim):
+		pivot = max(range(c, dim), key=lambda r: abs(MtM[r][c]))
+		MtM[c], MtM[pivot] = MtM[pivot], MtM[c]
+		Mtb[c], Mtb[pivot] = Mtb[pivot], Mtb[c]
+		for r in range(c + 1, dim):
+			f = MtM[r][c] / MtM[c][c]
+			if f == 0.0:
+				continue
+			for n in range(c, dim):
+				MtM[r][n] -= f * MtM[c][n]
+			for n in range(3):
+				Mtb[r][n] -= f * Mtb[c][n]
+	X = [None] * dim
+	for c in reversed(range(dim)):
+		s = list(Mtb[c])
+		for n in range(c + 1, dim):
+			for i in range(3):
+				s[i] -= MtM[c][n] * X[n][i]
+		X[c] = [s[i] / MtM[c][c] for i in range(3)]
+	return [[FreeCAD.Vector(*X[j*nv+k]) for k in range(nv)] for j in range(nu)]
+
+def evaluate(poles, uknots, vknots, udegree, vdegree, u, v):
+	bu = basisFunctions(uknots, udegree, u)
+	bv = basisFunctions(vknots, vdegree, v)
+	p = FreeCAD.Vector()
+	for j in range(len(bu)):
+		for k in range(len(bv)):
+			p = p + poles[j][k] * (bu[j] * bv[k])
+	return p
+
+def distance(surface, point):
+	u, v = surface.parameter(point)
+	return (surface.value(u, v) - point).Length
+
+
+class ApproxSurfaceCases(unittest.TestCase):
+	def fit(self, points, iterations, smoothing):
+		data = [(p.x, p.y, p.z) for p in points]
+		return ReverseEngineering.approxSurface(data, 4, 4, 6, 6, iterations, smoothing)
+
+	def testExactFit(self):
+		# a polynomial of degree 2 in x and y lies in the space of the bicubic
+		# surfaces, so the least-squares fit must reproduce it
+		points, params = samplePoints(lambda x, y: 0.1 * x * x * y * y - 0.05 * x * x)
+		surface = self.fit(points, 0, 0.0)
+		for p in points:
+			self.failUnless(distance(surface, p) < 1e-4)
+
+	def testParameterCorrection(self):
+		# correcting the parameters keeps an exact fit exact
+		points, params = samplePoints(lambda x, y: 0.1 * x * x * y * y - 0.05 * x * x)
+		surface = self.fit(points, 5, 0.0)
+		for p in points:
+			self.failUnless(distance(surface, p) < 1e-4)
+
+	def testDenseSolver(self):
+		# the sparse solver must give the same surface as the dense one
+		f = lambda x, y: 0.1 * x * x * y * y + 0.02 * math.cos(3.0 * x) * math.cos(4.0 * y)
+		points, params = samplePoints(f)
+		surface = self.fit(points, 0, 0.0)
+		uknots = knotSequence(surface.getUKnots(), surface.getUMultiplicities())
+		vknots = knotSequence(surface.getVKnots(), surface.getVMultiplicities())
+		poles = denseFit(points, params, uknots, vknots, surface.UDegree, surface.VDegree)
+		maxError = 0.0
+		for p, (u, v) in zip(points, params):
+			q = evaluate(poles, uknots, vknots, surface.UDegree, surface.VDegree, u, v)
+			self.failUnless(distance(surface, q) < 1e-4)
+			maxError = max(maxError, (q - p).Length)
+		# the noise cannot be represented
+		self.failUnless(maxError > 1e-3)
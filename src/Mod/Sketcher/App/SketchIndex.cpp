@@ -0,0 +1,343 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <algorithm>
+# include <cfloat>
+# include <cmath>
+#endif
+
+#include <Mod/Part/App/Geometry.h>
+
+#include "SketchIndex.h"
+
+using namespace Sketcher;
+
+namespace {
+// A curve whose bounding box covers more cells is not put into the grid
+const int MaxCurveCells = 16;
+// Upper limit of cells in each direction
+const int MaxCells = 1024;
+}
+
+SketchIndex::SketchIndex()
+  : valid(false), minX(0), minY(0), cellW(1), cellH(1), nx(0), ny(0)
+{
+}
+
+SketchIndex::~SketchIndex()
+{
+}
+
+void SketchIndex::clear()
+{
+    valid = false;
+    vertices.clear();
+    curves.clear();
+    vertexStart.clear();
+    vertexItems.clear();
+    curveStart.clear();
+    curveItems.clear();
+    bigCurves.clear();
+    nx = ny = 0;
+}
+
+void SketchIndex::build(const std::vector<Part::Geometry*>& geo, int intGeoCount)
+{
+    clear();
+
+    // skip the two axes at the end
+    int count = int(geo.size()) - 2;
+    int extGeoCount = count - intGeoCount + 2;
+    for (int i = 0; i < count; i++) {
+        int GeoId = (i < intGeoCount ? i : i - intGeoCount - extGeoCount);
+        const Part::Geometry* g = geo[i];
+        Base::TypeId type = g->getTypeId();
+        if (type == Part::GeomPoint::getClassTypeId()) {
+            const Part::GeomPoint* point = static_cast<const Part::GeomPoint*>(g);
+            addVertex(GeoId, start, point->getPoint());
+        }
+        else if (type == Part::GeomLineSegment::getClassTypeId()) {
+            const Part::GeomLineSegment* line = static_cast<const Part::GeomLineSegment*>(g);
+            Base::Vector3d p1 = line->getStartPoint();
+            Base::Vector3d p2 = line->getEndPoint();
+            addVertex(GeoId, start, p1);
+            addVertex(GeoId, end, p2);
+            addCurve(GeoId, p1, p2);
+        }
+        else if (type == Part::GeomCircle::getClassTypeId()) {
+            const Part::GeomCircle* circle = static_cast<const Part::GeomCircle*>(g);
+            Base::Vector3d center = circle->getCenter();
+            Base::Vector3d r(circle->getRadius(), circle->getRadius(), 0);
+            addVertex(GeoId, mid, center);
+            addCurve(GeoId, center - r, center + r);
+        }
+        else if (type == Part::GeomEllipse::getClassTypeId()) {
+            const Part::GeomEllipse* ellipse = static_cast<const Part::GeomEllipse*>(g);
+            Base::Vector3d center = ellipse->getCenter();
+            Base::Vector3d r(ellipse->getMajorRadius(), ellipse->getMajorRadius(), 0);
+            addVertex(GeoId, mid, center);
+            addCurve(GeoId, center - r, center + r);
+        }
+        else if (type == Part::GeomArcOfCircle::getClassTypeId()) {
+            // the box of the full circle is good enough to find candidates
+            const Part::GeomArcOfCircle* arc = static_cast<const Part::GeomArcOfCircle*>(g);
+            Base::Vector3d center = arc->getCenter();
+            Base::Vector3d r(arc->getRadius(), arc->getRadius(), 0);
+            addVertex(GeoId, start, arc->getStartPoint(/*emulateCCW=*/true));
+            addVertex(GeoId, end, arc->getEndPoint(/*emulateCCW=*/true));
+            addVertex(GeoId, mid, center);
+            addCurve(GeoId, center - r, center + r);
+        }
+        else if (type == Part::GeomArcOfEllipse::getClassTypeId()) {
+            const Part::GeomArcOfEllipse* arc = static_cast<const Part::GeomArcOfEllipse*>(g);
+            Base::Vector3d center = arc->getCenter();
+            Base::Vector3d r(arc->getMajorRadius(), arc->getMajorRadius(), 0);
+            addVertex(GeoId, start, arc->getStartPoint(/*emulateCCW=*/true));
+            addVertex(GeoId, end, arc->getEndPoint(/*emulateCCW=*/true));
+            addVertex(GeoId, mid, center);
+            addCurve(GeoId, center - r, center + r);
+        }
+        else {
+            // unknown extent, always test it
+            Curve c;
+            c.GeoId = GeoId;
+            c.MinX = c.MinY = -DBL_MAX;
+            c.MaxX = c.MaxY = DBL_MAX;
+            bigCurves.push_back(int(curves.size()));
+            curves.push_back(c);
+        }
+    }
+
+    setupGrid();
+    valid = true;
+}
+
+void SketchIndex::addVertex(int GeoId, PointPos PosId, const Base::Vector3d& pnt)
+{
+    Vertex v;
+    v.GeoId = GeoId;
+    v.PosId = PosId;
+    v.Point = pnt;
+    vertices.push_back(v);
+}
+
+void SketchIndex::addCurve(int GeoId, const Base::Vector3d& p1, const Base::Vector3d& p2)
+{
+    Curve c;
+    c.GeoId = GeoId;
+    c.MinX = std::min(p1.x, p2.x);
+    c.MinY = std::min(p1.y, p2.y);
+    c.MaxX = std::max(p1.x, p2.x);
+    c.MaxY = std::max(p1.y, p2.y);
+    curves.push_back(c);
+}
+
+void SketchIndex::setupGrid()
+{
+    // bounding box of all bounded elements
+    double maxX = -DBL_MAX, maxY = -DBL_MAX;
+    minX = minY = DBL_MAX;
+    for (std::vector<Vertex>::const_iterator it = vertices.begin(); it != vertices.end(); ++it) {
+        minX = std::min(minX, it->Point.x);
+        minY = std::min(minY, it->Point.y);
+        maxX = std::max(maxX, it->Point.x);
+        maxY = std::max(maxY, it->Point.y);
+    }
+    for (std::vector<Curve>::const_iterator it = curves.begin(); it != curves.end(); ++it) {
+        if (it->MinX == -DBL_MAX)
+            continue;
+        minX = std::min(minX, it->MinX);
+        minY = std::min(minY, it->MinY);
+        maxX = std::max(maxX, it->MaxX);
+        maxY = std::max(maxY, it->MaxY);
+    }
+    if (minX > maxX) {
+        nx = ny = 0;
+        return;
+    }
+
+    // about one element per cell
+    double w = std::max(maxX - minX, 1e-7);
+    double h = std::max(maxY - minY, 1e-7);
+    double n = double(std::max<std::size_t>(1, vertices.size() + curves.size()));
+    nx = std::max(1, std::min(MaxCells, int(std::ceil(std::sqrt(n * w / h)))));
+    ny = std::max(1, std::min(MaxCells, int(std::ceil(n / nx))));
+    cellW = w / nx;
+    cellH = h / ny;
+
+    int numCells = nx * ny;
+    vertexStart.assign(numCells + 1, 0);
+    for (std::vector<Vertex>::const_iterator it = vertices.begin(); it != vertices.end(); ++it)
+        vertexStart[cellY(it->Point.y) * nx + cellX(it->Point.x) + 1]++;
+    for (int c = 0; c < numCells; c++)
+        vertexStart[c+1] += vertexStart[c];
+    vertexItems.resize(vertices.size());
+    std::vector<int> fill(vertexStart.begin(), vertexStart.end() - 1);
+    for (std::size_t v = 0; v < vertices.size(); v++) {
+        const Base::Vector3d& p = vertices[v].Point;
+        vertexItems[fill[cellY(p.y) * nx + cellX(p.x)]++] = int(v);
+    }
+
+    // curves are put into all cells their bounding box overlaps
+    curveStart.assign(numCells + 1, 0);
+    std::vector<int> gridCurves;
+    for (std::size_t k = 0; k < curves.size(); k++) {
+        const Curve& c = curves[k];
+        if (c.MinX == -DBL_MAX)
+            continue;
+        int i0, j0, i1, j1;
+        getCellRange(c.MinX, c.MinY, c.MaxX, c.MaxY, i0, j0, i1, j1);
+        if ((i1 - i0 + 1) * (j1 - j0 + 1) > MaxCurveCells) {
+            bigCurves.push_back(int(k));
+            continue;
+        }
+        gridCurves.push_back(int(k));
+        for (int j = j0; j <= j1; j++)
+            for (int i = i0; i <= i1; i++)
+                curveStart[j * nx + i + 1]++;
+    }
+    for (int c = 0; c < numCells; c++)
+        curveStart[c+1] += curveStart[c];
+    curveItems.resize(curveStart[numCells]);
+    fill.assign(curveStart.begin(), curveStart.end() - 1);
+    for (std::vector<int>::const_iterator it = gridCurves.begin(); it != gridCurves.end(); ++it) {
+        const Curve& c = curves[*it];
+        int i0, j0, i1, j1;
+        getCellRange(c.MinX, c.MinY, c.MaxX, c.MaxY, i0, j0, i1, j1);
+        for (int j = j0; j <= j1; j++)
+            for (int i = i0; i <= i1; i++)
+                curveItems[fill[j * nx + i]++] = *it;
+    }
+    std::sort(bigCurves.begin(), bigCurves.end());
+}
+
+int SketchIndex::cellX(double x) const
+{
+    double i = std::floor((x - minX) / cellW);
+    if (i < 0)
+        return 0;
+    if (i >= nx)
+        return nx - 1;
+    return int(i);
+}
+
+int SketchIndex::cellY(double y) const
+{
+    double j = std::floor((y - minY) / cellH);
+    if (j < 0)
+        return 0;
+    if (j >= ny)
+        return ny - 1;
+    return int(j);
+}
+
+void SketchIndex::getCellRange(double x0, double y0, double x1, double y1,
+                               int& i0, int& j0, int& i1, int& j1) const
+{
+    i0 = cellX(x0);
+    j0 = cellY(y0);
+    i1 = cellX(x1);
+    j1 = cellY(y1);
+}
+
+void SketchIndex::findVertices(const Base::Vector3d& pnt, double tol, std::vector<int>& result) const
+{
+    result.clear();
+    if (nx == 0)
+        return;
+
+    double tol2 = tol * tol;
+    int i0, j0, i1, j1;
+    getCellRange(pnt.x - tol, pnt.y - tol, pnt.x + tol, pnt.y + tol, i0, j0, i1, j1);
+    if (double(i1 - i0 + 1) * double(j1 - j0 + 1) > double(vertices.size())) {
+        // the search radius is big compared to the cells
+        for (std::size_t v = 0; v < vertices.size(); v++) {
+            double dx = vertices[v].Point.x - pnt.x;
+            double dy = vertices[v].Point.y - pnt.y;
+            if (dx*dx + dy*dy <= tol2)
+                result.push_back(int(v));
+        }
+        return;
+    }
+
+    for (int j = j0; j <= j1; j++) {
+        for (int i = i0; i <= i1; i++) {
+            int cell = j * nx + i;
+            for (int k = vertexStart[cell]; k < vertexStart[cell+1]; k++) {
+                const Base::Vector3d& p = vertices[vertexItems[k]].Point;
+                double dx = p.x - pnt.x;
+                double dy = p.y - pnt.y;
+                if (dx*dx + dy*dy <= tol2)
+                    result.push_back(vertexItems[k]);
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+}
+
+void SketchIndex::findCurves(const Base::Vector3d& min, const Base::Vector3d& max, double tol,
+                             std::vector<int>& result) const
+{
+    result.clear();
+    double x0 = std::min(min.x, max.x) - tol;
+    double y0 = std::min(min.y, max.y) - tol;
+    double x1 = std::max(min.x, max.x) + tol;
+    double y1 = std::max(min.y, max.y) + tol;
+
+    std::vector<int> candidates(bigCurves);
+    if (nx > 0) {
+        int i0, j0, i1, j1;
+        getCellRange(x0, y0, x1, y1, i0, j0, i1, j1);
+        for (int j = j0; j <= j1; j++) {
+            for (int i = i0; i <= i1; i++) {
+                int cell = j * nx + i;
+                candidates.insert(candidates.end(), curveItems.begin() + curveStart[cell],
+                                  curveItems.begin() + curveStart[cell+1]);
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (std::vector<int>::const_iterator it = candidates.begin(); it != candidates.end(); ++it) {
+        const Curve& c = curves[*it];
+        if (c.MinX <= x1 && c.MaxX >= x0 && c.MinY <= y1 && c.MaxY >= y0)
+            result.push_back(c.GeoId);
+    }
+}
+
+void SketchIndex::findCoincidentVertices(double tol, std::vector<std::pair<int, int> >& result) const
+{
+    result.clear();
+    std::vector<int> near;
+    for (std::size_t v = 0; v < vertices.size(); v++) {
+        findVertices(vertices[v].Point, tol, near);
+        for (std::vector<int>::const_iterator it = near.begin(); it != near.end(); ++it) {
+            if (*it > int(v) && vertices[*it].GeoId != vertices[v].GeoId)
+                result.push_back(std::make_pair(int(v), *it));
+        }
+    }
+}
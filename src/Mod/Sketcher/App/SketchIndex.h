@@ -0,0 +1,111 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Developers                                 *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+
+#ifndef SKETCHER_SKETCHINDEX_H
+#define SKETCHER_SKETCHINDEX_H
+
+#include <vector>
+#include <utility>
+#include <Base/Vector3D.h>
+
+#include "Constraint.h"
+
+namespace Part {
+class Geometry;
+}
+
+namespace Sketcher
+{
+
+/**
+ * The SketchIndex class is a uniform grid over the vertices and the bounding
+ * boxes of the curves of a sketch. It answers proximity queries in time that
+ * depends on the number of nearby elements rather than on the size of the
+ * sketch. The grid is built in linear time from the complete geometry of a
+ * sketch and must be rebuilt after the geometry has changed.
+ * @author FreeCAD Developers
+ */
+class SketcherExport SketchIndex
+{
+public:
+    struct Vertex {
+        int GeoId;
+        PointPos PosId;
+        Base::Vector3d Point;
+    };
+
+    SketchIndex();
+    ~SketchIndex();
+
+    /** Indexes the geometry as returned by SketchObject::getCompleteGeometry(),
+     * i.e. the \a intGeoCount internal curves followed by the external curves
+     * in reverse order. The two axes at the end of the list are skipped.
+     */
+    void build(const std::vector<Part::Geometry*>& geo, int intGeoCount);
+    void clear();
+    bool isValid() const
+    { return valid; }
+
+    const std::vector<Vertex>& getVertices() const
+    { return vertices; }
+    /// Returns the indices of the vertices within distance \a tol of \a pnt
+    void findVertices(const Base::Vector3d& pnt, double tol, std::vector<int>& result) const;
+    /// Returns the GeoIds of the curves whose bounding box intersects the box expanded by \a tol
+    void findCurves(const Base::Vector3d& min, const Base::Vector3d& max, double tol,
+                    std::vector<int>& result) const;
+    /** Returns the pairs of vertex indices of different curves that are within
+     * distance \a tol of each other. The first index of a pair is the lower one.
+     */
+    void findCoincidentVertices(double tol, std::vector<std::pair<int, int> >& result) const;
+
+private:
+    struct Curve {
+        int GeoId;
+        double MinX, MinY, MaxX, MaxY;
+    };
+
+    void addVertex(int GeoId, PointPos PosId, const Base::Vector3d& pnt);
+    void addCurve(int GeoId, const Base::Vector3d& min, const Base::Vector3d& max);
+    void setupGrid();
+    void getCellRange(double minX, double minY, double maxX, double maxY,
+                      int& i0, int& j0, int& i1, int& j1) const;
+    int cellX(double x) const;
+    int cellY(double y) const;
+
+private:
+    bool valid;
+    std::vector<Vertex> vertices;
+    std::vector<Curve> curves;
+    // grid of nx * ny cells, the items of a cell are stored in compressed rows
+    double minX, minY, cellW, cellH;
+    int nx, ny;
+    std::vector<int> vertexStart, vertexItems;
+    std::vector<int> curveStart, curveItems;
+    // curves that would cover too many cells are always tested
+    std::vector<int> bigCurves;
+};
+
+} // namespace Sketcher
+
+#endif // SKETCHER_SKETCHINDEX_H
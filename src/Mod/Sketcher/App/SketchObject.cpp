@@ -2462,6 +2462,7 @@ void SketchObject::rebuildVertexIndex(void)
 {
     VertexId2GeoId.resize(0);
     VertexId2PosId.resize(0);
+    GeometryIndex.clear();
     int imax=getHighestCurveIndex();
     int i=0;
     const std::vector< Part::Geometry * > geometry = getCompleteGeometry();
@@ -2503,6 +2504,13 @@ void SketchObject::rebuildVertexIndex(void)
     }
 }
 
+const SketchIndex& SketchObject::getGeometryIndex(void) const
+{
+    if (!GeometryIndex.isValid())
+        GeometryIndex.build(getCompleteGeometry(), getHighestCurveIndex() + 1);
+    return GeometryIndex;
+}
+
 void SketchObject::getCoincidentPoints(int GeoId, PointPos PosId, std::vector<int> &GeoIdList,
                                        std::vector<PointPos> &PosIdList)
 {
@@ -2845,6 +2853,8 @@ void SketchObject::Restore(XMLReader &reader)
 void SketchObject::onChanged(const App::Property* prop)
 {
     if (prop == &Geometry || prop == &Constraints) {
+        if (prop == &Geometry)
+            GeometryIndex.clear();
         Constraints.checkGeometry(getCompleteGeometry());
     }
     else if (prop == &ExternalGeometry) {
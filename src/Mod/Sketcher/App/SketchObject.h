@@ -33,6 +33,7 @@
 #include <Mod/Sketcher/App/PropertyConstraintList.h>
 
 #include "Sketch.h"
+#include "SketchIndex.h"
 
 namespace Sketcher
 {
@@ -166,6 +167,8 @@ public:
     int getHighestVertexIndex(void) const { return VertexId2GeoId.size() - 1; } // Most recently created
     int getHighestCurveIndex(void) const { return Geometry.getSize() - 1; }
     void rebuildVertexIndex(void);
+    /// returns the spatial index of the complete geometry, it is rebuilt on demand after a change
+    const SketchIndex& getGeometryIndex(void) const;
     
     /// retrieves for a GeoId and PosId the Vertex number 
     int getVertexIndexGeoPos(int GeoId, PointPos PosId) const;
@@ -250,6 +253,7 @@ private:
 
     std::vector<int> VertexId2GeoId;
     std::vector<PointPos> VertexId2PosId;
+    mutable SketchIndex GeometryIndex;
     
     Sketch solvedSketch;
     
@@ -24,6 +24,7 @@
 #ifndef _PreComp_
 # include <sstream>
 # include <Geom_TrimmedCurve.hxx>
+# include <Precision.hxx>
 #endif
 
 #include <boost/shared_ptr.hpp>
@@ -823,6 +824,31 @@ PyObject* SketchObjectPy::changeConstraintsLocking(PyObject *args)
     return Py::new_reference_to(Py::Int(naff));
 }
 
+PyObject* SketchObjectPy::findCoincidentPoints(PyObject *args)
+{
+    double tolerance = Precision::Confusion();
+    if (!PyArg_ParseTuple(args, "|d", &tolerance))
+        return 0;
+
+    const SketchIndex& index = this->getSketchObjectPtr()->getGeometryIndex();
+    const std::vector<SketchIndex::Vertex>& vertices = index.getVertices();
+    std::vector<std::pair<int, int> > pairs;
+    index.findCoincidentVertices(tolerance, pairs);
+
+    Py::List list;
+    for (std::vector<std::pair<int, int> >::iterator it = pairs.begin(); it != pairs.end(); ++it) {
+        const SketchIndex::Vertex& v1 = vertices[it->first];
+        const SketchIndex::Vertex& v2 = vertices[it->second];
+        Py::Tuple tuple(4);
+        tuple.setItem(0, Py::Int(v1.GeoId));
+        tuple.setItem(1, Py::Int(int(v1.PosId)));
+        tuple.setItem(2, Py::Int(v2.GeoId));
+        tuple.setItem(3, Py::Int(int(v2.PosId)));
+        list.append(tuple);
+    }
+    return Py::new_reference_to(list);
+}
+
 PyObject* SketchObjectPy::ExposeInternalGeometry(PyObject *args)
 {
     int GeoId;
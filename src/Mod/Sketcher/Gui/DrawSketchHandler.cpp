@@ -241,19 +241,21 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
     // Decrease this value when a candidate is found.
     double tangDeviation = 0.1 * sketchgui->getScaleFactor();
 
-    // Get geometry list
-    const std::vector<Part::Geometry *> geomlist = sketchgui->getSketchObject()->getCompleteGeometry();
-
     Base::Vector3d tmpPos(Pos.fX, Pos.fY, 0.f);                 // Current cursor point
     Base::Vector3d tmpDir(Dir.fX, Dir.fY, 0.f);                 // Direction of line
     Base::Vector3d tmpStart(Pos.fX-Dir.fX, Pos.fY-Dir.fY, 0.f);  // Start point
 
+    // Only curves whose bounding box comes near the line are candidates
+    const Sketcher::SketchObject* obj = sketchgui->getSketchObject();
+    std::vector<int> geoIds;
+    obj->getGeometryIndex().findCurves(tmpStart, tmpPos, tangDeviation, geoIds);
+
     // Iterate through geometry
-    int i = 0;
-    for (std::vector<Part::Geometry *>::const_iterator it=geomlist.begin(); it != geomlist.end(); ++it, i++) {
+    for (std::vector<int>::const_iterator it=geoIds.begin(); it != geoIds.end(); ++it) {
+        const Part::Geometry* geo = obj->getGeometry(*it);
 
-        if ((*it)->getTypeId() == Part::GeomCircle::getClassTypeId()) {
-            const Part::GeomCircle *circle = dynamic_cast<const Part::GeomCircle *>((*it));
+        if (geo->getTypeId() == Part::GeomCircle::getClassTypeId()) {
+            const Part::GeomCircle *circle = dynamic_cast<const Part::GeomCircle *>(geo);
 
             Base::Vector3d center = circle->getCenter();
 
@@ -269,13 +271,13 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
             // Find if nearest
             if (projDist < tangDeviation) {
-                tangId = i;
+                tangId = *it;
                 tangDeviation = projDist;
             }
 
-        } else if ((*it)->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
+        } else if (geo->getTypeId() == Part::GeomEllipse::getClassTypeId()) {
             
-            const Part::GeomEllipse *ellipse = dynamic_cast<const Part::GeomEllipse *>((*it));
+            const Part::GeomEllipse *ellipse = dynamic_cast<const Part::GeomEllipse *>(geo);
 
             Base::Vector3d center = ellipse->getCenter();
 
@@ -297,12 +299,12 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
             double error = fabs((focus1PMirrored-focus2P).Length() - 2*a);
             
             if ( error< tangDeviation) { 
-                    tangId = i;
+                    tangId = *it;
                     tangDeviation = error;
             }
 
-        } else if ((*it)->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
-            const Part::GeomArcOfCircle *arc = dynamic_cast<const Part::GeomArcOfCircle *>((*it));
+        } else if (geo->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
+            const Part::GeomArcOfCircle *arc = dynamic_cast<const Part::GeomArcOfCircle *>(geo);
 
             Base::Vector3d center = arc->getCenter();
             double radius = arc->getRadius();
@@ -325,12 +327,12 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
                 // if the point is on correct side of arc
                 if (angle <= endAngle) {     // Now need to check only one side
-                    tangId = i;
+                    tangId = *it;
                     tangDeviation = projDist;
                 }
             }
-        } else if ((*it)->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
-            const Part::GeomArcOfEllipse *aoe = dynamic_cast<const Part::GeomArcOfEllipse *>((*it));
+        } else if (geo->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
+            const Part::GeomArcOfEllipse *aoe = dynamic_cast<const Part::GeomArcOfEllipse *>(geo);
 
             Base::Vector3d center = aoe->getCenter();
 
@@ -352,7 +354,7 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
             double error = fabs((focus1PMirrored-focus2P).Length() - 2*a);
             
             if ( error< tangDeviation ) {
-                    tangId = i;
+                    tangId = *it;
                     tangDeviation = error;
             }
 
@@ -370,7 +372,7 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
 
                 // if the point is on correct side of arc
                 if (angle <= endAngle) {     // Now need to check only one side
-                    tangId = i;
+                    tangId = *it;
                     tangDeviation = error;
                 }
             }
@@ -378,8 +380,6 @@ int DrawSketchHandler::seekAutoConstraint(std::vector<AutoConstraint> &suggested
     }
 
     if (tangId != Constraint::GeoUndef) {
-        if (tangId > getHighestCurveIndex()) // external Geometry
-            tangId = getHighestCurveIndex() - tangId;
         // Suggest vertical constraint
         constr.Type = Tangent;
         constr.GeoId = tangId;
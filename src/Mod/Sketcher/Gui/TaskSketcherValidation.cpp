@@ -95,51 +95,6 @@ void SketcherValidation::changeEvent(QEvent *e)
     QWidget::changeEvent(e);
 }
 
-struct SketcherValidation::VertexIds {
-    Base::Vector3d v;
-    int GeoId;
-    Sketcher::PointPos PosId;
-};
-
-struct SketcherValidation::Vertex_Less : public std::binary_function<const VertexIds&,
-                                                                     const VertexIds&, bool>
-{
-    Vertex_Less(double tolerance) : tolerance(tolerance){}
-    bool operator()(const VertexIds& x,
-                    const VertexIds& y) const
-    {
-        if (fabs (x.v.x - y.v.x) > tolerance)
-            return x.v.x < y.v.x;
-        if (fabs (x.v.y - y.v.y) > tolerance)
-            return x.v.y < y.v.y;
-        if (fabs (x.v.z - y.v.z) > tolerance)
-            return x.v.z < y.v.z;
-        return false; // points are considered to be equal
-    }
-private:
-    double tolerance;
-};
-
-struct SketcherValidation::Vertex_EqualTo : public std::binary_function<const VertexIds&,
-                                                                        const VertexIds&, bool>
-{
-    Vertex_EqualTo(double tolerance) : tolerance(tolerance){}
-    bool operator()(const VertexIds& x,
-                    const VertexIds& y) const
-    {
-        if (fabs (x.v.x - y.v.x) <= tolerance) {
-            if (fabs (x.v.y - y.v.y) <= tolerance) {
-                if (fabs (x.v.z - y.v.z) <= tolerance) {
-                    return true;
-                }
-            }
-        }
-        return false;
-    }
-private:
-    double tolerance;
-};
-
 struct SketcherValidation::ConstraintIds {
     Base::Vector3d v;
     int First;
@@ -172,50 +127,18 @@ struct SketcherValidation::Constraint_Less  : public std::binary_function<const
     }
 };
 
-void SketcherValidation::on_findButton_clicked()
+namespace {
+// Only the end points of internal curves are checked for missing coincidences
+bool isCurveEnd(const Sketcher::SketchObject* sketch, const Sketcher::SketchIndex::Vertex& v)
 {
-    std::vector<VertexIds> vertexIds;
-    const std::vector<Part::Geometry *>& geom = sketch->getInternalGeometry();
-    for (std::size_t i=0; i<geom.size(); i++) {
-        Part::Geometry* g = geom[i];
-        if (g->getTypeId() == Part::GeomLineSegment::getClassTypeId()) {
-            const Part::GeomLineSegment *segm = dynamic_cast<const Part::GeomLineSegment*>(g);
-            VertexIds id;
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::start;
-            id.v = segm->getStartPoint();
-            vertexIds.push_back(id);
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::end;
-            id.v = segm->getEndPoint();
-            vertexIds.push_back(id);
-        }
-        else if (g->getTypeId() == Part::GeomArcOfCircle::getClassTypeId()) {
-            const Part::GeomArcOfCircle *segm = dynamic_cast<const Part::GeomArcOfCircle*>(g);
-            VertexIds id;
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::start;
-            id.v = segm->getStartPoint(/*emulateCCW=*/true);
-            vertexIds.push_back(id);
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::end;
-            id.v = segm->getEndPoint(/*emulateCCW=*/true);
-            vertexIds.push_back(id);
-        }
-        else if (g->getTypeId() == Part::GeomArcOfEllipse::getClassTypeId()) {
-            const Part::GeomArcOfEllipse *segm = dynamic_cast<const Part::GeomArcOfEllipse*>(g);
-            VertexIds id;
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::start;
-            id.v = segm->getStartPoint(/*emulateCCW=*/true);
-            vertexIds.push_back(id);
-            id.GeoId = (int)i;
-            id.PosId = Sketcher::end;
-            id.v = segm->getEndPoint(/*emulateCCW=*/true);
-            vertexIds.push_back(id);
-        }
-    }
+    if (v.GeoId < 0 || (v.PosId != Sketcher::start && v.PosId != Sketcher::end))
+        return false;
+    return sketch->getGeometry(v.GeoId)->getTypeId() != Part::GeomPoint::getClassTypeId();
+}
+}
 
+void SketcherValidation::on_findButton_clicked()
+{
     std::set<ConstraintIds, Constraint_Less> coincidences;
     double prec = Precision::Confusion();
     QVariant v = ui->comboBoxTolerance->itemData(ui->comboBoxTolerance->currentIndex());
@@ -223,31 +146,24 @@ void SketcherValidation::on_findButton_clicked()
         prec = v.toDouble();
     else
         prec = QLocale::system().toDouble(ui->comboBoxTolerance->currentText());
-    std::sort(vertexIds.begin(), vertexIds.end(), Vertex_Less(prec));
-    std::vector<VertexIds>::iterator vt = vertexIds.begin();
-    Vertex_EqualTo pred(prec);
-    while (vt < vertexIds.end()) {
-        // get first item whose adjacent element has the same vertex coordinates
-        vt = std::adjacent_find(vt, vertexIds.end(), pred);
-        if (vt < vertexIds.end()) {
-            std::vector<VertexIds>::iterator vn;
-            for (vn = vt+1; vn != vertexIds.end(); ++vn) {
-                if (pred(*vt,*vn)) {
-                    ConstraintIds id;
-                    id.v = vt->v;
-                    id.First = vt->GeoId;
-                    id.FirstPos = vt->PosId;
-                    id.Second = vn->GeoId;
-                    id.SecondPos = vn->PosId;
-                    coincidences.insert(id);
-                }
-                else {
-                    break;
-                }
-            }
 
-            vt = vn;
-        }
+    // the geometry index of the sketch finds the close vertices without comparing all of them
+    const Sketcher::SketchIndex& index = sketch->getGeometryIndex();
+    const std::vector<Sketcher::SketchIndex::Vertex>& vertices = index.getVertices();
+    std::vector<std::pair<int, int> > pairs;
+    index.findCoincidentVertices(prec, pairs);
+    for (std::vector<std::pair<int, int> >::iterator it = pairs.begin(); it != pairs.end(); ++it) {
+        const Sketcher::SketchIndex::Vertex& v1 = vertices[it->first];
+        const Sketcher::SketchIndex::Vertex& v2 = vertices[it->second];
+        if (!isCurveEnd(sketch, v1) || !isCurveEnd(sketch, v2))
+            continue;
+        ConstraintIds id;
+        id.v = v1.Point;
+        id.First = v1.GeoId;
+        id.FirstPos = v1.PosId;
+        id.Second = v2.GeoId;
+        id.SecondPos = v2.PosId;
+        coincidences.insert(id);
     }
 
     std::vector<Sketcher::Constraint*> constraint = sketch->Constraints.getValues();
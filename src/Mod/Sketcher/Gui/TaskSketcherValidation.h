@@ -66,9 +66,6 @@ private:
     Sketcher::SketchObject* sketch;
     SoGroup* coincidenceRoot;
 
-    struct VertexIds;
-    struct Vertex_Less;
-    struct Vertex_EqualTo;
     struct ConstraintIds;
     struct Constraint_Less;
     std::vector<ConstraintIds> vertexConstraints;
@@ -119,3 +119,76 @@ class SketcherSolverTestCases(unittest.TestCase):
 		#closing doc
 		FreeCAD.closeDocument("SketchSolverTest")
 		#print ("omit close document for debuging")
+
+
+class SketcherIndexTestCases(unittest.TestCase):
+	def setUp(self):
+		self.Doc = FreeCAD.newDocument("SketchIndexTest")
+		self.Sketch = self.Doc.addObject('Sketcher::SketchObject','Sketch')
+
+	def coincidentPoints(self, tol=None):
+		if tol is None:
+			pairs = self.Sketch.findCoincidentPoints()
+		else:
+			pairs = self.Sketch.findCoincidentPoints(tol)
+		# the order of the two points of a pair doesn't matter
+		result = set()
+		for g1, p1, g2, p2 in pairs:
+			result.add(tuple(sorted([(g1, p1), (g2, p2)])))
+		self.failUnless(len(result) == len(pairs), "Pairs reported twice")
+		return result
+
+	def testExternalGeometry(self):
+		# points are 1 = start, 2 = end, 3 = mid
+		line = self.Doc.addObject('Part::Feature','Line')
+		line.Shape = Part.makeLine(App.Vector(0,0,0), App.Vector(10,0,0))
+		self.Sketch.addGeometry(Part.Line(App.Vector(10,0,0),App.Vector(10,10,0)))
+		self.Sketch.addGeometry(Part.Line(App.Vector(10,10.0099,0),App.Vector(0,10,0)))
+		self.Sketch.addGeometry(Part.Line(App.Vector(0,9.9899,0),App.Vector(0.0099,0,0)))
+		self.Sketch.addGeometry(Part.Circle(App.Vector(5,5,0),App.Vector(0,0,1),2))
+		self.Sketch.addGeometry(Part.ArcOfCircle(Part.Circle(App.Vector(10,10,0),App.Vector(0,0,1),1),0,1.5))
+		self.Sketch.addExternal("Line","Edge1")
+		self.Doc.recompute()
+
+		# the external line has the GeoId -3, -1 and -2 are the axes
+		exact = set([((-3,2), (0,1)), ((0,2), (4,3))])
+		self.failUnless(self.coincidentPoints() == exact, str(self.coincidentPoints()))
+
+		# 0.0099 is within the tolerance but 0.0101 is not
+		near = exact | set([((0,2), (1,1)), ((1,1), (4,3)), ((-3,1), (2,2))])
+		self.failUnless(self.coincidentPoints(0.01) == near, str(self.coincidentPoints(0.01)))
+		self.failUnless(((1,2), (2,1)) not in self.coincidentPoints(0.01))
+		self.failUnless(((1,2), (2,1)) in self.coincidentPoints(0.0102))
+
+		# removing the external geometry updates the index
+		self.Sketch.delExternal(0)
+		self.Doc.recompute()
+		self.failUnless(self.coincidentPoints() == set([((0,2), (4,3))]))
+
+	def testBruteForce(self):
+		import random
+		rand = random.Random(4711)
+		for i in range(300):
+			p1 = App.Vector(rand.randint(0, 40) + rand.uniform(-0.02, 0.02), rand.randint(0, 40), 0)
+			p2 = App.Vector(rand.randint(0, 40), rand.randint(0, 40) + rand.uniform(-0.02, 0.02), 0)
+			if p1.distanceToPoint(p2) > 0.1:
+				self.Sketch.addGeometry(Part.Line(p1, p2))
+
+		points = []
+		for geoId, geo in enumerate(self.Sketch.Geometry):
+			points.append((geoId, 1, geo.StartPoint))
+			points.append((geoId, 2, geo.EndPoint))
+
+		for tol in [0.005, 0.01, 0.03]:
+			expected = set()
+			for i in range(len(points)):
+				for j in range(i + 1, len(points)):
+					g1, p1, v1 = points[i]
+					g2, p2, v2 = points[j]
+					if g1 != g2 and (v1 - v2).Length <= tol:
+						expected.add(tuple(sorted([(g1, p1), (g2, p2)])))
+			self.failUnless(len(expected) > 0)
+			self.failUnless(self.coincidentPoints(tol) == expected, "Wrong coincident points for tolerance %f" % tol)
+
+	def tearDown(self):
+		FreeCAD.closeDocument("SketchIndexTest")
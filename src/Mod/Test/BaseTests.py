@@ -65,6 +65,52 @@ class ConsoleTestCase(unittest.TestCase):
         time.sleep(3)
         FreeCAD.Console.PrintMessage(str(self.count)+"\n")
 
+    def logFromThreads(self, asynchronous):
+        # App::FeatureTestConsole logs from C++ threads that don't hold the GIL
+        # and counts the messages with its own observer
+        doc = FreeCAD.newDocument("ConsoleTest")
+        try:
+            feature = doc.addObject("App::FeatureTestConsole","Console")
+            feature.Asynchronous = asynchronous
+            doc.recompute()
+            self.failUnless(feature.ExecCount == 1)
+            self.failUnless(feature.Delivered == feature.Threads * feature.Messages,
+                            "%d of %d messages delivered" % (feature.Delivered, feature.Threads * feature.Messages))
+            return feature.Delivered, max(feature.Seconds, 1e-6)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    def testLogThroughputFromThreads(self):
+        mode = FreeCAD.Console.IsAsynchronous()
+        try:
+            for asynchronous in [False, True]:
+                count, elapsed = self.logFromThreads(asynchronous)
+                FreeCAD.Console.PrintMessage("Logged %d messages from 8 threads in %.3f s (%.0f msg/s, asynchronous=%s)\n" % (count, elapsed, count/elapsed, asynchronous))
+            self.failUnless(FreeCAD.Console.IsAsynchronous() == mode)
+        finally:
+            FreeCAD.Console.SetAsynchronous(mode)
+
+    def testAsynchronousMode(self):
+        mode = FreeCAD.Console.IsAsynchronous()
+        try:
+            FreeCAD.Console.SetAsynchronous(True)
+            self.failUnless(FreeCAD.Console.IsAsynchronous())
+            # switching twice must not start a second consumer
+            FreeCAD.Console.SetAsynchronous(True)
+            # more messages than the queue can hold
+            self.logFromThreads(True)
+            self.failUnless(FreeCAD.Console.IsAsynchronous())
+            FreeCAD.Console.PrintMessage("   Printing message asynchronously\n")
+            FreeCAD.Console.PrintWarning("   Printing warning asynchronously\n")
+            # waits until the error is delivered
+            FreeCAD.Console.PrintError("   Printing error asynchronously\n")
+            # delivers the pending messages before it returns
+            FreeCAD.Console.SetAsynchronous(False)
+            self.failUnless(not FreeCAD.Console.IsAsynchronous())
+            self.assertRaises(TypeError, FreeCAD.Console.SetAsynchronous, "yes")
+        finally:
+            FreeCAD.Console.SetAsynchronous(mode)
+
 #    def testStatus(self):
 #        SLog = FreeCAD.GetStatus("Console","Log")
 #        SErr = FreeCAD.GetStatus("Console","Err")
@@ -149,6 +195,34 @@ class ParameterTestCase(unittest.TestCase):
         self.TestPar.RemString("44")
         self.failUnless(self.TestPar.GetString("44","hallo") == "hallo","Deletion error at String")
 
+    def testCachedValues(self):
+        # same name with different types must not interfere
+        self.TestPar.SetInt("Cache",1)
+        self.TestPar.SetFloat("Cache",2.5)
+        self.TestPar.SetString("Cache","three")
+        self.failUnless(self.TestPar.GetInt("Cache") == 1,"Type mix-up at Int")
+        self.failUnless(self.TestPar.GetFloat("Cache") == 2.5,"Type mix-up at Float")
+        self.failUnless(self.TestPar.GetString("Cache") == "three","Type mix-up at String")
+        # a modification must be visible right after a lookup
+        self.TestPar.SetInt("Cache",2)
+        self.failUnless(self.TestPar.GetInt("Cache") == 2,"Stale value at Int")
+        self.TestPar.Clear()
+        self.failUnless(self.TestPar.GetInt("Cache",7) == 7,"Stale value after Clear")
+        # concurrent readers
+        self.TestPar.SetUnsigned("Cache",4711)
+        import threading
+        result = []
+        def reader():
+            for i in range(1000):
+                if self.TestPar.GetUnsigned("Cache") != 4711:
+                    result.append(i)
+        threads = [threading.Thread(target=reader) for i in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.failUnless(len(result) == 0,"Wrong value read from thread")
+
     def testMatrix(self):
         m=FreeCAD.Matrix(4,2,1,0,1,1,1,0,0,0,1,0,0,0,0,1)
         u=m.multiply(m.inverse())
@@ -208,3 +282,169 @@ class ParameterTestCase(unittest.TestCase):
         #remove all
         TestPar = FreeCAD.ParamGet("System parameter:Test")
         TestPar.Clear()
+
+class TaskSchedulerTestCase(unittest.TestCase):
+    # App::FeatureTestParallel runs Base::parallel_for and Base::parallel_reduce
+    # over Count items on recompute
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("TaskSchedulerTest")
+        self.Feature = self.Doc.addObject("App::FeatureTestParallel","Parallel")
+
+    def checkRanges(self, count, grain):
+        ranges = self.Feature.Ranges
+        # the ranges must be joined in their order and cover all items
+        self.failUnless(len(ranges) % 2 == 0)
+        self.failUnless(ranges[0] == 0 and ranges[-1] == count, "Ranges %s don't cover %d items" % (ranges, count))
+        for i in range(0, len(ranges), 2):
+            self.failUnless(ranges[i] < ranges[i+1], "Empty range in %s" % ranges)
+            # only the last range may be smaller than the grain size
+            if i + 2 < len(ranges):
+                self.failUnless(ranges[i+1] - ranges[i] >= grain, "Range smaller than grain size in %s" % ranges)
+            if i > 0:
+                self.failUnless(ranges[i] == ranges[i-1], "Ranges %s joined out of order" % ranges)
+
+    def testCoverage(self):
+        for count, grain in [(1, 1), (7, 10), (1000, 1), (1000, 100), (100003, 1000)]:
+            self.Feature.Count = count
+            self.Feature.GrainSize = grain
+            self.Doc.recompute()
+            self.failUnless(self.Feature.ExecResult == "Exec")
+            self.failUnless(len(self.Feature.Visits) == count)
+            self.failUnless(self.Feature.Visits == [1] * count, "Items missed or visited twice")
+            self.checkRanges(count, grain)
+            self.failUnless(self.Feature.Sum == count * (count - 1) / 2)
+
+    def testSerial(self):
+        # fewer items than the grain size are processed in one go
+        self.Feature.Count = 50
+        self.Feature.GrainSize = 100
+        self.Doc.recompute()
+        self.failUnless(self.Feature.Ranges == [0, 50])
+
+    def testException(self):
+        self.Feature.Count = 1000
+        self.Feature.ExceptionAt = 500
+        self.Doc.recompute()
+        self.failUnless("Invalid" in self.Feature.State)
+        self.failUnless(self.Feature.ExecResult == "Exception at item 500", self.Feature.ExecResult)
+
+        # a failed run doesn't affect the next one
+        self.Feature.ExceptionAt = -1
+        self.Doc.recompute()
+        self.failUnless(self.Feature.ExecResult == "Exec")
+        self.failUnless(self.Feature.Visits == [1] * 1000)
+
+    def testCancel(self):
+        self.Feature.Count = 1000
+        self.Feature.GrainSize = 10
+        self.Feature.CancelAt = 0
+        self.Doc.recompute()
+        visits = self.Feature.Visits
+        self.failUnless(self.Feature.ExecResult == "Exec")
+        self.failUnless(max(visits) == 1 and visits[0] == 1)
+        # the rest of the canceling task is skipped, and so are all tasks
+        # that haven't started before
+        self.failUnless(visits[1:10] == [0] * 9)
+        self.failUnless(sum(visits) < 1000)
+
+    def tearDown(self):
+        FreeCAD.closeDocument("TaskSchedulerTest")
+
+class WorkerTestCase(unittest.TestCase):
+    # FreeCADCmd --worker runs in a separate process and gets jobs with a
+    # Part box that is exported, imported again and saved
+    def setUp(self):
+        import Part
+        self.Exe = os.path.join(FreeCAD.getHomePath(), "bin", "FreeCADCmd")
+        if os.name == "nt":
+            self.Exe += ".exe"
+            self.Name = "box 1"
+        else:
+            # a quote in a file name must not end a string in generated code
+            self.Name = 'box "1"'
+        self.Dir = tempfile.mkdtemp()
+        self.Input = os.path.join(self.Dir, self.Name + ".FCStd")
+        doc = FreeCAD.newDocument("WorkerTest")
+        doc.addObject("Part::Box", "Box")
+        doc.recompute()
+        doc.saveAs(self.Input)
+        FreeCAD.closeDocument(doc.Name)
+
+    def replies(self, output):
+        # the banner is printed before the worker starts
+        return [line.split("\t") for line in output.splitlines()
+                if line.startswith("ok\t") or line.startswith("error\t")]
+
+    def testStdin(self):
+        import subprocess, Part
+        brep = os.path.join(self.Dir, self.Name + ".brep")
+        copy = os.path.join(self.Dir, self.Name + " copy.FCStd")
+        missing = os.path.join(self.Dir, "missing.FCStd")
+        jobs = [self.Input + "\t" + brep, brep + "\t" + copy, missing, "quit", self.Input]
+        proc = subprocess.Popen([self.Exe, "--worker"], stdin=subprocess.PIPE,
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        out, err = proc.communicate("\n".join(jobs) + "\n")
+        self.failUnless(proc.returncode == 0, err)
+
+        # one reply per job, the job after 'quit' isn't processed
+        replies = self.replies(out)
+        self.failUnless(len(replies) == 3, out)
+        self.failUnless(replies[0][0] == "ok" and replies[0][2] == self.Input, replies[0])
+        self.failUnless(replies[1][0] == "ok" and replies[1][2] == brep, replies[1])
+        self.failUnless(replies[2][0] == "error" and replies[2][2] == missing, replies[2])
+        self.failUnless(replies[2][3] == "File not found", replies[2])
+
+        # the box made it through the export module and the import module
+        self.failUnless(abs(Part.read(brep).Volume - 1000.0) < 1e-6)
+        doc = FreeCAD.openDocument(copy)
+        try:
+            shapes = [o.Shape for o in doc.Objects if hasattr(o, "Shape")]
+            self.failUnless(len(shapes) == 1 and abs(shapes[0].Volume - 1000.0) < 1e-6)
+        finally:
+            FreeCAD.closeDocument(doc.Name)
+
+    def testSocketSlots(self):
+        import socket, subprocess, time
+        if not hasattr(socket, "AF_UNIX"):
+            return
+        path = os.path.join(self.Dir, "worker.socket")
+        log = open(os.path.join(self.Dir, "worker.log"), "w")
+        # the forked job slots must also work with the asynchronous console
+        proc = subprocess.Popen([self.Exe, "--async-log", "--worker-socket=" + path,
+                                 "--worker-slots=2"], stdout=log, stderr=log)
+        try:
+            clients = []
+            for i in range(2):
+                s = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+                for attempt in range(600):
+                    try:
+                        s.connect(path)
+                        break
+                    except socket.error:
+                        time.sleep(0.1)
+                clients.append(s)
+
+            # both connections are served at the same time by different slots
+            outputs = []
+            for i in range(2):
+                outputs.append(os.path.join(self.Dir, "slot%d.brep" % i))
+                clients[i].sendall(self.Input + "\t" + outputs[i] + "\nquit\n")
+            for i in range(2):
+                reply = ""
+                while not reply.endswith("\n"):
+                    data = clients[i].recv(4096)
+                    if not data:
+                        break
+                    reply += data
+                clients[i].close()
+                self.failUnless(reply.startswith("ok\t"), reply)
+                self.failUnless(os.path.exists(outputs[i]))
+        finally:
+            proc.terminate()
+            proc.wait()
+            log.close()
+        self.failUnless(proc.returncode == 0)
+
+    def tearDown(self):
+        import shutil
+        shutil.rmtree(self.Dir)
@@ -138,9 +138,105 @@ class DocumentBasicCases(unittest.TestCase):
     self.failUnless(L1.Label== "Label_2","Invalid object name")
     self.Doc.removeObject("Label_1")
 
+  def testInheritedProperties(self):
+    # App::FeatureTestException redefines ExceptionType of App::FeatureTest
+    L1 = self.Doc.addObject("App::FeatureTestException","Exception")
+    L2 = self.Doc.addObject("App::FeatureTest","Test")
+    self.failUnless(L1.ExceptionType != 0, "Property of the parent class found")
+    self.failUnless(L1.getPropertyByName("ExceptionType") == L1.ExceptionType)
+    self.failUnless(L2.ExceptionType == 0)
+    # properties of the parent classes
+    self.failUnless(L1.getPropertyByName("Integer") == 4711)
+    self.failUnless(L1.getTypeIdOfProperty("Integer") == "App::PropertyInteger")
+    self.failUnless(L1.getPropertyByName("Label") == "Exception")
+    self.failUnless(L1.getTypeIdOfProperty("Label") == "App::PropertyString")
+    for i in ["ExceptionType", "Integer", "Label"]:
+      self.failUnless(L1.PropertiesList.count(i) == 1, "'%s' not listed once" % (i))
+    # objects created later use the same lookup tables
+    L3 = self.Doc.addObject("App::FeatureTestException","Exception")
+    self.failUnless(L3.ExceptionType == L1.ExceptionType)
+    self.failUnless(L3.getGroupOfProperty("Integer") == L1.getGroupOfProperty("Integer"))
+    self.Doc.removeObject(L1.Name)
+    self.Doc.removeObject(L2.Name)
+    self.Doc.removeObject(L3.Name)
+
   def testMem(self):
     self.Doc.MemSize
 
+  def testUniqueNames(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Box")
+    L2 = self.Doc.addObject("App::FeatureTest","Box")
+    L3 = self.Doc.addObject("App::FeatureTest","Box")
+    self.failUnless(L2.Name == "Box001" and L3.Name == "Box002","Invalid object name")
+    # the highest suffix in use determines the next name
+    self.Doc.removeObject("Box001")
+    L4 = self.Doc.addObject("App::FeatureTest","Box")
+    self.failUnless(L4.Name == "Box003","Invalid object name")
+    self.Doc.removeObject("Box003")
+    L5 = self.Doc.addObject("App::FeatureTest","Box")
+    self.failUnless(L5.Name == "Box003","Invalid object name")
+    # relabeling doesn't change the names
+    L5.Label = "Box010"
+    L6 = self.Doc.addObject("App::FeatureTest","Box")
+    self.failUnless(L6.Name == "Box004","Invalid object name")
+
+  def testPropertyBuffer(self):
+    L1 = self.Doc.addObject("App::FeatureTest","Label")
+    L1.FloatList = [1.0, 2.0, 3.0]
+    view = L1.getPropertyBuffer("FloatList")
+    self.failUnless(len(view) == 3 and view.shape == (3,1) and view.format == "d")
+    L1.VectorList = [FreeCAD.Vector(1,2,3), FreeCAD.Vector(4,5,6)]
+    view = L1.getPropertyBuffer("VectorList")
+    self.failUnless(view.shape == (2,3))
+    # assigning a buffer copies its values
+    L1.FloatList = view
+    self.failUnless(L1.FloatList == [1.0, 2.0, 3.0, 4.0, 5.0, 6.0])
+    L1.VectorList = L1.getPropertyBuffer("FloatList")
+    self.failUnless(L1.VectorList[1] == FreeCAD.Vector(4,5,6))
+    L1.IntegerList = [4, 5, 6]
+    L1.FloatList = L1.getPropertyBuffer("IntegerList")
+    self.failUnless(L1.FloatList == [4.0, 5.0, 6.0])
+    try:
+      L1.IntegerList = L1.getPropertyBuffer("FloatList")
+    except Exception:
+      pass
+    else:
+      self.fail("Float buffer assigned to integer list")
+    self.failUnlessRaises(TypeError, L1.getPropertyBuffer, "Integer")
+    # the properties cannot be changed while a buffer is in use
+    view = memoryview(L1.getPropertyBuffer("FloatList"))
+    try:
+      L1.FloatList = [1.0]
+    except BufferError:
+      pass
+    else:
+      self.fail("Exported list property changed")
+    self.failUnless(L1.getTypeIdOfProperty("FloatList") == "App::PropertyFloatList")
+    del view
+    L1.FloatList = [1.0]
+    self.failUnless(L1.FloatList == [1.0])
+
+  def testPropertyBufferUndo(self):
+    # undo and recompute change the lists from C++ while their data is in use
+    self.Doc.UndoMode = 1
+    L1 = self.Doc.addObject("App::FeatureTestParallel","Label")
+    L1.Count = 1000
+    self.Doc.recompute()
+    self.Doc.openTransaction("Change")
+    L1.FloatList = [float(i) for i in range(1000)]
+    self.Doc.commitTransaction()
+    L1.Count = 5000
+    floats = memoryview(L1.getPropertyBuffer("FloatList"))
+    visits = memoryview(L1.getPropertyBuffer("Visits"))
+    data = floats.tobytes(), visits.tobytes()
+    self.Doc.undo()
+    self.failUnless(len(L1.FloatList) == 1)
+    self.Doc.recompute()
+    self.failUnless(len(L1.Visits) == 5000)
+    self.failUnless((floats.tobytes(), visits.tobytes()) == data)
+    del floats, visits
+    L1.FloatList = [1.0]
+
   def testAddRemove(self):
     L1 = self.Doc.addObject("App::FeatureTest","Label_1")
     # must delete object
@@ -570,6 +666,86 @@ class UndoRedoCases(unittest.TestCase):
     self.assertEqual(self.Doc.RedoNames,[])
     self.assertEqual(self.Doc.RedoCount,0)
 
+  def editLargeValues(self, edit, values):
+    # each transaction changes a single value, returns the values and the
+    # undo size after each transaction
+    states = [values()]
+    sizes = [self.Doc.UndoRedoMemSize]
+    for i in range(4):
+      self.Doc.openTransaction("Edit%d" % i)
+      edit(i)
+      self.Doc.commitTransaction()
+      states.append(values())
+      sizes.append(self.Doc.UndoRedoMemSize)
+
+    # the first transaction keeps a copy of all values, the others only
+    # the chunk of 64 KB with the changed value
+    full = sizes[1] - sizes[0]
+    for i in range(2, len(sizes)):
+      step = sizes[i] - sizes[i-1]
+      self.failUnless(step < 0x20000, "Undo size grows by %d bytes for a single value" % step)
+      self.failUnless(step < full / 4, "Undo size grows by %d of %d bytes for a single value" % (step, full))
+    return states
+
+  def checkUndoRedo(self, states, values):
+    for i in range(3):
+      for state in reversed(states[:-1]):
+        self.Doc.undo()
+        self.failUnless(values() == state)
+      for state in states[1:]:
+        self.Doc.redo()
+        self.failUnless(values() == state)
+
+  def testUndoLargeFloatList(self):
+    obj = self.Doc.getObject("Base")
+    obj.FloatList = [i * 0.1 for i in range(100000)]
+    self.Doc.UndoMode = 1
+
+    def edit(i):
+      values = obj.FloatList
+      values[1000 + i * 30000] = -1.0 / (i + 3)
+      obj.FloatList = values
+    values = lambda: obj.FloatList
+    states = self.editLargeValues(edit, values)
+    self.checkUndoRedo(states, values)
+    self.Doc.UndoMode = 0
+
+  def testUndoLargeVectorList(self):
+    obj = self.Doc.getObject("Base")
+    obj.VectorList = [(i, -i, i * 0.1) for i in range(30000)]
+    self.Doc.UndoMode = 1
+
+    def edit(i):
+      values = obj.VectorList
+      values[1000 + i * 9000] = FreeCAD.Vector(1.0 / (i + 3), 0, -1)
+      obj.VectorList = values
+    values = lambda: [(v.x, v.y, v.z) for v in obj.VectorList]
+    states = self.editLargeValues(edit, values)
+    self.checkUndoRedo(states, values)
+    self.Doc.UndoMode = 0
+
+  def testUndoLargeMesh(self):
+    import Mesh
+    triangles = []
+    for i in range(100):
+      for j in range(100):
+        triangles += [[i, j, 0], [i + 1, j, 0], [i + 1, j + 1, 0]]
+        triangles += [[i, j, 0], [i + 1, j + 1, 0], [i, j + 1, 0]]
+    obj = self.Doc.addObject("Mesh::Feature","Mesh")
+    obj.Mesh = Mesh.Mesh(triangles)
+    self.Doc.UndoMode = 1
+
+    def edit(i):
+      mesh = obj.Mesh.copy()
+      mesh.setPoint(500 + i * 3000, FreeCAD.Vector(0.5, 0.25, 1.0 / (i + 3)))
+      obj.Mesh = mesh
+    def values():
+      points, facets = obj.Mesh.Topology
+      return ([(p.x, p.y, p.z) for p in points], facets)
+    states = self.editLargeValues(edit, values)
+    self.checkUndoRedo(states, values)
+    self.Doc.UndoMode = 0
+
   def testGroup(self):
     # Add an object to the group
     L2 = self.Doc.addObject("App::FeatureTest","Label_2")
@@ -698,6 +874,22 @@ class DocumentPlatformCases(unittest.TestCase):
 
     self.failUnless(len(self.Doc.Test.VectorList) == 2)
 
+  def testLargeLists(self):
+    floats = [i * 0.5 for i in range(5000)]
+    vectors = [(i, -i, i * 0.25) for i in range(5000)]
+    self.Doc.Test.FloatList = floats
+    self.Doc.Test.VectorList = vectors
+
+    # saving and restoring
+    self.Doc.saveAs(self.DocName)
+    FreeCAD.closeDocument("PlatformTests")
+    self.Doc = FreeCAD.open(self.DocName)
+
+    self.failUnless(self.Doc.Test.FloatList == floats)
+    self.failUnless(len(self.Doc.Test.VectorList) == 5000)
+    v = self.Doc.Test.VectorList[4711]
+    self.failUnless(v.x == 4711 and v.y == -4711 and v.z == 4711 * 0.25)
+
   def testPoints(self):
     try:
       self.Doc.addObject("Points::Feature", "Points")
@@ -45,7 +45,11 @@ def All():
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("MeshTestsApp") )
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestSketcherApp") )
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestPartApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestImportApp") )
     suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestPartDesignApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("DrawingTests") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestReverseEngineeringApp") )
+    suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestFem") )
     # gui tests of modules
     if ( FreeCAD.GuiUp == 1):
         suite.addTest(unittest.defaultTestLoader.loadTestsFromName("TestSketcherGui") )
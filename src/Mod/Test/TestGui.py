@@ -54,6 +54,7 @@ class TestCmd:
         QtUnitGui.addTest("Menu")
         QtUnitGui.addTest("Menu.MenuDeleteCases")
         QtUnitGui.addTest("Menu.MenuCreateCases")
+        QtUnitGui.addTest("TreeView")
 
     def GetResources(self):
         return {'MenuText': 'Self-test...', 'ToolTip': 'Runs a self-test to check if the application works properly'}
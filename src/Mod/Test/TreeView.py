@@ -0,0 +1,120 @@
+# Tree view test module
+# (c) 2026 FreeCAD Developers
+#
+
+#***************************************************************************
+#*   Copyright (c) 2026 FreeCAD Developers                                 *
+#*                                                                         *
+#*   This file is part of the FreeCAD CAx development system.              *
+#*                                                                         *
+#*   This program is free software; you can redistribute it and/or modify  *
+#*   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#*   as published by the Free Software Foundation; either version 2 of     *
+#*   the License, or (at your option) any later version.                   *
+#*   for detail see the LICENCE text file.                                 *
+#*                                                                         *
+#*   FreeCAD is distributed in the hope that it will be useful,            *
+#*   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#*   GNU Library General Public License for more details.                  *
+#*                                                                         *
+#*   You should have received a copy of the GNU Library General Public     *
+#*   License along with FreeCAD; if not, write to the Free Software        *
+#*   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#*   USA                                                                   *
+#*                                                                         *
+#***************************************************************************/
+
+import FreeCAD, FreeCADGui, unittest
+from PySide import QtGui
+
+class DocumentModelTestCase(unittest.TestCase):
+    def setUp(self):
+        # the model only shows documents that are created after it
+        self.Tree = FreeCADGui.UiLoader().createWidget("Gui::TreeView")
+        self.Model = self.Tree.model()
+        self.Doc = FreeCAD.newDocument("TreeViewTest")
+        self.Groups = []
+        for i in range(50):
+            grp = self.Doc.addObject("App::DocumentObjectGroup", "Group")
+            for j in range(100):
+                grp.addObject(self.Doc.addObject("App::DocumentObjectGroup", "Child"))
+            self.Groups.append(grp)
+        # the structural changes are applied once per event loop turn
+        QtGui.qApp.processEvents()
+
+    def documentIndex(self):
+        root = self.Model.index(0, 0)
+        for row in range(self.Model.rowCount(root)):
+            index = self.Model.index(row, 0, root)
+            if self.Model.data(index) == self.Doc.Label:
+                return index
+        self.fail("Document not found in the model")
+
+    def testLazyChildren(self):
+        doc = self.documentIndex()
+        # the claimed objects are not shown at the top-level
+        self.failUnless(self.Model.rowCount(doc) == len(self.Groups))
+        for row in range(self.Model.rowCount(doc)):
+            index = self.Model.index(row, 0, doc)
+            self.failUnless(self.Model.hasChildren(index))
+            self.failUnless(self.Model.canFetchMore(index))
+            self.failUnless(self.Model.rowCount(index) == 0)
+
+        # only the fetched item gets its children
+        first = self.Model.index(0, 0, doc)
+        self.Model.fetchMore(first)
+        self.failIf(self.Model.canFetchMore(first))
+        self.failUnless(self.Model.rowCount(first) == 100)
+        second = self.Model.index(1, 0, doc)
+        self.failUnless(self.Model.canFetchMore(second))
+        self.failUnless(self.Model.rowCount(second) == 0)
+
+        # a child without children has nothing to fetch
+        child = self.Model.index(0, 0, first)
+        self.failIf(self.Model.hasChildren(child))
+        self.Model.fetchMore(child)
+        self.failUnless(self.Model.rowCount(child) == 0)
+
+    def testExpand(self):
+        # the view fetches the children of an item when laying it out expanded
+        doc = self.documentIndex()
+        self.Tree.show()
+        self.Tree.expand(self.Model.index(0, 0))
+        self.Tree.expand(doc)
+        index = self.Model.index(2, 0, doc)
+        self.Tree.expand(index)
+        QtGui.qApp.processEvents()
+        self.Tree.doItemsLayout()
+        self.failUnless(self.Tree.isExpanded(index))
+        self.failUnless(self.Model.rowCount(index) == 100)
+        self.failUnless(self.Model.rowCount(self.Model.index(3, 0, doc)) == 0)
+
+    def testMoveChild(self):
+        doc = self.documentIndex()
+        first = self.Model.index(0, 0, doc)
+        self.Model.fetchMore(first)
+        child = self.Groups[0].Group[0]
+        self.Groups[0].removeObject(child)
+        self.Groups[1].addObject(child)
+        QtGui.qApp.processEvents()
+        # the populated item is updated, the other one is fetched later
+        self.failUnless(self.Model.rowCount(first) == 99)
+        second = self.Model.index(1, 0, doc)
+        self.failUnless(self.Model.canFetchMore(second))
+        self.Model.fetchMore(second)
+        self.failUnless(self.Model.rowCount(second) == 101)
+        self.failUnless(self.Model.rowCount(doc) == len(self.Groups))
+
+    def testRelease(self):
+        doc = self.documentIndex()
+        child = self.Groups[0].Group[0]
+        self.Groups[0].removeObject(child)
+        QtGui.qApp.processEvents()
+        # an object released by its group goes back to the top-level
+        self.failUnless(self.Model.rowCount(doc) == len(self.Groups) + 1)
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.Doc.Name)
+        QtGui.qApp.processEvents()
+        self.Tree.deleteLater()
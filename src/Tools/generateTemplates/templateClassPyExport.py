@@ -450,6 +450,12 @@ PyObject * @self.export.Name@::staticCallback_@i.Name@ (PyObject *self, PyObject
         PyErr_SetString(PyExc_ReferenceError, "This object is immutable, you can not set any attribute or call a non const method");
         return NULL;
     }
+
+    // test if the data of the object is exported as buffer
+    if (((PyObjectBase*) self)->isExported()){
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        return NULL;
+    }
 -
 
     try { // catches all exceptions coming up from c++ and generate a python exception
@@ -711,6 +717,12 @@ PyObject *@self.export.Name@::_getattr(char *attr)				// __getattr__ function: n
 
 int @self.export.Name@::_setattr(char *attr, PyObject *value) 	// __setattr__ function: note only need to handle new state
 {
+    // test if the data of the object is exported as buffer
+    if (isExported()) {
+        PyErr_SetString(PyExc_BufferError, "Object cannot be changed while its data is exported as buffer");
+        return -1;
+    }
+
     try {
         // setter for  special Attributes (e.g. dynamic ones)
         int r = setCustomAttributes(attr, value);